@@ -0,0 +1,174 @@
+/**
+ * @file JwtCodecBenchmark.cpp
+ * @brief Бенчмарк проверки access-токена: прежний JSON-путь против JwtCodec
+ *
+ * "json x3" повторяет удалённый FakeJwtAdapter: isValidToken, getUserId и
+ * getAccountId по отдельности декодируют base64 и делают nlohmann::json::parse,
+ * первый - под мьютексом чёрного списка. "hmac" - HmacJwtAdapter::validateAndExtract
+ * (подпись HS256 + разбор claims за один проход). Один поток - токенов/с на ядро.
+ * allocs/op считается подменой operator new.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./auth-JwtCodecBenchmark [iterations]
+ */
+
+#include "adapters/secondary/HmacJwtAdapter.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_set>
+
+using namespace auth;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<size_t> allocations{0};
+
+}  // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// Не даём компилятору выбросить результат
+volatile size_t sink = 0;
+
+double elapsedNs(Clock::time_point started) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - started).count();
+}
+
+void report(const char* name, double totalNs, int iterations, size_t allocs) {
+    std::cout << std::left << std::setw(18) << name << std::right
+              << std::setw(9) << std::fixed << std::setprecision(1) << totalNs / iterations << " ns/op"
+              << std::setw(12) << std::setprecision(0) << iterations / (totalNs / 1e9) << " tokens/s"
+              << std::setw(8) << std::setprecision(1) << static_cast<double>(allocs) / iterations << " allocs/op"
+              << std::endl;
+}
+
+// --- прежний FakeJwtAdapter ---
+
+std::string base64UrlEncode(const std::string& input) {
+    static const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string result;
+    int val = 0, valb = -6;
+    for (unsigned char c : input) {
+        val = (val << 8) + c;
+        valb += 8;
+        while (valb >= 0) {
+            result.push_back(chars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
+    }
+    if (valb > -6)
+        result.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+    return result;
+}
+
+std::string base64UrlDecode(const std::string& input) {
+    std::string result;
+    int val = 0, valb = -8;
+    for (unsigned char c : input) {
+        int v = c >= 'A' && c <= 'Z' ? c - 'A'
+              : c >= 'a' && c <= 'z' ? c - 'a' + 26
+              : c >= '0' && c <= '9' ? c - '0' + 52
+              : c == '-' ? 62 : c == '_' ? 63 : -1;
+        if (v < 0)
+            continue;
+        val = (val << 6) + v;
+        valb += 6;
+        if (valb >= 0) {
+            result.push_back(char((val >> valb) & 0xFF));
+            valb -= 8;
+        }
+    }
+    return result;
+}
+
+nlohmann::json decodePayload(const std::string& token) {
+    size_t first = token.find('.');
+    size_t last = token.rfind('.');
+    return nlohmann::json::parse(base64UrlDecode(token.substr(first + 1, last - first - 1)));
+}
+
+std::string legacyToken() {
+    nlohmann::json payload;
+    payload["type"] = "access";
+    payload["userId"] = "user-1760000000000000000-42";
+    payload["accountId"] = "acc-7d3b9e21-5c4a-4f0e-8b6d-2a1c9f8e7d60";
+    payload["iat"] = std::chrono::system_clock::now().time_since_epoch().count();
+    payload["exp"] = payload["iat"].get<int64_t>() + 3600 * 1000000000LL;
+    return "eyJ." + base64UrlEncode(payload.dump()) + ".sig";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    std::cout << "[JwtCodecBenchmark] iterations=" << iterations << std::endl;
+
+    // --- json x3 ---
+    std::mutex blacklistMutex;
+    std::unordered_set<std::string> blacklist;
+    std::string legacy = legacyToken();
+
+    size_t allocsBefore = allocations.load();
+    auto started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        bool valid;
+        {
+            std::lock_guard<std::mutex> lock(blacklistMutex);
+            valid = blacklist.count(legacy) == 0 && decodePayload(legacy).value("exp", 0LL) > 0;
+        }
+        std::string userId = decodePayload(legacy).value("userId", "");
+        std::string accountId = decodePayload(legacy).value("accountId", "");
+        sink = sink + valid + userId.size() + accountId.size();
+    }
+    report("json x3", elapsedNs(started), iterations, allocations.load() - allocsBefore);
+
+    // --- hmac ---
+    setenv("JWT_SECRET", "benchmark-jwt-secret", 0);
+    adapters::secondary::HmacJwtAdapter jwt(std::make_shared<adapters::secondary::AuthSettings>());
+    std::string token = jwt.createAccessToken(
+        "user-1760000000000000000-42", "acc-7d3b9e21-5c4a-4f0e-8b6d-2a1c9f8e7d60", 3600);
+
+    allocsBefore = allocations.load();
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto claims = jwt.validateAndExtract(token);
+        sink = sink + claims->userId.size() + claims->accountId.size();
+    }
+    report("hmac", elapsedNs(started), iterations, allocations.load() - allocsBefore);
+
+    // --- hmac, отклонённая подпись ---
+    std::string forged = token;
+    forged[forged.size() - 2] = forged[forged.size() - 2] == 'A' ? 'B' : 'A';
+
+    allocsBefore = allocations.load();
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + jwt.validateAndExtract(forged).has_value();
+    }
+    report("hmac forged", elapsedNs(started), iterations, allocations.load() - allocsBefore);
+
+    return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file LoginStormBenchmark.cpp
+ * @brief Бенчмарк параллельных login: одно соединение против пула
+ *
+ * Настоящие PostgresUserRepository / PostgresSessionRepository и AuthService,
+ * N потоков одновременно логинят заранее зарегистрированных пользователей
+ * (findByUsername + INSERT сессии на каждый login).
+ *
+ * "pool=1" - пул из одного соединения: так раньше работал каждый репозиторий
+ * (одно соединение под мьютексом), все потоки стоят в очереди к нему.
+ * "pool=N" - пул из N соединений, по одному на поток.
+ *
+ * Нужен PostgreSQL со схемой sql/01-schema.sql, подключение - из AUTH_DB_*
+ * (docker-compose из корня подходит). Созданные сессии удаляются в конце.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./auth-LoginStormBenchmark [logins] [threads]
+ */
+
+#include "adapters/secondary/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
+#include "adapters/secondary/PostgresUserRepository.hpp"
+#include "adapters/secondary/PostgresSessionRepository.hpp"
+#include "adapters/secondary/HmacJwtAdapter.hpp"
+#include "application/AuthService.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace auth;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int USERS = 64;
+const std::string PASSWORD = "storm-password";
+
+class NullEventPublisher : public ports::output::IEventPublisher {
+public:
+    void publish(const std::string&, const std::string&) override {}
+};
+
+// Не даём компилятору выбросить результат
+volatile size_t sink = 0;
+
+std::string username(int i) {
+    return "storm-user-" + std::to_string(i);
+}
+
+void report(const char* name, double totalNs, int logins, std::vector<double>& latenciesUs,
+            const adapters::secondary::PgConnectionPool::Stats& stats) {
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    auto percentile = [&](double p) {
+        return latenciesUs.empty() ? 0.0 : latenciesUs[static_cast<size_t>(p * (latenciesUs.size() - 1))];
+    };
+    double avgWaitUs = stats.checkouts == 0 ? 0.0
+        : static_cast<double>(stats.waitMicrosTotal) / stats.checkouts;
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::setw(10) << std::fixed << std::setprecision(0) << logins / (totalNs / 1e9) << " logins/s"
+              << std::setw(9) << std::setprecision(0) << percentile(0.50) << " us p50"
+              << std::setw(9) << percentile(0.99) << " us p99"
+              << std::setw(9) << std::setprecision(1) << avgWaitUs << " us pool wait"
+              << std::endl;
+}
+
+/**
+ * @brief Один прогон: свой пул заданного размера, logins login из threads потоков
+ */
+void runStorm(const char* name, int poolSize, int logins, int threads) {
+    setenv("AUTH_DB_POOL_SIZE", std::to_string(poolSize).c_str(), 1);
+    setenv("JWT_SECRET", "benchmark-jwt-secret", 0);
+
+    auto dbSettings = std::make_shared<adapters::secondary::DbSettings>();
+    auto authSettings = std::make_shared<adapters::secondary::AuthSettings>();
+    auto pool = std::make_shared<adapters::secondary::PgConnectionPool>(dbSettings);
+    auto users = std::make_shared<adapters::secondary::PostgresUserRepository>(pool);
+    auto sessions = std::make_shared<adapters::secondary::PostgresSessionRepository>(
+        pool, dbSettings, authSettings);
+    application::AuthService service(
+        authSettings, users, sessions,
+        std::make_shared<adapters::secondary::HmacJwtAdapter>(authSettings),
+        std::make_shared<NullEventPublisher>());
+
+    for (int i = 0; i < USERS; ++i) {
+        if (!users->existsByUsername(username(i))) {
+            service.registerUser(username(i), username(i) + "@storm.local", PASSWORD);
+        }
+    }
+
+    // Прогрев: каждое соединение пула открыто и подготовило запросы
+    for (int i = 0; i < poolSize; ++i) {
+        sink = sink + service.login(username(i % USERS), PASSWORD).success;
+    }
+
+    std::atomic<int> next{0};
+    std::atomic<int> failures{0};
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    auto started = Clock::now();
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            latencies[t].reserve(logins / threads + 1);
+            for (int i = next.fetch_add(1); i < logins; i = next.fetch_add(1)) {
+                auto loginStarted = Clock::now();
+                bool ok = false;
+                try {
+                    ok = service.login(username(i % USERS), PASSWORD).success;
+                } catch (const std::exception&) {
+                    // PoolTimeoutError или ошибка БД - считаем отказом
+                }
+                latencies[t].push_back(
+                    std::chrono::duration<double, std::micro>(Clock::now() - loginStarted).count());
+                if (!ok) {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    double totalNs = std::chrono::duration<double, std::nano>(Clock::now() - started).count();
+
+    std::vector<double> all;
+    for (auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    report(name, totalNs, logins, all, pool->stats());
+    if (failures.load() > 0) {
+        std::cout << "  failures: " << failures.load() << std::endl;
+    }
+
+    for (int i = 0; i < USERS; ++i) {
+        if (auto user = users->findByUsername(username(i))) {
+            sessions->deleteByUserId(user->userId);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const int logins = argc > 1 ? std::atoi(argv[1]) : 20000;
+    const int threads = argc > 2 ? std::atoi(argv[2])
+                                 : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    std::cout << "[LoginStormBenchmark] logins=" << logins << " threads=" << threads << std::endl;
+
+    try {
+        runStorm("pool=1", 1, logins, threads);
+        std::string pooled = "pool=" + std::to_string(threads);
+        runStorm(pooled.c_str(), threads, logins, threads);
+    } catch (const std::exception& e) {
+        std::cerr << "[LoginStormBenchmark] " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -10,18 +10,22 @@
 #include "ports/output/IAccountRepository.hpp"
 #include "ports/output/ISessionRepository.hpp"
 #include "ports/output/IJwtProvider.hpp"
+#include "ports/output/IEventPublisher.hpp"
 
 // Application
 #include "application/AuthService.hpp"
 #include "application/AccountService.hpp"
 
 // Secondary Adapters
-#include "adapters/secondary/FakeJwtAdapter.hpp"
+#include "adapters/secondary/HmacJwtAdapter.hpp"
 #include "adapters/secondary/PostgresUserRepository.hpp"
 #include "adapters/secondary/PostgresAccountRepository.hpp"
 #include "adapters/secondary/PostgresSessionRepository.hpp"
 #include "adapters/secondary/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include "adapters/secondary/AuthSettings.hpp"
+#include "adapters/secondary/RabbitMQSettings.hpp"
+#include "adapters/secondary/RabbitMQPublisher.hpp"
 
 // Primary Adapters
 #include "HealthHandler.hpp"
@@ -30,6 +34,7 @@
 #include "adapters/primary/LoginHandler.hpp"
 #include "adapters/primary/LogoutHandler.hpp"
 #include "adapters/primary/ValidateTokenHandler.hpp"
+#include "adapters/primary/ValidateTokenBatchHandler.hpp"
 #include "adapters/primary/GetAccountsHandler.hpp"
 #include "adapters/primary/AddAccountHandler.hpp"
 #include "adapters/primary/DeleteAccountHandler.hpp"
@@ -65,6 +70,11 @@ protected:
     void configureInjection() override {
         std::cout << "[AuthApp] Configuring Boost.DI injection..." << std::endl;
 
+        // auth.session.revoked для trading-service (кэш валидации токенов)
+        eventPublisher_ = std::make_shared<adapters::secondary::RabbitMQPublisher>(
+            std::make_shared<adapters::secondary::RabbitMQSettings>());
+        eventPublisher_->start();
+
         // ====================================================================
         // Boost.DI Injector Configuration
         // ====================================================================
@@ -80,6 +90,9 @@ protected:
             di::bind<adapters::secondary::AuthSettings>()
                 .to(std::make_shared<adapters::secondary::AuthSettings>()),
 
+            // Один пул на все репозитории
+            di::bind<adapters::secondary::PgConnectionPool>().in(di::singleton),
+
             // ================================================================
             // Layer 2: Secondary Adapters (Output Ports implementations)
             // ================================================================
@@ -97,9 +110,12 @@ protected:
                 .in(di::singleton),
             
             di::bind<ports::output::IJwtProvider>()
-                .to<adapters::secondary::FakeJwtAdapter>()
+                .to<adapters::secondary::HmacJwtAdapter>()
                 .in(di::singleton),
 
+            di::bind<ports::output::IEventPublisher>()
+                .to(eventPublisher_),
+
             // ================================================================
             // Layer 3: Application Services (Input Ports implementations)
             // ================================================================
@@ -114,7 +130,7 @@ protected:
         );
 
         std::cout << "[AuthApp] DI Injector configured:" << std::endl;
-        std::cout << "  ✓ Secondary Adapters (4 bindings)" << std::endl;
+        std::cout << "  ✓ Secondary Adapters (5 bindings)" << std::endl;
         std::cout << "  ✓ Application Services (2 bindings)" << std::endl;
 
         // ====================================================================
@@ -161,6 +177,12 @@ protected:
             std::cout << "  ✓ ValidateTokenHandler: POST /api/v1/auth/validate" << std::endl;
         }
 
+        {
+            auto handler = injector.create<std::shared_ptr<adapters::primary::ValidateTokenBatchHandler>>();
+            registerEndpoint("POST", "/api/v1/auth/validate/batch", handler);
+            std::cout << "  ✓ ValidateTokenBatchHandler: POST /api/v1/auth/validate/batch" << std::endl;
+        }
+
         // Access Token Handler
         {
             auto handler = injector.create<std::shared_ptr<adapters::primary::GetAccessTokenHandler>>();
@@ -187,8 +209,11 @@ protected:
             std::cout << "  ✓ DeleteAccountHandler: DELETE /api/v1/accounts/*" << std::endl;
         }
 
-        std::cout << "[AuthApp] Configuration complete! 10 handlers registered." << std::endl;
+        std::cout << "[AuthApp] Configuration complete! 11 handlers registered." << std::endl;
     }
+
+private:
+    std::shared_ptr<adapters::secondary::RabbitMQPublisher> eventPublisher_;
 };
 
 } // namespace auth
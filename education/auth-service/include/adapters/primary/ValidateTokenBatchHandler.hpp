@@ -0,0 +1,85 @@
+#pragma once
+
+#include <IHttpHandler.hpp>
+#include "ports/input/IAuthService.hpp"
+#include "adapters/primary/ValidateTokenHandler.hpp"
+#include <nlohmann/json.hpp>
+#include <memory>
+
+namespace auth::adapters::primary {
+
+/**
+ * @brief Пакетная валидация токенов (внутренний API для Trading Service)
+ *
+ * POST /api/v1/auth/validate/batch
+ * {
+ *   "tokens": ["eyJ...", "eyJ..."],
+ *   "type": "access"          // session или access, как в /validate
+ * }
+ *
+ * Response (results[i] - для tokens[i], формат как у /validate):
+ * {
+ *   "results": [
+ *     {"valid": true, "user_id": "user-123", "account_id": "acc-456", "expires_at": 1700000000000},
+ *     {"valid": false, "message": "Invalid or expired token"}
+ *   ]
+ * }
+ *
+ * Каждый токен разбирается ровно один раз (IJwtProvider::validateAndExtract).
+ * Больше MAX_TOKENS токенов - 400.
+ */
+class ValidateTokenBatchHandler : public IHttpHandler {
+public:
+    static constexpr size_t MAX_TOKENS = 256;
+
+    explicit ValidateTokenBatchHandler(
+        std::shared_ptr<ports::input::IAuthService> authService
+    ) : authService_(std::move(authService)) {}
+
+    void handle(IRequest& req, IResponse& res) override {
+        try {
+            auto body = nlohmann::json::parse(req.getBody());
+
+            auto tokens = body.find("tokens");
+            if (tokens == body.end() || !tokens->is_array()) {
+                sendError(res, 400, "tokens array is required");
+                return;
+            }
+            if (tokens->size() > MAX_TOKENS) {
+                sendError(res, 400, "at most " + std::to_string(MAX_TOKENS) + " tokens per request");
+                return;
+            }
+            bool access = body.value("type", "session") == "access";
+
+            nlohmann::json results = nlohmann::json::array();
+            for (const auto& item : *tokens) {
+                if (!item.is_string() || item.get_ref<const std::string&>().empty()) {
+                    results.push_back({{"valid", false}, {"message", "token is required"}});
+                    continue;
+                }
+                const auto& token = item.get_ref<const std::string&>();
+                results.push_back(ValidateTokenHandler::toJson(
+                    access ? authService_->validateAccessToken(token)
+                           : authService_->validateSessionToken(token)));
+            }
+
+            nlohmann::json response;
+            response["results"] = std::move(results);
+            res.setResult(200, "application/json", response.dump());
+
+        } catch (const nlohmann::json::exception& e) {
+            sendError(res, 400, "Invalid JSON");
+        }
+    }
+
+private:
+    std::shared_ptr<ports::input::IAuthService> authService_;
+
+    void sendError(IResponse& res, int status, const std::string& message) {
+        nlohmann::json error;
+        error["error"] = message;
+        res.setResult(status, "application/json", error.dump());
+    }
+};
+
+} // namespace auth::adapters::primary
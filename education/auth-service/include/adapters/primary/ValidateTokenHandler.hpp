@@ -19,7 +19,8 @@ namespace auth::adapters::primary {
  * {
  *   "valid": true,
  *   "user_id": "user-123",
- *   "account_id": "acc-456"  // для access token
+ *   "account_id": "acc-456",  // для access token
+ *   "expires_at": 1700000000000  // для access token, мс с эпохи Unix
  * }
  */
 class ValidateTokenHandler : public IHttpHandler {
@@ -47,25 +48,32 @@ public:
                 result = authService_->validateSessionToken(token);
             }
 
-            nlohmann::json response;
-            response["valid"] = result.valid;
-            
-            if (result.valid) {
-                response["user_id"] = result.userId;
-                if (!result.accountId.empty()) {
-                    response["account_id"] = result.accountId;
-                }
-            } else {
-                response["message"] = result.message;
-            }
-
-            res.setResult(200, "application/json", response.dump());
+            res.setResult(200, "application/json", toJson(result).dump());
 
         } catch (const nlohmann::json::exception& e) {
             sendError(res, 400, "Invalid JSON");
         }
     }
 
+    /// Тело ответа; тот же объект - элемент results в /validate/batch
+    static nlohmann::json toJson(const ports::input::ValidateResult& result) {
+        nlohmann::json response;
+        response["valid"] = result.valid;
+
+        if (result.valid) {
+            response["user_id"] = result.userId;
+            if (!result.accountId.empty()) {
+                response["account_id"] = result.accountId;
+            }
+            if (result.expiresAtMs > 0) {
+                response["expires_at"] = result.expiresAtMs;
+            }
+        } else {
+            response["message"] = result.message;
+        }
+        return response;
+    }
+
 private:
     std::shared_ptr<ports::input::IAuthService> authService_;
 
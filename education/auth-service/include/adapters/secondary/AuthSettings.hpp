@@ -2,27 +2,44 @@
 
 #include <string>
 #include <cstdlib>
+#include <stdexcept>
 
 namespace auth::adapters::secondary {
 
 /**
  * @brief Настройки Auth Service из ENV
+ *
+ * - AUTH_SESSION_LIFETIME - срок session token, с (86400)
+ * - JWT_SECRET - ключ HMAC-SHA256 для подписи токенов, обязателен: без него
+ *   сервис не стартует (встроенного ключа нет, иначе токены подписывал бы
+ *   общеизвестный секрет)
  */
 class AuthSettings {
 public:
     AuthSettings() {
         sessionLifetimeSeconds_ = std::stoi(getEnvOrDefault("AUTH_SESSION_LIFETIME", "86400"));
+        jwtSecret_ = getEnvOrThrow("JWT_SECRET");
     }
 
     int getSessionLifetimeSeconds() const { return sessionLifetimeSeconds_; }
+    const std::string& getJwtSecret() const { return jwtSecret_; }
 
 private:
     int sessionLifetimeSeconds_;
+    std::string jwtSecret_;
 
     static std::string getEnvOrDefault(const char* name, const std::string& defaultValue) {
         const char* value = std::getenv(name);
         return value ? value : defaultValue;
     }
+
+    static std::string getEnvOrThrow(const char* name) {
+        const char* value = std::getenv(name);
+        if (!value || *value == '\0') {
+            throw std::runtime_error(std::string("Required env variable not set: ") + name);
+        }
+        return value;
+    }
 };
 
 } // namespace auth::adapters::secondary
@@ -9,6 +9,14 @@ namespace auth::adapters::secondary
 
     /**
      * @brief Настройки подключения к БД из ENV
+     *
+     * Пул соединений (общий для репозиториев):
+     * - AUTH_DB_POOL_SIZE: максимум соединений (default: 8)
+     * - AUTH_DB_POOL_TIMEOUT_MS: ожидание свободного соединения (default: 2000)
+     *
+     * Чистка таблицы sessions:
+     * - AUTH_SESSION_REAP_INTERVAL_SECONDS: период фоновой чистки (default: 300)
+     * - AUTH_SESSION_REAP_BATCH: строк за один DELETE (default: 1000)
      */
     class DbSettings
     {
@@ -20,6 +28,10 @@ namespace auth::adapters::secondary
             name_ = getEnvOrDefault("AUTH_DB_NAME", "auth_db");
             user_ = getEnvOrDefault("AUTH_DB_USER", "auth_user");
             password_ = getEnvOrDefault("AUTH_DB_PASSWORD", "auth_secret_password");
+            poolSize_ = std::stoi(getEnvOrDefault("AUTH_DB_POOL_SIZE", "8"));
+            poolTimeoutMs_ = std::stoi(getEnvOrDefault("AUTH_DB_POOL_TIMEOUT_MS", "2000"));
+            reapIntervalSeconds_ = std::stoi(getEnvOrDefault("AUTH_SESSION_REAP_INTERVAL_SECONDS", "300"));
+            reapBatch_ = std::stoi(getEnvOrDefault("AUTH_SESSION_REAP_BATCH", "1000"));
         }
 
         std::string getHost() const { return host_; }
@@ -27,6 +39,10 @@ namespace auth::adapters::secondary
         std::string getName() const { return name_; }
         std::string getUser() const { return user_; }
         std::string getPassword() const { return password_; }
+        int getPoolSize() const { return poolSize_; }
+        int getPoolTimeoutMs() const { return poolTimeoutMs_; }
+        int getReapIntervalSeconds() const { return reapIntervalSeconds_; }
+        int getReapBatch() const { return reapBatch_; }
 
         std::string getConnectionString() const
         {
@@ -43,6 +59,10 @@ namespace auth::adapters::secondary
         std::string name_;
         std::string user_;
         std::string password_;
+        int poolSize_;
+        int poolTimeoutMs_;
+        int reapIntervalSeconds_;
+        int reapBatch_;
 
         static std::string getEnvOrDefault(const char *name, const std::string &defaultValue)
         {
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "ports/output/IJwtProvider.hpp"
+#include "adapters/secondary/AuthSettings.hpp"
+#include "adapters/secondary/JwtCodec.hpp"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <iostream>
+
+namespace auth::adapters::secondary
+{
+
+    /**
+     * @brief JWT провайдер: HS256-токены, подписанные JWT_SECRET
+     *
+     * validateAndExtract() - один проход JwtCodec::decode (подпись, затем
+     * claims) и проверка срока, без выделения памяти. Состояния нет: отзыв
+     * токенов - TokenRevocationSet в AuthService.
+     */
+    class HmacJwtAdapter : public ports::output::IJwtProvider
+    {
+    public:
+        explicit HmacJwtAdapter(std::shared_ptr<AuthSettings> settings)
+            : codec_(settings->getJwtSecret())
+        {
+            std::cout << "[HmacJwtAdapter] Created" << std::endl;
+        }
+
+        std::string createSessionToken(const std::string &userId, int lifetimeSeconds) override
+        {
+            domain::TokenClaims claims;
+            claims.type = domain::TokenClaims::Type::SESSION;
+            assignId(claims.userId, userId, "userId");
+            stamp(claims, lifetimeSeconds);
+            return codec_.encode(claims);
+        }
+
+        std::string createAccessToken(const std::string &userId,
+                                      const std::string &accountId,
+                                      int lifetimeSeconds) override
+        {
+            domain::TokenClaims claims;
+            claims.type = domain::TokenClaims::Type::ACCESS;
+            assignId(claims.userId, userId, "userId");
+            assignId(claims.accountId, accountId, "accountId");
+            stamp(claims, lifetimeSeconds);
+            return codec_.encode(claims);
+        }
+
+        std::optional<domain::TokenClaims> validateAndExtract(const std::string &token) override
+        {
+            auto claims = codec_.decode(token);
+            if (!claims || claims->expiresAtMs <= nowMs())
+                return std::nullopt;
+            return claims;
+        }
+
+    private:
+        JwtCodec codec_;
+
+        static int64_t nowMs()
+        {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+
+        static void stamp(domain::TokenClaims &claims, int lifetimeSeconds)
+        {
+            claims.issuedAtMs = nowMs();
+            claims.expiresAtMs = claims.issuedAtMs + lifetimeSeconds * 1000LL;
+        }
+
+        template <size_t N>
+        static void assignId(domain::FixedString<N> &field, const std::string &value, const char *name)
+        {
+            if (!field.assign(value))
+                throw std::invalid_argument(std::string(name) + " is longer than " + std::to_string(N));
+        }
+    };
+
+} // namespace auth::adapters::secondary
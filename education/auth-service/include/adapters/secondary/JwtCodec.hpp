@@ -0,0 +1,401 @@
+#pragma once
+
+#include "domain/TokenClaims.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/sha.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace auth::adapters::secondary {
+
+// SHA256_Init/Update/Final устарели в OpenSSL 3, но только они позволяют
+// скопировать готовое состояние хэша без выделения памяти (EVP_MD_CTX - куча)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+
+/**
+ * @brief JWT (JWS compact, HS256): кодирование и проверка без кучи
+ *
+ * Формат: base64url(header).base64url(payload).base64url(HMAC-SHA256).
+ * Payload - плоский объект {"typ","sub","acc","iat","exp"}, iat/exp в мс.
+ *
+ * decode() разбирает токен за один проход: сверяет заголовок, проверяет
+ * подпись и только затем читает payload в TokenClaims. Всё - на стеке:
+ * base64 декодируется в буферы фиксированного размера, HMAC считается от
+ * заранее подготовленных состояний SHA-256 для ipad/opad ключа. Токен
+ * длиннее MAX_TOKEN_SIZE отклоняется. tokenId - первые 8 байт подписи:
+ * подделать его без секрета нельзя.
+ *
+ * Срок действия не проверяет - это дело вызывающего (нужно текущее время).
+ */
+class JwtCodec {
+public:
+    static constexpr size_t MAX_TOKEN_SIZE = 1024;
+
+    explicit JwtCodec(std::string_view secret) {
+        unsigned char key[BLOCK_SIZE] = {};
+        if (secret.size() > BLOCK_SIZE) {
+            SHA256(reinterpret_cast<const unsigned char*>(secret.data()), secret.size(), key);
+        } else {
+            std::memcpy(key, secret.data(), secret.size());
+        }
+
+        unsigned char ipad[BLOCK_SIZE];
+        unsigned char opad[BLOCK_SIZE];
+        for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+            ipad[i] = key[i] ^ 0x36;
+            opad[i] = key[i] ^ 0x5c;
+        }
+        SHA256_Init(&inner_);
+        SHA256_Update(&inner_, ipad, BLOCK_SIZE);
+        SHA256_Init(&outer_);
+        SHA256_Update(&outer_, opad, BLOCK_SIZE);
+        OPENSSL_cleanse(key, sizeof(key));
+        OPENSSL_cleanse(ipad, sizeof(ipad));
+        OPENSSL_cleanse(opad, sizeof(opad));
+    }
+
+    std::string encode(const domain::TokenClaims& claims) const {
+        std::string payload;
+        payload.reserve(160);
+        payload += "{\"typ\":\"";
+        payload += claims.type == domain::TokenClaims::Type::ACCESS ? "access" : "session";
+        payload += "\",\"sub\":";
+        appendJsonString(payload, claims.userId.view());
+        if (claims.type == domain::TokenClaims::Type::ACCESS) {
+            payload += ",\"acc\":";
+            appendJsonString(payload, claims.accountId.view());
+        }
+        payload += ",\"iat\":";
+        payload += std::to_string(claims.issuedAtMs);
+        payload += ",\"exp\":";
+        payload += std::to_string(claims.expiresAtMs);
+        payload += '}';
+
+        std::string token(HEADER);
+        token += '.';
+        appendBase64Url(token, reinterpret_cast<const unsigned char*>(payload.data()), payload.size());
+
+        unsigned char mac[MAC_SIZE];
+        sign(token, mac);
+        token += '.';
+        appendBase64Url(token, mac, MAC_SIZE);
+        return token;
+    }
+
+    /**
+     * @return nullopt - не наш формат, подпись не сошлась или payload не разобран
+     */
+    std::optional<domain::TokenClaims> decode(std::string_view token) const {
+        if (token.size() > MAX_TOKEN_SIZE || token.size() <= HEADER.size() + 1 ||
+            token.compare(0, HEADER.size(), HEADER) != 0 || token[HEADER.size()] != '.') {
+            return std::nullopt;
+        }
+        size_t dot = token.rfind('.');
+        if (dot <= HEADER.size() + 1) {
+            return std::nullopt;
+        }
+        std::string_view signedPart = token.substr(0, dot);
+        std::string_view payloadPart = signedPart.substr(HEADER.size() + 1);
+
+        unsigned char given[MAC_SIZE + 2];
+        if (decodeBase64Url(token.substr(dot + 1), given, sizeof(given)) != MAC_SIZE) {
+            return std::nullopt;
+        }
+        unsigned char expected[MAC_SIZE];
+        sign(signedPart, expected);
+        if (CRYPTO_memcmp(given, expected, MAC_SIZE) != 0) {
+            return std::nullopt;
+        }
+
+        char payload[MAX_TOKEN_SIZE];
+        size_t size = decodeBase64Url(payloadPart, reinterpret_cast<unsigned char*>(payload), sizeof(payload));
+        if (size == NPOS) {
+            return std::nullopt;
+        }
+        auto claims = parsePayload(std::string_view(payload, size));
+        if (claims) {
+            std::memcpy(&claims->tokenId, given, sizeof(claims->tokenId));
+        }
+        return claims;
+    }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 64;
+    static constexpr size_t MAC_SIZE = 32;
+    static constexpr size_t NPOS = static_cast<size_t>(-1);
+
+    /// base64url({"alg":"HS256","typ":"JWT"})
+    static constexpr std::string_view HEADER = "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9";
+
+    SHA256_CTX inner_;
+    SHA256_CTX outer_;
+
+    void sign(std::string_view data, unsigned char* out) const {
+        unsigned char innerHash[MAC_SIZE];
+        SHA256_CTX ctx = inner_;
+        SHA256_Update(&ctx, data.data(), data.size());
+        SHA256_Final(innerHash, &ctx);
+        ctx = outer_;
+        SHA256_Update(&ctx, innerHash, MAC_SIZE);
+        SHA256_Final(out, &ctx);
+    }
+
+    // ------------------------------------------------------------------
+    // base64url без '='
+    // ------------------------------------------------------------------
+
+    static void appendBase64Url(std::string& out, const unsigned char* data, size_t size) {
+        static constexpr char chars[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        size_t i = 0;
+        for (; i + 3 <= size; i += 3) {
+            uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+            out += chars[v >> 18];
+            out += chars[(v >> 12) & 0x3F];
+            out += chars[(v >> 6) & 0x3F];
+            out += chars[v & 0x3F];
+        }
+        if (size - i == 1) {
+            uint32_t v = uint32_t(data[i]) << 16;
+            out += chars[v >> 18];
+            out += chars[(v >> 12) & 0x3F];
+        } else if (size - i == 2) {
+            uint32_t v = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8);
+            out += chars[v >> 18];
+            out += chars[(v >> 12) & 0x3F];
+            out += chars[(v >> 6) & 0x3F];
+        }
+    }
+
+    static int8_t base64Value(unsigned char c) {
+        if (c >= 'A' && c <= 'Z') return static_cast<int8_t>(c - 'A');
+        if (c >= 'a' && c <= 'z') return static_cast<int8_t>(c - 'a' + 26);
+        if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0' + 52);
+        if (c == '-') return 62;
+        if (c == '_') return 63;
+        return -1;
+    }
+
+    /// @return число байт или NPOS (недопустимый символ, не влезло)
+    static size_t decodeBase64Url(std::string_view in, unsigned char* out, size_t capacity) {
+        if (in.size() % 4 == 1 || in.size() / 4 * 3 + 2 > capacity) {
+            return NPOS;
+        }
+        size_t n = 0;
+        uint32_t acc = 0;
+        int bits = 0;
+        for (unsigned char c : in) {
+            int8_t v = base64Value(c);
+            if (v < 0) {
+                return NPOS;
+            }
+            acc = (acc << 6) | static_cast<uint32_t>(v);
+            bits += 6;
+            if (bits >= 8) {
+                bits -= 8;
+                out[n++] = static_cast<unsigned char>(acc >> bits);
+                acc &= (1u << bits) - 1;
+            }
+        }
+        // Лишние биты последнего символа - другое написание того же токена
+        return acc == 0 ? n : NPOS;
+    }
+
+    // ------------------------------------------------------------------
+    // payload
+    // ------------------------------------------------------------------
+
+    static void appendJsonString(std::string& out, std::string_view s) {
+        static constexpr char hex[] = "0123456789abcdef";
+        out += '"';
+        for (char c : s) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out += "\\u00";
+                out += hex[(c >> 4) & 0xF];
+                out += hex[c & 0xF];
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+    /// Разбор своего же payload: плоский объект, строки и целые
+    class PayloadReader {
+    public:
+        explicit PayloadReader(std::string_view s) : s_(s) {}
+
+        bool consume(char c) {
+            skipSpaces();
+            if (pos_ < s_.size() && s_[pos_] == c) {
+                ++pos_;
+                return true;
+            }
+            return false;
+        }
+
+        bool peek(char c) {
+            skipSpaces();
+            return pos_ < s_.size() && s_[pos_] == c;
+        }
+
+        bool atEnd() {
+            skipSpaces();
+            return pos_ == s_.size();
+        }
+
+        template<size_t N>
+        bool readString(domain::FixedString<N>& out) {
+            out.clear();
+            if (!consume('"')) {
+                return false;
+            }
+            while (pos_ < s_.size()) {
+                char c = s_[pos_++];
+                if (c == '"') {
+                    return true;
+                }
+                if (c == '\\') {
+                    if (pos_ >= s_.size()) {
+                        return false;
+                    }
+                    char e = s_[pos_++];
+                    if (e == 'u') {
+                        if (pos_ + 4 > s_.size() || s_[pos_] != '0' || s_[pos_ + 1] != '0') {
+                            return false;   // пишем только \u00XX
+                        }
+                        int hi = hexValue(s_[pos_ + 2]);
+                        int lo = hexValue(s_[pos_ + 3]);
+                        if (hi < 0 || lo < 0) {
+                            return false;
+                        }
+                        c = static_cast<char>(hi * 16 + lo);
+                        pos_ += 4;
+                    } else if (e == '"' || e == '\\' || e == '/') {
+                        c = e;
+                    } else {
+                        return false;
+                    }
+                }
+                if (!out.push_back(c)) {
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        bool readInt(int64_t& out) {
+            skipSpaces();
+            bool negative = pos_ < s_.size() && s_[pos_] == '-';
+            if (negative) {
+                ++pos_;
+            }
+            size_t start = pos_;
+            uint64_t value = 0;
+            while (pos_ < s_.size() && s_[pos_] >= '0' && s_[pos_] <= '9') {
+                if (pos_ - start >= 18) {
+                    return false;
+                }
+                value = value * 10 + static_cast<uint64_t>(s_[pos_++] - '0');
+            }
+            if (pos_ == start) {
+                return false;
+            }
+            out = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+            return true;
+        }
+
+        /// Пропустить значение неизвестного ключа (строка или целое)
+        bool skipValue() {
+            if (peek('"')) {
+                domain::FixedString<MAX_TOKEN_SIZE> ignored;
+                return readString(ignored);
+            }
+            int64_t ignored = 0;
+            return readInt(ignored);
+        }
+
+    private:
+        std::string_view s_;
+        size_t pos_ = 0;
+
+        void skipSpaces() {
+            while (pos_ < s_.size() && (s_[pos_] == ' ' || s_[pos_] == '\n' || s_[pos_] == '\t' || s_[pos_] == '\r')) {
+                ++pos_;
+            }
+        }
+
+        static int hexValue(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+    };
+
+    static std::optional<domain::TokenClaims> parsePayload(std::string_view payload) {
+        PayloadReader reader(payload);
+        if (!reader.consume('{')) {
+            return std::nullopt;
+        }
+
+        domain::TokenClaims claims;
+        bool hasType = false, hasSub = false, hasAcc = false, hasIat = false, hasExp = false;
+        domain::FixedString<16> key;
+        domain::FixedString<16> type;
+
+        if (!reader.consume('}')) {
+            do {
+                if (!reader.readString(key) || !reader.consume(':')) {
+                    return std::nullopt;
+                }
+                bool ok;
+                if (key.view() == "typ") {
+                    ok = hasType = reader.readString(type);
+                } else if (key.view() == "sub") {
+                    ok = hasSub = reader.readString(claims.userId);
+                } else if (key.view() == "acc") {
+                    ok = hasAcc = reader.readString(claims.accountId);
+                } else if (key.view() == "iat") {
+                    ok = hasIat = reader.readInt(claims.issuedAtMs);
+                } else if (key.view() == "exp") {
+                    ok = hasExp = reader.readInt(claims.expiresAtMs);
+                } else {
+                    ok = reader.skipValue();
+                }
+                if (!ok) {
+                    return std::nullopt;
+                }
+            } while (reader.consume(','));
+
+            if (!reader.consume('}')) {
+                return std::nullopt;
+            }
+        }
+        if (!reader.atEnd() || !hasType || !hasSub || !hasIat || !hasExp) {
+            return std::nullopt;
+        }
+
+        if (type.view() == "access" && hasAcc) {
+            claims.type = domain::TokenClaims::Type::ACCESS;
+        } else if (type.view() == "session") {
+            claims.type = domain::TokenClaims::Type::SESSION;
+        } else {
+            return std::nullopt;
+        }
+        return claims;
+    }
+};
+
+#pragma GCC diagnostic pop
+
+} // namespace auth::adapters::secondary
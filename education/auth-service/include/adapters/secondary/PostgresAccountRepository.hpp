@@ -1,60 +1,38 @@
 #pragma once
 
 #include "ports/output/IAccountRepository.hpp"
-#include "DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
 #include <memory>
-#include <mutex>
 #include <iostream>
 
 namespace auth::adapters::secondary {
 
 class PostgresAccountRepository : public ports::output::IAccountRepository {
 public:
-    explicit PostgresAccountRepository(std::shared_ptr<DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresAccountRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
-        std::cout << "[PostgresAccountRepository] Connecting..." << std::endl;
-        try {
-            connection_ = std::make_unique<pqxx::connection>(settings_->getConnectionString());
-            std::cout << "[PostgresAccountRepository] Connected" << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "[PostgresAccountRepository] Connection failed: " << e.what() << std::endl;
-            throw;
-        }
-    }
-
-    ~PostgresAccountRepository() {
-        if (connection_ && connection_->is_open()) {
-            connection_->close();
-        }
+        prepareStatements();
+        std::cout << "[PostgresAccountRepository] Initialized" << std::endl;
     }
 
     domain::Account save(const domain::Account& account) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
-            
-            txn.exec_params(
-                R"(
-                    INSERT INTO accounts (account_id, user_id, name, type, tinkoff_token_encrypted, created_at)
-                    VALUES ($1, $2, $3, $4, $5, NOW())
-                    ON CONFLICT (account_id) DO UPDATE SET
-                        name = EXCLUDED.name,
-                        type = EXCLUDED.type,
-                        tinkoff_token_encrypted = EXCLUDED.tinkoff_token_encrypted
-                )",
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            txn.exec_prepared("account_upsert",
                 account.accountId,
                 account.userId,
                 account.name,
                 domain::toString(account.type),
                 account.tinkoffTokenEncrypted
             );
-            
+
             txn.commit();
             return account;
-            
+
         } catch (const std::exception& e) {
             std::cerr << "[PostgresAccountRepository] save() failed: " << e.what() << std::endl;
             throw;
@@ -62,23 +40,18 @@ public:
     }
 
     std::optional<domain::Account> findById(const std::string& accountId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
-            
-            auto result = txn.exec_params(
-                R"(SELECT account_id, user_id, name, type, tinkoff_token_encrypted 
-                   FROM accounts WHERE account_id = $1)",
-                accountId
-            );
-            
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            auto result = txn.exec_prepared("account_find_by_id", accountId);
+
             txn.commit();
-            
+
             if (result.empty()) return std::nullopt;
-            
+
             return rowToAccount(result[0]);
-            
+
         } catch (const std::exception& e) {
             std::cerr << "[PostgresAccountRepository] findById() failed: " << e.what() << std::endl;
             return std::nullopt;
@@ -86,25 +59,20 @@ public:
     }
 
     std::vector<domain::Account> findByUserId(const std::string& userId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
-            
-            auto result = txn.exec_params(
-                R"(SELECT account_id, user_id, name, type, tinkoff_token_encrypted 
-                   FROM accounts WHERE user_id = $1)",
-                userId
-            );
-            
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            auto result = txn.exec_prepared("account_find_by_user", userId);
+
             txn.commit();
-            
+
             std::vector<domain::Account> accounts;
             for (const auto& row : result) {
                 accounts.push_back(rowToAccount(row));
             }
             return accounts;
-            
+
         } catch (const std::exception& e) {
             std::cerr << "[PostgresAccountRepository] findByUserId() failed: " << e.what() << std::endl;
             return {};
@@ -112,19 +80,15 @@ public:
     }
 
     bool deleteById(const std::string& accountId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
-            
-            auto result = txn.exec_params(
-                "DELETE FROM accounts WHERE account_id = $1",
-                accountId
-            );
-            
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            auto result = txn.exec_prepared("account_delete", accountId);
+
             txn.commit();
             return result.affected_rows() > 0;
-            
+
         } catch (const std::exception& e) {
             std::cerr << "[PostgresAccountRepository] deleteById() failed: " << e.what() << std::endl;
             return false;
@@ -132,9 +96,28 @@ public:
     }
 
 private:
-    std::shared_ptr<DbSettings> settings_;
-    std::unique_ptr<pqxx::connection> connection_;
-    mutable std::mutex mutex_;
+    std::shared_ptr<PgConnectionPool> pool_;
+
+    void prepareStatements() {
+        pool_->prepare("account_upsert", R"(
+            INSERT INTO accounts (account_id, user_id, name, type, tinkoff_token_encrypted, created_at)
+            VALUES ($1, $2, $3, $4, $5, NOW())
+            ON CONFLICT (account_id) DO UPDATE SET
+                name = EXCLUDED.name,
+                type = EXCLUDED.type,
+                tinkoff_token_encrypted = EXCLUDED.tinkoff_token_encrypted
+        )");
+        pool_->prepare("account_find_by_id", R"(
+            SELECT account_id, user_id, name, type, tinkoff_token_encrypted
+            FROM accounts WHERE account_id = $1
+        )");
+        pool_->prepare("account_find_by_user", R"(
+            SELECT account_id, user_id, name, type, tinkoff_token_encrypted
+            FROM accounts WHERE user_id = $1
+        )");
+        pool_->prepare("account_delete",
+            "DELETE FROM accounts WHERE account_id = $1");
+    }
 
     domain::Account rowToAccount(const pqxx::row& row) const {
         return domain::Account(
@@ -1,56 +1,97 @@
 #pragma once
 
 #include "ports/output/ISessionRepository.hpp"
-#include "DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
+#include "adapters/secondary/DbSettings.hpp"
+#include "adapters/secondary/AuthSettings.hpp"
+#include <openssl/sha.h>
 #include <pqxx/pqxx>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
+#include <thread>
 #include <iostream>
 
 namespace auth::adapters::secondary {
 
+/**
+ * @brief PostgreSQL репозиторий сессий
+ *
+ * Работает через общий PgConnectionPool: login, logout и проверки сессий
+ * из разных worker-потоков идут по разным соединениям параллельно.
+ *
+ * Сессия ищется по token_hash (SHA-256 от JWT, индекс idx_sessions_token_hash),
+ * а не по самому токену длиной в сотни байт.
+ *
+ * Таблица секционирована по дню expires_at (sql/01-schema.sql). Фоновый
+ * поток раз в AUTH_SESSION_REAP_INTERVAL_SECONDS:
+ * - создаёт дневные секции на сегодня и на срок жизни сессии вперёд;
+ * - удаляет секции, все строки которых истекли, без построчного DELETE:
+ *   DETACH PARTITION ... CONCURRENTLY, затем DROP уже отсоединённой таблицы.
+ *   Обычный DROP секции берёт ACCESS EXCLUSIVE на всю sessions и, ожидая
+ *   долгие чтения, останавливает за собой login и проверки сессий;
+ * - удаляет остальные истёкшие строки пачками по AUTH_SESSION_REAP_BATCH,
+ *   чтобы не держать долгих блокировок.
+ *
+ * Секции по умолчанию нет: с ней PostgreSQL не выполняет DETACH CONCURRENTLY
+ * (нужен PostgreSQL 14+). Строка вне созданных секций не вставится, поэтому
+ * секции создаются на весь срок жизни сессии вперёд.
+ *
+ * Таблица sessions без секций (база старше этой схемы) при старте
+ * переносится в секционированную вместе с действующими сессиями, а
+ * sessions_default из прежней схемы - в дневные секции. Если перенос не
+ * удался или таблицы нет, конструктор бросает исключение: без секций
+ * фоновая чистка не работала бы, а таблица росла бы снова.
+ */
 class PostgresSessionRepository : public ports::output::ISessionRepository {
 public:
-    explicit PostgresSessionRepository(std::shared_ptr<DbSettings> settings)
-        : settings_(std::move(settings))
+    PostgresSessionRepository(std::shared_ptr<PgConnectionPool> pool,
+                              std::shared_ptr<DbSettings> dbSettings,
+                              std::shared_ptr<AuthSettings> authSettings)
+        : pool_(std::move(pool))
+        , reapInterval_(std::max(1, dbSettings->getReapIntervalSeconds()))
+        , reapBatch_(std::max(1, dbSettings->getReapBatch()))
+          // Отозванная сессия хранится ещё час после срока - отсюда +1 день
+        , partitionDaysAhead_(authSettings->getSessionLifetimeSeconds() / 86400 + 1)
     {
-        std::cout << "[PostgresSessionRepository] Connecting..." << std::endl;
-        try {
-            connection_ = std::make_unique<pqxx::connection>(settings_->getConnectionString());
-            std::cout << "[PostgresSessionRepository] Connected" << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "[PostgresSessionRepository] Connection failed: " << e.what() << std::endl;
-            throw;
-        }
+        // Схема должна быть готова до подготовки запросов, которые на неё ссылаются
+        ensureSchema();
+        prepareStatements();
+        maintainPartitions();
+        std::cout << "[PostgresSessionRepository] Initialized, reap every "
+                  << reapInterval_.count() << "s" << std::endl;
+
+        reaperThread_ = std::thread([this] { reaperLoop(); });
     }
 
-    ~PostgresSessionRepository() {
-        if (connection_ && connection_->is_open()) {
-            connection_->close();
+    ~PostgresSessionRepository() override {
+        {
+            std::lock_guard<std::mutex> lock(reaperMutex_);
+            stopped_ = true;
+        }
+        reaperCv_.notify_all();
+        if (reaperThread_.joinable()) {
+            reaperThread_.join();
         }
     }
 
     domain::Session save(const domain::Session& session) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             auto expSeconds = std::chrono::duration_cast<std::chrono::seconds>(
                 session.expiresAt.time_since_epoch()).count();
             
-            txn.exec_params(
-                R"(
-                    INSERT INTO sessions (session_id, user_id, jwt_token, expires_at, created_at)
-                    VALUES ($1, $2, $3, to_timestamp($4), NOW())
-                    ON CONFLICT (session_id) DO UPDATE SET
-                        jwt_token = EXCLUDED.jwt_token,
-                        expires_at = EXCLUDED.expires_at
-                )",
+            txn.exec_prepared("session_upsert",
                 session.sessionId,
                 session.userId,
                 session.jwtToken,
-                expSeconds
+                expSeconds,
+                tokenHash(session.jwtToken)
             );
             
             txn.commit();
@@ -63,17 +104,11 @@ public:
     }
 
     std::optional<domain::Session> findById(const std::string& sessionId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                R"(SELECT session_id, user_id, jwt_token, 
-                          EXTRACT(EPOCH FROM expires_at)::bigint as exp_epoch
-                   FROM sessions WHERE session_id = $1)",
-                sessionId
-            );
+            auto result = txn.exec_prepared("session_find_by_id", sessionId);
             
             txn.commit();
             
@@ -88,17 +123,11 @@ public:
     }
 
     std::optional<domain::Session> findByToken(const std::string& jwtToken) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                R"(SELECT session_id, user_id, jwt_token,
-                          EXTRACT(EPOCH FROM expires_at)::bigint as exp_epoch
-                   FROM sessions WHERE jwt_token = $1)",
-                jwtToken
-            );
+            auto result = txn.exec_prepared("session_find_by_token", tokenHash(jwtToken));
             
             txn.commit();
             
@@ -113,17 +142,11 @@ public:
     }
 
     std::vector<domain::Session> findByUserId(const std::string& userId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                R"(SELECT session_id, user_id, jwt_token,
-                          EXTRACT(EPOCH FROM expires_at)::bigint as exp_epoch
-                   FROM sessions WHERE user_id = $1)",
-                userId
-            );
+            auto result = txn.exec_prepared("session_find_by_user", userId);
             
             txn.commit();
             
@@ -140,15 +163,11 @@ public:
     }
 
     bool deleteById(const std::string& sessionId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "DELETE FROM sessions WHERE session_id = $1",
-                sessionId
-            );
+            auto result = txn.exec_prepared("session_delete_by_id", sessionId);
             
             txn.commit();
             return result.affected_rows() > 0;
@@ -160,15 +179,11 @@ public:
     }
 
     bool deleteByUserId(const std::string& userId) override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
         try {
-            pqxx::work txn(*connection_);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "DELETE FROM sessions WHERE user_id = $1",
-                userId
-            );
+            auto result = txn.exec_prepared("session_delete_by_user", userId);
             
             txn.commit();
             return result.affected_rows() > 0;
@@ -179,22 +194,404 @@ public:
         }
     }
 
-    void deleteExpired() override {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
+    size_t deleteExpired() override {
+        size_t total = 0;
         try {
-            pqxx::work txn(*connection_);
-            txn.exec("DELETE FROM sessions WHERE expires_at < NOW()");
-            txn.commit();
+            while (true) {
+                // Каждая пачка - отдельная транзакция на отдельной аренде соединения
+                auto conn = pool_->acquire();
+                pqxx::work txn(*conn);
+                auto result = txn.exec_prepared("session_delete_expired", reapBatch_);
+                txn.commit();
+
+                total += static_cast<size_t>(result.affected_rows());
+                if (result.affected_rows() < reapBatch_) {
+                    return total;
+                }
+            }
         } catch (const std::exception& e) {
             std::cerr << "[PostgresSessionRepository] deleteExpired() failed: " << e.what() << std::endl;
         }
+        return total;
+    }
+
+    bool markRevoked(const std::string& sessionId,
+                     std::chrono::system_clock::time_point revokedAt,
+                     std::chrono::system_clock::time_point retainUntil) override {
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            auto result = txn.exec_prepared("session_mark_revoked",
+                sessionId,
+                toEpochSeconds(revokedAt),
+                toEpochSeconds(retainUntil)
+            );
+
+            txn.commit();
+            return result.affected_rows() > 0;
+
+        } catch (const std::exception& e) {
+            std::cerr << "[PostgresSessionRepository] markRevoked() failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    std::vector<domain::Session> findRevoked() override {
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+
+            auto result = txn.exec_prepared("session_find_revoked");
+
+            txn.commit();
+
+            std::vector<domain::Session> sessions;
+            sessions.reserve(result.size());
+            for (const auto& row : result) {
+                auto session = rowToSession(row);
+                session.revokedAt = std::chrono::system_clock::time_point(
+                    std::chrono::milliseconds(row["revoked_ms"].as<int64_t>()));
+                sessions.push_back(std::move(session));
+            }
+            return sessions;
+
+        } catch (const std::exception& e) {
+            // Без списка отзывов сервис принял бы отозванные токены - старт должен упасть
+            std::cerr << "[PostgresSessionRepository] findRevoked() failed: " << e.what() << std::endl;
+            throw;
+        }
     }
 
 private:
-    std::shared_ptr<DbSettings> settings_;
-    std::unique_ptr<pqxx::connection> connection_;
-    mutable std::mutex mutex_;
+    std::shared_ptr<PgConnectionPool> pool_;
+    const std::chrono::seconds reapInterval_;
+    const int reapBatch_;
+    const int partitionDaysAhead_;
+
+    std::mutex reaperMutex_;
+    std::condition_variable reaperCv_;
+    bool stopped_ = false;
+    std::thread reaperThread_;
+
+    static constexpr const char* SELECT_ACTIVE = R"(
+        SELECT session_id, user_id, jwt_token,
+               EXTRACT(EPOCH FROM expires_at)::bigint as exp_epoch
+        FROM sessions WHERE revoked_at IS NULL AND )";
+
+    void prepareStatements() {
+        pool_->prepare("session_upsert", R"(
+            INSERT INTO sessions (session_id, user_id, jwt_token, expires_at, token_hash, created_at)
+            VALUES ($1, $2, $3, to_timestamp($4), decode($5, 'hex'), NOW())
+            ON CONFLICT (session_id, expires_at) DO UPDATE SET
+                jwt_token = EXCLUDED.jwt_token,
+                token_hash = EXCLUDED.token_hash
+        )");
+        pool_->prepare("session_find_by_id", std::string(SELECT_ACTIVE) + "session_id = $1");
+        // expires_at > NOW() отсекает истёкшие дневные секции ещё до поиска по индексу
+        pool_->prepare("session_find_by_token", std::string(SELECT_ACTIVE) +
+            "token_hash = decode($1, 'hex') AND expires_at > NOW()");
+        pool_->prepare("session_find_by_user", std::string(SELECT_ACTIVE) + "user_id = $1");
+        pool_->prepare("session_delete_by_id",
+            "DELETE FROM sessions WHERE session_id = $1");
+        pool_->prepare("session_delete_by_user",
+            "DELETE FROM sessions WHERE user_id = $1");
+        pool_->prepare("session_delete_expired", R"(
+            DELETE FROM sessions WHERE (session_id, expires_at) IN (
+                SELECT session_id, expires_at FROM sessions
+                WHERE expires_at < NOW() LIMIT $1
+            )
+        )");
+        pool_->prepare("session_mark_revoked", R"(
+            UPDATE sessions SET
+                revoked_at = to_timestamp($2),
+                expires_at = GREATEST(expires_at, to_timestamp($3))
+            WHERE session_id = $1 AND revoked_at IS NULL
+        )");
+        pool_->prepare("session_find_revoked", R"(
+            SELECT session_id, user_id, jwt_token,
+                   EXTRACT(EPOCH FROM expires_at)::bigint as exp_epoch,
+                   (EXTRACT(EPOCH FROM revoked_at) * 1000)::bigint as revoked_ms
+            FROM sessions
+            WHERE revoked_at IS NOT NULL AND expires_at > NOW()
+        )");
+    }
+
+    /**
+     * @brief Перевести таблицу sessions без секций на секционированную схему
+     *
+     * Под advisory-блокировкой: реплики, стартующие одновременно, не
+     * переносят таблицу дважды.
+     *
+     * @throws std::exception если перенос не удался или таблицы sessions нет
+     */
+    void ensureSchema() {
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            txn.exec("SELECT pg_advisory_xact_lock(hashtext('auth.sessions.schema'))");
+
+            auto kind = txn.exec("SELECT relkind FROM pg_class WHERE oid = to_regclass('sessions')");
+            std::string relkind = kind.empty() ? "" : kind[0][0].as<std::string>();
+            if (relkind == "r") {
+                migrateToPartitioned(txn);
+                relkind = "p";
+            }
+            if (relkind != "p") {
+                throw std::runtime_error("sessions is not a partitioned table (relkind='" + relkind +
+                                         "'), apply sql/01-schema.sql");
+            }
+            removeDefaultPartition(txn);
+            txn.commit();
+        } catch (const std::exception& e) {
+            std::cerr << "[PostgresSessionRepository] ensureSchema: " << e.what() << std::endl;
+            throw;
+        }
+    }
+
+    void migrateToPartitioned(pqxx::work& txn) {
+        std::cout << "[PostgresSessionRepository] Migrating sessions to partitioned table..." << std::endl;
+
+        // Базы старше revoked_at
+        txn.exec("ALTER TABLE sessions ADD COLUMN IF NOT EXISTS revoked_at TIMESTAMP");
+        txn.exec("ALTER TABLE sessions RENAME TO sessions_legacy");
+        txn.exec("ALTER INDEX IF EXISTS sessions_pkey RENAME TO sessions_legacy_pkey");
+        txn.exec("DROP INDEX IF EXISTS idx_sessions_user_id");
+        txn.exec("DROP INDEX IF EXISTS idx_sessions_expires_at");
+        txn.exec("DROP INDEX IF EXISTS idx_sessions_revoked");
+
+        txn.exec(R"(
+            CREATE TABLE sessions (
+                session_id VARCHAR(64) NOT NULL,
+                user_id VARCHAR(64) REFERENCES users(user_id),
+                jwt_token VARCHAR(512) NOT NULL,
+                token_hash BYTEA NOT NULL,
+                expires_at TIMESTAMP NOT NULL,
+                created_at TIMESTAMP DEFAULT NOW(),
+                revoked_at TIMESTAMP,
+                PRIMARY KEY (session_id, expires_at)
+            ) PARTITION BY RANGE (expires_at)
+        )");
+        // Секции по умолчанию нет: каждой переносимой строке нужна своя дневная
+        for (const auto& day : upcomingDays(txn)) {
+            txn.exec(partitionDdl(txn, day));
+        }
+        for (const auto& day : liveDaysOf(txn, "sessions_legacy")) {
+            txn.exec(partitionDdl(txn, day));
+        }
+
+        auto copied = txn.exec(R"(
+            INSERT INTO sessions (session_id, user_id, jwt_token, token_hash,
+                                  expires_at, created_at, revoked_at)
+            SELECT session_id, user_id, jwt_token, sha256(convert_to(jwt_token, 'UTF8')),
+                   expires_at, created_at, revoked_at
+            FROM sessions_legacy WHERE expires_at > NOW()
+        )");
+        txn.exec("DROP TABLE sessions_legacy");
+
+        txn.exec("CREATE INDEX IF NOT EXISTS idx_sessions_user_id ON sessions(user_id)");
+        txn.exec("CREATE INDEX IF NOT EXISTS idx_sessions_token_hash ON sessions(token_hash)");
+        txn.exec("CREATE INDEX IF NOT EXISTS idx_sessions_expires_at ON sessions(expires_at)");
+        txn.exec(R"(
+            CREATE INDEX IF NOT EXISTS idx_sessions_revoked
+            ON sessions (expires_at) WHERE revoked_at IS NOT NULL
+        )");
+
+        std::cout << "[PostgresSessionRepository] Migrated " << copied.affected_rows()
+                  << " active sessions" << std::endl;
+    }
+
+    /**
+     * @brief Перенести строки sessions_default (прежняя схема) в дневные секции
+     *
+     * Разовая операция при старте, в транзакции ensureSchema: отсоединение
+     * секции по умолчанию коротко блокирует sessions, зато дальше секции
+     * отсоединяются CONCURRENTLY.
+     */
+    void removeDefaultPartition(pqxx::work& txn) {
+        auto attached = txn.exec(R"(
+            SELECT 1 FROM pg_inherits
+            WHERE inhparent = 'sessions'::regclass
+              AND inhrelid = to_regclass('sessions_default')
+        )");
+        if (attached.empty()) {
+            return;
+        }
+
+        txn.exec("ALTER TABLE sessions DETACH PARTITION sessions_default");
+        for (const auto& day : liveDaysOf(txn, "sessions_default")) {
+            txn.exec(partitionDdl(txn, day));
+        }
+        auto moved = txn.exec(R"(
+            INSERT INTO sessions (session_id, user_id, jwt_token, token_hash,
+                                  expires_at, created_at, revoked_at)
+            SELECT session_id, user_id, jwt_token, token_hash,
+                   expires_at, created_at, revoked_at
+            FROM sessions_default WHERE expires_at > NOW()
+        )");
+        txn.exec("DROP TABLE sessions_default");
+
+        std::cout << "[PostgresSessionRepository] Removed sessions_default, moved "
+                  << moved.affected_rows() << " active sessions to daily partitions" << std::endl;
+    }
+
+    /**
+     * @brief Граница дневной секции: имя, начало и конец диапазона
+     */
+    struct PartitionDay {
+        std::string name;   ///< sessions_pYYYYMMDD
+        std::string from;   ///< YYYY-MM-DD включительно
+        std::string to;     ///< YYYY-MM-DD исключительно
+    };
+
+    /// Сегодня и partitionDaysAhead_ дней вперёд (по часам БД, как и expires_at)
+    std::vector<PartitionDay> upcomingDays(pqxx::work& txn) const {
+        auto result = txn.exec_params(R"(
+            SELECT 'sessions_p' || to_char(CURRENT_DATE + g, 'YYYYMMDD'),
+                   to_char(CURRENT_DATE + g, 'YYYY-MM-DD'),
+                   to_char(CURRENT_DATE + g + 1, 'YYYY-MM-DD')
+            FROM generate_series(0, $1::int) g
+        )", partitionDaysAhead_);
+        return toDays(result);
+    }
+
+    /// Дни, на которые приходятся действующие строки table
+    static std::vector<PartitionDay> liveDaysOf(pqxx::work& txn, const std::string& table) {
+        auto result = txn.exec(
+            "SELECT DISTINCT 'sessions_p' || to_char(d, 'YYYYMMDD'),"
+            "       to_char(d, 'YYYY-MM-DD'), to_char(d + 1, 'YYYY-MM-DD') "
+            "FROM (SELECT expires_at::date AS d FROM " + txn.quote_name(table) +
+            "      WHERE expires_at > NOW()) live");
+        return toDays(result);
+    }
+
+    static std::vector<PartitionDay> toDays(const pqxx::result& result) {
+        std::vector<PartitionDay> days;
+        days.reserve(result.size());
+        for (const auto& row : result) {
+            days.push_back({row[0].as<std::string>(), row[1].as<std::string>(), row[2].as<std::string>()});
+        }
+        return days;
+    }
+
+    static std::string partitionDdl(pqxx::work& txn, const PartitionDay& day) {
+        return "CREATE TABLE IF NOT EXISTS " + txn.quote_name(day.name) +
+               " PARTITION OF sessions FOR VALUES FROM (" + txn.quote(day.from) +
+               ") TO (" + txn.quote(day.to) + ")";
+    }
+
+    /**
+     * @brief Истёкшая дневная секция и её состояние относительно sessions
+     */
+    struct ExpiredPartition {
+        std::string name;
+        bool attached;      ///< ещё секция sessions
+        bool detachPending; ///< DETACH CONCURRENTLY прервался посередине
+    };
+
+    /**
+     * @brief Создать недостающие дневные секции и удалить целиком истёкшие
+     * @return сколько секций удалено
+     */
+    size_t maintainPartitions() {
+        std::vector<PartitionDay> days;
+        std::vector<ExpiredPartition> expired;
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            days = upcomingDays(txn);
+            // Секция дня D хранит expires_at из [D, D+1): при D < сегодня истекло всё.
+            // Отсоединённые, но не удалённые (сбой между DETACH и DROP) - тоже.
+            // Прерванные отсоединения - первыми: пока такое есть, новый
+            // DETACH CONCURRENTLY для sessions не запустится.
+            auto result = txn.exec(R"(
+                SELECT c.relname, i.inhrelid IS NOT NULL, COALESCE(i.inhdetachpending, false)
+                FROM pg_class c
+                LEFT JOIN pg_inherits i ON i.inhrelid = c.oid AND i.inhparent = 'sessions'::regclass
+                WHERE c.relkind = 'r' AND pg_table_is_visible(c.oid)
+                  AND (i.inhrelid IS NOT NULL OR NOT c.relispartition)
+                  AND c.relname ~ '^sessions_p[0-9]{8}$'
+                  AND to_date(substr(c.relname, 11), 'YYYYMMDD') < CURRENT_DATE
+                ORDER BY 3 DESC
+            )");
+            txn.commit();
+            for (const auto& row : result) {
+                expired.push_back({row[0].as<std::string>(), row[1].as<bool>(), row[2].as<bool>()});
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[PostgresSessionRepository] maintainPartitions() failed: " << e.what() << std::endl;
+            return 0;
+        }
+
+        // По транзакции на секцию: ошибка одной не мешает остальным
+        for (const auto& day : days) {
+            try {
+                auto conn = pool_->acquire();
+                pqxx::work txn(*conn);
+                txn.exec(partitionDdl(txn, day));
+                txn.commit();
+            } catch (const std::exception& e) {
+                // Следующий проход повторит: секция создаётся с IF NOT EXISTS
+                std::cerr << "[PostgresSessionRepository] Create " << day.name << ": " << e.what() << std::endl;
+            }
+        }
+
+        // DETACH CONCURRENTLY держит на sessions только SHARE UPDATE EXCLUSIVE:
+        // login и проверки сессий идут, пока он ждёт завершения чтений секции.
+        // В блоке транзакции он запрещён - отсюда nontransaction (autocommit).
+        size_t dropped = 0;
+        for (const auto& part : expired) {
+            try {
+                auto conn = pool_->acquire();
+                pqxx::nontransaction ntx(*conn);
+                std::string name = ntx.quote_name(part.name);
+                if (part.detachPending) {
+                    ntx.exec("ALTER TABLE sessions DETACH PARTITION " + name + " FINALIZE");
+                } else if (part.attached) {
+                    ntx.exec("ALTER TABLE sessions DETACH PARTITION " + name + " CONCURRENTLY");
+                }
+                // Таблица уже вне sessions: её блокировка никого не задерживает
+                ntx.exec("DROP TABLE IF EXISTS " + name);
+                ++dropped;
+            } catch (const std::exception& e) {
+                std::cerr << "[PostgresSessionRepository] Drop " << part.name << ": " << e.what() << std::endl;
+            }
+        }
+        return dropped;
+    }
+
+    void reaperLoop() {
+        std::unique_lock<std::mutex> lock(reaperMutex_);
+        while (!reaperCv_.wait_for(lock, reapInterval_, [this] { return stopped_; })) {
+            lock.unlock();
+            size_t dropped = maintainPartitions();
+            size_t removed = deleteExpired();
+            if (dropped > 0 || removed > 0) {
+                std::cout << "[PostgresSessionRepository] Reaped " << removed
+                          << " expired sessions, dropped " << dropped << " partitions" << std::endl;
+            }
+            lock.lock();
+        }
+    }
+
+    /// SHA-256 от токена в hex - параметр для decode($n, 'hex')
+    static std::string tokenHash(const std::string& token) {
+        static const char* HEX = "0123456789abcdef";
+        unsigned char digest[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(token.data()), token.size(), digest);
+
+        std::string hex(SHA256_DIGEST_LENGTH * 2, '0');
+        for (size_t i = 0; i < SHA256_DIGEST_LENGTH; ++i) {
+            hex[2 * i] = HEX[digest[i] >> 4];
+            hex[2 * i + 1] = HEX[digest[i] & 0x0F];
+        }
+        return hex;
+    }
+
+    static double toEpochSeconds(std::chrono::system_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            tp.time_since_epoch()).count() / 1000.0;
+    }
 
     domain::Session rowToSession(const pqxx::row& row) const {
         domain::Session session;
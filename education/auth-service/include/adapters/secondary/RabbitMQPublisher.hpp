@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ports/output/IEventPublisher.hpp"
+#include "adapters/secondary/RabbitMQSettings.hpp"
+#include <amqpcpp.h>
+#include <amqpcpp/libboostasio.h>
+#include <boost/asio.hpp>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <atomic>
+#include <iostream>
+
+namespace auth::adapters::secondary {
+
+/**
+ * @brief Публикация событий auth-service в RabbitMQ (только publish, без очереди)
+ *
+ * Канал AMQP-CPP не потокобезопасен, поэтому publish() лишь ставит
+ * сообщение в io_context, а пишет в канал поток адаптера. До объявления
+ * exchange сообщения копятся (не больше MAX_PENDING) и уходят сразу
+ * после подключения - logout, пришедший во время старта, не теряется.
+ *
+ * ВАЖНО: start() НЕ вызывается в конструкторе.
+ */
+class RabbitMQPublisher : public ports::output::IEventPublisher {
+public:
+    static constexpr size_t MAX_PENDING = 1024;
+
+    explicit RabbitMQPublisher(std::shared_ptr<RabbitMQSettings> settings)
+        : settings_(std::move(settings))
+        , handler_(ioContext_)
+    {
+        exchangeName_ = settings_->getExchange();
+        std::cout << "[RabbitMQPublisher] Created for "
+                  << settings_->getHost() << ":" << settings_->getPort()
+                  << " exchange=" << exchangeName_ << std::endl;
+    }
+
+    ~RabbitMQPublisher() override {
+        stop();
+    }
+
+    void publish(const std::string& routingKey, const std::string& message) override {
+        boost::asio::post(ioContext_, [this, routingKey, message]() {
+            if (ready_) {
+                channel_->publish(exchangeName_, routingKey, message);
+                return;
+            }
+            if (pending_.size() >= MAX_PENDING) {
+                std::cerr << "[RabbitMQPublisher] Not connected, dropped " << routingKey << std::endl;
+                return;
+            }
+            pending_.emplace_back(routingKey, message);
+        });
+    }
+
+    void start() {
+        if (running_.exchange(true)) return;
+
+        workerThread_ = std::thread([this]() {
+            try {
+                connect();
+                ioContext_.run();
+            } catch (const std::exception& e) {
+                std::cerr << "[RabbitMQPublisher] Worker error: " << e.what() << std::endl;
+            }
+        });
+
+        std::cout << "[RabbitMQPublisher] Started" << std::endl;
+    }
+
+    void stop() {
+        if (!running_.exchange(false)) return;
+
+        workGuard_.reset();
+        ioContext_.stop();
+        if (workerThread_.joinable()) {
+            workerThread_.join();
+        }
+
+        channel_.reset();
+        connection_.reset();
+
+        std::cout << "[RabbitMQPublisher] Stopped" << std::endl;
+    }
+
+private:
+    void connect() {
+        std::string connStr = "amqp://" + settings_->getUser() + ":" +
+                              settings_->getPassword() + "@" +
+                              settings_->getHost() + ":" +
+                              std::to_string(settings_->getPort()) + "/";
+
+        connection_ = std::make_unique<AMQP::TcpConnection>(&handler_, AMQP::Address(connStr));
+        channel_ = std::make_unique<AMQP::TcpChannel>(connection_.get());
+
+        channel_->declareExchange(exchangeName_, AMQP::topic, AMQP::durable)
+            .onSuccess([this]() {
+                std::cout << "[RabbitMQPublisher] Exchange declared: " << exchangeName_
+                          << ", flushing " << pending_.size() << " pending" << std::endl;
+                ready_ = true;
+                for (const auto& [routingKey, message] : pending_) {
+                    channel_->publish(exchangeName_, routingKey, message);
+                }
+                pending_.clear();
+            })
+            .onError([this](const char* msg) {
+                ready_ = false;
+                std::cerr << "[RabbitMQPublisher] Exchange error: " << msg << std::endl;
+            });
+    }
+
+    std::shared_ptr<RabbitMQSettings> settings_;
+    std::string exchangeName_;
+
+    std::atomic<bool> running_{false};
+    boost::asio::io_context ioContext_;
+    std::optional<boost::asio::executor_work_guard<boost::asio::io_context::executor_type>> workGuard_{
+        boost::asio::make_work_guard(ioContext_)};
+    AMQP::LibBoostAsioHandler handler_;
+
+    std::unique_ptr<AMQP::TcpConnection> connection_;
+    std::unique_ptr<AMQP::TcpChannel> channel_;
+
+    // Только поток адаптера
+    bool ready_ = false;
+    std::deque<std::pair<std::string, std::string>> pending_;
+
+    std::thread workerThread_;
+};
+
+} // namespace auth::adapters::secondary
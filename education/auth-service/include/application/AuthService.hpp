@@ -4,7 +4,12 @@
 #include "ports/output/IUserRepository.hpp"
 #include "ports/output/ISessionRepository.hpp"
 #include "ports/output/IJwtProvider.hpp"
+#include "ports/output/IEventPublisher.hpp"
 #include "adapters/secondary/AuthSettings.hpp"
+#include "application/TokenRevocationSet.hpp"
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <iostream>
 
@@ -12,19 +17,33 @@ namespace auth::application {
 
 /**
  * @brief Сервис аутентификации
+ *
+ * Logout отзывает session token и access-токены пользователя, выпущенные
+ * до него, и публикует auth.session.revoked {"user_id", "revoked_at"} -
+ * trading-service по нему сбрасывает закэшированные результаты валидации.
+ *
+ * Отзывы проверяются по TokenRevocationSet в памяти (без блокировок и без
+ * обращения к БД на каждую валидацию). Источник истины - отозванные строки
+ * sessions: они хранятся до истечения отзыва, и конструктор восстанавливает
+ * по ним множество после рестарта.
  */
 class AuthService : public ports::input::IAuthService {
 public:
+    static constexpr int ACCESS_TOKEN_LIFETIME_SECONDS = 3600;
+
     AuthService(
         std::shared_ptr<adapters::secondary::AuthSettings> settings,
         std::shared_ptr<ports::output::IUserRepository> userRepo,
         std::shared_ptr<ports::output::ISessionRepository> sessionRepo,
-        std::shared_ptr<ports::output::IJwtProvider> jwtProvider
+        std::shared_ptr<ports::output::IJwtProvider> jwtProvider,
+        std::shared_ptr<ports::output::IEventPublisher> eventPublisher
     ) : settings_(std::move(settings))
       , userRepo_(std::move(userRepo))
       , sessionRepo_(std::move(sessionRepo))
       , jwtProvider_(std::move(jwtProvider))
+      , eventPublisher_(std::move(eventPublisher))
     {
+        restoreRevocations();
         std::cout << "[AuthService] Created" << std::endl;
     }
 
@@ -90,37 +109,56 @@ public:
             return false;
         }
 
-        jwtProvider_->invalidateToken(sessionToken);
-        sessionRepo_->deleteById(sessionOpt->sessionId);
+        int64_t revokedAt = nowMs();
+        revocations_.revoke({revocationOf(*sessionOpt, revokedAt)}, revokedAt);
+        if (!sessionRepo_->markRevoked(sessionOpt->sessionId, toTimePoint(revokedAt),
+                                       toTimePoint(revokedAt + ACCESS_TOKEN_LIFETIME_SECONDS * 1000LL))) {
+            std::cerr << "[AuthService] Revocation of " << sessionOpt->sessionId
+                      << " not persisted, it will not survive a restart" << std::endl;
+        }
+
+        nlohmann::json event;
+        event["user_id"] = sessionOpt->userId;
+        event["revoked_at"] = revokedAt;
+        eventPublisher_->publish("auth.session.revoked", event.dump());
         return true;
     }
 
     ports::input::ValidateResult validateSessionToken(const std::string& token) override {
-        if (!jwtProvider_->isValidToken(token)) {
+        auto claims = jwtProvider_->validateAndExtract(token);
+        if (!claims) {
             return {false, "", "", "Invalid or expired token"};
         }
-
-        auto userId = jwtProvider_->getUserId(token);
-        if (!userId) {
+        // Access token подписан тем же ключом: без проверки typ он прошёл бы
+        // как сессия и позволил бы выпускать новые access token
+        if (claims->type != domain::TokenClaims::Type::SESSION) {
+            return {false, "", "", "Invalid session token format"};
+        }
+        if (claims->userId.empty()) {
             return {false, "", "", "Cannot extract user from token"};
         }
+        if (revocations_.isTokenRevoked(claims->tokenId)) {
+            return {false, "", "", "Token revoked"};
+        }
 
-        return {true, *userId, "", "Valid"};
+        return {true, claims->userId.str(), "", "Valid"};
     }
 
     ports::input::ValidateResult validateAccessToken(const std::string& token) override {
-        if (!jwtProvider_->isValidToken(token)) {
+        auto claims = jwtProvider_->validateAndExtract(token);
+        if (!claims) {
             return {false, "", "", "Invalid or expired token"};
         }
-
-        auto userId = jwtProvider_->getUserId(token);
-        auto accountId = jwtProvider_->getAccountId(token);
-        
-        if (!userId || !accountId) {
+        if (claims->type != domain::TokenClaims::Type::ACCESS || claims->userId.empty()) {
             return {false, "", "", "Invalid access token format"};
         }
 
-        return {true, *userId, *accountId, "Valid"};
+        std::string userId = claims->userId.str();
+        if (revocations_.isUserRevoked(userId, claims->issuedAtMs)) {
+            return {false, "", "", "Token revoked"};
+        }
+
+        return {true, std::move(userId), claims->accountId.str(), "Valid", claims->expiresAtMs};
     }
 
     std::optional<std::string> createAccessToken(
@@ -135,7 +173,7 @@ public:
         return jwtProvider_->createAccessToken(
             result.userId,
             accountId,
-            3600  // 1 час
+            ACCESS_TOKEN_LIFETIME_SECONDS
         );
     }
 
@@ -144,12 +182,53 @@ private:
     std::shared_ptr<ports::output::IUserRepository> userRepo_;
     std::shared_ptr<ports::output::ISessionRepository> sessionRepo_;
     std::shared_ptr<ports::output::IJwtProvider> jwtProvider_;
+    std::shared_ptr<ports::output::IEventPublisher> eventPublisher_;
+
+    TokenRevocationSet revocations_;
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    static std::chrono::system_clock::time_point toTimePoint(int64_t ms) {
+        return std::chrono::system_clock::time_point(std::chrono::milliseconds(ms));
+    }
+
+    TokenRevocationSet::Revocation revocationOf(const domain::Session& session, int64_t revokedAt) {
+        TokenRevocationSet::Revocation revocation;
+        // Истёкший или чужой (другой JWT_SECRET) токен отзывать не нужно
+        if (auto claims = jwtProvider_->validateAndExtract(session.jwtToken)) {
+            revocation.tokenId = claims->tokenId;
+            revocation.tokenExpiresAtMs = claims->expiresAtMs;
+        }
+        revocation.userId = session.userId;
+        revocation.revokedAtMs = revokedAt;
+        revocation.userExpiresAtMs = revokedAt + ACCESS_TOKEN_LIFETIME_SECONDS * 1000LL;
+        return revocation;
+    }
+
+    void restoreRevocations() {
+        std::vector<TokenRevocationSet::Revocation> revocations;
+        for (const auto& session : sessionRepo_->findRevoked()) {
+            if (session.revokedAt) {
+                auto revokedAt = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    session.revokedAt->time_since_epoch()).count();
+                revocations.push_back(revocationOf(session, revokedAt));
+            }
+        }
+        revocations_.revoke(revocations, nowMs());
+        std::cout << "[AuthService] Restored " << revocations_.size()
+                  << " revocations from " << revocations.size() << " sessions" << std::endl;
+    }
 
     std::string generateUuid() {
-        // Простая генерация UUID для учебного проекта
-        static int counter = 0;
+        // Простая генерация UUID для учебного проекта.
+        // Счётчик атомарный: параллельные login из разных потоков не должны
+        // получить одинаковый sessionId (upsert затёр бы чужую сессию)
+        static std::atomic<uint64_t> counter{0};
         return std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) 
-               + "-" + std::to_string(++counter);
+               + "-" + std::to_string(counter.fetch_add(1, std::memory_order_relaxed) + 1);
     }
 
     std::string hashPassword(const std::string& password) {
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace auth::application {
+
+/**
+ * @brief Множество отозванных токенов: чтение без блокировок, вытеснение по сроку
+ *
+ * Два вида записей:
+ * - токен по tokenId (первые 8 байт подписи) - logout отзывает session token;
+ * - пользователь: access-токены, выпущенные не позже revokedAt, отозваны.
+ *
+ * Читатели берут неизменяемый Snapshot через std::atomic_load и никогда не
+ * ждут писателя. Писатель (logout - редкая операция) под мьютексом копирует
+ * снимок, меняет копию и публикует её atomic_store; старый снимок живёт, пока
+ * его держит хоть один читатель. Пока отзывов нет, чтение - одна атомарная
+ * загрузка счётчика.
+ *
+ * Каждая запись лежит в корзине своего срока (expiresAtMs / BUCKET_MS,
+ * округление вверх). Отзыв истёкшего токена ничего не меняет - validate его
+ * и так отклонит, - поэтому при каждой записи целые корзины с истёкшим
+ * сроком выбрасываются из снимка: размер множества ограничен числом
+ * действующих отзывов, а не историей logout.
+ */
+class TokenRevocationSet {
+public:
+    static constexpr int64_t BUCKET_MS = 60 * 1000;
+
+    /**
+     * @brief Отзыв одной сессии: её session token и access-токены пользователя
+     */
+    struct Revocation {
+        uint64_t tokenId = 0;
+        int64_t tokenExpiresAtMs = 0;   ///< 0 - токен не разобран или уже истёк
+        std::string userId;
+        int64_t revokedAtMs = 0;        ///< access-токены с iat <= revokedAtMs отозваны
+        int64_t userExpiresAtMs = 0;    ///< revokedAtMs + время жизни access-токена
+    };
+
+    /**
+     * @brief Применить отзывы одним новым снимком
+     *
+     * Заодно выбрасывает корзины, срок которых наступил к nowMs.
+     */
+    void revoke(const std::vector<Revocation>& revocations, int64_t nowMs) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        auto next = std::make_shared<Snapshot>(*current());
+        dropExpired(*next, nowMs);
+
+        for (const auto& r : revocations) {
+            if (r.tokenExpiresAtMs > nowMs && next->tokens.insert(r.tokenId).second) {
+                buckets_[bucketOf(r.tokenExpiresAtMs)].tokens.push_back(r.tokenId);
+            }
+            if (!r.userId.empty() && r.userExpiresAtMs > nowMs) {
+                auto [it, inserted] = next->usersRevokedBefore.emplace(r.userId, r.revokedAtMs);
+                if (inserted || r.revokedAtMs > it->second) {
+                    it->second = r.revokedAtMs;
+                    buckets_[bucketOf(r.userExpiresAtMs)].users.emplace_back(r.userId, r.revokedAtMs);
+                }
+            }
+        }
+        publish(std::move(next));
+    }
+
+    bool isTokenRevoked(uint64_t tokenId) const {
+        if (size_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        return current()->tokens.count(tokenId) > 0;
+    }
+
+    bool isUserRevoked(const std::string& userId, int64_t issuedAtMs) const {
+        if (size_.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        auto snapshot = current();
+        auto it = snapshot->usersRevokedBefore.find(userId);
+        return it != snapshot->usersRevokedBefore.end() && issuedAtMs <= it->second;
+    }
+
+    /// Записей в текущем снимке (токены + пользователи)
+    size_t size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+private:
+    struct Snapshot {
+        std::unordered_set<uint64_t> tokens;
+        std::unordered_map<std::string, int64_t> usersRevokedBefore;
+    };
+
+    struct Bucket {
+        std::vector<uint64_t> tokens;
+        std::vector<std::pair<std::string, int64_t>> users;
+    };
+
+    std::shared_ptr<const Snapshot> snapshot_ = std::make_shared<Snapshot>();
+    std::atomic<size_t> size_{0};
+
+    // Только для писателей
+    std::mutex writeMutex_;
+    std::map<int64_t, Bucket> buckets_;   ///< номер корзины -> записи
+
+    static int64_t bucketOf(int64_t expiresAtMs) {
+        return (expiresAtMs + BUCKET_MS - 1) / BUCKET_MS;
+    }
+
+    std::shared_ptr<const Snapshot> current() const {
+        return std::atomic_load_explicit(&snapshot_, std::memory_order_acquire);
+    }
+
+    void publish(std::shared_ptr<Snapshot> next) {
+        size_t size = next->tokens.size() + next->usersRevokedBefore.size();
+        std::atomic_store_explicit(&snapshot_, std::shared_ptr<const Snapshot>(std::move(next)),
+                                   std::memory_order_release);
+        size_.store(size, std::memory_order_release);
+    }
+
+    void dropExpired(Snapshot& snapshot, int64_t nowMs) {
+        auto end = buckets_.upper_bound(nowMs / BUCKET_MS);
+        for (auto it = buckets_.begin(); it != end; ++it) {
+            for (uint64_t tokenId : it->second.tokens) {
+                snapshot.tokens.erase(tokenId);
+            }
+            for (const auto& [userId, revokedAtMs] : it->second.users) {
+                // Более поздний logout того же пользователя лежит в другой корзине
+                auto user = snapshot.usersRevokedBefore.find(userId);
+                if (user != snapshot.usersRevokedBefore.end() && user->second == revokedAtMs) {
+                    snapshot.usersRevokedBefore.erase(user);
+                }
+            }
+        }
+        buckets_.erase(buckets_.begin(), end);
+    }
+};
+
+} // namespace auth::application
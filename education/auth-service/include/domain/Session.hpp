@@ -2,6 +2,7 @@
 
 #include <string>
 #include <chrono>
+#include <optional>
 
 namespace auth::domain {
 
@@ -9,14 +10,16 @@ namespace auth::domain {
  * @brief Сессия пользователя
  * 
  * Хранит JWT токен и время его истечения.
- * Позволяет инвалидировать сессию при logout.
+ * Позволяет инвалидировать сессию при logout: отозванная сессия
+ * (revokedAt) хранится как запись отзыва до expiresAt.
  */
 struct Session {
     std::string sessionId;      ///< UUID сессии (формат: "sess-xxxxxxxx")
     std::string userId;         ///< Владелец сессии
     std::string jwtToken;       ///< JWT токен
-    std::chrono::system_clock::time_point expiresAt;   ///< Время истечения
     std::chrono::system_clock::time_point createdAt;   ///< Время создания
+    std::chrono::system_clock::time_point expiresAt;   ///< Время истечения (считается от createdAt)
+    std::optional<std::chrono::system_clock::time_point> revokedAt;   ///< Момент logout
 
     Session() = default;
 
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace auth::domain {
+
+/**
+ * @brief Строка фиксированной ёмкости без выделения памяти
+ *
+ * Для идентификаторов в токене: user_id и account_id в БД - VARCHAR(64).
+ */
+template<size_t N>
+class FixedString {
+public:
+    static constexpr size_t CAPACITY = N;
+
+    /// @return false, если не помещается - строка не меняется
+    bool assign(std::string_view s) {
+        if (s.size() > N) {
+            return false;
+        }
+        std::memcpy(data_, s.data(), s.size());
+        size_ = s.size();
+        return true;
+    }
+
+    bool push_back(char c) {
+        if (size_ == N) {
+            return false;
+        }
+        data_[size_++] = c;
+        return true;
+    }
+
+    void clear() { size_ = 0; }
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    std::string_view view() const { return {data_, size_}; }
+    std::string str() const { return std::string(data_, size_); }
+
+private:
+    char data_[N];
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Содержимое проверенного токена
+ */
+struct TokenClaims {
+    enum class Type : uint8_t { SESSION, ACCESS };
+
+    Type type = Type::SESSION;
+    FixedString<64> userId;
+    FixedString<64> accountId;   ///< пусто у session token
+    int64_t issuedAtMs = 0;      ///< мс с эпохи Unix
+    int64_t expiresAtMs = 0;
+    uint64_t tokenId = 0;        ///< первые 8 байт HMAC-подписи - ключ отзыва
+};
+
+} // namespace auth::domain
@@ -3,6 +3,7 @@
 #include "domain/User.hpp"
 #include <string>
 #include <optional>
+#include <cstdint>
 
 namespace auth::ports::input {
 
@@ -33,6 +34,7 @@ struct ValidateResult {
     std::string userId;
     std::string accountId;  // Для access token
     std::string message;
+    int64_t expiresAtMs = 0;  // Для access token, мс с эпохи Unix
 };
 
 /**
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace auth::ports::output {
+
+/**
+ * @brief Интерфейс для публикации событий
+ *
+ * Реализуется RabbitMQPublisher (exchange trading.events).
+ */
+class IEventPublisher {
+public:
+    virtual ~IEventPublisher() = default;
+
+    /**
+     * @brief Опубликовать событие
+     * @param routingKey Ключ маршрутизации (например, "auth.session.revoked")
+     * @param message JSON-сообщение
+     */
+    virtual void publish(const std::string& routingKey, const std::string& message) = 0;
+};
+
+} // namespace auth::ports::output
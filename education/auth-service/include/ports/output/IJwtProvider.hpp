@@ -1,7 +1,9 @@
 #pragma once
 
+#include "domain/TokenClaims.hpp"
 #include <string>
 #include <optional>
+#include <cstdint>
 
 namespace auth::ports::output {
 
@@ -37,24 +39,11 @@ public:
     ) = 0;
 
     /**
-     * @brief Проверить валидность токена
+     * @brief Проверить токен и извлечь его содержимое за один разбор
+     * @return nullopt - подпись не сошлась или срок истёк. Отзыв проверяет
+     *         AuthService (TokenRevocationSet) по claims.tokenId
      */
-    virtual bool isValidToken(const std::string& token) = 0;
-
-    /**
-     * @brief Извлечь userId из токена
-     */
-    virtual std::optional<std::string> getUserId(const std::string& token) = 0;
-
-    /**
-     * @brief Извлечь accountId из токена (только для access token)
-     */
-    virtual std::optional<std::string> getAccountId(const std::string& token) = 0;
-
-    /**
-     * @brief Инвалидировать токен
-     */
-    virtual void invalidateToken(const std::string& token) = 0;
+    virtual std::optional<domain::TokenClaims> validateAndExtract(const std::string& token) = 0;
 };
 
 } // namespace auth::ports::output
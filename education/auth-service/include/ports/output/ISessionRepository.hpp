@@ -1,13 +1,19 @@
 #pragma once
 
 #include "domain/Session.hpp"
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <optional>
+#include <vector>
 
 namespace auth::ports::output {
 
 /**
  * @brief Интерфейс репозитория сессий
+ *
+ * findById / findByToken / findByUserId возвращают только действующие
+ * (не отозванные) сессии; findByToken вдобавок не находит истёкшие.
  */
 class ISessionRepository {
 public:
@@ -19,7 +25,29 @@ public:
     virtual std::vector<domain::Session> findByUserId(const std::string& userId) = 0;
     virtual bool deleteById(const std::string& sessionId) = 0;
     virtual bool deleteByUserId(const std::string& userId) = 0;
-    virtual void deleteExpired() = 0;
+
+    /**
+     * @brief Удалить истёкшие сессии
+     * @return сколько строк удалено
+     */
+    virtual size_t deleteExpired() = 0;
+
+    /**
+     * @brief Отозвать сессию (logout)
+     *
+     * Строка остаётся до retainUntil (но не раньше своего expires_at) -
+     * по ней после рестарта восстанавливается TokenRevocationSet.
+     * @return false - сессии нет или она уже отозвана
+     */
+    virtual bool markRevoked(const std::string& sessionId,
+                             std::chrono::system_clock::time_point revokedAt,
+                             std::chrono::system_clock::time_point retainUntil) = 0;
+
+    /**
+     * @brief Отозванные сессии, срок хранения которых ещё не истёк
+     * @throws std::exception при ошибке БД (вызывается на старте - сервис не поднимется)
+     */
+    virtual std::vector<domain::Session> findRevoked() = 0;
 };
 
 } // namespace auth::ports::output
@@ -0,0 +1,95 @@
+#!/bin/bash
+# auth-service/scripts/check-partition-detach.sh
+#
+# Ручная проверка чистки секций sessions против postgres:15 (Docker):
+# пока открыта долгая транзакция с чтением sessions, auth-service удаляет
+# истёкшую секцию, а новые запросы к sessions не ждут её блокировок.
+# Прежний DROP секции вставал в очередь за чтением с ACCESS EXCLUSIVE на
+# sessions - проба с lock_timeout падала.
+#
+# Нужны docker и собранный auth-service (AUTH_SERVICE_BIN).
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+SQL_DIR="$SCRIPT_DIR/../sql"
+
+AUTH_SERVICE_BIN="${AUTH_SERVICE_BIN:-$SCRIPT_DIR/../build/auth-service}"
+CONTAINER="${CONTAINER:-auth-pg-detach-check}"
+PG_PORT="${PG_PORT:-55432}"
+READER_SECONDS="${READER_SECONDS:-15}"
+
+SERVICE_LOG=$(mktemp)
+SERVICE_PID=""
+
+psql_db() {
+    docker exec -i "$CONTAINER" psql -v ON_ERROR_STOP=1 -qtA -U auth_user -d auth_db "$@"
+}
+
+cleanup() {
+    [ -n "$SERVICE_PID" ] && kill "$SERVICE_PID" 2>/dev/null
+    docker rm -f "$CONTAINER" >/dev/null 2>&1 || true
+}
+trap cleanup EXIT
+
+fail() {
+    echo "FAIL: $1"
+    echo "--- auth-service log ---"
+    cat "$SERVICE_LOG"
+    exit 1
+}
+
+echo "=== Sessions Partition Detach Check ==="
+
+echo "Step 1: Start postgres:15..."
+docker run -d --name "$CONTAINER" -p "$PG_PORT:5432" \
+    -e POSTGRES_USER=auth_user -e POSTGRES_PASSWORD=secret -e POSTGRES_DB=auth_db \
+    postgres:15 >/dev/null
+# По TCP отвечает только основной сервер, не временный из init-скрипта образа
+until docker exec "$CONTAINER" pg_isready -h 127.0.0.1 -U auth_user -d auth_db >/dev/null 2>&1; do
+    sleep 1
+done
+
+echo "Step 2: Schema..."
+psql_db < "$SQL_DIR/01-schema.sql"
+
+echo "Step 3: Start auth-service..."
+AUTH_DB_HOST=127.0.0.1 AUTH_DB_PORT="$PG_PORT" AUTH_DB_NAME=auth_db \
+AUTH_DB_USER=auth_user AUTH_DB_PASSWORD=secret \
+JWT_SECRET=partition-detach-check AUTH_SESSION_REAP_INTERVAL_SECONDS=2 \
+    "$AUTH_SERVICE_BIN" >"$SERVICE_LOG" 2>&1 &
+SERVICE_PID=$!
+# Стартовые секции на сегодня и вперёд создаются до долгого чтения:
+# CREATE TABLE ... PARTITION OF сам блокирует sessions
+for _ in $(seq 1 30); do
+    grep -q "PostgresSessionRepository\] Initialized" "$SERVICE_LOG" && break
+    sleep 1
+done
+grep -q "PostgresSessionRepository\] Initialized" "$SERVICE_LOG" || fail "auth-service did not start"
+
+echo "Step 4: Expired partition and a long reader (${READER_SECONDS}s)..."
+PARTITION="sessions_p$(psql_db -c "SELECT to_char(CURRENT_DATE - 1, 'YYYYMMDD')")"
+psql_db <<SQL
+CREATE TABLE $PARTITION PARTITION OF sessions FOR VALUES FROM (CURRENT_DATE - 1) TO (CURRENT_DATE);
+INSERT INTO sessions (session_id, jwt_token, token_hash, expires_at)
+VALUES ('expired-session', 'jwt', sha256('jwt'::bytea), CURRENT_DATE - 1 + TIME '12:00');
+SQL
+psql_db -c "BEGIN; SELECT count(*) FROM sessions; SELECT pg_sleep($READER_SECONDS); COMMIT;" >/dev/null &
+sleep 1
+
+echo "Step 5: sessions stays readable while $PARTITION is detached..."
+for _ in $(seq 1 $((READER_SECONDS - 3))); do
+    psql_db -c "SET lock_timeout = '1s'; SELECT count(*) FROM sessions;" >/dev/null \
+        || fail "query on sessions waited for the partition lock"
+    sleep 1
+done
+
+echo "Step 6: Wait for the drop..."
+for _ in $(seq 1 30); do
+    if [ "$(psql_db -c "SELECT to_regclass('$PARTITION') IS NULL")" = "t" ]; then
+        echo "OK: $PARTITION dropped, sessions was not blocked"
+        echo "=== Done ==="
+        exit 0
+    fi
+    sleep 1
+done
+fail "$PARTITION still exists"
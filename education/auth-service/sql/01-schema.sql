@@ -18,14 +18,24 @@ CREATE TABLE IF NOT EXISTS accounts (
     created_at TIMESTAMP DEFAULT NOW()
 );
 
+-- Секционирована по дню истечения: секции sessions_pYYYYMMDD на сегодня и
+-- вперёд на срок жизни сессии создаёт auth-service, целиком истёкшие
+-- секции он же отсоединяет (DETACH PARTITION ... CONCURRENTLY) и удаляет
+-- вместо построчного DELETE. Секции по умолчанию нет: с ней PostgreSQL
+-- не отсоединяет секции CONCURRENTLY.
 CREATE TABLE IF NOT EXISTS sessions (
-    session_id VARCHAR(64) PRIMARY KEY,
+    session_id VARCHAR(64) NOT NULL,
     user_id VARCHAR(64) REFERENCES users(user_id),
     jwt_token VARCHAR(512) NOT NULL,
+    token_hash BYTEA NOT NULL,          -- SHA-256 от jwt_token: поиск сессии по токену
     expires_at TIMESTAMP NOT NULL,
-    created_at TIMESTAMP DEFAULT NOW()
-);
+    created_at TIMESTAMP DEFAULT NOW(),
+    revoked_at TIMESTAMP,               -- logout: строка хранится до expires_at как запись отзыва
+    PRIMARY KEY (session_id, expires_at)
+) PARTITION BY RANGE (expires_at);
 
 CREATE INDEX IF NOT EXISTS idx_accounts_user_id ON accounts(user_id);
 CREATE INDEX IF NOT EXISTS idx_sessions_user_id ON sessions(user_id);
+CREATE INDEX IF NOT EXISTS idx_sessions_token_hash ON sessions(token_hash);
 CREATE INDEX IF NOT EXISTS idx_sessions_expires_at ON sessions(expires_at);
+CREATE INDEX IF NOT EXISTS idx_sessions_revoked ON sessions(expires_at) WHERE revoked_at IS NOT NULL;
@@ -4,16 +4,18 @@
 #include "adapters/primary/RegisterHandler.hpp"
 #include "adapters/primary/LoginHandler.hpp"
 #include "adapters/primary/ValidateTokenHandler.hpp"
+#include "adapters/primary/ValidateTokenBatchHandler.hpp"
 #include "adapters/primary/GetAccountsHandler.hpp"
 #include "adapters/primary/AddAccountHandler.hpp"
 
 #include "application/AuthService.hpp"
 #include "application/AccountService.hpp"
-#include "adapters/secondary/FakeJwtAdapter.hpp"
+#include "adapters/secondary/HmacJwtAdapter.hpp"
 #include "adapters/secondary/AuthSettings.hpp"
 #include "mocks/InMemoryUserRepository.hpp"
 #include "mocks/InMemoryAccountRepository.hpp"
 #include "mocks/InMemorySessionRepository.hpp"
+#include "mocks/InMemoryEventPublisher.hpp"
 
 // Используем SimpleRequest/SimpleResponse из http-server-core
 #include "SimpleRequest.hpp"
@@ -32,14 +34,16 @@ using namespace auth::adapters::primary;
 class AuthEndpointTest : public ::testing::Test {
 protected:
     void SetUp() override {
+        setenv("JWT_SECRET", "test-jwt-secret", 0);
         settings_ = std::make_shared<adapters::secondary::AuthSettings>();
         userRepo_ = std::make_shared<InMemoryUserRepository>();
         accountRepo_ = std::make_shared<InMemoryAccountRepository>();
         sessionRepo_ = std::make_shared<InMemorySessionRepository>();
-        jwtProvider_ = std::make_shared<adapters::secondary::FakeJwtAdapter>();
+        jwtProvider_ = std::make_shared<adapters::secondary::HmacJwtAdapter>(settings_);
+        eventPublisher_ = std::make_shared<InMemoryEventPublisher>();
         
         authService_ = std::make_shared<application::AuthService>(
-            settings_, userRepo_, sessionRepo_, jwtProvider_
+            settings_, userRepo_, sessionRepo_, jwtProvider_, eventPublisher_
         );
         accountService_ = std::make_shared<application::AccountService>(accountRepo_);
     }
@@ -54,7 +58,8 @@ protected:
     std::shared_ptr<InMemoryUserRepository> userRepo_;
     std::shared_ptr<InMemoryAccountRepository> accountRepo_;
     std::shared_ptr<InMemorySessionRepository> sessionRepo_;
-    std::shared_ptr<adapters::secondary::FakeJwtAdapter> jwtProvider_;
+    std::shared_ptr<adapters::secondary::HmacJwtAdapter> jwtProvider_;
+    std::shared_ptr<InMemoryEventPublisher> eventPublisher_;
     std::shared_ptr<application::AuthService> authService_;
     std::shared_ptr<application::AccountService> accountService_;
 };
@@ -175,6 +180,28 @@ TEST_F(AuthEndpointTest, ValidateTokenHandler_ValidSession) {
     EXPECT_EQ(json["user_id"], loginResult.userId);
 }
 
+TEST_F(AuthEndpointTest, ValidateTokenHandler_ValidAccess_ReturnsExpiresAt) {
+    authService_->registerUser("john", "john@test.com", "pass123");
+    auto loginResult = authService_->login("john", "pass123");
+    auto accessToken = authService_->createAccessToken(loginResult.sessionToken, "acc-1");
+    ASSERT_TRUE(accessToken.has_value());
+
+    ValidateTokenHandler handler(authService_);
+
+    SimpleRequest req;
+    req.setMethod("POST");
+    req.setPath("/api/v1/auth/validate");
+    req.setBody(R"({"token": ")" + *accessToken + R"(", "type": "access"})");
+
+    SimpleResponse res;
+    handler.handle(req, res);
+
+    auto json = nlohmann::json::parse(res.getBody());
+    EXPECT_TRUE(json["valid"].get<bool>());
+    EXPECT_EQ(json["account_id"], "acc-1");
+    EXPECT_GT(json["expires_at"].get<int64_t>(), 0);
+}
+
 TEST_F(AuthEndpointTest, ValidateTokenHandler_InvalidToken) {
     ValidateTokenHandler handler(authService_);
     
@@ -192,6 +219,55 @@ TEST_F(AuthEndpointTest, ValidateTokenHandler_InvalidToken) {
     EXPECT_FALSE(json["valid"].get<bool>());
 }
 
+TEST_F(AuthEndpointTest, ValidateTokenBatchHandler_ResultsInRequestOrder) {
+    authService_->registerUser("john", "john@test.com", "pass123");
+    auto loginResult = authService_->login("john", "pass123");
+    auto first = authService_->createAccessToken(loginResult.sessionToken, "acc-1");
+    auto second = authService_->createAccessToken(loginResult.sessionToken, "acc-2");
+    ASSERT_TRUE(first.has_value() && second.has_value());
+
+    ValidateTokenBatchHandler handler(authService_);
+
+    SimpleRequest req;
+    req.setMethod("POST");
+    req.setPath("/api/v1/auth/validate/batch");
+    nlohmann::json body;
+    body["tokens"] = {*first, "invalid-token", *second, ""};
+    body["type"] = "access";
+    req.setBody(body.dump());
+
+    SimpleResponse res;
+    handler.handle(req, res);
+
+    ASSERT_EQ(res.getStatus(), 200);
+    auto results = nlohmann::json::parse(res.getBody())["results"];
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_TRUE(results[0]["valid"].get<bool>());
+    EXPECT_EQ(results[0]["account_id"], "acc-1");
+    EXPECT_GT(results[0]["expires_at"].get<int64_t>(), 0);
+    EXPECT_FALSE(results[1]["valid"].get<bool>());
+    EXPECT_EQ(results[2]["account_id"], "acc-2");
+    EXPECT_FALSE(results[3]["valid"].get<bool>());
+}
+
+TEST_F(AuthEndpointTest, ValidateTokenBatchHandler_BadRequests) {
+    ValidateTokenBatchHandler handler(authService_);
+
+    nlohmann::json tooMany;
+    tooMany["tokens"] = std::vector<std::string>(ValidateTokenBatchHandler::MAX_TOKENS + 1, "t");
+
+    for (const std::string& body : {std::string(R"({"token": "t"})"), std::string("not json"), tooMany.dump()}) {
+        SimpleRequest req;
+        req.setMethod("POST");
+        req.setPath("/api/v1/auth/validate/batch");
+        req.setBody(body);
+
+        SimpleResponse res;
+        handler.handle(req, res);
+        EXPECT_EQ(res.getStatus(), 400) << body.substr(0, 40);
+    }
+}
+
 // ============================================
 // GET ACCOUNTS HANDLER TESTS
 // ============================================
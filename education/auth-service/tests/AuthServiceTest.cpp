@@ -2,10 +2,14 @@
 #include <gmock/gmock.h>
 
 #include "application/AuthService.hpp"
-#include "adapters/secondary/FakeJwtAdapter.hpp"
+#include "adapters/secondary/HmacJwtAdapter.hpp"
 #include "adapters/secondary/AuthSettings.hpp"
 #include "mocks/InMemoryUserRepository.hpp"
 #include "mocks/InMemorySessionRepository.hpp"
+#include "mocks/InMemoryEventPublisher.hpp"
+
+#include <nlohmann/json.hpp>
+#include <thread>
 
 using namespace auth;
 using namespace auth::tests::mocks;
@@ -13,13 +17,15 @@ using namespace auth::tests::mocks;
 class AuthServiceTest : public ::testing::Test {
 protected:
     void SetUp() override {
+        setenv("JWT_SECRET", "test-jwt-secret", 0);
         settings_ = std::make_shared<adapters::secondary::AuthSettings>();
         userRepo_ = std::make_shared<InMemoryUserRepository>();
         sessionRepo_ = std::make_shared<InMemorySessionRepository>();
-        jwtProvider_ = std::make_shared<adapters::secondary::FakeJwtAdapter>();
+        jwtProvider_ = std::make_shared<adapters::secondary::HmacJwtAdapter>(settings_);
+        eventPublisher_ = std::make_shared<InMemoryEventPublisher>();
         
         authService_ = std::make_shared<application::AuthService>(
-            settings_, userRepo_, sessionRepo_, jwtProvider_
+            settings_, userRepo_, sessionRepo_, jwtProvider_, eventPublisher_
         );
     }
 
@@ -31,7 +37,8 @@ protected:
     std::shared_ptr<adapters::secondary::AuthSettings> settings_;
     std::shared_ptr<InMemoryUserRepository> userRepo_;
     std::shared_ptr<InMemorySessionRepository> sessionRepo_;
-    std::shared_ptr<adapters::secondary::FakeJwtAdapter> jwtProvider_;
+    std::shared_ptr<adapters::secondary::HmacJwtAdapter> jwtProvider_;
+    std::shared_ptr<InMemoryEventPublisher> eventPublisher_;
     std::shared_ptr<application::AuthService> authService_;
 };
 
@@ -119,6 +126,66 @@ TEST_F(AuthServiceTest, Logout_Success) {
 TEST_F(AuthServiceTest, Logout_InvalidToken) {
     bool result = authService_->logout("invalid-token");
     EXPECT_FALSE(result);
+    EXPECT_TRUE(eventPublisher_->events().empty());
+}
+
+TEST_F(AuthServiceTest, Logout_PublishesSessionRevoked) {
+    authService_->registerUser("john", "john@example.com", "password123");
+    auto loginResult = authService_->login("john", "password123");
+
+    authService_->logout(loginResult.sessionToken);
+
+    auto events = eventPublisher_->events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].first, "auth.session.revoked");
+    auto json = nlohmann::json::parse(events[0].second);
+    EXPECT_EQ(json["user_id"], loginResult.userId);
+    EXPECT_GT(json["revoked_at"].get<int64_t>(), 0);
+}
+
+TEST_F(AuthServiceTest, Logout_RevokesEarlierAccessTokens) {
+    authService_->registerUser("john", "john@example.com", "password123");
+    auto first = authService_->login("john", "password123");
+    auto accessToken = authService_->createAccessToken(first.sessionToken, "acc-123");
+    ASSERT_TRUE(accessToken.has_value());
+
+    authService_->logout(first.sessionToken);
+
+    auto validation = authService_->validateAccessToken(*accessToken);
+    EXPECT_FALSE(validation.valid);
+    EXPECT_EQ(validation.message, "Token revoked");
+
+    // Токены, выпущенные после logout, действуют
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    auto second = authService_->login("john", "password123");
+    auto freshToken = authService_->createAccessToken(second.sessionToken, "acc-123");
+    ASSERT_TRUE(freshToken.has_value());
+    EXPECT_TRUE(authService_->validateAccessToken(*freshToken).valid);
+}
+
+TEST_F(AuthServiceTest, Logout_Twice_SecondFails) {
+    authService_->registerUser("john", "john@example.com", "password123");
+    auto loginResult = authService_->login("john", "password123");
+
+    EXPECT_TRUE(authService_->logout(loginResult.sessionToken));
+    EXPECT_FALSE(authService_->logout(loginResult.sessionToken));
+    EXPECT_EQ(eventPublisher_->events().size(), 1u);
+}
+
+TEST_F(AuthServiceTest, Logout_SurvivesRestart) {
+    authService_->registerUser("john", "john@example.com", "password123");
+    auto loginResult = authService_->login("john", "password123");
+    auto accessToken = authService_->createAccessToken(loginResult.sessionToken, "acc-123");
+    ASSERT_TRUE(accessToken.has_value());
+    authService_->logout(loginResult.sessionToken);
+
+    // Новый экземпляр над той же БД восстанавливает отзывы из sessions
+    auto restarted = std::make_shared<application::AuthService>(
+        settings_, userRepo_, sessionRepo_, jwtProvider_, eventPublisher_);
+
+    EXPECT_EQ(restarted->validateSessionToken(loginResult.sessionToken).message, "Token revoked");
+    EXPECT_EQ(restarted->validateAccessToken(*accessToken).message, "Token revoked");
+    EXPECT_FALSE(restarted->createAccessToken(loginResult.sessionToken, "acc-123").has_value());
 }
 
 // ============================================
@@ -141,6 +208,20 @@ TEST_F(AuthServiceTest, ValidateSessionToken_Invalid) {
     EXPECT_FALSE(validation.valid);
 }
 
+TEST_F(AuthServiceTest, ValidateSessionToken_AccessToken_Rejected) {
+    authService_->registerUser("john", "john@example.com", "password123");
+    auto loginResult = authService_->login("john", "password123");
+    auto accessToken = authService_->createAccessToken(loginResult.sessionToken, "acc-123");
+    ASSERT_TRUE(accessToken.has_value());
+
+    auto validation = authService_->validateSessionToken(*accessToken);
+
+    EXPECT_FALSE(validation.valid);
+    EXPECT_TRUE(validation.userId.empty());
+    // По access token новый access token не выпускается
+    EXPECT_FALSE(authService_->createAccessToken(*accessToken, "acc-456").has_value());
+}
+
 // ============================================
 // ACCESS TOKEN TESTS
 // ============================================
@@ -159,6 +240,12 @@ TEST_F(AuthServiceTest, CreateAccessToken_Success) {
     EXPECT_TRUE(validation.valid);
     EXPECT_EQ(validation.userId, loginResult.userId);
     EXPECT_EQ(validation.accountId, "acc-123");
+
+    // expiresAtMs ~ сейчас + 1 час
+    auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    EXPECT_NEAR(static_cast<double>(validation.expiresAtMs - nowMs),
+                application::AuthService::ACCESS_TOKEN_LIFETIME_SECONDS * 1000.0, 5000.0);
 }
 
 TEST_F(AuthServiceTest, CreateAccessToken_InvalidSession) {
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "adapters/secondary/JwtCodec.hpp"
+#include "adapters/secondary/HmacJwtAdapter.hpp"
+#include "adapters/secondary/AuthSettings.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+using namespace auth;
+using adapters::secondary::JwtCodec;
+
+namespace {
+
+domain::TokenClaims accessClaims(const std::string& userId, const std::string& accountId) {
+    domain::TokenClaims claims;
+    claims.type = domain::TokenClaims::Type::ACCESS;
+    claims.userId.assign(userId);
+    claims.accountId.assign(accountId);
+    claims.issuedAtMs = 1760000000000;
+    claims.expiresAtMs = 1760003600000;
+    return claims;
+}
+
+std::shared_ptr<adapters::secondary::AuthSettings> testSettings() {
+    setenv("JWT_SECRET", "test-jwt-secret", 0);
+    return std::make_shared<adapters::secondary::AuthSettings>();
+}
+
+} // namespace
+
+// ============================================
+// CODEC TESTS
+// ============================================
+
+TEST(JwtCodecTest, AccessToken_RoundTrip) {
+    JwtCodec codec("secret");
+    auto token = codec.encode(accessClaims("user-1", "acc-sandbox-001"));
+
+    auto claims = codec.decode(token);
+
+    ASSERT_TRUE(claims.has_value());
+    EXPECT_EQ(claims->type, domain::TokenClaims::Type::ACCESS);
+    EXPECT_EQ(claims->userId.view(), "user-1");
+    EXPECT_EQ(claims->accountId.view(), "acc-sandbox-001");
+    EXPECT_EQ(claims->issuedAtMs, 1760000000000);
+    EXPECT_EQ(claims->expiresAtMs, 1760003600000);
+}
+
+TEST(JwtCodecTest, SessionToken_HasNoAccount) {
+    JwtCodec codec("secret");
+    domain::TokenClaims session;
+    session.userId.assign("user-1");
+    session.issuedAtMs = 1;
+    session.expiresAtMs = 2;
+
+    auto claims = codec.decode(codec.encode(session));
+
+    ASSERT_TRUE(claims.has_value());
+    EXPECT_EQ(claims->type, domain::TokenClaims::Type::SESSION);
+    EXPECT_TRUE(claims->accountId.empty());
+}
+
+TEST(JwtCodecTest, SpecialCharacters_RoundTrip) {
+    JwtCodec codec("secret");
+    auto claims = codec.decode(codec.encode(accessClaims("us\"er\\1", std::string("acc\n\x01", 5))));
+
+    ASSERT_TRUE(claims.has_value());
+    EXPECT_EQ(claims->userId.view(), "us\"er\\1");
+    EXPECT_EQ(claims->accountId.view(), std::string_view("acc\n\x01", 5));
+}
+
+TEST(JwtCodecTest, MatchesHs256Reference) {
+    // Подпись того же токена, посчитанная независимо (Python hmac + hashlib)
+    JwtCodec codec("your-256-bit-secret");
+    std::string token =
+        "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+        "eyJ0eXAiOiJhY2Nlc3MiLCJzdWIiOiJ1c2VyLTEiLCJhY2MiOiJhY2MtMSIsImlhdCI6MSwiZXhwIjoyfQ."
+        "GewkI2rpFT3E0hwA6A49HDMsbK-VIoi-biclKha6IV4";
+
+    auto claims = codec.decode(token);
+
+    ASSERT_TRUE(claims.has_value());
+    EXPECT_EQ(claims->accountId.view(), "acc-1");
+}
+
+TEST(JwtCodecTest, TokenId_FromSignature) {
+    JwtCodec codec("secret");
+    auto token = codec.encode(accessClaims("user-1", "acc-1"));
+    auto other = codec.encode(accessClaims("user-1", "acc-2"));
+
+    auto claims = codec.decode(token);
+    ASSERT_TRUE(claims.has_value());
+    EXPECT_NE(claims->tokenId, 0u);
+    EXPECT_EQ(codec.decode(token)->tokenId, claims->tokenId);
+    EXPECT_NE(codec.decode(other)->tokenId, claims->tokenId);
+}
+
+TEST(JwtCodecTest, OtherSecret_Rejected) {
+    auto token = JwtCodec("secret").encode(accessClaims("user-1", "acc-1"));
+
+    EXPECT_FALSE(JwtCodec("other").decode(token).has_value());
+}
+
+TEST(JwtCodecTest, TamperedToken_Rejected) {
+    JwtCodec codec("secret");
+    auto token = codec.encode(accessClaims("user-1", "acc-1"));
+    auto forged = JwtCodec("secret").encode(accessClaims("user-1", "acc-2"));
+
+    // Payload от другого токена с исходной подписью
+    size_t dot = token.rfind('.');
+    size_t forgedDot = forged.rfind('.');
+    EXPECT_FALSE(codec.decode(forged.substr(0, forgedDot) + token.substr(dot)).has_value());
+
+    // Последний символ подписи несёт 4 значащих бита из 6: другой символ
+    // с теми же значащими битами - другое написание той же подписи
+    const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    std::string respelled = token;
+    respelled.back() = alphabet[alphabet.find(token.back()) ^ 1];
+    EXPECT_FALSE(codec.decode(respelled).has_value());
+}
+
+TEST(JwtCodecTest, Malformed_Rejected) {
+    JwtCodec codec("secret");
+    auto token = codec.encode(accessClaims("user-1", "acc-1"));
+
+    EXPECT_FALSE(codec.decode("").has_value());
+    EXPECT_FALSE(codec.decode("invalid-token").has_value());
+    EXPECT_FALSE(codec.decode("eyJ.e30.sig").has_value());
+    EXPECT_FALSE(codec.decode(token.substr(0, token.size() - 1)).has_value());
+    EXPECT_FALSE(codec.decode(token + "." + token).has_value());
+    EXPECT_FALSE(codec.decode(std::string(JwtCodec::MAX_TOKEN_SIZE + 1, 'a')).has_value());
+}
+
+// ============================================
+// ADAPTER TESTS
+// ============================================
+
+TEST(HmacJwtAdapterTest, Expired_Rejected) {
+    adapters::secondary::HmacJwtAdapter jwt(testSettings());
+
+    auto expired = jwt.createAccessToken("user-1", "acc-1", -1);
+    EXPECT_FALSE(jwt.validateAndExtract(expired).has_value());
+
+    auto token = jwt.createSessionToken("user-1", 60);
+    EXPECT_TRUE(jwt.validateAndExtract(token).has_value());
+}
+
+TEST(HmacJwtAdapterTest, OverlongId_Throws) {
+    adapters::secondary::HmacJwtAdapter jwt(testSettings());
+
+    EXPECT_THROW(jwt.createAccessToken("user-1", std::string(65, 'a'), 60), std::invalid_argument);
+}
+
+TEST(AuthSettingsTest, MissingJwtSecret_Throws) {
+    const char* saved = std::getenv("JWT_SECRET");
+    std::string previous = saved ? saved : "";
+
+    unsetenv("JWT_SECRET");
+    EXPECT_THROW(adapters::secondary::AuthSettings(), std::runtime_error);
+    setenv("JWT_SECRET", "", 1);
+    EXPECT_THROW(adapters::secondary::AuthSettings(), std::runtime_error);
+
+    if (saved) {
+        setenv("JWT_SECRET", previous.c_str(), 1);
+    } else {
+        unsetenv("JWT_SECRET");
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "application/TokenRevocationSet.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using auth::application::TokenRevocationSet;
+
+namespace {
+
+constexpr int64_t NOW = 1760000000000;
+constexpr int64_t HOUR = 3600 * 1000;
+
+TokenRevocationSet::Revocation sessionRevocation(uint64_t tokenId, int64_t tokenExpiresAtMs,
+                                                 const std::string& userId, int64_t revokedAtMs) {
+    TokenRevocationSet::Revocation r;
+    r.tokenId = tokenId;
+    r.tokenExpiresAtMs = tokenExpiresAtMs;
+    r.userId = userId;
+    r.revokedAtMs = revokedAtMs;
+    r.userExpiresAtMs = revokedAtMs + HOUR;
+    return r;
+}
+
+} // namespace
+
+TEST(TokenRevocationSetTest, Empty_NothingRevoked) {
+    TokenRevocationSet set;
+
+    EXPECT_FALSE(set.isTokenRevoked(42));
+    EXPECT_FALSE(set.isUserRevoked("user-1", NOW));
+    EXPECT_EQ(set.size(), 0u);
+}
+
+TEST(TokenRevocationSetTest, Revoke_TokenAndEarlierAccessTokens) {
+    TokenRevocationSet set;
+    set.revoke({sessionRevocation(42, NOW + 24 * HOUR, "user-1", NOW)}, NOW);
+
+    EXPECT_TRUE(set.isTokenRevoked(42));
+    EXPECT_FALSE(set.isTokenRevoked(43));
+    EXPECT_TRUE(set.isUserRevoked("user-1", NOW - 1));
+    EXPECT_TRUE(set.isUserRevoked("user-1", NOW));
+    EXPECT_FALSE(set.isUserRevoked("user-1", NOW + 1));
+    EXPECT_FALSE(set.isUserRevoked("user-2", NOW - 1));
+    EXPECT_EQ(set.size(), 2u);
+}
+
+TEST(TokenRevocationSetTest, ExpiredEntries_DroppedOnNextWrite) {
+    TokenRevocationSet set;
+    set.revoke({sessionRevocation(42, NOW + 10 * 60 * 1000, "user-1", NOW)}, NOW);
+
+    // Токен истёк, отзыв access-токенов ещё действует
+    int64_t later = NOW + 11 * 60 * 1000;
+    set.revoke({sessionRevocation(43, later + 24 * HOUR, "user-2", later)}, later);
+    EXPECT_FALSE(set.isTokenRevoked(42));
+    EXPECT_TRUE(set.isUserRevoked("user-1", NOW));
+    EXPECT_EQ(set.size(), 3u);
+
+    // Через час после logout - и он
+    int64_t afterHour = NOW + HOUR + TokenRevocationSet::BUCKET_MS;
+    set.revoke({}, afterHour);
+    EXPECT_FALSE(set.isUserRevoked("user-1", NOW));
+    EXPECT_TRUE(set.isTokenRevoked(43));
+    EXPECT_TRUE(set.isUserRevoked("user-2", later));
+    EXPECT_EQ(set.size(), 2u);
+}
+
+TEST(TokenRevocationSetTest, LaterLogout_OutlivesEarlierBucket) {
+    TokenRevocationSet set;
+    set.revoke({sessionRevocation(1, 0, "user-1", NOW)}, NOW);
+    set.revoke({sessionRevocation(2, 0, "user-1", NOW + 30 * 60 * 1000)}, NOW + 30 * 60 * 1000);
+
+    // Корзина первого logout истекла, второй всё ещё отзывает
+    set.revoke({}, NOW + HOUR + TokenRevocationSet::BUCKET_MS);
+    EXPECT_TRUE(set.isUserRevoked("user-1", NOW + 20 * 60 * 1000));
+}
+
+TEST(TokenRevocationSetTest, AlreadyExpired_NotStored) {
+    TokenRevocationSet set;
+    set.revoke({sessionRevocation(42, NOW - 1, "user-1", NOW - 2 * HOUR)}, NOW);
+
+    EXPECT_FALSE(set.isTokenRevoked(42));
+    EXPECT_FALSE(set.isUserRevoked("user-1", NOW - 3 * HOUR));
+    EXPECT_EQ(set.size(), 0u);
+}
+
+TEST(TokenRevocationSetTest, ConcurrentReaders_SeeEveryPublishedRevocation) {
+    TokenRevocationSet set;
+    constexpr uint64_t WRITES = 200;
+    std::atomic<uint64_t> published{0};
+    std::atomic<bool> missed{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (published.load() < WRITES) {
+                uint64_t last = published.load();
+                if (last > 0 && !set.isTokenRevoked(last)) {
+                    missed = true;
+                }
+            }
+        });
+    }
+    for (uint64_t id = 1; id <= WRITES; ++id) {
+        set.revoke({sessionRevocation(id, NOW + HOUR, "", NOW)}, NOW);
+        published.store(id);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(missed);
+    EXPECT_EQ(set.size(), WRITES);
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "ports/output/IEventPublisher.hpp"
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace auth::tests::mocks {
+
+/**
+ * @brief In-Memory реализация публикации событий для unit-тестов
+ */
+class InMemoryEventPublisher : public ports::output::IEventPublisher {
+public:
+    void publish(const std::string& routingKey, const std::string& message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.emplace_back(routingKey, message);
+    }
+
+    std::vector<std::pair<std::string, std::string>> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.clear();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, std::string>> events_;
+};
+
+} // namespace auth::tests::mocks
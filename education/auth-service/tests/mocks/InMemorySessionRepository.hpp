@@ -22,7 +22,7 @@ public:
     std::optional<domain::Session> findById(const std::string& sessionId) override {
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = sessions_.find(sessionId);
-        if (it == sessions_.end()) return std::nullopt;
+        if (it == sessions_.end() || it->second.revokedAt) return std::nullopt;
         return it->second;
     }
 
@@ -30,14 +30,16 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = tokenIndex_.find(jwtToken);
         if (it == tokenIndex_.end()) return std::nullopt;
-        return sessions_[it->second];
+        const auto& session = sessions_[it->second];
+        if (session.revokedAt || session.isExpired()) return std::nullopt;
+        return session;
     }
 
     std::vector<domain::Session> findByUserId(const std::string& userId) override {
         std::lock_guard<std::mutex> lock(mutex_);
         std::vector<domain::Session> result;
         for (const auto& [id, session] : sessions_) {
-            if (session.userId == userId) {
+            if (session.userId == userId && !session.revokedAt) {
                 result.push_back(session);
             }
         }
@@ -69,7 +71,7 @@ public:
         return !toDelete.empty();
     }
 
-    void deleteExpired() override {
+    size_t deleteExpired() override {
         std::lock_guard<std::mutex> lock(mutex_);
         auto now = std::chrono::system_clock::now();
         std::vector<std::string> toDelete;
@@ -82,6 +84,31 @@ public:
             tokenIndex_.erase(sessions_[id].jwtToken);
             sessions_.erase(id);
         }
+        return toDelete.size();
+    }
+
+    bool markRevoked(const std::string& sessionId,
+                     std::chrono::system_clock::time_point revokedAt,
+                     std::chrono::system_clock::time_point retainUntil) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end() || it->second.revokedAt) return false;
+
+        it->second.revokedAt = revokedAt;
+        it->second.expiresAt = std::max(it->second.expiresAt, retainUntil);
+        return true;
+    }
+
+    std::vector<domain::Session> findRevoked() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::system_clock::now();
+        std::vector<domain::Session> result;
+        for (const auto& [id, session] : sessions_) {
+            if (session.revokedAt && session.expiresAt > now) {
+                result.push_back(session);
+            }
+        }
+        return result;
     }
 
     // Test helpers
@@ -0,0 +1,107 @@
+/**
+ * @file PendingOrdersBenchmark.cpp
+ * @brief Бенчмарк processPendingOrders на 100 000 pending-ордеров
+ *
+ * Лимитные ордера ставятся вне рынка (BUY ниже ask, SELL выше bid),
+ * так что тик почти ничего не исполняет - меряется стоимость "пустого"
+ * тика, который раньше перебирал все ордера. Затем цена одного
+ * инструмента сдвигается, и меряется тик с массовым исполнением.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./broker-PendingOrdersBenchmark [orders] [instruments] [ticks]
+ */
+
+#include "adapters/secondary/broker/OrderProcessor.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace broker::adapters::secondary;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double elapsedUs(Clock::time_point started) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - started).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int orders = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int instruments = argc > 2 ? std::atoi(argv[2]) : 100;
+    const int ticks = argc > 3 ? std::atoi(argv[3]) : 1000;
+
+    auto simulator = std::make_shared<PriceSimulator>(42);
+    std::vector<std::string> figis;
+    for (int i = 0; i < instruments; ++i) {
+        figis.push_back("BENCH" + std::to_string(i));
+        simulator->initInstrument(figis.back(), 100.0, 0.001, 0.0);
+    }
+
+    OrderProcessor processor(simulator);
+    uint64_t filled = 0;
+    processor.setFillCallback([&](const OrderFillEvent&) { ++filled; });
+
+    auto scenario = MarketScenario::realistic(100.0);
+
+    // Лестница 50..95 для BUY и 105..150 для SELL
+    auto started = Clock::now();
+    for (int i = 0; i < orders; ++i) {
+        OrderRequest req;
+        req.orderId = "ord-" + std::to_string(i);
+        req.accountId = "acc-" + std::to_string(i % 64);
+        req.figi = figis[i % instruments];
+        req.type = Type::LIMIT;
+        req.quantity = 1;
+        double offset = 5.0 + (i / instruments) % 4500 * 0.01;
+        if (i % 2 == 0) {
+            req.direction = Direction::BUY;
+            req.price = 100.0 - offset;
+        } else {
+            req.direction = Direction::SELL;
+            req.price = 100.0 + offset;
+        }
+        processor.processOrder(req, scenario);
+    }
+    double placeUs = elapsedUs(started);
+
+    std::cout << "[PendingOrdersBenchmark] orders=" << processor.pendingCount()
+              << " instruments=" << instruments << " ticks=" << ticks << std::endl;
+    std::cout << std::fixed << std::setprecision(1)
+              << "place:          total=" << placeUs / 1000.0 << "ms"
+              << " per-order=" << placeUs / orders << "us" << std::endl;
+
+    std::vector<double> samples;
+    samples.reserve(ticks);
+    for (int i = 0; i < ticks; ++i) {
+        auto tickStarted = Clock::now();
+        processor.processPendingOrders(scenario);
+        samples.push_back(elapsedUs(tickStarted));
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+    }
+    std::cout << "quiet tick:     mean=" << sum / ticks << "us"
+              << " p50=" << samples[samples.size() / 2] << "us"
+              << " p99=" << samples[static_cast<size_t>(0.99 * (samples.size() - 1))] << "us"
+              << " fills=" << filled << std::endl;
+
+    // Обвал первого инструмента: все его BUY-лимиты пересекаются с ask
+    simulator->initInstrument(figis[0], 10.0, 0.001, 0.0);
+    auto sweepStarted = Clock::now();
+    processor.processPendingOrders(scenario);
+    double sweepUs = elapsedUs(sweepStarted);
+    std::cout << "crossing tick:  " << sweepUs << "us"
+              << " fills=" << filled
+              << " remaining=" << processor.pendingCount() << std::endl;
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file PlaceOrderBenchmark.cpp
+ * @brief Многопоточная пропускная способность EnhancedFakeBroker::placeOrder
+ *
+ * Каждый поток торгует своими аккаунтами (BUY/SELL market по SBER,
+ * сценарий IMMEDIATE). При одном глобальном мьютексе пропускная
+ * способность не росла с числом потоков; с шардированием аккаунтов
+ * ордера разных аккаунтов идут параллельно.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./broker-PlaceOrderBenchmark [ordersPerThread] [maxThreads]
+ */
+
+#include "adapters/secondary/broker/EnhancedFakeBroker.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace broker::adapters::secondary;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+const std::string SBER_FIGI = "BBG004730N88";
+constexpr int ACCOUNTS_PER_THREAD = 4;
+
+double run(int threads, int ordersPerThread) {
+    auto settings = std::make_shared<broker::settings::BrokerSettings>();
+    EnhancedFakeBroker broker(settings);
+
+    for (int t = 0; t < threads; ++t) {
+        for (int a = 0; a < ACCOUNTS_PER_THREAD; ++a) {
+            broker.registerAccount("bench-" + std::to_string(t) + "-" + std::to_string(a), "token", 1e12);
+        }
+    }
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<std::string> accounts;
+            for (int a = 0; a < ACCOUNTS_PER_THREAD; ++a) {
+                accounts.push_back("bench-" + std::to_string(t) + "-" + std::to_string(a));
+            }
+            while (!go.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (int i = 0; i < ordersPerThread; ++i) {
+                const auto& account = accounts[i % ACCOUNTS_PER_THREAD];
+                BrokerOrderRequest req;
+                req.orderId = account + "-" + std::to_string(i);
+                req.accountId = account;
+                req.figi = SBER_FIGI;
+                req.direction = (i / ACCOUNTS_PER_THREAD) % 2 == 0 ? Direction::BUY : Direction::SELL;
+                req.type = Type::MARKET;
+                req.quantity = 1;
+                broker.placeOrder(account, req);
+            }
+        });
+    }
+
+    auto started = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& w : workers) {
+        w.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - started).count();
+    return threads * ordersPerThread / seconds;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int ordersPerThread = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int maxThreads = argc > 2 ? std::atoi(argv[2])
+                                    : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    std::cout << "[PlaceOrderBenchmark] ordersPerThread=" << ordersPerThread
+              << " maxThreads=" << maxThreads << std::endl;
+
+    double base = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        double ops = run(threads, ordersPerThread);
+        if (threads == 1) {
+            base = ops;
+        }
+        std::cout << "threads=" << std::setw(3) << threads << std::fixed << std::setprecision(0)
+                  << "  orders/s=" << std::setw(10) << ops
+                  << std::setprecision(2) << "  scale=" << ops / base << "x" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file TickKernelBenchmark.cpp
+ * @brief Бенчмарк пакетного тика BackgroundTicker
+ *
+ * Сравнивает поштучный PriceSimulator::tick(figi) с пакетным
+ * BackgroundTicker::tickBatch() на 10 000 инструментов.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./broker-TickKernelBenchmark [instruments] [ticks]
+ */
+
+#include "adapters/secondary/broker/BackgroundTicker.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace broker::adapters::secondary;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Summary {
+    double meanUs;
+    double p50Us;
+    double p99Us;
+    double maxUs;
+};
+
+Summary summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) {
+        sum += s;
+    }
+    auto at = [&](double q) {
+        return samples[static_cast<size_t>(q * (samples.size() - 1))];
+    };
+    return {sum / samples.size(), at(0.50), at(0.99), samples.back()};
+}
+
+void print(const std::string& name, const Summary& s) {
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed
+              << std::setprecision(1)
+              << " mean=" << std::setw(8) << s.meanUs << "us"
+              << " p50=" << std::setw(8) << s.p50Us << "us"
+              << " p99=" << std::setw(8) << s.p99Us << "us"
+              << " max=" << std::setw(8) << s.maxUs << "us" << std::endl;
+}
+
+template <typename Fn>
+Summary measure(int ticks, Fn&& fn) {
+    for (int i = 0; i < 10; ++i) {
+        fn();  // прогрев
+    }
+    std::vector<double> samples;
+    samples.reserve(ticks);
+    for (int i = 0; i < ticks; ++i) {
+        auto started = Clock::now();
+        fn();
+        samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - started).count());
+    }
+    return summarize(std::move(samples));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int instruments = argc > 1 ? std::atoi(argv[1]) : 10000;
+    const int ticks = argc > 2 ? std::atoi(argv[2]) : 1000;
+
+    auto simulator = std::make_shared<PriceSimulator>(42);
+    BackgroundTicker ticker(simulator);
+
+    std::vector<std::string> figis;
+    figis.reserve(instruments);
+    for (int i = 0; i < instruments; ++i) {
+        figis.push_back("BENCH" + std::to_string(i));
+        simulator->initInstrument(figis.back(), 100.0 + i % 500, 0.001, 0.002);
+        ticker.addInstrument(figis.back());
+    }
+
+    std::cout << "[TickKernelBenchmark] instruments=" << instruments
+              << " ticks=" << ticks << std::endl;
+
+    auto scalar = measure(ticks, [&] {
+        for (const auto& figi : figis) {
+            simulator->tick(figi);
+        }
+    });
+    print("per-figi tick()", scalar);
+
+    size_t produced = 0;
+    auto batch = measure(ticks, [&] {
+        produced = ticker.tickBatch().size();
+    });
+    print("BackgroundTicker batch", batch);
+
+    std::cout << "[TickKernelBenchmark] quotes/tick=" << produced
+              << " speedup=" << std::setprecision(2) << scalar.meanUs / batch.meanUs
+              << "x" << std::endl;
+    return 0;
+}
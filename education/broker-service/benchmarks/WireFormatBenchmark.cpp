@@ -0,0 +1,177 @@
+/**
+ * @file WireFormatBenchmark.cpp
+ * @brief Бенчмарк кодирования/разбора quote.updated и order.filled: JSON против бинарного формата
+ *
+ * JSON-сторона повторяет реальный код: сборка nlohmann::json + dump()
+ * как в MarketDataPublisher / OrderCommandHandler, parse() + value()
+ * как в TradingEventHandler. Бинарная - wire::encode / wire::decode*.
+ *
+ * Запуск:
+ *   cmake -DBUILD_BENCHMARKS=ON ..
+ *   ./broker-WireFormatBenchmark [iterations]
+ */
+
+#include "application/events/EventWireFormat.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace broker::application;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+double elapsedNs(Clock::time_point started) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - started).count();
+}
+
+// Не даём компилятору выбросить результат
+volatile size_t sink = 0;
+
+void report(const char* name, double totalNs, int iterations, size_t bytes) {
+    std::cout << std::left << std::setw(22) << name << std::right
+              << std::setw(8) << std::fixed << std::setprecision(1) << totalNs / iterations << " ns/op"
+              << std::setw(8) << bytes << " bytes" << std::endl;
+}
+
+std::string quoteJson(int i) {
+    nlohmann::json event;
+    event["figi"] = "BBG004730N88";
+    event["bid"] = 265.1 + i * 0.01;
+    event["ask"] = 265.3 + i * 0.01;
+    event["last_price"] = 265.2 + i * 0.01;
+    event["currency"] = "RUB";
+    event["timestamp"] = int64_t{1700000000000} + i;
+    return event.dump();
+}
+
+std::string quoteBinary(int i) {
+    wire::QuoteFrame frame;
+    frame.figi = "BBG004730N88";
+    frame.bid = 265.1 + i * 0.01;
+    frame.ask = 265.3 + i * 0.01;
+    frame.last = 265.2 + i * 0.01;
+    frame.currency = "RUB";
+    frame.timestampMs = int64_t{1700000000000} + i;
+    return wire::encode(frame);
+}
+
+std::string orderJson(int i) {
+    nlohmann::json event;
+    event["order_id"] = "4f6c2a9e-1b7d-4c3e-9a55-0d2f8e7b6c41";
+    event["account_id"] = "acc-7d3b9e21-5c4a-4f0e-8b6d-2a1c9f8e7d60";
+    event["figi"] = "BBG004730N88";
+    event["status"] = "FILLED";
+    event["executed_lots"] = 10 + i % 5;
+    event["executed_price"] = 265.2 + i * 0.01;
+    event["currency"] = "RUB";
+    event["timestamp"] = int64_t{1700000000000} + i;
+    return event.dump();
+}
+
+std::string orderBinary(int i) {
+    wire::OrderFrame frame;
+    frame.orderId = "4f6c2a9e-1b7d-4c3e-9a55-0d2f8e7b6c41";
+    frame.accountId = "acc-7d3b9e21-5c4a-4f0e-8b6d-2a1c9f8e7d60";
+    frame.figi = "BBG004730N88";
+    frame.status = wire::OrderStatus::FILLED;
+    frame.lots = 10 + i % 5;
+    frame.price = 265.2 + i * 0.01;
+    frame.currency = "RUB";
+    frame.timestampMs = int64_t{1700000000000} + i;
+    return wire::encode(frame);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+    std::cout << "[WireFormatBenchmark] iterations=" << iterations << std::endl;
+
+    // --- quote.updated ---
+    auto started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + quoteJson(i).size();
+    }
+    report("quote json encode", elapsedNs(started), iterations, quoteJson(0).size());
+
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + quoteBinary(i).size();
+    }
+    report("quote binary encode", elapsedNs(started), iterations, quoteBinary(0).size());
+
+    std::string quoteJsonMessage = quoteJson(1);
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto json = nlohmann::json::parse(quoteJsonMessage);
+        std::string figi = json.value("figi", "");
+        double bid = json.value("bid", 0.0);
+        double ask = json.value("ask", 0.0);
+        double last = json.value("last_price", 0.0);
+        std::string currency = json.value("currency", "RUB");
+        int64_t timestamp = json.value("timestamp", int64_t{0});
+        sink = sink + figi.size() + currency.size() + static_cast<size_t>(bid + ask + last) + timestamp;
+    }
+    report("quote json decode", elapsedNs(started), iterations, quoteJsonMessage.size());
+
+    std::string quoteBinaryMessage = quoteBinary(1);
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto frame = wire::decodeQuote(quoteBinaryMessage);
+        std::string figi(frame->figi);
+        std::string currency(frame->currency);
+        sink = sink + figi.size() + currency.size()
+             + static_cast<size_t>(frame->bid + frame->ask + frame->last) + frame->timestampMs;
+    }
+    report("quote binary decode", elapsedNs(started), iterations, quoteBinaryMessage.size());
+
+    // --- order.filled ---
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + orderJson(i).size();
+    }
+    report("order json encode", elapsedNs(started), iterations, orderJson(0).size());
+
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        sink = sink + orderBinary(i).size();
+    }
+    report("order binary encode", elapsedNs(started), iterations, orderBinary(0).size());
+
+    std::string orderJsonMessage = orderJson(1);
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto json = nlohmann::json::parse(orderJsonMessage);
+        std::string orderId = json.value("order_id", "");
+        std::string accountId = json.value("account_id", "");
+        std::string figi = json.value("figi", "");
+        std::string status = json.value("status", "");
+        int64_t lots = json.value("executed_lots", json.value("filled_lots", 0));
+        double price = json.value("executed_price", 0.0);
+        sink = sink + orderId.size() + accountId.size() + figi.size() + status.size()
+             + static_cast<size_t>(lots + price);
+    }
+    report("order json decode", elapsedNs(started), iterations, orderJsonMessage.size());
+
+    std::string orderBinaryMessage = orderBinary(1);
+    started = Clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        auto frame = wire::decodeOrder(orderBinaryMessage);
+        std::string orderId(frame->orderId);
+        std::string accountId(frame->accountId);
+        std::string figi(frame->figi);
+        std::string status = wire::toString(frame->status);
+        sink = sink + orderId.size() + accountId.size() + figi.size() + status.size()
+             + static_cast<size_t>(frame->lots + frame->price);
+    }
+    report("order binary decode", elapsedNs(started), iterations, orderBinaryMessage.size());
+
+    return 0;
+}
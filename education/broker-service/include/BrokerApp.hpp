@@ -19,6 +19,8 @@
 #include "settings/DbSettings.hpp"
 #include "settings/RabbitMQSettings.hpp"
 #include "settings/BrokerSettings.hpp"
+#include "settings/OrderPipelineSettings.hpp"
+#include "settings/MarketDataSettings.hpp"
 
 // Application
 #include "application/QuoteService.hpp"
@@ -26,11 +28,14 @@
 #include "application/MarketDataPublisher.hpp"
 
 // Secondary Adapters
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include "adapters/secondary/PostgresInstrumentRepository.hpp"
 #include "adapters/secondary/PostgresQuoteRepository.hpp"
 #include "adapters/secondary/PostgresBrokerOrderRepository.hpp"
 #include "adapters/secondary/PostgresBrokerPositionRepository.hpp"
 #include "adapters/secondary/PostgresBrokerBalanceRepository.hpp"
+#include "adapters/secondary/QuoteWriteBehindSink.hpp"
+#include "adapters/secondary/ConflatingQuotePublisher.hpp"
 #include "adapters/secondary/broker/EnhancedFakeBroker.hpp"
 #include "adapters/secondary/broker/FakeBrokerAdapter.hpp"
 #include "adapters/secondary/events/RabbitMQAdapter.hpp"
@@ -63,8 +68,8 @@ namespace broker {
 /**
  * @brief Broker Service Application (Event-Driven)
  * 
- * Слушает: order.create, order.cancel (из trading.events)
- * Публикует: order.*, quote.updated, portfolio.updated (в broker.events)
+ * Слушает: order.create, order.cancel, quote.snapshot.request (из trading.events)
+ * Публикует: order.*, quote.batch / quote.snapshot (или quote.updated), portfolio.updated (в broker.events)
  * HTTP: только GET запросы (POST/DELETE через RabbitMQ)
  */
 class BrokerApp : public BoostBeastApplication {
@@ -91,19 +96,30 @@ protected:
         auto injector = di::make_injector(
             di::bind<settings::DbSettings>().in(di::singleton),
             di::bind<settings::RabbitMQSettings>().in(di::singleton),
+            di::bind<settings::OrderPipelineSettings>().in(di::singleton),
+            di::bind<settings::MarketDataSettings>().in(di::singleton),
             
-            // RabbitMQ - один экземпляр для обоих интерфейсов
+            // Один пул соединений на все Postgres-репозитории
+            di::bind<adapters::secondary::PgConnectionPool>().in(di::singleton),
+            
+            // RabbitMQ - один экземпляр для обоих интерфейсов (и для метрик публикации)
             di::bind<ports::output::IEventPublisher>().to(rabbitMQAdapter),
             di::bind<ports::output::IEventConsumer>().to(rabbitMQAdapter),
+            di::bind<adapters::secondary::RabbitMQAdapter>().to(rabbitMQAdapter),
             
             di::bind<ports::output::IInstrumentRepository>().to<adapters::secondary::PostgresInstrumentRepository>().in(di::singleton),
             di::bind<ports::output::IQuoteRepository>().to<adapters::secondary::PostgresQuoteRepository>().in(di::singleton),
             di::bind<ports::output::IBrokerOrderRepository>().to<adapters::secondary::PostgresBrokerOrderRepository>().in(di::singleton),
             di::bind<ports::output::IBrokerPositionRepository>().to<adapters::secondary::PostgresBrokerPositionRepository>().in(di::singleton),
             di::bind<ports::output::IBrokerBalanceRepository>().to<adapters::secondary::PostgresBrokerBalanceRepository>().in(di::singleton),
+            di::bind<adapters::secondary::QuoteWriteBehindSink>().in(di::singleton),
+            di::bind<adapters::secondary::ConflatingQuotePublisher>().in(di::singleton),
             di::bind<adapters::secondary::EnhancedFakeBroker>().in(di::singleton),
             di::bind<ports::output::IBrokerGateway>().to<adapters::secondary::FakeBrokerAdapter>().in(di::singleton),
-            di::bind<ports::input::IQuoteService>().to<application::QuoteService>().in(di::singleton)
+            di::bind<ports::input::IQuoteService>().to<application::QuoteService>().in(di::singleton),
+
+            // Один конвейер команд: его же метрики отдаёт MetricsHandler
+            di::bind<application::OrderCommandHandler>().in(di::singleton)
         );
 
         // Настройки брокера (определяюет его поведение)
@@ -115,6 +131,8 @@ protected:
         // OrderCommandHandler вызывает subscribe() в конструкторе
         auto orderCommandHandler_ = injector.create<std::shared_ptr<application::OrderCommandHandler>>();
         auto marketDataPublisher_ = injector.create<std::shared_ptr<application::MarketDataPublisher>>();
+        // Рассылка котировок подписывается на quote.snapshot.request в конструкторе
+        auto quotePublisher = injector.create<std::shared_ptr<adapters::secondary::ConflatingQuotePublisher>>();
 
         // Шаг 4: Запускаем RabbitMQ ПОСЛЕ регистрации всех handlers
         std::cout << "[BrokerApp] Starting RabbitMQ consumer..." << std::endl;
@@ -138,6 +156,10 @@ protected:
 
         std::cout << "[BrokerApp] Ready (POST/DELETE via RabbitMQ)" << std::endl;
 
+        // Фоновая запись котировок в БД - до старта тикера
+        injector.create<std::shared_ptr<adapters::secondary::QuoteWriteBehindSink>>()->start();
+        quotePublisher->start();
+
         enhancedFakeBroker->startSimulation(std::chrono::milliseconds{brokerSettings->getTickIntervalMs()});
         std::cout << "[BrokerApp] fake broker simulation started" << std::endl;
     }
@@ -2,19 +2,37 @@
 
 #include <IHttpHandler.hpp>
 #include "ports/output/IBrokerGateway.hpp"
+#include "domain/Timestamp.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <iostream>
+#include <optional>
 
 namespace broker::adapters::primary
 {
 
     /**
-     * @brief GET /api/v1/orders?account_id=xxx — список ордеров
+     * @brief GET /api/v1/orders?account_id=xxx — история ордеров, новые первыми
+     *
+     * Параметры:
+     * - limit - размер страницы (по умолчанию DEFAULT_LIMIT, не больше MAX_LIMIT);
+     * - cursor - next_cursor предыдущей страницы;
+     * - from, to - период по времени получения ордера, [from, to):
+     *   Unix-время в миллисекундах или "2026-01-31T10:00:00Z" (только UTC:
+     *   смещение вроде "+03:00" и любой хвост - 400);
+     * - status - PENDING / PARTIALLY_FILLED / FILLED / CANCELLED / REJECTED.
+     *
+     * Ответ: {"orders": [...], "next_cursor": "..." | null}. Тело собирается
+     * строкой по одному ордеру, без общего nlohmann::json документа.
      */
     class GetOrdersHandler : public IHttpHandler
     {
     public:
+        static constexpr size_t DEFAULT_LIMIT = 100;
+        static constexpr size_t MAX_LIMIT = 1000;
+
         explicit GetOrdersHandler(std::shared_ptr<broker::ports::output::IBrokerGateway> broker)
             : broker_(std::move(broker))
         {
@@ -39,15 +57,30 @@ namespace broker::adapters::primary
                     return;
                 }
 
-                auto orders = broker_->getOrders(accountId);
+                domain::OrderQuery query;
+                std::string invalid = parseQuery(req, query);
+                if (!invalid.empty())
+                {
+                    sendError(res, 400, "Invalid parameter '" + invalid + "'");
+                    return;
+                }
 
-                nlohmann::json response = nlohmann::json::array();
-                for (const auto &order : orders)
+                auto page = broker_->getOrderHistory(accountId, query);
+
+                std::string body;
+                body.reserve(64 + page.orders.size() * 320);
+                body += "{\"orders\":[";
+                for (size_t i = 0; i < page.orders.size(); ++i)
                 {
-                    response.push_back(orderToJson(order));
+                    if (i > 0)
+                        body += ',';
+                    body += orderToJson(page.orders[i]).dump();
                 }
+                body += "],\"next_cursor\":";
+                body += page.nextCursor ? nlohmann::json(*page.nextCursor).dump() : "null";
+                body += '}';
 
-                res.setResult(200, "application/json", response.dump());
+                res.setResult(200, "application/json", body);
             }
             catch (const std::runtime_error &e)
             {
@@ -63,6 +96,67 @@ namespace broker::adapters::primary
     private:
         std::shared_ptr<broker::ports::output ::IBrokerGateway> broker_;
 
+        /**
+         * @return имя неверного параметра или пустая строка
+         */
+        static std::string parseQuery(IRequest &req, domain::OrderQuery &query)
+        {
+            query.limit = DEFAULT_LIMIT;
+            if (auto limit = req.getQueryParam("limit"))
+            {
+                auto value = parseUnsigned(*limit);
+                if (!value || *value == 0)
+                    return "limit";
+                query.limit = std::min<size_t>(static_cast<size_t>(*value), MAX_LIMIT);
+            }
+            if (auto cursor = req.getQueryParam("cursor"))
+            {
+                query.after = domain::OrderCursor::decode(*cursor);
+                if (!query.after)
+                    return "cursor";
+            }
+            if (auto from = req.getQueryParam("from"))
+            {
+                query.from = parseTime(*from);
+                if (!query.from)
+                    return "from";
+            }
+            if (auto to = req.getQueryParam("to"))
+            {
+                query.to = parseTime(*to);
+                if (!query.to)
+                    return "to";
+            }
+            if (auto status = req.getQueryParam("status"))
+            {
+                try
+                {
+                    query.status = domain::orderStatusFromString(*status);
+                }
+                catch (const std::invalid_argument &)
+                {
+                    return "status";
+                }
+            }
+            return "";
+        }
+
+        static std::optional<uint64_t> parseUnsigned(const std::string &s)
+        {
+            if (s.empty() || s.size() > 18 ||
+                !std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                return std::nullopt;
+            return std::stoull(s);
+        }
+
+        static std::optional<std::chrono::system_clock::time_point> parseTime(const std::string &s)
+        {
+            auto ts = broker::domain::Timestamp::parseUtc(s);
+            if (!ts)
+                return std::nullopt;
+            return ts->value;
+        }
+
         nlohmann::json orderToJson(const broker::domain::Order &order)
         {
             nlohmann::json j;
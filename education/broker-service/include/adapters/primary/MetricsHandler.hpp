@@ -3,14 +3,33 @@
 #include <IHttpHandler.hpp>
 #include <IRequest.hpp>
 #include <IResponse.hpp>
+#include "adapters/secondary/PgConnectionPool.hpp"
+#include "adapters/secondary/QuoteWriteBehindSink.hpp"
+#include "adapters/secondary/ConflatingQuotePublisher.hpp"
+#include "adapters/secondary/events/RabbitMQAdapter.hpp"
+#include "application/OrderCommandHandler.hpp"
 #include <sstream>
 #include <mutex>
 #include <map>
+#include <memory>
 
 namespace broker::adapters::primary {
 
 class MetricsHandler : public IHttpHandler {
 public:
+    MetricsHandler(
+        std::shared_ptr<secondary::PgConnectionPool> dbPool,
+        std::shared_ptr<secondary::QuoteWriteBehindSink> quoteSink,
+        std::shared_ptr<application::OrderCommandHandler> orderPipeline,
+        std::shared_ptr<secondary::RabbitMQAdapter> rabbitMQ,
+        std::shared_ptr<secondary::ConflatingQuotePublisher> quotePublisher)
+        : dbPool_(std::move(dbPool))
+        , quoteSink_(std::move(quoteSink))
+        , orderPipeline_(std::move(orderPipeline))
+        , rabbitMQ_(std::move(rabbitMQ))
+        , quotePublisher_(std::move(quotePublisher))
+    {}
+
     void handle(IRequest& req, IResponse& res) override {
         res.setResult(200, "text/plain; version=0.0.4", serialize());
     }
@@ -29,6 +48,11 @@ public:
     }
 
 private:
+    std::shared_ptr<secondary::PgConnectionPool> dbPool_;
+    std::shared_ptr<secondary::QuoteWriteBehindSink> quoteSink_;
+    std::shared_ptr<application::OrderCommandHandler> orderPipeline_;
+    std::shared_ptr<secondary::RabbitMQAdapter> rabbitMQ_;
+    std::shared_ptr<secondary::ConflatingQuotePublisher> quotePublisher_;
     std::mutex mutex_;
     std::map<std::string, int64_t> counters_;
 
@@ -46,8 +70,217 @@ private:
             oss << key << " " << value << "\n";
         }
 
+        if (dbPool_) {
+            serializeDbPool(oss);
+        }
+        if (quoteSink_) {
+            serializeQuoteSink(oss);
+        }
+        if (orderPipeline_) {
+            serializeOrderPipeline(oss);
+        }
+        if (rabbitMQ_) {
+            serializeRabbitMQPublisher(oss);
+        }
+        if (quotePublisher_ && quotePublisher_->isEnabled()) {
+            serializeQuotePublisher(oss);
+        }
+
         return oss.str();
     }
+
+    void serializeDbPool(std::ostringstream& oss) const {
+        auto s = dbPool_->stats();
+
+        oss << "# HELP broker_db_pool_size Maximum DB connections in pool\n";
+        oss << "# TYPE broker_db_pool_size gauge\n";
+        oss << "broker_db_pool_size " << s.maxSize << "\n";
+
+        oss << "# HELP broker_db_pool_connections DB connections by state\n";
+        oss << "# TYPE broker_db_pool_connections gauge\n";
+        oss << "broker_db_pool_connections{state=\"idle\"} " << s.idle << "\n";
+        oss << "broker_db_pool_connections{state=\"in_use\"} " << s.inUse << "\n";
+
+        oss << "# HELP broker_db_pool_waiting Threads waiting for a DB connection\n";
+        oss << "# TYPE broker_db_pool_waiting gauge\n";
+        oss << "broker_db_pool_waiting " << s.waiting << "\n";
+
+        oss << "# HELP broker_db_pool_checkouts_total Total DB connection checkouts\n";
+        oss << "# TYPE broker_db_pool_checkouts_total counter\n";
+        oss << "broker_db_pool_checkouts_total " << s.checkouts << "\n";
+
+        oss << "# HELP broker_db_pool_waits_total Checkouts that had to wait for a free connection\n";
+        oss << "# TYPE broker_db_pool_waits_total counter\n";
+        oss << "broker_db_pool_waits_total " << s.waits << "\n";
+
+        oss << "# HELP broker_db_pool_timeouts_total Checkouts failed by timeout\n";
+        oss << "# TYPE broker_db_pool_timeouts_total counter\n";
+        oss << "broker_db_pool_timeouts_total " << s.timeouts << "\n";
+
+        oss << "# HELP broker_db_pool_connections_created_total DB connections opened\n";
+        oss << "# TYPE broker_db_pool_connections_created_total counter\n";
+        oss << "broker_db_pool_connections_created_total " << s.created << "\n";
+
+        oss << "# HELP broker_db_pool_connections_discarded_total Broken DB connections dropped\n";
+        oss << "# TYPE broker_db_pool_connections_discarded_total counter\n";
+        oss << "broker_db_pool_connections_discarded_total " << s.discarded << "\n";
+
+        oss << "# HELP broker_db_pool_wait_seconds_total Total time spent waiting for a connection\n";
+        oss << "# TYPE broker_db_pool_wait_seconds_total counter\n";
+        oss << "broker_db_pool_wait_seconds_total " << s.waitMicrosTotal / 1e6 << "\n";
+
+        oss << "# HELP broker_db_pool_checkout_seconds_total Total time connections were held\n";
+        oss << "# TYPE broker_db_pool_checkout_seconds_total counter\n";
+        oss << "broker_db_pool_checkout_seconds_total " << s.checkoutMicrosTotal / 1e6 << "\n";
+    }
+
+    void serializeQuoteSink(std::ostringstream& oss) const {
+        auto s = quoteSink_->stats();
+
+        oss << "# HELP broker_quote_sink_offered_total Quotes accepted by write-behind sink\n";
+        oss << "# TYPE broker_quote_sink_offered_total counter\n";
+        oss << "broker_quote_sink_offered_total " << s.offered << "\n";
+
+        oss << "# HELP broker_quote_sink_coalesced_total Quote writes coalesced before flush\n";
+        oss << "# TYPE broker_quote_sink_coalesced_total counter\n";
+        oss << "broker_quote_sink_coalesced_total " << s.coalesced << "\n";
+
+        oss << "# HELP broker_quote_sink_written_total Quote rows written to DB\n";
+        oss << "# TYPE broker_quote_sink_written_total counter\n";
+        oss << "broker_quote_sink_written_total " << s.written << "\n";
+
+        oss << "# HELP broker_quote_sink_flushes_total Quote flushes by result\n";
+        oss << "# TYPE broker_quote_sink_flushes_total counter\n";
+        oss << "broker_quote_sink_flushes_total{result=\"ok\"} " << s.flushes << "\n";
+        oss << "broker_quote_sink_flushes_total{result=\"error\"} " << s.failures << "\n";
+
+        oss << "# HELP broker_quote_sink_pending Quotes waiting for flush\n";
+        oss << "# TYPE broker_quote_sink_pending gauge\n";
+        oss << "broker_quote_sink_pending " << s.pending << "\n";
+
+        oss << "# HELP broker_quote_sink_flush_seconds Quote flush duration\n";
+        oss << "# TYPE broker_quote_sink_flush_seconds gauge\n";
+        oss << "broker_quote_sink_flush_seconds{stat=\"last\"} " << s.lastFlushMicros / 1e6 << "\n";
+        oss << "broker_quote_sink_flush_seconds{stat=\"max\"} " << s.maxFlushMicros / 1e6 << "\n";
+
+        oss << "# HELP broker_quote_sink_flush_seconds_total Total time spent flushing quotes\n";
+        oss << "# TYPE broker_quote_sink_flush_seconds_total counter\n";
+        oss << "broker_quote_sink_flush_seconds_total " << s.totalFlushMicros / 1e6 << "\n";
+    }
+
+    void serializeOrderPipeline(std::ostringstream& oss) const {
+        using application::OrderCommandHandler;
+        using application::pipeline::LatencyHistogram;
+        auto s = orderPipeline_->stats();
+
+        oss << "# HELP broker_order_pipeline_workers Order execution worker threads\n";
+        oss << "# TYPE broker_order_pipeline_workers gauge\n";
+        oss << "broker_order_pipeline_workers " << s.workers << "\n";
+
+        oss << "# HELP broker_order_pipeline_queue_capacity Capacity of each order pipeline queue\n";
+        oss << "# TYPE broker_order_pipeline_queue_capacity gauge\n";
+        oss << "broker_order_pipeline_queue_capacity " << s.queueCapacity << "\n";
+
+        oss << "# HELP broker_order_pipeline_queue_depth Commands waiting in order pipeline queues\n";
+        oss << "# TYPE broker_order_pipeline_queue_depth gauge\n";
+        oss << "broker_order_pipeline_queue_depth{queue=\"execute\"} " << s.executeQueueDepth << "\n";
+        oss << "broker_order_pipeline_queue_depth{queue=\"publish\"} " << s.publishQueueDepth << "\n";
+
+        oss << "# HELP broker_order_pipeline_in_flight Order commands received but not acknowledged\n";
+        oss << "# TYPE broker_order_pipeline_in_flight gauge\n";
+        oss << "broker_order_pipeline_in_flight " << s.inFlight << "\n";
+
+        oss << "# HELP broker_order_pipeline_commands_total Order commands by outcome\n";
+        oss << "# TYPE broker_order_pipeline_commands_total counter\n";
+        oss << "broker_order_pipeline_commands_total{result=\"received\"} " << s.received << "\n";
+        oss << "broker_order_pipeline_commands_total{result=\"completed\"} " << s.completed << "\n";
+        oss << "broker_order_pipeline_commands_total{result=\"decode_error\"} " << s.decodeErrors << "\n";
+
+        oss << "# HELP broker_order_pipeline_publish_batches_total Publish batches sent\n";
+        oss << "# TYPE broker_order_pipeline_publish_batches_total counter\n";
+        oss << "broker_order_pipeline_publish_batches_total " << s.publishBatches << "\n";
+
+        oss << "# HELP broker_order_pipeline_stage_seconds Order pipeline latency by stage\n";
+        oss << "# TYPE broker_order_pipeline_stage_seconds histogram\n";
+        for (size_t i = 0; i < OrderCommandHandler::STAGE_COUNT; ++i) {
+            std::string stage = OrderCommandHandler::toString(static_cast<OrderCommandHandler::Stage>(i));
+            const auto& h = s.latency[i];
+            for (size_t b = 0; b < LatencyHistogram::BOUND_COUNT; ++b) {
+                oss << "broker_order_pipeline_stage_seconds_bucket{stage=\"" << stage
+                    << "\",le=\"" << LatencyHistogram::BOUNDS_MICROS[b] / 1e6 << "\"} "
+                    << h.cumulative[b] << "\n";
+            }
+            oss << "broker_order_pipeline_stage_seconds_bucket{stage=\"" << stage
+                << "\",le=\"+Inf\"} " << h.count << "\n";
+            oss << "broker_order_pipeline_stage_seconds_sum{stage=\"" << stage << "\"} "
+                << h.sumMicros / 1e6 << "\n";
+            oss << "broker_order_pipeline_stage_seconds_count{stage=\"" << stage << "\"} "
+                << h.count << "\n";
+        }
+    }
+
+    void serializeRabbitMQPublisher(std::ostringstream& oss) const {
+        auto s = rabbitMQ_->publisherStats();
+
+        oss << "# HELP broker_rabbitmq_publish_queued Messages waiting to be written to the channel\n";
+        oss << "# TYPE broker_rabbitmq_publish_queued gauge\n";
+        oss << "broker_rabbitmq_publish_queued " << s.queued << "\n";
+
+        oss << "# HELP broker_rabbitmq_publish_in_flight Messages sent and awaiting publisher confirm\n";
+        oss << "# TYPE broker_rabbitmq_publish_in_flight gauge\n";
+        oss << "broker_rabbitmq_publish_in_flight " << s.inFlight << "\n";
+
+        oss << "# HELP broker_rabbitmq_published_total Published messages by outcome\n";
+        oss << "# TYPE broker_rabbitmq_published_total counter\n";
+        oss << "broker_rabbitmq_published_total{result=\"sent\"} " << s.sent << "\n";
+        oss << "broker_rabbitmq_published_total{result=\"confirmed\"} " << s.confirmed << "\n";
+        oss << "broker_rabbitmq_published_total{result=\"nacked\"} " << s.nacked << "\n";
+        oss << "broker_rabbitmq_published_total{result=\"dropped\"} " << s.dropped << "\n";
+    }
+
+    void serializeQuotePublisher(std::ostringstream& oss) const {
+        using secondary::ConflatingQuotePublisher;
+        auto s = quotePublisher_->stats();
+
+        oss << "# HELP broker_quote_fanout_offered_total Quote updates received from the ticker\n";
+        oss << "# TYPE broker_quote_fanout_offered_total counter\n";
+        oss << "broker_quote_fanout_offered_total " << s.offered << "\n";
+
+        oss << "# HELP broker_quote_fanout_published_total Quotes sent to subscribers (sum over subscribers)\n";
+        oss << "# TYPE broker_quote_fanout_published_total counter\n";
+        oss << "broker_quote_fanout_published_total " << s.published << "\n";
+
+        oss << "# HELP broker_quote_fanout_conflation_ratio Ticker updates per quote sent to one subscriber\n";
+        oss << "# TYPE broker_quote_fanout_conflation_ratio gauge\n";
+        double perSubscriber = s.subscribers > 0 ? static_cast<double>(s.published) / s.subscribers : 0.0;
+        oss << "broker_quote_fanout_conflation_ratio "
+            << (perSubscriber > 0 ? static_cast<double>(s.offered) / perSubscriber : 0.0) << "\n";
+
+        oss << "# HELP broker_quote_fanout_frames_total Quote frames by outcome\n";
+        oss << "# TYPE broker_quote_fanout_frames_total counter\n";
+        oss << "broker_quote_fanout_frames_total{result=\"delivered\"} " << s.frames << "\n";
+        oss << "broker_quote_fanout_frames_total{result=\"snapshot\"} " << s.snapshotFrames << "\n";
+        oss << "broker_quote_fanout_frames_total{result=\"skipped\"} " << s.skippedFrames << "\n";
+
+        oss << "# HELP broker_quote_fanout_frame_bytes Size of delivered quote frames\n";
+        oss << "# TYPE broker_quote_fanout_frame_bytes histogram\n";
+        for (size_t b = 0; b < ConflatingQuotePublisher::FRAME_BOUND_COUNT; ++b) {
+            oss << "broker_quote_fanout_frame_bytes_bucket{le=\""
+                << ConflatingQuotePublisher::FRAME_BOUNDS_BYTES[b] << "\"} "
+                << s.frameBytesCumulative[b] << "\n";
+        }
+        oss << "broker_quote_fanout_frame_bytes_bucket{le=\"+Inf\"} " << s.frames << "\n";
+        oss << "broker_quote_fanout_frame_bytes_sum " << s.frameBytes << "\n";
+        oss << "broker_quote_fanout_frame_bytes_count " << s.frames << "\n";
+
+        oss << "# HELP broker_quote_fanout_instruments Instruments in the quote snapshot\n";
+        oss << "# TYPE broker_quote_fanout_instruments gauge\n";
+        oss << "broker_quote_fanout_instruments " << s.instruments << "\n";
+
+        oss << "# HELP broker_quote_fanout_subscribers Quote frame subscribers\n";
+        oss << "# TYPE broker_quote_fanout_subscribers gauge\n";
+        oss << "broker_quote_fanout_subscribers " << s.subscribers << "\n";
+    }
 };
 
 } // namespace broker::adapters::primary
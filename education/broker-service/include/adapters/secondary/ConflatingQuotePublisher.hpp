@@ -0,0 +1,452 @@
+// include/adapters/secondary/ConflatingQuotePublisher.hpp
+#pragma once
+
+#include "ports/output/IEventPublisher.hpp"
+#include "ports/output/IEventConsumer.hpp"
+#include "settings/MarketDataSettings.hpp"
+#include "application/events/EventWireFormat.hpp"
+#include "domain/Quote.hpp"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Рассылка котировок с конфляцией (последняя котировка на FIGI)
+ *
+ * Тикер обновляет каждый инструмент каждые BROKER_TICK_INTERVAL_MS, и
+ * quote.updated на каждое обновление заваливал RabbitMQ и trading-service.
+ * Вместо этого:
+ * - offer() только запоминает последнюю котировку и помечает FIGI
+ *   "грязным" у каждого подписчика - без кодирования и без сети;
+ * - фоновый поток раз в BROKER_QUOTE_CONFLATION_MS отправляет каждому
+ *   подписчику одну пачку quote.batch с последними котировками
+ *   изменившихся FIGI (не больше BROKER_QUOTE_FRAME_MAX в фрейме);
+ * - подписчик, который не принял фрейм (медленный), ничего не копит:
+ *   его FIGI остаются помеченными, и в следующую пачку попадут уже
+ *   самые свежие цены - промежуточные обновления для него теряются;
+ * - новый подписчик сначала получает полный срез quote.snapshot.
+ *
+ * Подписчик по умолчанию - exchange RabbitMQ. Он считается медленным,
+ * пока у транспорта больше BROKER_QUOTE_MAX_BACKLOG неподтверждённых
+ * сообщений (IEventPublisher::pendingMessages). Полный срез в exchange
+ * можно запросить событием quote.snapshot.request.
+ *
+ * Фреймы нумеруются (seq) отдельно для каждого подписчика без пропусков:
+ * seq растёт только на принятых фреймах. Формат - JSON или
+ * wire::QuoteBatchFrame, как настроен транспорт (RABBITMQ_WIRE_FORMAT).
+ *
+ * @example
+ * ```cpp
+ * auto quotes = std::make_shared<ConflatingQuotePublisher>(publisher, consumer, settings);
+ * quotes->start();
+ * quotes->offer(quote);   // из тикера, не блокирует на сети
+ * quotes->stop();         // финальная пачка
+ * ```
+ *
+ * Thread-safe: да
+ */
+class ConflatingQuotePublisher {
+public:
+    /**
+     * @brief Получатель фреймов
+     * @return false - подписчик не успевает, фрейм не доставлен
+     */
+    using FrameSink = std::function<bool(const std::string& routingKey,
+                                         const std::string& payload,
+                                         const std::string& contentType)>;
+    using SubscriberId = uint64_t;
+
+    static constexpr size_t FRAME_BOUND_COUNT = 7;
+
+    /// Верхние границы корзин размера фрейма, байт
+    static constexpr std::array<uint64_t, FRAME_BOUND_COUNT> FRAME_BOUNDS_BYTES = {
+        256, 1024, 4096, 16384, 65536, 262144, 1048576
+    };
+
+    /**
+     * @brief Метрики рассылки (для /metrics)
+     */
+    struct Stats {
+        uint64_t offered = 0;          ///< Обновлений котировок от тикера
+        uint64_t published = 0;        ///< Котировок отправлено (сумма по подписчикам)
+        uint64_t frames = 0;           ///< Фреймов доставлено
+        uint64_t snapshotFrames = 0;   ///< Из них - полные срезы
+        uint64_t skippedFrames = 0;    ///< Не принято медленными подписчиками
+        uint64_t frameBytes = 0;       ///< Суммарный размер доставленных фреймов
+        std::array<uint64_t, FRAME_BOUND_COUNT> frameBytesCumulative{};   ///< Фреймов <= FRAME_BOUNDS_BYTES[i]
+        size_t instruments = 0;        ///< FIGI в срезе
+        size_t subscribers = 0;
+    };
+
+    ConflatingQuotePublisher(
+        std::shared_ptr<ports::output::IEventPublisher> eventPublisher,
+        std::shared_ptr<ports::output::IEventConsumer> eventConsumer,
+        std::shared_ptr<settings::MarketDataSettings> settings)
+        : eventPublisher_(std::move(eventPublisher))
+        , interval_(std::chrono::milliseconds(settings->getConflationMs()))
+        , frameMax_(static_cast<size_t>(settings->getFrameMax()))
+        , maxBacklog_(static_cast<size_t>(settings->getMaxBacklog()))
+        , binary_(eventPublisher_->binaryWireFormat())
+    {
+        if (!isEnabled()) {
+            std::cout << "[ConflatingQuotePublisher] Disabled, quote.updated per tick" << std::endl;
+            return;
+        }
+
+        exchangeSubscriber_ = subscribe([this](const std::string& routingKey,
+                                               const std::string& payload,
+                                               const std::string& contentType) {
+            if (eventPublisher_->pendingMessages() > maxBacklog_) {
+                return false;
+            }
+            eventPublisher_->publish(routingKey, payload, contentType);
+            return true;
+        });
+
+        if (eventConsumer) {
+            eventConsumer->subscribe({"quote.snapshot.request"},
+                [this](const std::string&, const std::string&) {
+                    std::cout << "[ConflatingQuotePublisher] quote.snapshot.request" << std::endl;
+                    publishSnapshot(exchangeSubscriber_);
+                });
+        }
+
+        std::cout << "[ConflatingQuotePublisher] Created, interval=" << interval_.count()
+                  << "ms, frameMax=" << frameMax_
+                  << ", maxBacklog=" << maxBacklog_
+                  << ", wire=" << (binary_ ? "binary" : "json") << std::endl;
+    }
+
+    ~ConflatingQuotePublisher() {
+        stop();
+    }
+
+    ConflatingQuotePublisher(const ConflatingQuotePublisher&) = delete;
+    ConflatingQuotePublisher& operator=(const ConflatingQuotePublisher&) = delete;
+
+    /**
+     * @brief Включена ли конфляция (BROKER_QUOTE_CONFLATION_MS > 0)
+     */
+    bool isEnabled() const {
+        return interval_.count() > 0;
+    }
+
+    /**
+     * @brief Запустить периодическую рассылку
+     */
+    void start() {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (running_ || !isEnabled()) {
+            return;
+        }
+        running_ = true;
+        thread_ = std::thread(&ConflatingQuotePublisher::run, this);
+        std::cout << "[ConflatingQuotePublisher] Started" << std::endl;
+    }
+
+    /**
+     * @brief Остановить рассылку, отправив накопленное
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        flush();
+        std::cout << "[ConflatingQuotePublisher] Stopped" << std::endl;
+    }
+
+    /**
+     * @brief Принять котировку (последняя по FIGI побеждает)
+     */
+    void offer(const domain::Quote& quote) {
+        offered_.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        book_.insert_or_assign(quote.figi, quote);
+        for (auto& [id, subscriber] : subscribers_) {
+            subscriber->dirty.insert(quote.figi);
+        }
+    }
+
+    /**
+     * @brief Добавить подписчика; он сразу получает полный срез
+     */
+    SubscriberId subscribe(FrameSink sink) {
+        std::lock_guard<std::mutex> sendLock(flushMutex_);
+
+        auto subscriber = std::make_shared<Subscriber>();
+        subscriber->sink = std::move(sink);
+
+        SubscriberId id;
+        std::vector<domain::Quote> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            id = nextId_++;
+            subscribers_.emplace(id, subscriber);
+            snapshot = collectAll();
+        }
+        deliver(*subscriber, snapshot, true);
+        return id;
+    }
+
+    void unsubscribe(SubscriberId id) {
+        std::lock_guard<std::mutex> sendLock(flushMutex_);
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers_.erase(id);
+    }
+
+    /**
+     * @brief Отправить подписчику полный срез вместо накопленных изменений
+     */
+    void publishSnapshot(SubscriberId id) {
+        std::lock_guard<std::mutex> sendLock(flushMutex_);
+
+        std::shared_ptr<Subscriber> subscriber;
+        std::vector<domain::Quote> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = subscribers_.find(id);
+            if (it == subscribers_.end()) {
+                return;
+            }
+            subscriber = it->second;
+            subscriber->dirty.clear();
+            snapshot = collectAll();
+        }
+        deliver(*subscriber, snapshot, true);
+    }
+
+    /**
+     * @brief Один раунд рассылки: изменения с прошлой пачки каждому подписчику
+     * @return Сколько котировок отправлено
+     */
+    size_t flush() {
+        std::lock_guard<std::mutex> sendLock(flushMutex_);
+
+        std::vector<std::pair<std::shared_ptr<Subscriber>, std::vector<domain::Quote>>> work;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [id, subscriber] : subscribers_) {
+                if (subscriber->dirty.empty()) {
+                    continue;
+                }
+                std::vector<domain::Quote> quotes;
+                quotes.reserve(subscriber->dirty.size());
+                for (const auto& figi : subscriber->dirty) {
+                    auto it = book_.find(figi);
+                    if (it != book_.end()) {
+                        quotes.push_back(it->second);
+                    }
+                }
+                subscriber->dirty.clear();
+                work.emplace_back(subscriber, std::move(quotes));
+            }
+        }
+
+        size_t sent = 0;
+        for (auto& [subscriber, quotes] : work) {
+            sent += deliver(*subscriber, quotes, false);
+        }
+        return sent;
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.offered = offered_.load(std::memory_order_relaxed);
+        s.published = published_.load(std::memory_order_relaxed);
+        s.frames = frames_.load(std::memory_order_relaxed);
+        s.snapshotFrames = snapshotFrames_.load(std::memory_order_relaxed);
+        s.skippedFrames = skippedFrames_.load(std::memory_order_relaxed);
+        s.frameBytes = frameBytes_.load(std::memory_order_relaxed);
+        uint64_t running = 0;
+        for (size_t i = 0; i < FRAME_BOUND_COUNT; ++i) {
+            running += frameBuckets_[i].load(std::memory_order_relaxed);
+            s.frameBytesCumulative[i] = running;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            s.instruments = book_.size();
+            s.subscribers = subscribers_.size();
+        }
+        return s;
+    }
+
+private:
+    struct Subscriber {
+        FrameSink sink;
+        std::unordered_set<std::string> dirty;   ///< Под mutex_
+        uint64_t seq = 0;                        ///< Под flushMutex_: последний доставленный фрейм
+    };
+
+    std::shared_ptr<ports::output::IEventPublisher> eventPublisher_;
+    const std::chrono::milliseconds interval_;
+    const size_t frameMax_;
+    const size_t maxBacklog_;
+    const bool binary_;
+    SubscriberId exchangeSubscriber_ = 0;
+
+    mutable std::mutex mutex_;                   ///< Защищает book_ и subscribers_
+    std::unordered_map<std::string, domain::Quote> book_;
+    std::map<SubscriberId, std::shared_ptr<Subscriber>> subscribers_;
+    SubscriberId nextId_ = 1;
+    std::mutex flushMutex_;                      ///< Один отправитель: порядок и seq фреймов
+
+    mutable std::mutex threadMutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool running_ = false;
+
+    std::atomic<uint64_t> offered_{0};
+    std::atomic<uint64_t> published_{0};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> snapshotFrames_{0};
+    std::atomic<uint64_t> skippedFrames_{0};
+    std::atomic<uint64_t> frameBytes_{0};
+    std::array<std::atomic<uint64_t>, FRAME_BOUND_COUNT + 1> frameBuckets_{};
+
+    void run() {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        while (running_) {
+            cv_.wait_for(lock, interval_, [this] { return !running_; });
+            if (!running_) {
+                break;
+            }
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    /// Под mutex_
+    std::vector<domain::Quote> collectAll() const {
+        std::vector<domain::Quote> quotes;
+        quotes.reserve(book_.size());
+        for (const auto& [figi, quote] : book_) {
+            quotes.push_back(quote);
+        }
+        return quotes;
+    }
+
+    /**
+     * @brief Отправить котировки фреймами по frameMax_ (под flushMutex_)
+     *
+     * Если подписчик отказал, оставшиеся FIGI снова помечаются грязными -
+     * следующая пачка возьмёт их самые свежие цены.
+     */
+    size_t deliver(Subscriber& subscriber, const std::vector<domain::Quote>& quotes, bool snapshot) {
+        const char* routingKey = snapshot ? "quote.snapshot" : "quote.batch";
+        size_t sent = 0;
+        while (sent < quotes.size()) {
+            size_t count = std::min(frameMax_, quotes.size() - sent);
+            std::string payload = encode(quotes, sent, count, subscriber.seq + 1, snapshot);
+            const char* contentType = binary_ ? application::wire::CONTENT_TYPE_BINARY
+                                              : application::wire::CONTENT_TYPE_JSON;
+
+            bool accepted = false;
+            try {
+                accepted = subscriber.sink(routingKey, payload, contentType);
+            } catch (const std::exception& e) {
+                std::cerr << "[ConflatingQuotePublisher] Sink error: " << e.what() << std::endl;
+            }
+            if (!accepted) {
+                skippedFrames_.fetch_add((quotes.size() - sent + frameMax_ - 1) / frameMax_,
+                                         std::memory_order_relaxed);
+                remark(subscriber, quotes, sent);
+                return sent;
+            }
+
+            ++subscriber.seq;
+            sent += count;
+            published_.fetch_add(count, std::memory_order_relaxed);
+            frames_.fetch_add(1, std::memory_order_relaxed);
+            if (snapshot) {
+                snapshotFrames_.fetch_add(1, std::memory_order_relaxed);
+            }
+            observeFrame(payload.size());
+        }
+        return sent;
+    }
+
+    void remark(Subscriber& subscriber, const std::vector<domain::Quote>& quotes, size_t from) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = from; i < quotes.size(); ++i) {
+            subscriber.dirty.insert(quotes[i].figi);
+        }
+    }
+
+    void observeFrame(size_t bytes) {
+        size_t bucket = 0;
+        while (bucket < FRAME_BOUND_COUNT && bytes > FRAME_BOUNDS_BYTES[bucket]) {
+            ++bucket;
+        }
+        frameBuckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        frameBytes_.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    std::string encode(const std::vector<domain::Quote>& quotes, size_t from, size_t count,
+                       uint64_t seq, bool snapshot) const {
+        if (binary_) {
+            application::wire::QuoteBatchFrame frame;
+            frame.seq = seq;
+            frame.snapshot = snapshot;
+            frame.quotes.reserve(count);
+            for (size_t i = from; i < from + count; ++i) {
+                const auto& quote = quotes[i];
+                application::wire::QuoteFrame q;
+                q.figi = quote.figi;
+                q.bid = quote.bidPrice.toDouble();
+                q.ask = quote.askPrice.toDouble();
+                q.last = quote.lastPrice.toDouble();
+                q.currency = quote.lastPrice.currency;
+                q.timestampMs = quote.updatedAt.toUnixMillis();
+                frame.quotes.push_back(q);
+            }
+            return application::wire::encode(frame);
+        }
+
+        nlohmann::json frame;
+        frame["seq"] = seq;
+        frame["snapshot"] = snapshot;
+        frame["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        auto& items = frame["quotes"] = nlohmann::json::array();
+        for (size_t i = from; i < from + count; ++i) {
+            const auto& quote = quotes[i];
+            items.push_back({
+                {"figi", quote.figi},
+                {"bid", quote.bidPrice.toDouble()},
+                {"ask", quote.askPrice.toDouble()},
+                {"last_price", quote.lastPrice.toDouble()},
+                {"currency", quote.lastPrice.currency},
+                {"timestamp", quote.updatedAt.toUnixMillis()}
+            });
+        }
+        return frame.dump();
+    }
+};
+
+} // namespace broker::adapters::secondary
@@ -2,7 +2,7 @@
 #pragma once
 
 #include "ports/output/IBrokerBalanceRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
 #include <memory>
 #include <iostream>
@@ -21,22 +21,19 @@ namespace broker::adapters::secondary {
  */
 class PostgresBrokerBalanceRepository : public ports::output::IBrokerBalanceRepository {
 public:
-    explicit PostgresBrokerBalanceRepository(std::shared_ptr<settings::DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresBrokerBalanceRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
         initSchema();
+        prepareStatements();
     }
 
     std::optional<domain::BrokerBalance> findByAccountId(const std::string& accountId) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT account_id, currency, available, reserved "
-                "FROM broker_balances WHERE account_id = $1",
-                accountId
-            );
+            auto result = txn.exec_prepared("balance_find_by_account", accountId);
             
             if (result.empty()) {
                 return std::nullopt;
@@ -58,17 +55,11 @@ public:
 
     void save(const domain::BrokerBalance& balance) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
-            
-            txn.exec_params(
-                "INSERT INTO broker_balances (account_id, currency, available, reserved, updated_at) "
-                "VALUES ($1, $2, $3, $4, NOW()) "
-                "ON CONFLICT (account_id) DO UPDATE SET "
-                "currency = EXCLUDED.currency, "
-                "available = EXCLUDED.available, "
-                "reserved = EXCLUDED.reserved, "
-                "updated_at = NOW()",
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            
+            txn.exec_prepared(
+                "balance_upsert",
                 balance.accountId,
                 balance.currency,
                 balance.available,
@@ -90,17 +81,12 @@ public:
     
     bool reserve(const std::string& accountId, int64_t amount) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             // Атомарное резервирование с проверкой
-            auto result = txn.exec_params(
-                "UPDATE broker_balances "
-                "SET available = available - $2, "
-                "    reserved = reserved + $2, "
-                "    updated_at = NOW() "
-                "WHERE account_id = $1 AND available >= $2 "
-                "RETURNING account_id",
+            auto result = txn.exec_prepared(
+                "balance_reserve",
                 accountId,
                 amount
             );
@@ -122,13 +108,11 @@ public:
     
     void commitReserved(const std::string& accountId, int64_t amount) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            txn.exec_params(
-                "UPDATE broker_balances "
-                "SET reserved = reserved - $2, updated_at = NOW() "
-                "WHERE account_id = $1",
+            txn.exec_prepared(
+                "balance_commit_reserved",
                 accountId,
                 amount
             );
@@ -143,15 +127,11 @@ public:
     
     void releaseReserved(const std::string& accountId, int64_t amount) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
-            
-            txn.exec_params(
-                "UPDATE broker_balances "
-                "SET available = available + $2, "
-                "    reserved = reserved - $2, "
-                "    updated_at = NOW() "
-                "WHERE account_id = $1",
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            
+            txn.exec_prepared(
+                "balance_release_reserved",
                 accountId,
                 amount
             );
@@ -165,12 +145,44 @@ public:
     }
 
 private:
-    std::shared_ptr<settings::DbSettings> settings_;
+    std::shared_ptr<PgConnectionPool> pool_;
+    
+    void prepareStatements() {
+        pool_->prepare("balance_find_by_account",
+            "SELECT account_id, currency, available, reserved "
+            "FROM broker_balances WHERE account_id = $1");
+        pool_->prepare("balance_upsert",
+            "INSERT INTO broker_balances (account_id, currency, available, reserved, updated_at) "
+            "VALUES ($1, $2, $3, $4, NOW()) "
+            "ON CONFLICT (account_id) DO UPDATE SET "
+            "currency = EXCLUDED.currency, "
+            "available = EXCLUDED.available, "
+            "reserved = EXCLUDED.reserved, "
+            "updated_at = NOW()");
+        // Атомарное резервирование с проверкой
+        pool_->prepare("balance_reserve",
+            "UPDATE broker_balances "
+            "SET available = available - $2, "
+            "    reserved = reserved + $2, "
+            "    updated_at = NOW() "
+            "WHERE account_id = $1 AND available >= $2 "
+            "RETURNING account_id");
+        pool_->prepare("balance_commit_reserved",
+            "UPDATE broker_balances "
+            "SET reserved = reserved - $2, updated_at = NOW() "
+            "WHERE account_id = $1");
+        pool_->prepare("balance_release_reserved",
+            "UPDATE broker_balances "
+            "SET available = available + $2, "
+            "    reserved = reserved - $2, "
+            "    updated_at = NOW() "
+            "WHERE account_id = $1");
+    }
     
     void initSchema() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             txn.exec(R"(
                 CREATE TABLE IF NOT EXISTS broker_balances (
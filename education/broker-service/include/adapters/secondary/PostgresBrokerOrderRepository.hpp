@@ -2,8 +2,9 @@
 #pragma once
 
 #include "ports/output/IBrokerOrderRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
+#include <chrono>
 #include <memory>
 #include <iostream>
 #include <vector>
@@ -11,12 +12,21 @@
 
 namespace broker::adapters::secondary {
 
+/**
+ * @brief Ордера брокера в PostgreSQL (таблица broker_orders)
+ *
+ * История аккаунта читается страницами по курсору (received_at, order_id)
+ * через индекс idx_broker_orders_account_history: страница стоит O(limit)
+ * независимо от того, сколько ордеров у аккаунта и какая это страница.
+ */
 class PostgresBrokerOrderRepository : public ports::output::IBrokerOrderRepository {
 public:
-    explicit PostgresBrokerOrderRepository(std::shared_ptr<settings::DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresBrokerOrderRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
         ensureExecutedPriceColumn();
+        ensureHistoryIndex();
+        prepareStatements();
         std::cout << "[PostgresBrokerOrderRepository] Initialized" << std::endl;
     }
 
@@ -24,18 +34,10 @@ public:
         std::vector<domain::BrokerOrder> orders;
         
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT order_id, account_id, figi, direction, "
-                "       quantity, filled_quantity, price, "
-                "       COALESCE(executed_price, price) as executed_price, "
-                "       order_type, status, reject_reason, received_at, updated_at "
-                "FROM broker_orders WHERE account_id = $1 "
-                "ORDER BY received_at DESC",
-                accountId
-            );
+            auto result = txn.exec_prepared("order_find_by_account", accountId);
             
             for (const auto& row : result) {
                 orders.push_back(rowToOrder(row));
@@ -50,19 +52,51 @@ public:
         return orders;
     }
 
+    std::vector<domain::BrokerOrder> findPage(
+        const std::string& accountId, const domain::OrderQuery& query) override
+    {
+        // Верхняя граница - меньшая из курсора и to: (to, "") отсекает
+        // всё, что получено в момент to и позже
+        std::optional<int64_t> upperUs;
+        std::string upperId;
+        if (query.to) {
+            upperUs = toMicros(*query.to);
+        }
+        if (query.after && (!upperUs || query.after->receivedAtUs < *upperUs)) {
+            upperUs = query.after->receivedAtUs;
+            upperId = query.after->orderId;
+        }
+
+        std::optional<int64_t> fromUs;
+        if (query.from) {
+            fromUs = toMicros(*query.from);
+        }
+        std::optional<std::string> status;
+        if (query.status) {
+            status = domain::toString(*query.status);
+        }
+
+        std::vector<domain::BrokerOrder> orders;
+        orders.reserve(query.limit);
+
+        auto conn = pool_->acquire();
+        pqxx::work txn(*conn);
+        auto result = txn.exec_prepared("order_find_page", accountId, fromUs, upperUs, upperId,
+                                        status, static_cast<int64_t>(query.limit));
+        for (const auto& row : result) {
+            orders.push_back(rowToOrder(row));
+        }
+        txn.commit();
+
+        return orders;
+    }
+
     std::optional<domain::BrokerOrder> findById(const std::string& orderId) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT order_id, account_id, figi, direction, "
-                "       quantity, filled_quantity, price, "
-                "       COALESCE(executed_price, price) as executed_price, "
-                "       order_type, status, reject_reason, received_at, updated_at "
-                "FROM broker_orders WHERE order_id = $1",
-                orderId
-            );
+            auto result = txn.exec_prepared("order_find_by_id", orderId);
             
             txn.commit();
             
@@ -79,20 +113,11 @@ public:
 
     void save(const domain::BrokerOrder& order) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            txn.exec_params(
-                "INSERT INTO broker_orders "
-                "(order_id, account_id, figi, direction, quantity, filled_quantity, "
-                " price, executed_price, order_type, status, reject_reason, received_at, updated_at) "
-                "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, NOW(), NOW()) "
-                "ON CONFLICT (order_id) DO UPDATE SET "
-                "filled_quantity = EXCLUDED.filled_quantity, "
-                "executed_price = EXCLUDED.executed_price, "
-                "status = EXCLUDED.status, "
-                "reject_reason = EXCLUDED.reject_reason, "
-                "updated_at = NOW()",
+            txn.exec_prepared(
+                "order_upsert",
                 order.orderId,
                 order.accountId,
                 order.figi,
@@ -117,13 +142,11 @@ public:
 
     void update(const domain::BrokerOrder& order) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            txn.exec_params(
-                "UPDATE broker_orders SET "
-                "filled_quantity = $1, executed_price = $2, status = $3, updated_at = NOW() "
-                "WHERE order_id = $4",
+            txn.exec_prepared(
+                "order_update",
                 order.executedLots,
                 order.executedPrice,
                 order.status,
@@ -138,15 +161,64 @@ public:
     }
 
 private:
-    std::shared_ptr<settings::DbSettings> settings_;
+    std::shared_ptr<PgConnectionPool> pool_;
+
+    static constexpr const char* ORDER_COLUMNS =
+        "SELECT order_id, account_id, figi, direction, "
+        "       quantity, filled_quantity, price, "
+        "       COALESCE(executed_price, price) as executed_price, "
+        "       order_type, status, reject_reason, received_at, updated_at, "
+        "       (EXTRACT(EPOCH FROM received_at) * 1000000)::BIGINT AS received_us "
+        "FROM broker_orders ";
+
+    static int64_t toMicros(std::chrono::system_clock::time_point tp) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch()).count();
+    }
+
+    void prepareStatements() {
+        pool_->prepare("order_find_by_account",
+            std::string(ORDER_COLUMNS) +
+            "WHERE account_id = $1 "
+            "ORDER BY received_at DESC");
+        // NULL-границы заменяются на ±infinity, чтобы обе оставались
+        // условиями индекса и в generic-плане prepared statement
+        pool_->prepare("order_find_page",
+            std::string(ORDER_COLUMNS) +
+            "WHERE account_id = $1 "
+            "AND received_at >= COALESCE(TIMESTAMP 'epoch' + $2::BIGINT * INTERVAL '1 microsecond', "
+            "                            TIMESTAMP '-infinity') "
+            "AND (received_at, order_id) < "
+            "    (COALESCE(TIMESTAMP 'epoch' + $3::BIGINT * INTERVAL '1 microsecond', "
+            "              TIMESTAMP 'infinity'), $4::TEXT) "
+            "AND ($5::TEXT IS NULL OR status = $5) "
+            "ORDER BY received_at DESC, order_id DESC "
+            "LIMIT $6");
+        pool_->prepare("order_find_by_id",
+            std::string(ORDER_COLUMNS) + "WHERE order_id = $1");
+        pool_->prepare("order_upsert",
+            "INSERT INTO broker_orders "
+            "(order_id, account_id, figi, direction, quantity, filled_quantity, "
+            " price, executed_price, order_type, status, reject_reason, received_at, updated_at) "
+            "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, NOW(), NOW()) "
+            "ON CONFLICT (order_id) DO UPDATE SET "
+            "filled_quantity = EXCLUDED.filled_quantity, "
+            "executed_price = EXCLUDED.executed_price, "
+            "status = EXCLUDED.status, "
+            "reject_reason = EXCLUDED.reject_reason, "
+            "updated_at = NOW()");
+        pool_->prepare("order_update",
+            "UPDATE broker_orders SET "
+            "filled_quantity = $1, executed_price = $2, status = $3, updated_at = NOW() "
+            "WHERE order_id = $4");
+    }
 
     /**
      * @brief Добавляет колонку executed_price если её нет (миграция)
      */
     void ensureExecutedPriceColumn() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             // Добавляем колонку если её нет
             txn.exec(R"(
@@ -163,6 +235,24 @@ private:
         }
     }
 
+    /**
+     * @brief Индекс под постраничную историю (миграция для существующих БД)
+     */
+    void ensureHistoryIndex() {
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            txn.exec(R"(
+                CREATE INDEX IF NOT EXISTS idx_broker_orders_account_history
+                ON broker_orders (account_id, received_at DESC, order_id DESC)
+            )");
+            txn.commit();
+        } catch (const std::exception& e) {
+            std::cerr << "[PostgresBrokerOrderRepository] ensureHistoryIndex: "
+                      << e.what() << std::endl;
+        }
+    }
+
     domain::BrokerOrder rowToOrder(const pqxx::row& row) const {
         domain::BrokerOrder order;
         order.orderId = row["order_id"].as<std::string>();
@@ -177,6 +267,7 @@ private:
         order.status = row["status"].as<std::string>();
         order.createdAt = row["received_at"].is_null() ? "" : row["received_at"].as<std::string>();
         order.updatedAt = row["updated_at"].is_null() ? "" : row["updated_at"].as<std::string>();
+        order.receivedAtUs = row["received_us"].is_null() ? 0 : row["received_us"].as<int64_t>();
         return order;
     }
 };
@@ -2,7 +2,7 @@
 #pragma once
 
 #include "ports/output/IBrokerPositionRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
 #include <memory>
 #include <iostream>
@@ -16,10 +16,11 @@ namespace broker::adapters::secondary {
  */
 class PostgresBrokerPositionRepository : public ports::output::IBrokerPositionRepository {
 public:
-    explicit PostgresBrokerPositionRepository(std::shared_ptr<settings::DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresBrokerPositionRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
         // Схема создаётся в init.sql, не здесь
+        prepareStatements();
         std::cout << "[PostgresBrokerPositionRepository] Initialized" << std::endl;
     }
 
@@ -27,14 +28,10 @@ public:
         std::vector<domain::BrokerPosition> positions;
         
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT account_id, figi, quantity, avg_price "
-                "FROM broker_positions WHERE account_id = $1",
-                accountId
-            );
+            auto result = txn.exec_prepared("position_find_by_account", accountId);
             
             for (const auto& row : result) {
                 domain::BrokerPosition pos;
@@ -61,14 +58,10 @@ public:
         const std::string& figi) override 
     {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT account_id, figi, quantity, avg_price "
-                "FROM broker_positions WHERE account_id = $1 AND figi = $2",
-                accountId, figi
-            );
+            auto result = txn.exec_prepared("position_find_by_account_figi", accountId, figi);
             
             txn.commit();
             
@@ -92,19 +85,14 @@ public:
 
     void save(const domain::BrokerPosition& position) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             // avg_price в БД в копейках
             int64_t avgPriceKopeks = static_cast<int64_t>(position.averagePrice * 100);
             
-            txn.exec_params(
-                "INSERT INTO broker_positions (account_id, figi, quantity, avg_price, updated_at) "
-                "VALUES ($1, $2, $3, $4, NOW()) "
-                "ON CONFLICT (account_id, figi) DO UPDATE SET "
-                "quantity = EXCLUDED.quantity, "
-                "avg_price = EXCLUDED.avg_price, "
-                "updated_at = NOW()",
+            txn.exec_prepared(
+                "position_upsert",
                 position.accountId,
                 position.figi,
                 position.quantity,
@@ -123,12 +111,28 @@ public:
     }
 
 private:
-    std::shared_ptr<settings::DbSettings> settings_;
+    std::shared_ptr<PgConnectionPool> pool_;
+
+    void prepareStatements() {
+        pool_->prepare("position_find_by_account",
+            "SELECT account_id, figi, quantity, avg_price "
+            "FROM broker_positions WHERE account_id = $1");
+        pool_->prepare("position_find_by_account_figi",
+            "SELECT account_id, figi, quantity, avg_price "
+            "FROM broker_positions WHERE account_id = $1 AND figi = $2");
+        pool_->prepare("position_upsert",
+            "INSERT INTO broker_positions (account_id, figi, quantity, avg_price, updated_at) "
+            "VALUES ($1, $2, $3, $4, NOW()) "
+            "ON CONFLICT (account_id, figi) DO UPDATE SET "
+            "quantity = EXCLUDED.quantity, "
+            "avg_price = EXCLUDED.avg_price, "
+            "updated_at = NOW()");
+    }
 
     void initSchema() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             txn.exec(R"(
                 CREATE TABLE IF NOT EXISTS broker_positions (
@@ -2,7 +2,7 @@
 #pragma once
 
 #include "ports/output/IInstrumentRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
 #include <memory>
 #include <iostream>
@@ -22,24 +22,22 @@ namespace broker::adapters::secondary {
  */
 class PostgresInstrumentRepository : public ports::output::IInstrumentRepository {
 public:
-    explicit PostgresInstrumentRepository(std::shared_ptr<settings::DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresInstrumentRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
         initSchema();
         seedInstruments();
+        prepareStatements();
     }
 
     std::vector<domain::Instrument> findAll() override {
         std::vector<domain::Instrument> instruments;
         
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec(
-                "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
-                "FROM instruments ORDER BY ticker"
-            );
+            auto result = txn.exec_prepared("instrument_find_all");
             
             for (const auto& row : result) {
                 domain::Instrument instr;
@@ -64,14 +62,10 @@ public:
 
     std::optional<domain::Instrument> findByFigi(const std::string& figi) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec_params(
-                "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
-                "FROM instruments WHERE figi = $1",
-                figi
-            );
+            auto result = txn.exec_prepared("instrument_find_by_figi", figi);
             
             if (result.empty()) {
                 return std::nullopt;
@@ -97,20 +91,13 @@ public:
 
     void save(const domain::Instrument& instrument) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             int64_t minIncCents = static_cast<int64_t>(instrument.minPriceIncrement.toDouble() * 100);
             
-            txn.exec_params(
-                "INSERT INTO instruments (figi, ticker, name, currency, lot_size, min_price_increment) "
-                "VALUES ($1, $2, $3, $4, $5, $6) "
-                "ON CONFLICT (figi) DO UPDATE SET "
-                "ticker = EXCLUDED.ticker, "
-                "name = EXCLUDED.name, "
-                "currency = EXCLUDED.currency, "
-                "lot_size = EXCLUDED.lot_size, "
-                "min_price_increment = EXCLUDED.min_price_increment",
+            txn.exec_prepared(
+                "instrument_upsert",
                 instrument.figi,
                 instrument.ticker,
                 instrument.name,
@@ -135,18 +122,12 @@ public:
         std::vector<domain::Instrument> instruments;
         
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             std::string pattern = "%" + query + "%";
             
-            auto result = txn.exec_params(
-                "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
-                "FROM instruments "
-                "WHERE LOWER(ticker) LIKE LOWER($1) OR LOWER(name) LIKE LOWER($1) "
-                "ORDER BY ticker",
-                pattern
-            );
+            auto result = txn.exec_prepared("instrument_search", pattern);
             
             for (const auto& row : result) {
                 domain::Instrument instr;
@@ -170,12 +151,35 @@ public:
     }
 
 private:
-    std::shared_ptr<settings::DbSettings> settings_;
+    std::shared_ptr<PgConnectionPool> pool_;
+    
+    void prepareStatements() {
+        pool_->prepare("instrument_find_all",
+            "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
+            "FROM instruments ORDER BY ticker");
+        pool_->prepare("instrument_find_by_figi",
+            "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
+            "FROM instruments WHERE figi = $1");
+        pool_->prepare("instrument_upsert",
+            "INSERT INTO instruments (figi, ticker, name, currency, lot_size, min_price_increment) "
+            "VALUES ($1, $2, $3, $4, $5, $6) "
+            "ON CONFLICT (figi) DO UPDATE SET "
+            "ticker = EXCLUDED.ticker, "
+            "name = EXCLUDED.name, "
+            "currency = EXCLUDED.currency, "
+            "lot_size = EXCLUDED.lot_size, "
+            "min_price_increment = EXCLUDED.min_price_increment");
+        pool_->prepare("instrument_search",
+            "SELECT figi, ticker, name, currency, lot_size, min_price_increment "
+            "FROM instruments "
+            "WHERE LOWER(ticker) LIKE LOWER($1) OR LOWER(name) LIKE LOWER($1) "
+            "ORDER BY ticker");
+    }
     
     void initSchema() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             txn.exec(R"(
                 CREATE TABLE IF NOT EXISTS instruments (
@@ -198,8 +202,8 @@ private:
     
     void seedInstruments() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             // Проверяем есть ли данные
             auto count = txn.exec("SELECT COUNT(*) FROM instruments");
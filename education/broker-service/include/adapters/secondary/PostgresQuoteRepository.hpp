@@ -2,7 +2,7 @@
 #pragma once
 
 #include "ports/output/IQuoteRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include <pqxx/pqxx>
 #include <memory>
 #include <iostream>
@@ -21,24 +21,19 @@ namespace broker::adapters::secondary {
  */
 class PostgresQuoteRepository : public ports::output::IQuoteRepository {
 public:
-    explicit PostgresQuoteRepository(std::shared_ptr<settings::DbSettings> settings)
-        : settings_(std::move(settings))
+    explicit PostgresQuoteRepository(std::shared_ptr<PgConnectionPool> pool)
+        : pool_(std::move(pool))
     {
         initSchema();
+        prepareStatements();
     }
 
     std::optional<domain::Quote> findByFigi(const std::string& figi) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
-            
-            auto result = txn.exec_params(
-                "SELECT q.figi, i.ticker, q.bid, q.ask, q.last_price, q.updated_at "
-                "FROM quotes q "
-                "LEFT JOIN instruments i ON q.figi = i.figi "
-                "WHERE q.figi = $1",
-                figi
-            );
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            
+            auto result = txn.exec_prepared("quote_find_by_figi", figi);
             
             if (result.empty()) {
                 return std::nullopt;
@@ -67,22 +62,16 @@ public:
 
     void save(const domain::Quote& quote) override {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             // Конвертируем Money в копейки
             int64_t bidCents = static_cast<int64_t>(quote.bidPrice.toDouble() * 100);
             int64_t askCents = static_cast<int64_t>(quote.askPrice.toDouble() * 100);
             int64_t lastCents = static_cast<int64_t>(quote.lastPrice.toDouble() * 100);
             
-            txn.exec_params(
-                "INSERT INTO quotes (figi, bid, ask, last_price, updated_at) "
-                "VALUES ($1, $2, $3, $4, NOW()) "
-                "ON CONFLICT (figi) DO UPDATE SET "
-                "bid = EXCLUDED.bid, "
-                "ask = EXCLUDED.ask, "
-                "last_price = EXCLUDED.last_price, "
-                "updated_at = NOW()",
+            txn.exec_prepared(
+                "quote_upsert",
                 quote.figi,
                 bidCents,
                 askCents,
@@ -97,6 +86,44 @@ public:
         }
     }
     
+    /**
+     * @brief Multi-row UPSERT пачки котировок одним запросом
+     *
+     * Массивы разворачиваются через unnest, поэтому один prepared statement
+     * подходит для пачки любого размера. FIGI в пачке должны быть уникальны
+     * (ON CONFLICT не может обновить строку дважды).
+     */
+    void saveBatch(const std::vector<domain::Quote>& quotes) override {
+        if (quotes.empty()) {
+            return;
+        }
+        
+        std::vector<std::string> figis;
+        std::vector<int64_t> bids, asks, lasts;
+        figis.reserve(quotes.size());
+        bids.reserve(quotes.size());
+        asks.reserve(quotes.size());
+        lasts.reserve(quotes.size());
+        
+        for (const auto& quote : quotes) {
+            figis.push_back(quote.figi);
+            bids.push_back(static_cast<int64_t>(quote.bidPrice.toDouble() * 100));
+            asks.push_back(static_cast<int64_t>(quote.askPrice.toDouble() * 100));
+            lasts.push_back(static_cast<int64_t>(quote.lastPrice.toDouble() * 100));
+        }
+        
+        try {
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
+            txn.exec_prepared("quote_upsert_batch", figis, bids, asks, lasts);
+            txn.commit();
+            
+        } catch (const std::exception& e) {
+            std::cerr << "[PostgresQuoteRepository] saveBatch error: " << e.what() << std::endl;
+            throw;
+        }
+    }
+    
     /**
      * @brief Получить все котировки
      */
@@ -104,14 +131,10 @@ public:
         std::vector<domain::Quote> quotes;
         
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
-            auto result = txn.exec(
-                "SELECT q.figi, i.ticker, q.bid, q.ask, q.last_price "
-                "FROM quotes q "
-                "LEFT JOIN instruments i ON q.figi = i.figi"
-            );
+            auto result = txn.exec_prepared("quote_find_all");
             
             for (const auto& row : result) {
                 domain::Quote quote;
@@ -137,12 +160,42 @@ public:
     }
 
 private:
-    std::shared_ptr<settings::DbSettings> settings_;
+    std::shared_ptr<PgConnectionPool> pool_;
+    
+    void prepareStatements() {
+        pool_->prepare("quote_find_by_figi",
+            "SELECT q.figi, i.ticker, q.bid, q.ask, q.last_price, q.updated_at "
+            "FROM quotes q "
+            "LEFT JOIN instruments i ON q.figi = i.figi "
+            "WHERE q.figi = $1");
+        pool_->prepare("quote_upsert",
+            "INSERT INTO quotes (figi, bid, ask, last_price, updated_at) "
+            "VALUES ($1, $2, $3, $4, NOW()) "
+            "ON CONFLICT (figi) DO UPDATE SET "
+            "bid = EXCLUDED.bid, "
+            "ask = EXCLUDED.ask, "
+            "last_price = EXCLUDED.last_price, "
+            "updated_at = NOW()");
+        pool_->prepare("quote_upsert_batch",
+            "INSERT INTO quotes (figi, bid, ask, last_price, updated_at) "
+            "SELECT t.figi, t.bid, t.ask, t.last_price, NOW() "
+            "FROM unnest($1::varchar[], $2::bigint[], $3::bigint[], $4::bigint[]) "
+            "AS t(figi, bid, ask, last_price) "
+            "ON CONFLICT (figi) DO UPDATE SET "
+            "bid = EXCLUDED.bid, "
+            "ask = EXCLUDED.ask, "
+            "last_price = EXCLUDED.last_price, "
+            "updated_at = NOW()");
+        pool_->prepare("quote_find_all",
+            "SELECT q.figi, i.ticker, q.bid, q.ask, q.last_price "
+            "FROM quotes q "
+            "LEFT JOIN instruments i ON q.figi = i.figi");
+    }
     
     void initSchema() {
         try {
-            pqxx::connection conn(settings_->getConnectionString());
-            pqxx::work txn(conn);
+            auto conn = pool_->acquire();
+            pqxx::work txn(*conn);
             
             txn.exec(R"(
                 CREATE TABLE IF NOT EXISTS quotes (
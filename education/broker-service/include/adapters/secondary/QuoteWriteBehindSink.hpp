@@ -0,0 +1,236 @@
+// include/adapters/secondary/QuoteWriteBehindSink.hpp
+#pragma once
+
+#include "ports/output/IQuoteRepository.hpp"
+#include "settings/BrokerSettings.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Write-behind запись котировок в БД
+ *
+ * Тикер генерирует котировку на каждый инструмент каждые
+ * BROKER_TICK_INTERVAL_MS (100 мс), и синхронный UPSERT на каждый тик
+ * тормозил генерацию цен. Sink принимает котировки без обращения к БД:
+ * - хранит только последнюю котировку на FIGI (промежуточные схлопываются);
+ * - фоновый поток раз в BROKER_QUOTE_FLUSH_INTERVAL_MS пишет пачку
+ *   через IQuoteRepository::saveBatch (один multi-row UPSERT);
+ * - при ошибке записи пачка возвращается в буфер, если по FIGI
+ *   ещё не пришла более свежая котировка.
+ *
+ * @example
+ * ```cpp
+ * auto sink = std::make_shared<QuoteWriteBehindSink>(quoteRepo, brokerSettings);
+ * sink->start();
+ * sink->offer(quote);   // не блокирует на БД
+ * sink->stop();         // финальный flush
+ * ```
+ *
+ * Thread-safe: да
+ */
+class QuoteWriteBehindSink {
+public:
+    /**
+     * @brief Метрики sink'а (для /metrics)
+     */
+    struct Stats {
+        uint64_t offered = 0;           ///< Принято котировок
+        uint64_t coalesced = 0;         ///< Перезаписано до flush (сэкономлено записей)
+        uint64_t written = 0;           ///< Записано строк в БД
+        uint64_t flushes = 0;           ///< Успешных flush
+        uint64_t failures = 0;          ///< Неудачных flush
+        uint64_t lastFlushMicros = 0;   ///< Длительность последнего flush
+        uint64_t maxFlushMicros = 0;    ///< Максимальная длительность flush
+        uint64_t totalFlushMicros = 0;  ///< Суммарная длительность flush
+        size_t pending = 0;             ///< Котировок ждут записи
+    };
+
+    QuoteWriteBehindSink(
+        std::shared_ptr<ports::output::IQuoteRepository> quoteRepo,
+        std::shared_ptr<settings::BrokerSettings> settings)
+        : quoteRepo_(std::move(quoteRepo))
+        , interval_(std::chrono::milliseconds(settings->getQuoteFlushIntervalMs()))
+    {}
+
+    ~QuoteWriteBehindSink() {
+        stop();
+        flush();  // если поток не запускался
+    }
+
+    QuoteWriteBehindSink(const QuoteWriteBehindSink&) = delete;
+    QuoteWriteBehindSink& operator=(const QuoteWriteBehindSink&) = delete;
+
+    /**
+     * @brief Запустить фоновый flush
+     */
+    void start() {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        if (running_) {
+            return;
+        }
+        running_ = true;
+        thread_ = std::thread(&QuoteWriteBehindSink::run, this);
+        std::cout << "[QuoteWriteBehindSink] Started, flush interval="
+                  << interval_.count() << "ms" << std::endl;
+    }
+
+    /**
+     * @brief Остановить фоновый flush и записать остаток
+     */
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            if (!running_) {
+                return;
+            }
+            running_ = false;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        flush();
+        std::cout << "[QuoteWriteBehindSink] Stopped" << std::endl;
+    }
+
+    bool isRunning() const {
+        std::lock_guard<std::mutex> lock(threadMutex_);
+        return running_;
+    }
+
+    /**
+     * @brief Принять котировку (последняя по FIGI побеждает)
+     */
+    void offer(const domain::Quote& quote) {
+        offered_.fetch_add(1, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto [it, inserted] = pending_.try_emplace(quote.figi, quote);
+        if (!inserted) {
+            it->second = quote;
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Записать накопленные котировки одной пачкой
+     * @return Количество записанных котировок
+     */
+    size_t flush() {
+        std::lock_guard<std::mutex> flushLock(flushMutex_);
+
+        std::unordered_map<std::string, domain::Quote> batch;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.empty()) {
+                return 0;
+            }
+            batch.swap(pending_);
+        }
+
+        std::vector<domain::Quote> quotes;
+        quotes.reserve(batch.size());
+        for (auto& [figi, quote] : batch) {
+            quotes.push_back(std::move(quote));
+        }
+
+        auto started = std::chrono::steady_clock::now();
+        try {
+            quoteRepo_->saveBatch(quotes);
+        } catch (const std::exception& e) {
+            std::cerr << "[QuoteWriteBehindSink] flush error: " << e.what() << std::endl;
+            failures_.fetch_add(1, std::memory_order_relaxed);
+            requeue(quotes);
+            return 0;
+        }
+        auto micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - started).count());
+
+        flushes_.fetch_add(1, std::memory_order_relaxed);
+        written_.fetch_add(quotes.size(), std::memory_order_relaxed);
+        lastFlushMicros_.store(micros, std::memory_order_relaxed);
+        totalFlushMicros_.fetch_add(micros, std::memory_order_relaxed);
+        if (micros > maxFlushMicros_.load(std::memory_order_relaxed)) {
+            maxFlushMicros_.store(micros, std::memory_order_relaxed);
+        }
+
+        return quotes.size();
+    }
+
+    /**
+     * @brief Текущие метрики
+     */
+    Stats stats() const {
+        Stats s;
+        s.offered = offered_.load(std::memory_order_relaxed);
+        s.coalesced = coalesced_.load(std::memory_order_relaxed);
+        s.written = written_.load(std::memory_order_relaxed);
+        s.flushes = flushes_.load(std::memory_order_relaxed);
+        s.failures = failures_.load(std::memory_order_relaxed);
+        s.lastFlushMicros = lastFlushMicros_.load(std::memory_order_relaxed);
+        s.maxFlushMicros = maxFlushMicros_.load(std::memory_order_relaxed);
+        s.totalFlushMicros = totalFlushMicros_.load(std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            s.pending = pending_.size();
+        }
+        return s;
+    }
+
+private:
+    std::shared_ptr<ports::output::IQuoteRepository> quoteRepo_;
+    std::chrono::milliseconds interval_;
+
+    mutable std::mutex mutex_;                                   ///< Защищает pending_
+    std::unordered_map<std::string, domain::Quote> pending_;
+    std::mutex flushMutex_;                                      ///< Один flush за раз
+
+    mutable std::mutex threadMutex_;
+    std::condition_variable cv_;
+    std::thread thread_;
+    bool running_ = false;
+
+    std::atomic<uint64_t> offered_{0};
+    std::atomic<uint64_t> coalesced_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> flushes_{0};
+    std::atomic<uint64_t> failures_{0};
+    std::atomic<uint64_t> lastFlushMicros_{0};
+    std::atomic<uint64_t> maxFlushMicros_{0};
+    std::atomic<uint64_t> totalFlushMicros_{0};
+
+    void run() {
+        std::unique_lock<std::mutex> lock(threadMutex_);
+        while (running_) {
+            cv_.wait_for(lock, interval_, [this] { return !running_; });
+            if (!running_) {
+                break;
+            }
+            lock.unlock();
+            flush();
+            lock.lock();
+        }
+    }
+
+    /**
+     * @brief Вернуть неудачную пачку в буфер, не затирая более свежие котировки
+     */
+    void requeue(const std::vector<domain::Quote>& quotes) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& quote : quotes) {
+            pending_.try_emplace(quote.figi, quote);
+        }
+    }
+};
+
+} // namespace broker::adapters::secondary
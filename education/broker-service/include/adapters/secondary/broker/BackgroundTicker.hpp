@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -27,8 +28,18 @@ struct QuoteUpdate {
 
 using QuoteUpdateCallback = std::function<void(const QuoteUpdate&)>;
 
+/**
+ * @brief Callback на весь пакет котировок одного тика
+ */
+using QuoteBatchCallback = std::function<void(const std::vector<QuoteUpdate>&)>;
+
 /**
  * @brief Фоновый поток для симуляции рынка
+ * 
+ * Каждый тик двигает цены всех инструментов одним вызовом
+ * PriceSimulator::tickBatch и собирает непрерывный пакет QuoteUpdate.
+ * InstrumentId кэшируются и пересобираются только при
+ * addInstrument/removeInstrument.
  */
 class BackgroundTicker {
 public:
@@ -54,6 +65,7 @@ public:
     void addInstrument(const std::string& figi) {
         std::lock_guard<std::mutex> lock(mutex_);
         instruments_.push_back(figi);
+        ++instrumentsVersion_;
     }
     
     void removeInstrument(const std::string& figi) {
@@ -61,6 +73,7 @@ public:
         instruments_.erase(
             std::remove(instruments_.begin(), instruments_.end(), figi),
             instruments_.end());
+        ++instrumentsVersion_;
     }
     
     void setQuoteCallback(QuoteUpdateCallback callback) {
@@ -68,6 +81,14 @@ public:
         quoteCallback_ = std::move(callback);
     }
     
+    /**
+     * @brief Callback на весь пакет котировок тика (вызывается до поштучного)
+     */
+    void setBatchCallback(QuoteBatchCallback callback) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batchCallback_ = std::move(callback);
+    }
+    
     void setInterval(std::chrono::milliseconds interval) {
         interval_ = interval;
     }
@@ -102,6 +123,17 @@ public:
     void manualTick() {
         doTick();
     }
+    
+    /**
+     * @brief Сдвинуть цены всех инструментов и вернуть пакет котировок
+     * 
+     * Только шаг цен: без callback'ов и обработки pending-ордеров.
+     * Ссылка действительна до следующего тика.
+     */
+    const std::vector<QuoteUpdate>& tickBatch() {
+        std::lock_guard<std::mutex> lock(tickMutex_);
+        return advancePrices();
+    }
 
 private:
     std::shared_ptr<PriceSimulator> priceSimulator_;
@@ -112,36 +144,41 @@ private:
     std::thread thread_;
     mutable std::mutex mutex_;
     std::vector<std::string> instruments_;
+    uint64_t instrumentsVersion_ = 0;
     QuoteUpdateCallback quoteCallback_;
+    QuoteBatchCallback batchCallback_;
     MarketScenario defaultScenario_ = MarketScenario::realistic();
     
+    // Состояние тика (под tickMutex_)
+    std::mutex tickMutex_;
+    uint64_t cachedVersion_ = UINT64_MAX;
+    std::vector<std::string> tickFigis_;
+    std::vector<PriceSimulator::InstrumentId> tickIds_;
+    std::vector<std::string> unresolved_;
+    std::vector<PriceSimulator::BatchQuote> quotes_;
+    std::vector<QuoteUpdate> batch_;
+    
     void doTick() {
-        std::vector<std::string> currentInstruments;
-        QuoteUpdateCallback currentCallback;
+        std::lock_guard<std::mutex> tickLock(tickMutex_);
         
+        QuoteUpdateCallback currentCallback;
+        QuoteBatchCallback currentBatchCallback;
         {
             std::lock_guard<std::mutex> lock(mutex_);
-            currentInstruments = instruments_;
             currentCallback = quoteCallback_;
+            currentBatchCallback = batchCallback_;
         }
         
         // 1. Tick all instruments
-        for (const auto& figi : currentInstruments) {
-            priceSimulator_->tick(figi);
-            
-            // 2. Notify about quote update
-            if (currentCallback) {
-                auto quote = priceSimulator_->getQuote(figi);
-                if (quote) {
-                    QuoteUpdate update;
-                    update.figi = figi;
-                    update.bid = quote->bid;
-                    update.ask = quote->ask;
-                    update.last = quote->last;
-                    update.volume = quote->volume;
-                    
-                    currentCallback(update);
-                }
+        const auto& batch = advancePrices();
+        
+        // 2. Notify about quote update
+        if (currentBatchCallback && !batch.empty()) {
+            currentBatchCallback(batch);
+        }
+        if (currentCallback) {
+            for (const auto& update : batch) {
+                currentCallback(update);
             }
         }
         
@@ -152,6 +189,64 @@ private:
         
         ++tickCount_;
     }
+    
+    /**
+     * @brief Шаг цен одним пакетом (вызывать под tickMutex_)
+     */
+    const std::vector<QuoteUpdate>& advancePrices() {
+        refreshInstrumentIds();
+        
+        priceSimulator_->tickBatch(tickIds_, quotes_);
+        
+        batch_.resize(quotes_.size());
+        for (size_t i = 0; i < quotes_.size(); ++i) {
+            const auto& src = quotes_[i];
+            QuoteUpdate& update = batch_[i];
+            update.figi = tickFigis_[src.index];
+            update.bid = src.quote.bid;
+            update.ask = src.quote.ask;
+            update.last = src.quote.last;
+            update.volume = src.quote.volume;
+        }
+        return batch_;
+    }
+    
+    /**
+     * @brief Пересобрать FIGI -> InstrumentId, если список изменился
+     * 
+     * Инструменты, ещё не заведённые в симуляторе, пробуем разрешить
+     * на каждом тике. Id стабильны, поэтому удаление/повторная
+     * инициализация инструмента в симуляторе кэш не ломает.
+     */
+    void refreshInstrumentIds() {
+        bool changed = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (cachedVersion_ != instrumentsVersion_) {
+                cachedVersion_ = instrumentsVersion_;
+                unresolved_ = instruments_;
+                tickFigis_.clear();
+                tickIds_.clear();
+                changed = true;
+            }
+        }
+        
+        if (!changed && unresolved_.empty()) {
+            return;
+        }
+        
+        auto it = unresolved_.begin();
+        while (it != unresolved_.end()) {
+            auto id = priceSimulator_->instrumentId(*it);
+            if (id) {
+                tickFigis_.push_back(*it);
+                tickIds_.push_back(*id);
+                it = unresolved_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
 };
 
 } // namespace broker::adapters::secondary
@@ -8,8 +8,10 @@
 #include "settings/BrokerSettings.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <functional>
+#include <iostream>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -176,16 +178,26 @@ namespace broker::adapters::secondary
      * - Различные сценарии исполнения (slippage, partial fills, rejection)
      * - События для интеграции с EventBus
      * - Детерминированное тестирование (через setPrice)
+     *
+     * Блокировки:
+     * - аккаунты разложены по ACCOUNT_SHARDS шардам (hash(accountId)),
+     *   у каждого шарда свой мьютекс - ордера разных аккаунтов не ждут друг друга;
+     * - инструменты и сценарии - неизменяемый снимок MarketSnapshot
+     *   (copy-on-write): читатели берут shared_ptr без блокировок,
+     *   писатели (setScenario и т.п.) копируют снимок и публикуют новый;
+     * - PriceSimulator вызывается вне блокировок шардов.
      */
     class EnhancedFakeBroker
     {
     public:
+        static constexpr size_t ACCOUNT_SHARDS = 16;
+
         /**
          * @brief Конструктор
          * @param settings Настройки брокера (seed, slippage и т.д.)
          */
         explicit EnhancedFakeBroker(std::shared_ptr<settings::BrokerSettings> settings)
-            : settings_(std::move(settings)), priceSimulator_(std::make_shared<PriceSimulator>(settings_->getSeed())), orderProcessor_(std::make_shared<OrderProcessor>(priceSimulator_)), ticker_(std::make_shared<BackgroundTicker>(priceSimulator_, orderProcessor_))
+            : settings_(std::move(settings)), priceSimulator_(std::make_shared<PriceSimulator>(settings_->getSeed())), orderProcessor_(std::make_shared<OrderProcessor>(priceSimulator_)), ticker_(std::make_shared<BackgroundTicker>(priceSimulator_, orderProcessor_)), market_(std::make_shared<const MarketSnapshot>())
         {
             initDefaultInstruments();
             setupCallbacks();
@@ -244,8 +256,8 @@ namespace broker::adapters::secondary
          */
         void setScenario(const std::string &figi, const MarketScenario &scenario)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            scenarios_[figi] = scenario;
+            updateMarket([&](MarketSnapshot &market)
+                         { market.scenarios[figi] = scenario; });
             priceSimulator_->initInstrument(
                 figi,
                 scenario.basePrice,
@@ -259,8 +271,8 @@ namespace broker::adapters::secondary
          */
         void setDefaultScenario(const MarketScenario &scenario)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            defaultScenario_ = scenario;
+            updateMarket([&](MarketSnapshot &market)
+                         { market.defaultScenario = scenario; });
         }
 
         /**
@@ -268,9 +280,7 @@ namespace broker::adapters::secondary
          */
         MarketScenario getScenario(const std::string &figi) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = scenarios_.find(figi);
-            return (it != scenarios_.end()) ? it->second : defaultScenario_;
+            return market()->scenarioFor(figi);
         }
 
         // ========================================================================
@@ -320,7 +330,7 @@ namespace broker::adapters::secondary
          */
         void setOrderFillCallback(OrderFillEventCallback callback)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<std::mutex> lock(callbackMutex_);
             orderFillCallback_ = std::move(callback);
         }
 
@@ -329,7 +339,7 @@ namespace broker::adapters::secondary
          */
         void setQuoteUpdateCallback(QuoteUpdateEventCallback callback)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            std::lock_guard<std::mutex> lock(callbackMutex_);
             quoteUpdateCallback_ = std::move(callback);
 
             // Пробрасываем в тикер
@@ -337,7 +347,7 @@ namespace broker::adapters::secondary
                                       {
             QuoteUpdateEventCallback cb;
             {
-                std::lock_guard<std::mutex> lock(mutex_);
+                std::lock_guard<std::mutex> lock(callbackMutex_);
                 cb = quoteUpdateCallback_;
             }
             if (cb) {
@@ -360,13 +370,14 @@ namespace broker::adapters::secondary
          */
         void registerAccount(const std::string &accountId, const std::string &token, double initialCash = 100000.0)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            if (accounts_.find(accountId) == accounts_.end())
+            auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (shard.accounts.find(accountId) == shard.accounts.end())
             {
                 AccountData account;
                 account.token = token;
-                account.cash = initialCash;
-                accounts_[accountId] = account;
+                account.available = initialCash;
+                shard.accounts[accountId] = account;
             }
         }
 
@@ -375,8 +386,9 @@ namespace broker::adapters::secondary
          */
         void unregisterAccount(const std::string &accountId)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            accounts_.erase(accountId);
+            auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.accounts.erase(accountId);
         }
 
         /**
@@ -384,8 +396,9 @@ namespace broker::adapters::secondary
          */
         bool hasAccount(const std::string &accountId) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return accounts_.find(accountId) != accounts_.end();
+            const auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            return shard.accounts.find(accountId) != shard.accounts.end();
         }
 
         /**
@@ -394,15 +407,15 @@ namespace broker::adapters::secondary
         void importPosition(const std::string &accountId, const std::string &figi,
                             const std::string &ticker, int64_t quantity, double averagePrice)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = accounts_.find(accountId);
-            if (it != accounts_.end())
+            auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.accounts.find(accountId);
+            if (it != shard.accounts.end())
             {
-                PositionData pos;
+                auto &pos = it->second.positions[figi];
                 pos.ticker = ticker;
                 pos.quantity = quantity;
                 pos.averagePrice = averagePrice;
-                it->second.positions[figi] = pos;
             }
         }
 
@@ -427,11 +440,9 @@ namespace broker::adapters::secondary
             result.volume = quote->volume;
 
             // Ticker из инструмента
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = instruments_.find(figi);
-            if (it != instruments_.end())
+            if (const auto *instrument = market()->findInstrument(figi))
             {
-                result.ticker = it->second.ticker;
+                result.ticker = instrument->ticker;
             }
 
             return result;
@@ -442,11 +453,10 @@ namespace broker::adapters::secondary
          */
         std::optional<BrokerInstrument> getInstrument(const std::string &figi) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = instruments_.find(figi);
-            if (it != instruments_.end())
+            auto snapshot = market();
+            if (const auto *instrument = snapshot->findInstrument(figi))
             {
-                return it->second;
+                return *instrument;
             }
             return std::nullopt;
         }
@@ -456,10 +466,10 @@ namespace broker::adapters::secondary
          */
         std::vector<BrokerInstrument> getAllInstruments() const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            auto snapshot = market();
             std::vector<BrokerInstrument> result;
-            result.reserve(instruments_.size());
-            for (const auto &[figi, instr] : instruments_)
+            result.reserve(snapshot->instruments.size());
+            for (const auto &[figi, instr] : snapshot->instruments)
             {
                 result.push_back(instr);
             }
@@ -471,10 +481,10 @@ namespace broker::adapters::secondary
          */
         std::vector<BrokerInstrument> searchInstruments(const std::string &query) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            auto snapshot = market();
             std::vector<BrokerInstrument> result;
 
-            for (const auto &[figi, instr] : instruments_)
+            for (const auto &[figi, instr] : snapshot->instruments)
             {
                 if (instr.ticker.find(query) != std::string::npos ||
                     instr.name.find(query) != std::string::npos ||
@@ -495,40 +505,37 @@ namespace broker::adapters::secondary
          */
         BrokerPortfolio getPortfolio(const std::string &accountId) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-
             BrokerPortfolio portfolio;
             portfolio.accountId = accountId;
 
-            auto it = accounts_.find(accountId);
-            if (it == accounts_.end())
+            // Копируем позиции под блокировкой шарда, цены берём уже без неё
             {
-                return portfolio;
-            }
-
-            const auto &account = it->second;
-            portfolio.cash = account.cash;
-
-            for (const auto &[figi, posData] : account.positions)
-            {
-                BrokerPosition pos;
-                pos.figi = figi;
-                pos.ticker = posData.ticker;
-                pos.quantity = posData.quantity;
-                pos.averagePrice = posData.averagePrice;
-
-                // Текущая цена из симулятора (без блокировки - уже под mutex_)
-                auto quote = priceSimulator_->getQuote(figi);
-                if (quote)
+                const auto &shard = shardFor(accountId);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto it = shard.accounts.find(accountId);
+                if (it == shard.accounts.end())
                 {
-                    pos.currentPrice = quote->last;
+                    return portfolio;
                 }
-                else
+
+                const auto &account = it->second;
+                portfolio.cash = account.cash();
+                portfolio.positions.reserve(account.positions.size());
+                for (const auto &[figi, posData] : account.positions)
                 {
-                    pos.currentPrice = pos.averagePrice;
+                    BrokerPosition pos;
+                    pos.figi = figi;
+                    pos.ticker = posData.ticker;
+                    pos.quantity = posData.quantity;
+                    pos.averagePrice = posData.averagePrice;
+                    portfolio.positions.push_back(pos);
                 }
+            }
 
-                portfolio.positions.push_back(pos);
+            for (auto &pos : portfolio.positions)
+            {
+                auto quote = priceSimulator_->getQuote(pos.figi);
+                pos.currentPrice = quote ? quote->last : pos.averagePrice;
             }
 
             return portfolio;
@@ -539,25 +546,38 @@ namespace broker::adapters::secondary
          */
         double getBalance(const std::string &accountId) const
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = accounts_.find(accountId);
-            if (it != accounts_.end())
+            const auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.accounts.find(accountId);
+            if (it != shard.accounts.end())
             {
-                return it->second.cash;
+                return it->second.cash();
             }
             return 0.0;
         }
 
+        /**
+         * @brief Получить сумму, зарезервированную под активные BUY-ордера
+         */
+        double getReservedBalance(const std::string &accountId) const
+        {
+            const auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.accounts.find(accountId);
+            return it != shard.accounts.end() ? it->second.reserved : 0.0;
+        }
+
         /**
          * @brief Установить баланс аккаунта (для тестов)
          */
         void setCash(const std::string &accountId, double cash)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
-            auto it = accounts_.find(accountId);
-            if (it != accounts_.end())
+            auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.accounts.find(accountId);
+            if (it != shard.accounts.end())
             {
-                it->second.cash = cash;
+                it->second.available = cash - it->second.reserved;
             }
         }
 
@@ -567,75 +587,59 @@ namespace broker::adapters::secondary
 
         /**
          * @brief Разместить ордер
+         *
+         * Деньги (BUY) или бумаги (SELL) резервируются в той же критической
+         * секции шарда, где проверяются аккаунт и остаток, - два параллельных
+         * ордера не могут потратить одни и те же деньги. После исполнения
+         * резерв списывается (commit), неисполненный остаток возвращается
+         * (release) или остаётся за pending-ордером до его исполнения/отмены.
+         * Итого две критические секции шарда на ордер.
+         *
+         * MARKET BUY резервируется по ask с запасом на проскальзывание и
+         * исполняется не дороже цены резерва: иначе отклоняется (см.
+         * OrderProcessor), и available не уходит в минус.
          */
         BrokerOrderResult placeOrder(const std::string &accountId, const BrokerOrderRequest &request)
         {
-            // 1. Проверяем аккаунт
-            {
-                std::lock_guard<std::mutex> lock(mutex_);
-                if (accounts_.find(accountId) == accounts_.end())
-                {
-                    BrokerOrderResult result;
-                    result.status = Status::REJECTED;
-                    result.message = "Account not found";
-                    return result;
-                }
-            }
+            auto snapshot = market();
 
-            // 2. Проверяем инструмент
-            auto instrOpt = getInstrument(request.figi);
-            if (!instrOpt)
-            {
-                BrokerOrderResult result;
-                result.status = Status::REJECTED;
-                result.message = "Instrument not found: " + request.figi;
-                return result;
-            }
+            // 1. Проверяем инструмент
+            const auto *instrument = snapshot->findInstrument(request.figi);
 
-            // 3. Проверяем баланс для покупки
-            if (request.direction == Direction::BUY)
+            // Цена резерва (вне блокировки шарда)
+            double reservePrice = request.price;
+            if (instrument && request.direction == Direction::BUY && request.type == Type::MARKET)
             {
-                auto quote = getQuote(request.figi);
-                double price = (request.type == Type::MARKET && quote)
-                                   ? quote->askPrice
-                                   : request.price;
-                double totalCost = price * request.quantity * instrOpt->lot;
-
-                std::lock_guard<std::mutex> lock(mutex_);
-                if (accounts_[accountId].cash < totalCost)
+                auto quote = priceSimulator_->getQuote(request.figi);
+                if (quote)
                 {
-                    BrokerOrderResult result;
-                    result.status = Status::REJECTED;
-                    result.message = "Insufficient funds";
-                    return result;
+                    reservePrice = marketBuyReservePrice(quote->ask, request.quantity,
+                                                         snapshot->scenarioFor(request.figi));
                 }
             }
 
-            // 3.5. Проверяем позицию для продажи (короткие продажи запрещены)
-            if (request.direction == Direction::SELL)
+            // 2. Проверяем аккаунт и резервируем деньги/бумаги
             {
-                std::lock_guard<std::mutex> lock(mutex_);
-                auto &account = accounts_[accountId];
-                auto posIt = account.positions.find(request.figi);
-
-                int64_t availableQuantity = 0;
-                if (posIt != account.positions.end())
+                auto &shard = shardFor(accountId);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto accountIt = shard.accounts.find(accountId);
+                if (accountIt == shard.accounts.end())
+                {
+                    return rejected("Account not found");
+                }
+                if (!instrument)
                 {
-                    availableQuantity = posIt->second.quantity / instrOpt->lot; // в лотах
+                    return rejected("Instrument not found: " + request.figi);
                 }
 
-                if (availableQuantity < request.quantity)
+                auto error = reserve(accountIt->second, request, *instrument, reservePrice);
+                if (error)
                 {
-                    BrokerOrderResult result;
-                    result.status = Status::REJECTED;
-                    result.message = "Insufficient position: have " +
-                                     std::to_string(availableQuantity) + " lots, need " +
-                                     std::to_string(request.quantity);
-                    return result;
+                    return rejected(*error);
                 }
             }
 
-            // 4. Обрабатываем ордер
+            // 3. Обрабатываем ордер
             OrderRequest procRequest;
             procRequest.orderId = request.orderId;
             procRequest.accountId = accountId;
@@ -643,18 +647,31 @@ namespace broker::adapters::secondary
             procRequest.direction = request.direction;
             procRequest.type = request.type;
             procRequest.quantity = request.quantity;
-            procRequest.price = request.price;
+            // MARKET BUY: цена резерва - защитная, дороже процессор не исполнит
+            procRequest.price = reservePrice;
 
-            auto scenario = getScenario(request.figi);
-            auto procResult = orderProcessor_->processOrder(procRequest, scenario);
+            auto procResult = orderProcessor_->processOrder(procRequest, snapshot->scenarioFor(request.figi));
 
-            // 5. Если исполнен — обновляем портфель
-            if (procResult.status == Status::FILLED || procResult.status == Status::PARTIALLY_FILLED)
+            // 4. Списываем исполненное, возвращаем то, что не ждёт исполнения
             {
-                executeOrder(accountId, request, *instrOpt, procResult);
+                auto &shard = shardFor(accountId);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto accountIt = shard.accounts.find(accountId);
+                if (accountIt != shard.accounts.end())
+                {
+                    if (procResult.isSuccess() && procResult.executedQuantity > 0)
+                    {
+                        settle(accountIt->second, request.orderId, request.direction, request.figi,
+                               *instrument, procResult.executedQuantity, procResult.executedPrice);
+                    }
+                    if (procResult.pendingQuantity == 0)
+                    {
+                        release(accountIt->second, request.orderId);
+                    }
+                }
             }
 
-            // 6. Конвертируем результат
+            // 5. Конвертируем результат
             BrokerOrderResult result;
             result.orderId = procResult.orderId;
             result.status = procResult.status;
@@ -666,11 +683,23 @@ namespace broker::adapters::secondary
         }
 
         /**
-         * @brief Отменить ордер
+         * @brief Отменить ордер (резерв под остаток возвращается)
          */
         bool cancelOrder(const std::string &accountId, const std::string &orderId)
         {
-            return orderProcessor_->cancelOrder(orderId);
+            if (!orderProcessor_->cancelOrder(orderId))
+            {
+                return false;
+            }
+
+            auto &shard = shardFor(accountId);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto it = shard.accounts.find(accountId);
+            if (it != shard.accounts.end())
+            {
+                release(it->second, orderId);
+            }
+            return true;
         }
 
         /**
@@ -692,82 +721,166 @@ namespace broker::adapters::secondary
         {
             stopSimulation();
 
-            std::lock_guard<std::mutex> lock(mutex_);
-            accounts_.clear();
-            scenarios_.clear();
+            for (auto &shard : shards_)
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.accounts.clear();
+            }
             orderProcessor_->clearPending();
             priceSimulator_->clear();
+            publishMarket(std::make_shared<const MarketSnapshot>());
 
             initDefaultInstruments();
         }
 
     private:
-        std::shared_ptr<settings::BrokerSettings> settings_;
-        std::shared_ptr<PriceSimulator> priceSimulator_;
-        std::shared_ptr<OrderProcessor> orderProcessor_;
-        std::shared_ptr<BackgroundTicker> ticker_;
-
-        mutable std::mutex mutex_;
+        /**
+         * @brief Неизменяемый снимок справочников (copy-on-write)
+         */
+        struct MarketSnapshot
+        {
+            std::unordered_map<std::string, BrokerInstrument> instruments;
+            std::unordered_map<std::string, MarketScenario> scenarios;
+            MarketScenario defaultScenario;
 
-        // Сценарии
-        MarketScenario defaultScenario_;
-        std::unordered_map<std::string, MarketScenario> scenarios_;
+            const BrokerInstrument *findInstrument(const std::string &figi) const
+            {
+                auto it = instruments.find(figi);
+                return it != instruments.end() ? &it->second : nullptr;
+            }
 
-        // Инструменты
-        std::unordered_map<std::string, BrokerInstrument> instruments_;
+            const MarketScenario &scenarioFor(const std::string &figi) const
+            {
+                auto it = scenarios.find(figi);
+                return it != scenarios.end() ? it->second : defaultScenario;
+            }
+        };
 
         // Аккаунты
         struct PositionData
         {
             std::string ticker;
             int64_t quantity = 0;
+            int64_t reserved = 0;       ///< Штук под активные SELL-ордера
             double averagePrice = 0.0;
         };
 
+        /**
+         * @brief Резерв под ордер (аналог reserve_balance в sql/01-schema.sql)
+         */
+        struct Reservation
+        {
+            std::string figi;
+            Direction direction = Direction::BUY;
+            int64_t lots = 0;           ///< Неисполненный остаток в лотах
+            int64_t sharesPerLot = 1;
+            double cashPerLot = 0.0;    ///< BUY: зарезервировано денег на лот
+        };
+
         struct AccountData
         {
             std::string token;
-            double cash = 0.0;
+            double available = 0.0;     ///< Свободные деньги
+            double reserved = 0.0;      ///< Деньги под активные BUY-ордера
             std::unordered_map<std::string, PositionData> positions;
+            std::unordered_map<std::string, Reservation> reservations;   ///< orderId -> резерв
+
+            double cash() const { return available + reserved; }
         };
 
-        std::unordered_map<std::string, AccountData> accounts_;
+        struct AccountShard
+        {
+            mutable std::mutex mutex;
+            std::unordered_map<std::string, AccountData> accounts;
+        };
+
+        std::shared_ptr<settings::BrokerSettings> settings_;
+        std::shared_ptr<PriceSimulator> priceSimulator_;
+        std::shared_ptr<OrderProcessor> orderProcessor_;
+        std::shared_ptr<BackgroundTicker> ticker_;
+
+        // Инструменты и сценарии: читать через market(), менять через updateMarket()
+        std::shared_ptr<const MarketSnapshot> market_;
+        std::mutex marketWriteMutex_;
+
+        std::array<AccountShard, ACCOUNT_SHARDS> shards_;
 
         // Callbacks
+        mutable std::mutex callbackMutex_;
         OrderFillEventCallback orderFillCallback_;
         QuoteUpdateEventCallback quoteUpdateCallback_;
 
+        AccountShard &shardFor(const std::string &accountId)
+        {
+            return shards_[std::hash<std::string>{}(accountId) % ACCOUNT_SHARDS];
+        }
+
+        const AccountShard &shardFor(const std::string &accountId) const
+        {
+            return shards_[std::hash<std::string>{}(accountId) % ACCOUNT_SHARDS];
+        }
+
+        std::shared_ptr<const MarketSnapshot> market() const
+        {
+            return std::atomic_load(&market_);
+        }
+
+        void publishMarket(std::shared_ptr<const MarketSnapshot> snapshot)
+        {
+            std::atomic_store(&market_, std::move(snapshot));
+        }
+
+        /**
+         * @brief Скопировать снимок, изменить и опубликовать
+         */
+        template <typename Fn>
+        void updateMarket(Fn &&mutate)
+        {
+            std::lock_guard<std::mutex> lock(marketWriteMutex_);
+            auto next = std::make_shared<MarketSnapshot>(*market());
+            mutate(*next);
+            publishMarket(std::move(next));
+        }
+
+        static BrokerOrderResult rejected(const std::string &message)
+        {
+            BrokerOrderResult result;
+            result.status = Status::REJECTED;
+            result.message = message;
+            return result;
+        }
+
+        void addDefaultInstrument(const BrokerInstrument &instrument, double price,
+                                  double spread, double volatility, const MarketScenario &scenario)
+        {
+            updateMarket([&](MarketSnapshot &market)
+                         { market.instruments[instrument.figi] = instrument; });
+            priceSimulator_->initInstrument(instrument.figi, price, spread, volatility);
+            ticker_->addInstrument(instrument.figi);
+            setScenario(instrument.figi, scenario);
+        }
+
         void initDefaultInstruments()
         {
             // SBER - мгновенное исполнение (основной для обычных тестов)
-            instruments_["BBG004730N88"] = {"BBG004730N88", "SBER", "Сбербанк", "RUB", 10, 0.01};
-            priceSimulator_->initInstrument("BBG004730N88", 280.0, 0.001, 0.002);
-            ticker_->addInstrument("BBG004730N88");
-            setScenario("BBG004730N88", MarketScenario::immediate(280.0));
+            addDefaultInstrument({"BBG004730N88", "SBER", "Сбербанк", "RUB", 10, 0.01},
+                                 280.0, 0.001, 0.002, MarketScenario::immediate(280.0));
 
             // GAZP - всегда reject (для теста order.rejected)
-            instruments_["BBG004730RP0"] = {"BBG004730RP0", "GAZP", "Газпром", "RUB", 10, 0.01};
-            priceSimulator_->initInstrument("BBG004730RP0", 160.0, 0.001, 0.003);
-            ticker_->addInstrument("BBG004730RP0");
-            setScenario("BBG004730RP0", MarketScenario::alwaysReject("Test: always reject GAZP"));
+            addDefaultInstrument({"BBG004730RP0", "GAZP", "Газпром", "RUB", 10, 0.01},
+                                 160.0, 0.001, 0.003, MarketScenario::alwaysReject("Test: always reject GAZP"));
 
             // YNDX - реалистичное поведение
-            instruments_["BBG006L8G4H1"] = {"BBG006L8G4H1", "YNDX", "Яндекс", "RUB", 1, 0.1};
-            priceSimulator_->initInstrument("BBG006L8G4H1", 3500.0, 0.002, 0.004);
-            ticker_->addInstrument("BBG006L8G4H1");
-            setScenario("BBG006L8G4H1", MarketScenario::realistic(3500.0));
+            addDefaultInstrument({"BBG006L8G4H1", "YNDX", "Яндекс", "RUB", 1, 0.1},
+                                 3500.0, 0.002, 0.004, MarketScenario::realistic(3500.0));
 
             // LKOH - с задержкой (для теста order.cancelled)
-            instruments_["BBG004731032"] = {"BBG004731032", "LKOH", "Лукойл", "RUB", 1, 0.5};
-            priceSimulator_->initInstrument("BBG004731032", 7200.0, 0.001, 0.002);
-            ticker_->addInstrument("BBG004731032");
-            setScenario("BBG004731032", MarketScenario::delayed(7200.0, std::chrono::milliseconds{5000}));
+            addDefaultInstrument({"BBG004731032", "LKOH", "Лукойл", "RUB", 1, 0.5},
+                                 7200.0, 0.001, 0.002, MarketScenario::delayed(7200.0, std::chrono::milliseconds{5000}));
 
             // MGNT - частичное исполнение (50%)
-            instruments_["BBG004RVFCY3"] = {"BBG004RVFCY3", "MGNT", "Магнит", "RUB", 1, 0.5};
-            priceSimulator_->initInstrument("BBG004RVFCY3", 5500.0, 0.002, 0.003);
-            ticker_->addInstrument("BBG004RVFCY3");
-            setScenario("BBG004RVFCY3", MarketScenario::partialFill(5500.0, 0.5));
+            addDefaultInstrument({"BBG004RVFCY3", "MGNT", "Магнит", "RUB", 1, 0.5},
+                                 5500.0, 0.002, 0.003, MarketScenario::partialFill(5500.0, 0.5));
         }
 
         void setupCallbacks()
@@ -776,27 +889,20 @@ namespace broker::adapters::secondary
             orderProcessor_->setFillCallback([this](const OrderFillEvent &e)
                                              {
             // Обновляем портфель
-            auto instrOpt = getInstrument(e.figi);
-            if (instrOpt) {
-                BrokerOrderRequest req;
-                req.accountId = e.accountId;
-                req.figi = e.figi;
-                req.quantity = e.quantity;
-                req.direction = e.direction;
-                
-                OrderResult procResult;
-                procResult.orderId = e.orderId;
-                procResult.executedPrice = e.price;
-                procResult.executedQuantity = e.quantity;
-                procResult.status = e.partial ? Status::PARTIALLY_FILLED : Status::FILLED;
-                
-                executeOrder(e.accountId, req, *instrOpt, procResult);
-            }
-            
+            auto snapshot = market();
+            if (const auto* instrument = snapshot->findInstrument(e.figi)) {
+                auto& shard = shardFor(e.accountId);
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                auto it = shard.accounts.find(e.accountId);
+                if (it != shard.accounts.end()) {
+                    settle(it->second, e.orderId, e.direction, e.figi, *instrument, e.quantity, e.price);
+                }
+            }
+
             // Вызываем внешний callback
             OrderFillEventCallback cb;
             {
-                std::lock_guard<std::mutex> lock(mutex_);
+                std::lock_guard<std::mutex> lock(callbackMutex_);
                 cb = orderFillCallback_;
             }
             if (cb) {
@@ -812,38 +918,172 @@ namespace broker::adapters::secondary
             } });
         }
 
-        void executeOrder(
-            const std::string &accountId,
+        // ========================================================================
+        // РЕЗЕРВЫ (вызываются под блокировкой шарда аккаунта)
+        // ========================================================================
+
+        /**
+         * @brief Цена резерва MARKET BUY: ask с запасом на проскальзывание
+         *
+         * Объёмное проскальзывание - по той же формуле, что в OrderProcessor
+         * (REALISTIC), сверху BROKER_SLIPPAGE на сдвиг котировки до исполнения.
+         */
+        double marketBuyReservePrice(double ask, int64_t lots, const MarketScenario &scenario) const
+        {
+            double slippage = settings_->getSlippage();
+            if (scenario.availableLiquidity > 0 && lots > scenario.availableLiquidity * 0.1)
+            {
+                slippage += scenario.slippagePercent * static_cast<double>(lots) / scenario.availableLiquidity;
+            }
+            return ask * (1.0 + slippage);
+        }
+
+        /**
+         * @brief Проверить остаток и зарезервировать деньги/бумаги под ордер
+         * @return Причина отказа или nullopt
+         */
+        std::optional<std::string> reserve(
+            AccountData &account,
             const BrokerOrderRequest &request,
             const BrokerInstrument &instrument,
-            const OrderResult &result)
+            double price)
         {
-            std::lock_guard<std::mutex> lock(mutex_);
+            Reservation reservation;
+            reservation.figi = request.figi;
+            reservation.direction = request.direction;
+            reservation.lots = request.quantity;
+            reservation.sharesPerLot = instrument.lot;
 
-            auto it = accounts_.find(accountId);
-            if (it == accounts_.end())
-                return;
+            if (request.direction == Direction::BUY)
+            {
+                reservation.cashPerLot = price * instrument.lot;
+                double totalCost = reservation.cashPerLot * request.quantity;
+                if (account.available < totalCost)
+                {
+                    return std::string("Insufficient funds");
+                }
+            }
+            else
+            {
+                // Короткие продажи запрещены
+                auto posIt = account.positions.find(request.figi);
+                int64_t availableQuantity = 0;
+                if (posIt != account.positions.end())
+                {
+                    availableQuantity = (posIt->second.quantity - posIt->second.reserved) / instrument.lot; // в лотах
+                }
+
+                if (availableQuantity < request.quantity)
+                {
+                    return "Insufficient position: have " +
+                           std::to_string(availableQuantity) + " lots, need " +
+                           std::to_string(request.quantity);
+                }
+            }
 
-            auto &account = it->second;
-            int64_t totalShares = result.executedQuantity * instrument.lot;
-            double totalCost = result.executedPrice * totalShares;
+            // Ордер с тем же id замещается в OrderProcessor - его резерв тоже
+            release(account, request.orderId);
 
             if (request.direction == Direction::BUY)
             {
-                account.cash -= totalCost;
+                double amount = reservation.cashPerLot * request.quantity;
+                account.available -= amount;
+                account.reserved += amount;
+            }
+            else
+            {
+                auto posIt = account.positions.find(request.figi);
+                if (posIt != account.positions.end())
+                {
+                    posIt->second.reserved += request.quantity * instrument.lot;
+                }
+            }
+            account.reservations[request.orderId] = reservation;
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Вернуть неисполненный остаток резерва ордера
+         */
+        void release(AccountData &account, const std::string &orderId)
+        {
+            auto it = account.reservations.find(orderId);
+            if (it == account.reservations.end())
+                return;
 
-                auto &pos = account.positions[request.figi];
+            const auto &reservation = it->second;
+            if (reservation.direction == Direction::BUY)
+            {
+                double amount = reservation.cashPerLot * reservation.lots;
+                account.reserved -= amount;
+                account.available += amount;
+            }
+            else
+            {
+                auto posIt = account.positions.find(reservation.figi);
+                if (posIt != account.positions.end())
+                {
+                    posIt->second.reserved -= reservation.lots * reservation.sharesPerLot;
+                    if (posIt->second.quantity <= 0 && posIt->second.reserved <= 0)
+                    {
+                        account.positions.erase(posIt);
+                    }
+                }
+            }
+            account.reservations.erase(it);
+        }
+
+        /**
+         * @brief Провести исполнение: списать резерв ордера и обновить портфель
+         *
+         * Если резерва нет (отменён раньше, чем пришло исполнение), сделка
+         * проводится по свободному остатку.
+         */
+        void settle(
+            AccountData &account,
+            const std::string &orderId,
+            Direction direction,
+            const std::string &figi,
+            const BrokerInstrument &instrument,
+            int64_t lots,
+            double price)
+        {
+            int64_t reservedLots = 0;
+            double reservedCashPerLot = 0.0;
+            auto resIt = account.reservations.find(orderId);
+            if (resIt != account.reservations.end() && resIt->second.direction == direction)
+            {
+                reservedLots = std::min(lots, resIt->second.lots);
+                reservedCashPerLot = resIt->second.cashPerLot;
+                resIt->second.lots -= reservedLots;
+                if (resIt->second.lots == 0)
+                {
+                    account.reservations.erase(resIt);
+                }
+            }
+
+            int64_t totalShares = lots * instrument.lot;
+            double totalCost = price * totalShares;
+
+            if (direction == Direction::BUY)
+            {
+                // commit: резерв уходит, разница с фактической ценой - в свободные
+                double committed = reservedCashPerLot * reservedLots;
+                account.reserved -= committed;
+                account.available += committed - totalCost;
+
+                auto &pos = account.positions[figi];
                 if (pos.quantity == 0)
                 {
                     pos.ticker = instrument.ticker;
-                    pos.averagePrice = result.executedPrice;
+                    pos.averagePrice = price;
                     pos.quantity = totalShares;
                 }
                 else
                 {
                     // Средняя цена
                     double newAvg = (pos.averagePrice * pos.quantity +
-                                     result.executedPrice * totalShares) /
+                                     price * totalShares) /
                                     (pos.quantity + totalShares);
                     pos.averagePrice = newAvg;
                     pos.quantity += totalShares;
@@ -851,13 +1091,14 @@ namespace broker::adapters::secondary
             }
             else
             {
-                account.cash += totalCost;
+                account.available += totalCost;
 
-                auto posIt = account.positions.find(request.figi);
+                auto posIt = account.positions.find(figi);
                 if (posIt != account.positions.end())
                 {
+                    posIt->second.reserved -= reservedLots * instrument.lot;
                     posIt->second.quantity -= totalShares;
-                    if (posIt->second.quantity <= 0)
+                    if (posIt->second.quantity <= 0 && posIt->second.reserved <= 0)
                     {
                         account.positions.erase(posIt);
                     }
@@ -9,6 +9,9 @@
  * 4. БД - единственный источник правды
  * 5. EnhancedFakeBroker инжектится через DI
  * 6. Публикация portfolio.updated после исполнения ордеров
+ * 7. Котировки пишутся в БД через write-behind QuoteWriteBehindSink
+ * 8. Котировки рассылаются пачками через ConflatingQuotePublisher
+ *    (при BROKER_QUOTE_CONFLATION_MS=0 - quote.updated на каждый тик)
  */
 #pragma once
 
@@ -20,8 +23,10 @@
 #include "ports/output/IBrokerOrderRepository.hpp"
 #include "ports/output/IQuoteRepository.hpp"
 #include "ports/output/IInstrumentRepository.hpp"
+#include "adapters/secondary/QuoteWriteBehindSink.hpp"
+#include "adapters/secondary/ConflatingQuotePublisher.hpp"
+#include "application/events/EventWireFormat.hpp"
 #include "domain/events/OrderCreatedEvent.hpp"
-#include "domain/events/OrderFilledEvent.hpp"
 #include "domain/events/OrderCancelledEvent.hpp"
 #include "domain/events/QuoteUpdatedEvent.hpp"
 
@@ -35,7 +40,10 @@
 #include <iostream>
 #include <string>
 #include <chrono>
+#include <mutex>
 #include <stdexcept>
+#include <array>
+#include <unordered_map>
 
 
 namespace broker::adapters::secondary {
@@ -58,7 +66,9 @@ public:
         std::shared_ptr<ports::output::IBrokerPositionRepository> positionRepo,
         std::shared_ptr<ports::output::IBrokerOrderRepository> orderRepo,
         std::shared_ptr<ports::output::IQuoteRepository> quoteRepo,
-        std::shared_ptr<ports::output::IInstrumentRepository> instrumentRepo)
+        std::shared_ptr<ports::output::IInstrumentRepository> instrumentRepo,
+        std::shared_ptr<QuoteWriteBehindSink> quoteSink,
+        std::shared_ptr<ConflatingQuotePublisher> quotePublisher)
         : broker_(std::move(broker))
         , eventPublisher_(std::move(eventPublisher))
         , balanceRepo_(std::move(balanceRepo))
@@ -66,6 +76,8 @@ public:
         , orderRepo_(std::move(orderRepo))
         , quoteRepo_(std::move(quoteRepo))
         , instrumentRepo_(std::move(instrumentRepo))
+        , quoteSink_(std::move(quoteSink))
+        , quotePublisher_(std::move(quotePublisher))
     {
         initCaches();
         loadFromDatabase();
@@ -384,12 +396,38 @@ public:
         return std::nullopt;
     }
     
-    std::vector<domain::Order> getOrderHistory(
+    domain::OrderPage getOrderHistory(
         const std::string& accountId,
-        const std::optional<std::chrono::system_clock::time_point>& from = std::nullopt,
-        const std::optional<std::chrono::system_clock::time_point>& to = std::nullopt) override
+        const domain::OrderQuery& query) override
     {
-        return getOrders(accountId);
+        domain::OrderPage page;
+        if (!accountExists(accountId)) {
+            if (isSandboxAccount(accountId)) {
+                registerAccount(accountId, "sandbox-token-" + accountId);
+                return page;
+            }
+            throw std::runtime_error("Account not found: " + accountId);
+        }
+        ensureAccountInBroker(accountId);
+
+        if (!orderRepo_ || query.limit == 0) {
+            return page;
+        }
+
+        // Одна лишняя строка - признак того, что страница не последняя
+        domain::OrderQuery probe = query;
+        probe.limit = query.limit + 1;
+        auto rows = orderRepo_->findPage(accountId, probe);
+
+        if (rows.size() > query.limit) {
+            rows.pop_back();
+            page.nextCursor = domain::OrderCursor{rows.back().receivedAtUs, rows.back().orderId}.encode();
+        }
+        page.orders.reserve(rows.size());
+        for (const auto& bo : rows) {
+            page.orders.push_back(convertBrokerOrderToOrder(bo));
+        }
+        return page;
     }
 
 
@@ -401,12 +439,28 @@ private:
     std::shared_ptr<ports::output::IBrokerOrderRepository> orderRepo_;
     std::shared_ptr<ports::output::IQuoteRepository> quoteRepo_;
     std::shared_ptr<ports::output::IInstrumentRepository> instrumentRepo_;
+    std::shared_ptr<QuoteWriteBehindSink> quoteSink_;
+    std::shared_ptr<ConflatingQuotePublisher> quotePublisher_;
     
     // Кэши
     std::unique_ptr<ShardedCache<std::string, domain::Quote, CACHE_SHARD_COUNT>> quoteCache_;
     std::unique_ptr<ShardedCache<std::string, domain::Instrument, CACHE_SHARD_COUNT>> instrumentCache_;
     std::unique_ptr<ShardedCache<std::string, domain::BrokerBalance, CACHE_SHARD_COUNT>> balanceCache_;
     std::unique_ptr<ShardedCache<std::string, domain::BrokerOrder, CACHE_SHARD_COUNT>> orderCache_;
+
+    // Версии portfolio.updated: epoch - запуск процесса, version - номер события по аккаунту.
+    // Аккаунты разложены по полосам hash(accountId): срезы разных аккаунтов не ждут друг друга
+    struct PortfolioPublishStripe {
+        std::mutex mutex;
+        std::unordered_map<std::string, uint64_t> versions;
+    };
+    const int64_t portfolioEpoch_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::array<PortfolioPublishStripe, CACHE_SHARD_COUNT> portfolioStripes_;
+    
+    PortfolioPublishStripe& portfolioStripeFor(const std::string& accountId) {
+        return portfolioStripes_[std::hash<std::string>{}(accountId) % CACHE_SHARD_COUNT];
+    }
     
     // ========================================================================
     // INITIALIZATION
@@ -475,6 +529,11 @@ private:
         }
     }
     
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    
     void setupEventCallbacks() {
         // Callback для обновления котировок
         broker_->setQuoteUpdateCallback([this](const BrokerQuoteUpdateEvent& e) {
@@ -483,19 +542,28 @@ private:
             quote.lastPrice = domain::Money::fromDouble(e.last, "RUB");
             quote.bidPrice = domain::Money::fromDouble(e.bid, "RUB");
             quote.askPrice = domain::Money::fromDouble(e.ask, "RUB");
+            quote.updatedAt = domain::Timestamp::now();
             
-            if (quoteRepo_) {
-                try {
-                    quoteRepo_->save(quote);
-                    quoteCache_->put(e.figi, quote);
-                } catch (const std::exception& ex) {
-                    std::cerr << "[FakeBrokerAdapter] Failed to persist quote: " << ex.what() << std::endl;
-                }
-            } else {
-                quoteCache_->put(e.figi, quote);
+            quoteCache_->put(e.figi, quote);
+            
+            // В БД - пачкой в фоне, тикер не ждёт UPSERT
+            if (quoteSink_) {
+                quoteSink_->offer(quote);
             }
             
-            if (eventPublisher_) {
+            if (quotePublisher_ && quotePublisher_->isEnabled()) {
+                quotePublisher_->offer(quote);
+            } else if (eventPublisher_ && eventPublisher_->binaryWireFormat()) {
+                application::wire::QuoteFrame frame;
+                frame.figi = e.figi;
+                frame.bid = e.bid;
+                frame.ask = e.ask;
+                frame.last = e.last;
+                frame.currency = "RUB";
+                frame.timestampMs = nowMs();
+                eventPublisher_->publish("quote.updated", application::wire::encode(frame),
+                                         application::wire::CONTENT_TYPE_BINARY);
+            } else if (eventPublisher_) {
                 domain::QuoteUpdatedEvent event;
                 event.figi = e.figi;
                 event.lastPrice = quote.lastPrice;
@@ -513,34 +581,74 @@ private:
             // Публикуем portfolio.updated
             publishPortfolioUpdate(e.accountId);
             
-            // Обновляем ордер
-            if (orderRepo_) {
-                auto order = orderRepo_->findById(e.orderId);
-                if (order) {
-                    order->executedLots += e.quantity;
-                    order->executedPrice = e.price;
-                    order->status = (order->executedLots >= order->requestedLots) 
-                        ? "FILLED" 
-                        : "PARTIALLY_FILLED";
-                    try {
+            // Обновляем ордер: e.quantity - размер этой сделки, в событие
+            // уходит накопленное исполнение ордера
+            int64_t executedLots = e.quantity;
+            auto order = findBrokerOrder(e.orderId);
+            if (order) {
+                order->executedLots += e.quantity;
+                order->executedPrice = e.price;
+                order->status = e.partial ? "PARTIALLY_FILLED" : "FILLED";
+                executedLots = order->executedLots;
+                try {
+                    if (orderRepo_) {
                         orderRepo_->update(*order);
-                        orderCache_->put(e.orderId, *order);
-                    } catch (...) {}
-                }
+                    }
+                    orderCache_->put(e.orderId, *order);
+                } catch (...) {}
             }
             
-            if (eventPublisher_) {
-                domain::OrderFilledEvent event;
-                event.orderId = e.orderId;
-                event.accountId = e.accountId;
-                event.figi = e.figi;
-                event.quantity = e.quantity;
-                event.executedPrice = domain::Money::fromDouble(e.price, "RUB");
-                eventPublisher_->publish(event.eventType, event.toJson());
-            }
+            publishOrderFill(e, executedLots);
         });
     }
     
+    /**
+     * @brief order.filled / order.partially_filled по исполнению из книги
+     *
+     * Формат тот же, что у OrderCommandHandler: executed_lots (и lots
+     * бинарного фрейма) - накопленное исполнение, last_fill_lots - эта сделка.
+     */
+    void publishOrderFill(const BrokerOrderFillEvent& e, int64_t executedLots) {
+        if (!eventPublisher_) return;
+        
+        const char* routingKey = e.partial ? "order.partially_filled" : "order.filled";
+        
+        if (eventPublisher_->binaryWireFormat()) {
+            application::wire::OrderFrame frame;
+            frame.orderId = e.orderId;
+            frame.accountId = e.accountId;
+            frame.figi = e.figi;
+            frame.status = e.partial ? application::wire::OrderStatus::PARTIALLY_FILLED
+                                     : application::wire::OrderStatus::FILLED;
+            frame.lots = executedLots;
+            frame.price = e.price;
+            frame.currency = "RUB";
+            frame.timestampMs = nowMs();
+            eventPublisher_->publish(routingKey, application::wire::encode(frame),
+                                     application::wire::CONTENT_TYPE_BINARY);
+            return;
+        }
+        
+        nlohmann::json event;
+        event["order_id"] = e.orderId;
+        event["account_id"] = e.accountId;
+        event["figi"] = e.figi;
+        event["status"] = e.partial ? "PARTIALLY_FILLED" : "FILLED";
+        event["executed_lots"] = executedLots;
+        event["last_fill_lots"] = e.quantity;
+        event["executed_price"] = e.price;
+        event["currency"] = "RUB";
+        event["timestamp"] = nowMs();
+        eventPublisher_->publish(routingKey, event.dump());
+    }
+    
+    std::optional<domain::BrokerOrder> findBrokerOrder(const std::string& orderId) {
+        if (orderRepo_) {
+            return orderRepo_->findById(orderId);
+        }
+        return orderCache_->get(orderId);
+    }
+    
     // ========================================================================
     // PORTFOLIO UPDATE PUBLISHER (НОВЫЙ МЕТОД)
     // ========================================================================
@@ -550,13 +658,24 @@ private:
      * 
      * Вызывается после исполнения ордера для уведомления trading-service
      * об изменении портфеля (позиций и баланса).
+     *
+     * Событие - полный срез портфеля с epoch (запуск процесса) и version
+     * (1, 2, ... по аккаунту). Срез и номер берутся под мьютексом полосы
+     * аккаунта, поэтому больший version всегда несёт более новое состояние;
+     * другие аккаунты при этом не ждут. Публикация - после снятия блокировки:
+     * trading-service отбрасывает опоздавшие версии, а по пропуску номера
+     * перечитывает портфель по HTTP.
      */
     void publishPortfolioUpdate(const std::string& accountId) {
         if (!eventPublisher_) return;
         
         try {
             nlohmann::json event;
+            auto& stripe = portfolioStripeFor(accountId);
+            std::unique_lock<std::mutex> lock(stripe.mutex);
             event["account_id"] = accountId;
+            event["epoch"] = portfolioEpoch_;
+            event["version"] = ++stripe.versions[accountId];
             event["timestamp"] = std::chrono::duration_cast<std::chrono::milliseconds>(
                 std::chrono::system_clock::now().time_since_epoch()).count();
             
@@ -592,6 +711,7 @@ private:
                 {"amount", totalValue},
                 {"currency", "RUB"}
             };
+            lock.unlock();
             
             eventPublisher_->publish("portfolio.updated", event.dump());
             
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Хранилище состояния инструментов симулятора
+ *
+ * Рассчитано на тысячи FIGI (вся вселенная MOEX):
+ * - каждому FIGI выдаётся плотный InstrumentId (0, 1, 2, ...), id не
+ *   переиспользуются и не меняются после removeInstrument/clear;
+ * - состояние лежит колонками (structure-of-arrays) в чанках по CHUNK_SIZE,
+ *   чанки не перемещаются в памяти, поэтому доступ по id не требует блокировок;
+ * - каждый слот защищён seqlock'ом: читатель не блокирует писателя,
+ *   при гонке с записью просто перечитывает слот.
+ *
+ * Справочник FIGI -> id под std::shared_mutex: эксклюзивно берётся только
+ * при появлении нового FIGI, поиск идёт под shared-блокировкой.
+ *
+ * Писатели (write/activate/deactivate) должны быть сериализованы снаружи -
+ * PriceSimulator делает это своим мьютексом. Читатели (read/find) -
+ * из любых потоков.
+ *
+ * Thread-safe: чтение - да, запись - один писатель за раз
+ */
+class InstrumentStateStore {
+public:
+    using InstrumentId = uint32_t;
+
+    static constexpr size_t CHUNK_SIZE = 1024;
+    static constexpr size_t MAX_CHUNKS = 256;       ///< До 262144 инструментов
+
+    /**
+     * @brief Снимок состояния инструмента
+     */
+    struct State {
+        double price = 100.0;
+        double spread = 0.001;       ///< Спред в долях
+        double volatility = 0.002;   ///< Волатильность за тик в долях
+        int64_t dailyVolume = 1000000;
+        std::chrono::system_clock::time_point lastUpdate;
+    };
+
+    InstrumentStateStore() = default;
+
+    InstrumentStateStore(const InstrumentStateStore&) = delete;
+    InstrumentStateStore& operator=(const InstrumentStateStore&) = delete;
+
+    // ========================================================================
+    // СПРАВОЧНИК
+    // ========================================================================
+
+    /**
+     * @brief Получить id FIGI, выделив новый при первом обращении
+     *
+     * Новый слот создаётся неактивным; активирует его activate().
+     */
+    InstrumentId resolve(const std::string& figi) {
+        {
+            std::shared_lock<std::shared_mutex> lock(directoryMutex_);
+            auto it = ids_.find(figi);
+            if (it != ids_.end()) {
+                return it->second;
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(directoryMutex_);
+        auto it = ids_.find(figi);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+
+        InstrumentId id = static_cast<InstrumentId>(figis_.size());
+        size_t chunkIndex = id / CHUNK_SIZE;
+        if (chunkIndex >= MAX_CHUNKS) {
+            throw std::length_error("[InstrumentStateStore] too many instruments");
+        }
+        if (!chunks_[chunkIndex].load(std::memory_order_relaxed)) {
+            owned_.push_back(std::make_unique<Chunk>());
+            chunks_[chunkIndex].store(owned_.back().get(), std::memory_order_release);
+        }
+
+        ids_.emplace(figi, id);
+        figis_.push_back(figi);
+        idCount_.store(figis_.size(), std::memory_order_release);
+        return id;
+    }
+
+    /**
+     * @brief Найти id активного инструмента
+     */
+    std::optional<InstrumentId> find(const std::string& figi) const {
+        std::shared_lock<std::shared_mutex> lock(directoryMutex_);
+        auto it = ids_.find(figi);
+        if (it == ids_.end() || !isActive(it->second)) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief FIGI по id
+     */
+    std::string figiOf(InstrumentId id) const {
+        std::shared_lock<std::shared_mutex> lock(directoryMutex_);
+        return id < figis_.size() ? figis_[id] : std::string{};
+    }
+
+    /**
+     * @brief Количество выданных id (верхняя граница для перебора)
+     */
+    size_t idCount() const {
+        return idCount_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Количество активных инструментов
+     */
+    size_t size() const {
+        return activeCount_.load(std::memory_order_relaxed);
+    }
+
+    // ========================================================================
+    // ЧТЕНИЕ (lock-free)
+    // ========================================================================
+
+    bool isActive(InstrumentId id) const {
+        const Chunk* chunk = chunkOf(id);
+        return chunk && chunk->active[id % CHUNK_SIZE].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Согласованный снимок состояния (seqlock read)
+     * @return nullopt если id неизвестен или инструмент удалён
+     */
+    std::optional<State> read(InstrumentId id) const {
+        const Chunk* chunk = chunkOf(id);
+        if (!chunk) {
+            return std::nullopt;
+        }
+        size_t i = id % CHUNK_SIZE;
+
+        State state;
+        bool active;
+        for (;;) {
+            uint64_t before = chunk->seq[i].load(std::memory_order_acquire);
+            if (before & 1) {
+                continue;  // идёт запись
+            }
+            active = chunk->active[i].load(std::memory_order_relaxed);
+            state.price = chunk->price[i].load(std::memory_order_relaxed);
+            state.spread = chunk->spread[i].load(std::memory_order_relaxed);
+            state.volatility = chunk->volatility[i].load(std::memory_order_relaxed);
+            state.dailyVolume = chunk->volume[i].load(std::memory_order_relaxed);
+            int64_t updatedNs = chunk->updatedNs[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (chunk->seq[i].load(std::memory_order_relaxed) == before) {
+                state.lastUpdate = std::chrono::system_clock::time_point(
+                    std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                        std::chrono::nanoseconds(updatedNs)));
+                break;
+            }
+        }
+
+        if (!active) {
+            return std::nullopt;
+        }
+        return state;
+    }
+
+    // ========================================================================
+    // ЗАПИСЬ (один писатель за раз)
+    // ========================================================================
+
+    /**
+     * @brief Записать состояние слота (seqlock write)
+     */
+    void write(InstrumentId id, const State& state) {
+        Chunk* chunk = chunkOf(id);
+        if (!chunk) {
+            return;
+        }
+        size_t i = id % CHUNK_SIZE;
+        int64_t updatedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            state.lastUpdate.time_since_epoch()).count();
+
+        uint64_t seq = chunk->seq[i].load(std::memory_order_relaxed);
+        chunk->seq[i].store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        chunk->price[i].store(state.price, std::memory_order_relaxed);
+        chunk->spread[i].store(state.spread, std::memory_order_relaxed);
+        chunk->volatility[i].store(state.volatility, std::memory_order_relaxed);
+        chunk->volume[i].store(state.dailyVolume, std::memory_order_relaxed);
+        chunk->updatedNs[i].store(updatedNs, std::memory_order_relaxed);
+
+        chunk->seq[i].store(seq + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Записать состояние и сделать инструмент видимым
+     */
+    void activate(InstrumentId id, const State& state) {
+        write(id, state);
+        Chunk* chunk = chunkOf(id);
+        if (chunk && !chunk->active[id % CHUNK_SIZE].exchange(true, std::memory_order_acq_rel)) {
+            activeCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Скрыть инструмент (id остаётся закреплён за FIGI)
+     * @return true если инструмент был активен
+     */
+    bool deactivate(InstrumentId id) {
+        Chunk* chunk = chunkOf(id);
+        if (!chunk || !chunk->active[id % CHUNK_SIZE].exchange(false, std::memory_order_acq_rel)) {
+            return false;
+        }
+        activeCount_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Скрыть все инструменты
+     */
+    void deactivateAll() {
+        size_t count = idCount();
+        for (size_t id = 0; id < count; ++id) {
+            deactivate(static_cast<InstrumentId>(id));
+        }
+    }
+
+private:
+    /**
+     * @brief Чанк колонок состояния (SoA)
+     */
+    struct Chunk {
+        std::array<std::atomic<uint64_t>, CHUNK_SIZE> seq{};
+        std::array<std::atomic<double>, CHUNK_SIZE> price{};
+        std::array<std::atomic<double>, CHUNK_SIZE> spread{};
+        std::array<std::atomic<double>, CHUNK_SIZE> volatility{};
+        std::array<std::atomic<int64_t>, CHUNK_SIZE> volume{};
+        std::array<std::atomic<int64_t>, CHUNK_SIZE> updatedNs{};
+        std::array<std::atomic<bool>, CHUNK_SIZE> active{};
+    };
+
+    Chunk* chunkOf(InstrumentId id) const {
+        size_t chunkIndex = id / CHUNK_SIZE;
+        if (chunkIndex >= MAX_CHUNKS || id >= idCount()) {
+            return nullptr;
+        }
+        return chunks_[chunkIndex].load(std::memory_order_acquire);
+    }
+
+    mutable std::shared_mutex directoryMutex_;
+    std::unordered_map<std::string, InstrumentId> ids_;
+    std::vector<std::string> figis_;
+    std::vector<std::unique_ptr<Chunk>> owned_;
+
+    std::array<std::atomic<Chunk*>, MAX_CHUNKS> chunks_{};
+    std::atomic<size_t> idCount_{0};
+    std::atomic<size_t> activeCount_{0};
+};
+
+} // namespace broker::adapters::secondary
@@ -14,7 +14,8 @@ enum class OrderFillBehavior {
     REALISTIC,        ///< Реалистичное: market=fill, limit=pending до цены
     PARTIAL,          ///< Частичное исполнение
     DELAYED,          ///< С задержкой (async)
-    ALWAYS_REJECT     ///< Всегда отклонять (тест ошибок)
+    ALWAYS_REJECT,    ///< Всегда отклонять (тест ошибок)
+    MATCHING          ///< Встречные заявки аккаунтов сводятся в книге (CLOB)
 };
 
 /**
@@ -27,6 +28,7 @@ inline std::string toString(OrderFillBehavior behavior) {
         case OrderFillBehavior::PARTIAL: return "PARTIAL";
         case OrderFillBehavior::DELAYED: return "DELAYED";
         case OrderFillBehavior::ALWAYS_REJECT: return "ALWAYS_REJECT";
+        case OrderFillBehavior::MATCHING: return "MATCHING";
         default: return "UNKNOWN";
     }
 }
@@ -40,6 +42,7 @@ inline OrderFillBehavior parseOrderFillBehavior(const std::string& str) {
     if (str == "PARTIAL") return OrderFillBehavior::PARTIAL;
     if (str == "DELAYED") return OrderFillBehavior::DELAYED;
     if (str == "ALWAYS_REJECT") return OrderFillBehavior::ALWAYS_REJECT;
+    if (str == "MATCHING") return OrderFillBehavior::MATCHING;
     return OrderFillBehavior::REALISTIC;  // По умолчанию
 }
 
@@ -60,6 +63,7 @@ inline OrderFillBehavior parseOrderFillBehavior(const std::string& str) {
  * - partialFill(): алиас для partial()
  * - delayed(): асинхронное исполнение с задержкой
  * - alwaysReject(): всегда отклонять (для тестов ошибок)
+ * - matching(): сведение заявок аккаунтов между собой
  * - lowLiquidity(): низкая ликвидность с высоким проскальзыванием
  * - highVolatility(): высокая волатильность
  */
@@ -200,6 +204,20 @@ struct MarketScenario {
         return s;
     }
     
+    /**
+     * @brief Сведение заявок (central limit order book)
+     * 
+     * Ордера разных аккаунтов исполняются друг против друга по
+     * price-time priority, цена сделки становится последней ценой
+     * инструмента. Без встречных заявок MARKET отклоняется, LIMIT ждёт.
+     */
+    static MarketScenario matching(double price = 100.0) {
+        MarketScenario s;
+        s.basePrice = price;
+        s.fillBehavior = OrderFillBehavior::MATCHING;
+        return s;
+    }
+    
     // ========================================================================
     // BUILDER МЕТОДЫ
     // ========================================================================
@@ -0,0 +1,369 @@
+#pragma once
+
+#include "OrderTypes.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Центральная книга заявок одного инструмента (CLOB)
+ *
+ * Заявки разных аккаунтов сводятся друг с другом по price-time priority:
+ * лучшая цена первой, внутри уровня - по времени постановки.
+ *
+ * Раскладка в памяти:
+ * - цена хранится в целых тиках (PRICE_SCALE), без сравнений double;
+ * - уровни - отсортированные std::vector<Level>, лучший уровень в конце
+ *   (bids по возрастанию, asks по убыванию), поэтому снятие/добавление
+ *   у вершины книги не сдвигает остальные уровни;
+ * - заявки - узлы интрузивного двусвязного списка уровня, связанные
+ *   индексами uint32_t; узлы берутся из пула (free list) и не аллоцируются
+ *   на каждую заявку;
+ * - горячие поля узла (qty, prev/next, цена) отделены от холодных
+ *   (orderId, accountId), которые нужны только при сделке.
+ *
+ * Остаток LIMIT встаёт в книгу, остаток MARKET отбрасывается (IOC).
+ * Self-trade не запрещён: для нагрузочных тестов это не мешает.
+ *
+ * Thread-safe: нет (защищается мьютексом OrderProcessor)
+ */
+class MatchingBook {
+public:
+    static constexpr double PRICE_SCALE = 10000.0;   ///< 1 тик = 0.0001
+
+    /**
+     * @brief Сделка с одной встречной (maker) заявкой
+     */
+    struct Trade {
+        std::string makerOrderId;
+        std::string makerAccountId;
+        Direction makerDirection;
+        int64_t quantity;
+        double price;
+        bool makerDone;   ///< Встречная заявка исполнена полностью
+    };
+
+    /**
+     * @brief Итог постановки заявки
+     */
+    struct SubmitResult {
+        std::vector<Trade> trades;
+        int64_t filled = 0;        ///< Исполнено у входящей заявки
+        double notional = 0.0;     ///< Сумма price * qty по сделкам
+        int64_t resting = 0;       ///< Встало в книгу
+    };
+
+    /**
+     * @brief Поставить заявку: свести со встречной стороной, остаток LIMIT - в книгу
+     */
+    SubmitResult submit(const OrderRequest& request) {
+        SubmitResult result;
+        int64_t remaining = request.quantity;
+        bool isBuy = request.direction == Direction::BUY;
+        // MARKET сметает встречную сторону; MARKET BUY с защитной ценой - до неё
+        bool unbounded = request.type == Type::MARKET && !(isBuy && request.price > 0.0);
+        int64_t limit = unbounded
+            ? (isBuy ? std::numeric_limits<int64_t>::max() : std::numeric_limits<int64_t>::min())
+            : toTicks(request.price);
+
+        auto& opposite = isBuy ? asks_ : bids_;
+        while (remaining > 0 && !opposite.empty()) {
+            Level& level = opposite.back();
+            if (isBuy ? level.price > limit : level.price < limit) {
+                break;
+            }
+            remaining = matchLevel(level, !isBuy, remaining, result);
+            if (level.head == NIL) {
+                opposite.pop_back();
+            }
+        }
+
+        if (remaining > 0 && request.type == Type::LIMIT) {
+            rest(request, limit, remaining);
+            result.resting = remaining;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Снять заявку из книги
+     */
+    bool cancel(const std::string& orderId) {
+        auto it = index_.find(orderId);
+        if (it == index_.end()) {
+            return false;
+        }
+        uint32_t n = it->second;
+        index_.erase(it);
+
+        auto& levels = hot_[n].isBuy ? bids_ : asks_;
+        auto levelIt = findLevel(levels, hot_[n].price, hot_[n].isBuy);
+        if (levelIt != levels.end()) {
+            unlink(*levelIt, n);
+            if (levelIt->head == NIL) {
+                levels.erase(levelIt);
+            }
+        }
+        freeNode(n);
+        return true;
+    }
+
+    bool contains(const std::string& orderId) const {
+        return index_.count(orderId) > 0;
+    }
+
+    size_t size() const {
+        return index_.size();
+    }
+
+    size_t levelCount() const {
+        return bids_.size() + asks_.size();
+    }
+
+    /**
+     * @brief Лучшие цены книги (0.0 если сторона пуста)
+     */
+    double bestBid() const { return bids_.empty() ? 0.0 : fromTicks(bids_.back().price); }
+    double bestAsk() const { return asks_.empty() ? 0.0 : fromTicks(asks_.back().price); }
+
+    /**
+     * @brief Стоящие заявки в формате PendingOrder
+     */
+    void appendResting(const std::string& figi, std::vector<PendingOrder>& out) const {
+        for (const auto& [orderId, n] : index_) {
+            PendingOrder order;
+            order.orderId = orderId;
+            order.accountId = cold_[n].accountId;
+            order.figi = figi;
+            order.direction = hot_[n].isBuy ? Direction::BUY : Direction::SELL;
+            order.type = Type::LIMIT;
+            order.quantity = hot_[n].quantity;
+            order.limitPrice = fromTicks(hot_[n].price);
+            order.createdAt = cold_[n].createdAt;
+            out.push_back(std::move(order));
+        }
+    }
+
+    void clear() {
+        bids_.clear();
+        asks_.clear();
+        hot_.clear();
+        cold_.clear();
+        index_.clear();
+        freeHead_ = NIL;
+    }
+
+private:
+    static constexpr uint32_t NIL = std::numeric_limits<uint32_t>::max();
+
+    struct Level {
+        int64_t price;
+        int64_t totalQuantity;
+        uint32_t head;
+        uint32_t tail;
+    };
+
+    struct NodeHot {
+        int64_t quantity;
+        int64_t price;
+        uint32_t prev;
+        uint32_t next;     ///< Следующий в уровне или в free list
+        bool isBuy;
+    };
+
+    struct NodeCold {
+        std::string orderId;
+        std::string accountId;
+        std::chrono::system_clock::time_point createdAt;
+    };
+
+    std::vector<Level> bids_;   ///< По возрастанию цены, лучший в конце
+    std::vector<Level> asks_;   ///< По убыванию цены, лучший в конце
+    std::vector<NodeHot> hot_;
+    std::vector<NodeCold> cold_;
+    std::unordered_map<std::string, uint32_t> index_;
+    uint32_t freeHead_ = NIL;
+
+    static int64_t toTicks(double price) {
+        return std::llround(price * PRICE_SCALE);
+    }
+
+    static double fromTicks(int64_t ticks) {
+        return static_cast<double>(ticks) / PRICE_SCALE;
+    }
+
+    /**
+     * @brief Свести входящую заявку с уровнем по времени постановки
+     * @return Неисполненный остаток входящей заявки
+     */
+    int64_t matchLevel(Level& level, bool makerIsBuy, int64_t remaining, SubmitResult& result) {
+        double price = fromTicks(level.price);
+        while (remaining > 0 && level.head != NIL) {
+            uint32_t n = level.head;
+            int64_t qty = std::min(remaining, hot_[n].quantity);
+
+            hot_[n].quantity -= qty;
+            level.totalQuantity -= qty;
+            remaining -= qty;
+            result.filled += qty;
+            result.notional += price * static_cast<double>(qty);
+
+            bool done = hot_[n].quantity == 0;
+            result.trades.push_back(Trade{
+                cold_[n].orderId,
+                cold_[n].accountId,
+                makerIsBuy ? Direction::BUY : Direction::SELL,
+                qty,
+                price,
+                done});
+
+            if (done) {
+                index_.erase(cold_[n].orderId);
+                unlink(level, n);
+                freeNode(n);
+            }
+        }
+        return remaining;
+    }
+
+    void rest(const OrderRequest& request, int64_t price, int64_t quantity) {
+        bool isBuy = request.direction == Direction::BUY;
+        uint32_t n = allocNode();
+        hot_[n] = NodeHot{quantity, price, NIL, NIL, isBuy};
+        cold_[n].orderId = request.orderId;
+        cold_[n].accountId = request.accountId;
+        cold_[n].createdAt = std::chrono::system_clock::now();
+        index_[request.orderId] = n;
+
+        auto& levels = isBuy ? bids_ : asks_;
+        auto it = findLevel(levels, price, isBuy);
+        if (it == levels.end()) {
+            it = levels.insert(insertPosition(levels, price, isBuy), Level{price, 0, NIL, NIL});
+        }
+        append(*it, n);
+    }
+
+    /**
+     * @brief Позиция уровня с заданной ценой для вставки (порядок "лучший в конце")
+     */
+    static std::vector<Level>::iterator insertPosition(std::vector<Level>& levels, int64_t price, bool isBuy) {
+        return std::lower_bound(levels.begin(), levels.end(), price,
+            [isBuy](const Level& level, int64_t p) {
+                return isBuy ? level.price < p : level.price > p;
+            });
+    }
+
+    static std::vector<Level>::iterator findLevel(std::vector<Level>& levels, int64_t price, bool isBuy) {
+        auto it = insertPosition(levels, price, isBuy);
+        return (it != levels.end() && it->price == price) ? it : levels.end();
+    }
+
+    void append(Level& level, uint32_t n) {
+        hot_[n].prev = level.tail;
+        hot_[n].next = NIL;
+        if (level.tail != NIL) {
+            hot_[level.tail].next = n;
+        } else {
+            level.head = n;
+        }
+        level.tail = n;
+        level.totalQuantity += hot_[n].quantity;
+    }
+
+    void unlink(Level& level, uint32_t n) {
+        uint32_t prev = hot_[n].prev;
+        uint32_t next = hot_[n].next;
+        if (prev != NIL) hot_[prev].next = next; else level.head = next;
+        if (next != NIL) hot_[next].prev = prev; else level.tail = prev;
+        level.totalQuantity -= hot_[n].quantity;
+    }
+
+    uint32_t allocNode() {
+        if (freeHead_ != NIL) {
+            uint32_t n = freeHead_;
+            freeHead_ = hot_[n].next;
+            return n;
+        }
+        hot_.emplace_back();
+        cold_.emplace_back();
+        return static_cast<uint32_t>(hot_.size() - 1);
+    }
+
+    void freeNode(uint32_t n) {
+        hot_[n].quantity = 0;
+        hot_[n].next = freeHead_;
+        cold_[n].orderId.clear();
+        cold_[n].accountId.clear();
+        freeHead_ = n;
+    }
+};
+
+/**
+ * @brief Набор книг MatchingBook по FIGI (режим OrderFillBehavior::MATCHING)
+ *
+ * Thread-safe: нет (защищается мьютексом OrderProcessor)
+ */
+class MatchingEngine {
+public:
+    MatchingBook::SubmitResult submit(const OrderRequest& request) {
+        auto& book = books_[request.figi];
+        auto result = book.submit(request);
+        if (result.resting > 0) {
+            orderFigi_[request.orderId] = request.figi;
+        }
+        for (const auto& trade : result.trades) {
+            if (trade.makerDone) {
+                orderFigi_.erase(trade.makerOrderId);
+            }
+        }
+        return result;
+    }
+
+    bool cancel(const std::string& orderId) {
+        auto it = orderFigi_.find(orderId);
+        if (it == orderFigi_.end()) {
+            return false;
+        }
+        auto bookIt = books_.find(it->second);
+        orderFigi_.erase(it);
+        return bookIt != books_.end() && bookIt->second.cancel(orderId);
+    }
+
+    bool contains(const std::string& orderId) const {
+        return orderFigi_.count(orderId) > 0;
+    }
+
+    const MatchingBook* book(const std::string& figi) const {
+        auto it = books_.find(figi);
+        return it != books_.end() ? &it->second : nullptr;
+    }
+
+    size_t restingCount() const {
+        return orderFigi_.size();
+    }
+
+    void appendResting(std::vector<PendingOrder>& out) const {
+        for (const auto& [figi, book] : books_) {
+            book.appendResting(figi, out);
+        }
+    }
+
+    void clear() {
+        books_.clear();
+        orderFigi_.clear();
+    }
+
+private:
+    std::unordered_map<std::string, MatchingBook> books_;
+    std::unordered_map<std::string, std::string> orderFigi_;   ///< orderId -> FIGI стоящих заявок
+};
+
+} // namespace broker::adapters::secondary
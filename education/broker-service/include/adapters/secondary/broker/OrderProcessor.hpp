@@ -1,6 +1,9 @@
 #pragma once
 
 #include "MarketScenario.hpp"
+#include "MatchingEngine.hpp"
+#include "OrderTypes.hpp"
+#include "PendingOrderBook.hpp"
 #include "PriceSimulator.hpp"
 
 #include <atomic>
@@ -11,92 +14,12 @@
 #include <optional>
 #include <random>
 #include <string>
-#include <unordered_map>
+#include <utility>
 
 // TODO: в будущем наверно лучше распилить на 4 процессора для удобства:
 // MarketBuy, MarketSell, LimitBuy, LimitSell
 namespace broker::adapters::secondary {
 
-/**
- * @brief Направление ордера (локальная копия для изоляции от domain)
- */
-enum class Direction { BUY, SELL };
-
-/**
- * @brief Тип ордера
- */
-enum class Type { MARKET, LIMIT };
-
-/**
- * @brief Статус ордера
- */
-enum class Status {
-    PENDING,
-    FILLED,
-    PARTIALLY_FILLED,
-    CANCELLED,
-    REJECTED
-};
-
-inline std::string toString(Status s) {
-    switch (s) {
-        case Status::PENDING: return "PENDING";
-        case Status::FILLED: return "FILLED";
-        case Status::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
-        case Status::CANCELLED: return "CANCELLED";
-        case Status::REJECTED: return "REJECTED";
-        default: return "UNKNOWN";
-    }
-}
-
-/**
- * @brief Запрос на создание ордера (изолированный от domain)
- */
-struct OrderRequest {
-    std::string orderId;
-    std::string accountId;
-    std::string figi;
-    Direction direction = Direction::BUY;
-    Type type = Type::MARKET;
-    int64_t quantity = 0;
-    double price = 0.0;  // Для LIMIT ордеров
-};
-
-/**
- * @brief Результат обработки ордера
- */
-struct OrderResult {
-    std::string orderId;
-    Status status = Status::PENDING;
-    double executedPrice = 0.0;
-    int64_t executedQuantity = 0;
-    std::string message;
-    
-    bool isSuccess() const {
-        return status == Status::FILLED || status == Status::PARTIALLY_FILLED;
-    }
-    
-    bool isFinal() const {
-        return status == Status::FILLED || status == Status::REJECTED || status == Status::CANCELLED;
-    }
-};
-
-/**
- * @brief Pending ордер в очереди
- */
-struct PendingOrder {
-    std::string orderId;
-    std::string accountId;
-    std::string figi;
-    Direction direction;
-    Type type;
-    int64_t quantity;
-    double limitPrice;
-    std::chrono::system_clock::time_point createdAt; // время, после которого нужно исполнить (для DELAYED)
-    std::chrono::system_clock::time_point fillAfter;
-    bool isDelayedMarket = false;  // TRUE только для MARKET ордеров!
-};
-
 /**
  * @brief Событие исполнения ордера
  */
@@ -124,6 +47,11 @@ using FillCallback = std::function<void(const OrderFillEvent&)>;
  * - PARTIAL: частичное исполнение
  * - DELAYED: отложенное исполнение
  * - ALWAYS_REJECT: всегда отклонять
+ * - MATCHING: сведение заявок аккаунтов в книге (см. MatchingEngine)
+ *
+ * У MARKET BUY с price > 0 это защитная цена (цена резерва денег):
+ * исполнение дороже отклоняется, в MATCHING книга сметается только до неё,
+ * отложенный (DELAYED) ордер ждёт её как LIMIT.
  */
 class OrderProcessor {
 public:
@@ -171,70 +99,43 @@ public:
                 return rejectOrder(request, scenario.rejectReason.empty() 
                     ? "Always reject mode" 
                     : scenario.rejectReason);
+                
+            case OrderFillBehavior::MATCHING:
+                return matchOrder(request);
         }
         
         return rejectOrder(request, "Unknown fill behavior");
     }
     
     /**
-     * @brief Обработать pending limit-ордера
+     * @brief Обработать pending-ордера
+     *
+     * Трогает только исполнимые ордера: limit, чья цена пересеклась
+     * с котировкой, и delayed market, чей fillAfter наступил
+     * (см. PendingOrderBook).
      */
-        void processPendingOrders(const MarketScenario& scenario) {
+    void processPendingOrders(const MarketScenario& scenario) {
         std::lock_guard<std::mutex> lock(mutex_);
         
-        auto now = std::chrono::system_clock::now();
-        std::vector<std::string> filledOrders;
+        auto fills = pendingBook_.takeExecutable(
+            std::chrono::system_clock::now(),
+            [this](const std::string& figi) { return priceSimulator_->getQuote(figi); });
         
-        for (auto& [orderId, order] : pendingOrders_) {
-            auto quoteOpt = priceSimulator_->getQuote(order.figi);
-            if (!quoteOpt) continue;
-            
-            const auto& quote = *quoteOpt;
-            bool shouldFill = false;
-            double fillPrice = 0.0;
-            
-            // Разная логика для MARKET и LIMIT
-            if (order.isDelayedMarket) {
-                // DELAYED MARKET — проверяем только время
-                if (now >= order.fillAfter) {
-                    shouldFill = true;
-                    fillPrice = (order.direction == Direction::BUY) ? quote.ask : quote.bid;
-                }
-            } else {
-                // LIMIT — проверяем цену (стандартная биржевая логика)
-                if (order.direction == Direction::BUY) {
-                    if (quote.ask <= order.limitPrice) {
-                        shouldFill = true;
-                        fillPrice = quote.ask;
-                    }
-                } else {
-                    if (quote.bid >= order.limitPrice) {
-                        shouldFill = true;
-                        fillPrice = quote.bid;
-                    }
-                }
-            }
-            
-            if (shouldFill) {
-                filledOrders.push_back(orderId);
-                
-                if (fillCallback_) {
-                    OrderFillEvent event;
-                    event.orderId = orderId;
-                    event.accountId = order.accountId;
-                    event.figi = order.figi;
-                    event.direction = order.direction;
-                    event.quantity = order.quantity;
-                    event.price = fillPrice;
-                    event.partial = false;
-                    
-                    fillCallback_(event);
-                }
-            }
+        if (!fillCallback_) {
+            return;
         }
         
-        for (const auto& orderId : filledOrders) {
-            pendingOrders_.erase(orderId);
+        for (const auto& fill : fills) {
+            OrderFillEvent event;
+            event.orderId = fill.order.orderId;
+            event.accountId = fill.order.accountId;
+            event.figi = fill.order.figi;
+            event.direction = fill.order.direction;
+            event.quantity = fill.order.quantity;
+            event.price = fill.price;
+            event.partial = false;
+            
+            fillCallback_(event);
         }
     }
     
@@ -243,7 +144,7 @@ public:
      */
     bool cancelOrder(const std::string& orderId) {
         std::lock_guard<std::mutex> lock(mutex_);
-        return pendingOrders_.erase(orderId) > 0;
+        return pendingBook_.remove(orderId) || matchingEngine_.cancel(orderId);
     }
     
     /**
@@ -251,17 +152,14 @@ public:
      */
     std::vector<PendingOrder> getPendingOrders() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        std::vector<PendingOrder> result;
-        result.reserve(pendingOrders_.size());
-        for (const auto& [_, order] : pendingOrders_) {
-            result.push_back(order);
-        }
+        auto result = pendingBook_.snapshot();
+        matchingEngine_.appendResting(result);
         return result;
     }
     
     size_t pendingCount() const {
         std::lock_guard<std::mutex> lock(mutex_);
-        return pendingOrders_.size();
+        return pendingBook_.size() + matchingEngine_.restingCount();
     }
     
     /**
@@ -269,13 +167,28 @@ public:
      */
     void clearPending() {
         std::lock_guard<std::mutex> lock(mutex_);
-        pendingOrders_.clear();
+        pendingBook_.clear();
+        matchingEngine_.clear();
+    }
+    
+    /**
+     * @brief Лучшие цены книги MATCHING
+     * @return {bestBid, bestAsk}, 0.0 для пустой стороны
+     */
+    std::pair<double, double> bookTop(const std::string& figi) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto* book = matchingEngine_.book(figi);
+        if (!book) {
+            return {0.0, 0.0};
+        }
+        return {book->bestBid(), book->bestAsk()};
     }
 
 private:
     std::shared_ptr<PriceSimulator> priceSimulator_;
     mutable std::mutex mutex_;
-    std::unordered_map<std::string, PendingOrder> pendingOrders_;
+    PendingOrderBook pendingBook_;
+    MatchingEngine matchingEngine_;
     FillCallback fillCallback_;
     std::mt19937 rng_;
     std::atomic<uint64_t> orderCounter_{0};
@@ -296,8 +209,24 @@ private:
         return result;
     }
     
+    /**
+     * @brief MARKET BUY дороже защитной цены (резерв не покроет сделку)
+     */
+    static bool aboveProtectionPrice(const OrderRequest& request, double fillPrice) {
+        return request.type == Type::MARKET && request.direction == Direction::BUY
+            && request.price > 0.0 && fillPrice > request.price;
+    }
+    
+    OrderResult rejectAboveProtection(const OrderRequest& request, double fillPrice) {
+        return rejectOrder(request, "Execution price " + std::to_string(fillPrice) +
+                                    " exceeds reserved price " + std::to_string(request.price));
+    }
+    
     OrderResult fillImmediately(const OrderRequest& request, const PriceSimulator::Quote& quote) {
         double fillPrice = (request.direction == Direction::BUY) ? quote.ask : quote.bid;
+        if (aboveProtectionPrice(request, fillPrice)) {
+            return rejectAboveProtection(request, fillPrice);
+        }
         
         OrderResult result;
         result.orderId = request.orderId;
@@ -328,6 +257,9 @@ private:
             double fillPrice = (request.direction == Direction::BUY)
                 ? basePrice + slippage
                 : basePrice - slippage;
+            if (aboveProtectionPrice(request, fillPrice)) {
+                return rejectAboveProtection(request, fillPrice);
+            }
             
             OrderResult result;
             result.orderId = request.orderId;
@@ -374,6 +306,9 @@ private:
         const MarketScenario& scenario)
     {
         double fillPrice = (request.direction == Direction::BUY) ? quote.ask : quote.bid;
+        if (aboveProtectionPrice(request, fillPrice)) {
+            return rejectAboveProtection(request, fillPrice);
+        }
         int64_t filledQty = std::max(
             int64_t{1},
             static_cast<int64_t>(request.quantity * scenario.partialFillRatio)
@@ -440,11 +375,12 @@ private:
         // TRUE только для MARKET!
         pending.isDelayedMarket = (request.type == Type::MARKET);
         
-        pendingOrders_[pending.orderId] = pending;
+        pendingBook_.add(pending);
         
         OrderResult result;
         result.orderId = pending.orderId;
         result.status = Status::PENDING;
+        result.pendingQuantity = pending.quantity;
         result.message = pending.isDelayedMarket 
             ? "Market order queued for delayed fill"
             : "Limit order queued (waiting for price)";
@@ -465,15 +401,80 @@ private:
         pending.limitPrice = request.price;
         pending.createdAt = std::chrono::system_clock::now();
         
-        pendingOrders_[pending.orderId] = pending;
+        pendingBook_.add(pending);
         
         OrderResult result;
         result.orderId = pending.orderId;
         result.status = Status::PENDING;
+        result.pendingQuantity = pending.quantity;
         result.message = "Limit order queued";
         
         return result;
     }
+    
+    /**
+     * @brief Свести ордер со встречными заявками других аккаунтов
+     *
+     * Встречные (maker) исполнения уходят через fillCallback_ после снятия
+     * блокировки, цена последней сделки записывается в PriceSimulator.
+     */
+    OrderResult matchOrder(const OrderRequest& request) {
+        MatchingBook::SubmitResult match;
+        FillCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (matchingEngine_.contains(request.orderId)) {
+                return rejectOrder(request, "Duplicate order id: " + request.orderId);
+            }
+            match = matchingEngine_.submit(request);
+            callback = fillCallback_;
+        }
+        
+        if (!match.trades.empty()) {
+            priceSimulator_->setPrice(request.figi, match.trades.back().price);
+        }
+        
+        if (callback) {
+            for (const auto& trade : match.trades) {
+                OrderFillEvent event;
+                event.orderId = trade.makerOrderId;
+                event.accountId = trade.makerAccountId;
+                event.figi = request.figi;
+                event.direction = trade.makerDirection;
+                event.quantity = trade.quantity;
+                event.price = trade.price;
+                event.partial = !trade.makerDone;
+                
+                callback(event);
+            }
+        }
+        
+        OrderResult result;
+        result.orderId = request.orderId;
+        result.executedQuantity = match.filled;
+        result.pendingQuantity = match.resting;
+        if (match.filled > 0) {
+            result.executedPrice = match.notional / static_cast<double>(match.filled);
+        }
+        
+        if (match.filled == request.quantity) {
+            result.status = Status::FILLED;
+            result.message = "Matched";
+        } else if (match.filled > 0) {
+            result.status = Status::PARTIALLY_FILLED;
+            result.message = match.resting > 0
+                ? "Partially matched, rest queued in book"
+                : "Partially matched, rest cancelled (no liquidity)";
+        } else if (match.resting > 0) {
+            result.status = Status::PENDING;
+            result.message = "Limit order queued in book";
+        } else {
+            result.status = Status::REJECTED;
+            result.message = "No liquidity in book";
+        }
+        
+        return result;
+    }
 };
 
 } // namespace broker::adapters::secondary
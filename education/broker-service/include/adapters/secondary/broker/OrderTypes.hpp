@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Направление ордера (локальная копия для изоляции от domain)
+ */
+enum class Direction { BUY, SELL };
+
+/**
+ * @brief Тип ордера
+ */
+enum class Type { MARKET, LIMIT };
+
+/**
+ * @brief Статус ордера
+ */
+enum class Status {
+    PENDING,
+    FILLED,
+    PARTIALLY_FILLED,
+    CANCELLED,
+    REJECTED
+};
+
+inline std::string toString(Status s) {
+    switch (s) {
+        case Status::PENDING: return "PENDING";
+        case Status::FILLED: return "FILLED";
+        case Status::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
+        case Status::CANCELLED: return "CANCELLED";
+        case Status::REJECTED: return "REJECTED";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * @brief Запрос на создание ордера (изолированный от domain)
+ */
+struct OrderRequest {
+    std::string orderId;
+    std::string accountId;
+    std::string figi;
+    Direction direction = Direction::BUY;
+    Type type = Type::MARKET;
+    int64_t quantity = 0;
+    double price = 0.0;  // Для LIMIT ордеров; у MARKET BUY > 0 - защитная цена
+};
+
+/**
+ * @brief Результат обработки ордера
+ */
+struct OrderResult {
+    std::string orderId;
+    Status status = Status::PENDING;
+    double executedPrice = 0.0;
+    int64_t executedQuantity = 0;
+    int64_t pendingQuantity = 0;   ///< Остаток, ожидающий исполнения (очередь/книга)
+    std::string message;
+    
+    bool isSuccess() const {
+        return status == Status::FILLED || status == Status::PARTIALLY_FILLED;
+    }
+    
+    bool isFinal() const {
+        return status == Status::FILLED || status == Status::REJECTED || status == Status::CANCELLED;
+    }
+};
+
+/**
+ * @brief Pending ордер в очереди
+ */
+struct PendingOrder {
+    std::string orderId;
+    std::string accountId;
+    std::string figi;
+    Direction direction;
+    Type type;
+    int64_t quantity;
+    double limitPrice;
+    std::chrono::system_clock::time_point createdAt; // время, после которого нужно исполнить (для DELAYED)
+    std::chrono::system_clock::time_point fillAfter;
+    bool isDelayedMarket = false;  // TRUE только для MARKET ордеров!
+};
+
+} // namespace broker::adapters::secondary
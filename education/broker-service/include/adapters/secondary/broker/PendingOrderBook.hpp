@@ -0,0 +1,266 @@
+#pragma once
+
+#include "OrderTypes.hpp"
+#include "PriceSimulator.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Индекс pending-ордеров OrderProcessor
+ *
+ * Раньше processPendingOrders перебирал все pending-ордера и для каждого
+ * запрашивал котировку: тик стоил O(ордеров). Здесь ордера разложены так,
+ * чтобы тик трогал только те, что действительно исполняются:
+ * - LIMIT BUY  - лестница по FIGI, цена по убыванию: исполняются все
+ *   с limitPrice >= ask, т.е. префикс лестницы;
+ * - LIMIT SELL - лестница по FIGI, цена по возрастанию: исполняются все
+ *   с limitPrice <= bid;
+ * - DELAYED MARKET - min-куча по fillAfter: исполняются вершины кучи
+ *   с fillAfter <= now. BUY с limitPrice > 0 (защитная цена), у которого
+ *   ask к этому моменту выше неё, переходит в лестницу LIMIT BUY.
+ *
+ * Внутри одного ценового уровня сохраняется порядок постановки (FIFO).
+ * Котировка запрашивается один раз на FIGI с непустой лестницей.
+ *
+ * Отмена из кучи ленивая: запись в куче помечена seq ордера и
+ * пропускается, если ордер уже удалён или перезаписан.
+ *
+ * Thread-safe: нет (защищается мьютексом OrderProcessor)
+ */
+class PendingOrderBook {
+public:
+    /**
+     * @brief Ордер, снятый из книги для исполнения
+     */
+    struct Fill {
+        PendingOrder order;
+        double price;
+    };
+
+    using QuoteLookup = std::function<std::optional<PriceSimulator::Quote>(const std::string&)>;
+
+    /**
+     * @brief Поставить ордер (ордер с тем же orderId заменяется)
+     */
+    void add(const PendingOrder& order) {
+        remove(order.orderId);
+
+        Entry entry;
+        entry.order = order;
+        entry.seq = ++seqCounter_;
+
+        if (order.isDelayedMarket) {
+            delayed_.push(DelayedKey{order.fillAfter, entry.seq, order.orderId});
+            orders_.emplace(order.orderId, std::move(entry));
+            return;
+        }
+
+        auto& ladders = ladders_[order.figi];
+        if (order.direction == Direction::BUY) {
+            entry.bidPos = ladders.bids.emplace(order.limitPrice, order.orderId);
+        } else {
+            entry.askPos = ladders.asks.emplace(order.limitPrice, order.orderId);
+        }
+        orders_.emplace(order.orderId, std::move(entry));
+    }
+
+    /**
+     * @brief Снять ордер
+     * @return true если ордер был в книге
+     */
+    bool remove(const std::string& orderId) {
+        auto it = orders_.find(orderId);
+        if (it == orders_.end()) {
+            return false;
+        }
+        unlink(it->second);
+        orders_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief Снять все ордера, которые исполняются на текущем рынке
+     *
+     * @param now Текущее время (для DELAYED MARKET)
+     * @param quoteOf Котировка по FIGI; nullopt - ордер остаётся в книге
+     * @return Исполненные ордера: сначала отложенные market, затем limit
+     */
+    std::vector<Fill> takeExecutable(std::chrono::system_clock::time_point now,
+                                     const QuoteLookup& quoteOf) {
+        std::vector<Fill> fills;
+        takeDueDelayed(now, quoteOf, fills);
+        takeCrossedLimits(quoteOf, fills);
+        return fills;
+    }
+
+    std::vector<PendingOrder> snapshot() const {
+        std::vector<PendingOrder> result;
+        result.reserve(orders_.size());
+        for (const auto& [_, entry] : orders_) {
+            result.push_back(entry.order);
+        }
+        return result;
+    }
+
+    size_t size() const {
+        return orders_.size();
+    }
+
+    /**
+     * @brief Количество FIGI с непустыми лестницами
+     */
+    size_t figiCount() const {
+        return ladders_.size();
+    }
+
+    void clear() {
+        orders_.clear();
+        ladders_.clear();
+        delayed_ = {};
+    }
+
+private:
+    using BidLadder = std::multimap<double, std::string, std::greater<double>>;
+    using AskLadder = std::multimap<double, std::string>;
+
+    struct Ladders {
+        BidLadder bids;   ///< LIMIT BUY, лучшая (высшая) цена первой
+        AskLadder asks;   ///< LIMIT SELL, лучшая (низшая) цена первой
+    };
+
+    struct Entry {
+        PendingOrder order;
+        uint64_t seq = 0;
+        std::optional<BidLadder::iterator> bidPos;
+        std::optional<AskLadder::iterator> askPos;
+    };
+
+    struct DelayedKey {
+        std::chrono::system_clock::time_point fillAfter;
+        uint64_t seq;
+        std::string orderId;
+
+        bool operator>(const DelayedKey& other) const {
+            if (fillAfter != other.fillAfter) {
+                return fillAfter > other.fillAfter;
+            }
+            return seq > other.seq;
+        }
+    };
+
+    std::unordered_map<std::string, Entry> orders_;
+    std::unordered_map<std::string, Ladders> ladders_;
+    std::priority_queue<DelayedKey, std::vector<DelayedKey>, std::greater<DelayedKey>> delayed_;
+    uint64_t seqCounter_ = 0;
+
+    /**
+     * @brief Убрать ордер из лестницы (запись в куче отбросится лениво)
+     */
+    void unlink(const Entry& entry) {
+        if (!entry.bidPos && !entry.askPos) {
+            return;
+        }
+        auto it = ladders_.find(entry.order.figi);
+        if (it == ladders_.end()) {
+            return;
+        }
+        if (entry.bidPos) {
+            it->second.bids.erase(*entry.bidPos);
+        } else {
+            it->second.asks.erase(*entry.askPos);
+        }
+        if (it->second.bids.empty() && it->second.asks.empty()) {
+            ladders_.erase(it);
+        }
+    }
+
+    void takeDueDelayed(std::chrono::system_clock::time_point now,
+                        const QuoteLookup& quoteOf,
+                        std::vector<Fill>& fills) {
+        std::vector<DelayedKey> noQuote;
+
+        while (!delayed_.empty() && delayed_.top().fillAfter <= now) {
+            DelayedKey key = delayed_.top();
+            delayed_.pop();
+
+            auto it = orders_.find(key.orderId);
+            if (it == orders_.end() || it->second.seq != key.seq) {
+                continue;  // отменён или перезаписан
+            }
+
+            auto quote = quoteOf(it->second.order.figi);
+            if (!quote) {
+                noQuote.push_back(std::move(key));
+                continue;
+            }
+
+            const auto& order = it->second.order;
+            if (order.direction == Direction::BUY && order.limitPrice > 0.0 && quote->ask > order.limitPrice) {
+                // Дороже защитной цены не покупаем: дальше ждём как LIMIT по ней
+                PendingOrder limit = order;
+                limit.isDelayedMarket = false;
+                orders_.erase(it);
+                add(limit);
+                continue;
+            }
+
+            double price = (order.direction == Direction::BUY) ? quote->ask : quote->bid;
+            fills.push_back(Fill{std::move(it->second.order), price});
+            orders_.erase(it);
+        }
+
+        for (auto& key : noQuote) {
+            delayed_.push(std::move(key));
+        }
+    }
+
+    void takeCrossedLimits(const QuoteLookup& quoteOf, std::vector<Fill>& fills) {
+        for (auto ladderIt = ladders_.begin(); ladderIt != ladders_.end();) {
+            auto quote = quoteOf(ladderIt->first);
+            if (!quote) {
+                ++ladderIt;
+                continue;
+            }
+
+            auto& bids = ladderIt->second.bids;
+            while (!bids.empty() && bids.begin()->first >= quote->ask) {
+                takeFromLadder(bids, bids.begin(), quote->ask, fills);
+            }
+
+            auto& asks = ladderIt->second.asks;
+            while (!asks.empty() && asks.begin()->first <= quote->bid) {
+                takeFromLadder(asks, asks.begin(), quote->bid, fills);
+            }
+
+            if (bids.empty() && asks.empty()) {
+                ladderIt = ladders_.erase(ladderIt);
+            } else {
+                ++ladderIt;
+            }
+        }
+    }
+
+    template <typename Ladder>
+    void takeFromLadder(Ladder& ladder, typename Ladder::iterator pos,
+                        double price, std::vector<Fill>& fills) {
+        auto it = orders_.find(pos->second);
+        ladder.erase(pos);
+        if (it == orders_.end()) {
+            return;
+        }
+        fills.push_back(Fill{std::move(it->second.order), price});
+        orders_.erase(it);
+    }
+};
+
+} // namespace broker::adapters::secondary
@@ -1,12 +1,14 @@
 #pragma once
 
+#include "InstrumentStateStore.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <mutex>
 #include <optional>
 #include <random>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 namespace broker::adapters::secondary {
 
@@ -34,6 +36,10 @@ namespace broker::adapters::secondary {
  * sim.tick("SBER");  // Цена изменится случайно
  * ```
  * 
+ * Состояние хранится в InstrumentStateStore: читатели (getQuote, getPrice)
+ * не берут блокировок и не мешают тикеру, изменения сериализуются
+ * мьютексом писателей.
+ * 
  * Thread-safe: да (внутренняя синхронизация)
  */
 class PriceSimulator {
@@ -71,6 +77,16 @@ public:
         }
     };
     
+    using InstrumentId = InstrumentStateStore::InstrumentId;
+    
+    /**
+     * @brief Результат пакетного тика для одного инструмента
+     */
+    struct BatchQuote {
+        size_t index = 0;   ///< Позиция инструмента во входном списке ids
+        Quote quote;
+    };
+    
     /**
      * @brief Конструктор
      * @param seed Seed для генератора случайных чисел (0 = random_device)
@@ -93,50 +109,58 @@ public:
         double spread = 0.001,
         double volatility = 0.002)
     {
-        std::lock_guard<std::mutex> lock(mutex_);
+        std::lock_guard<std::mutex> lock(writeMutex_);
         
-        InstrumentState state;
-        state.currentPrice = basePrice;
+        State state;
+        state.price = basePrice;
         state.spread = spread;
         state.volatility = volatility;
         state.dailyVolume = 1000000;
         state.lastUpdate = std::chrono::system_clock::now();
         
-        instruments_[figi] = state;
+        store_.activate(store_.resolve(figi), state);
     }
     
     /**
      * @brief Проверить, инициализирован ли инструмент
      */
     bool hasInstrument(const std::string& figi) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return instruments_.find(figi) != instruments_.end();
+        return store_.find(figi).has_value();
+    }
+    
+    /**
+     * @brief Плотный id инструмента (для доступа без поиска по FIGI)
+     * @return id или nullopt если инструмент не найден
+     */
+    std::optional<InstrumentId> instrumentId(const std::string& figi) const {
+        return store_.find(figi);
     }
     
     /**
      * @brief Получить текущую котировку
      * 
+     * Не блокирует тикер: чтение идёт через seqlock слота.
+     * 
      * @param figi Идентификатор инструмента
      * @return Котировка или nullopt если инструмент не найден
      */
     std::optional<Quote> getQuote(const std::string& figi) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
+        auto id = store_.find(figi);
+        if (!id) {
             return std::nullopt;
         }
-        
-        const auto& state = it->second;
-        
-        Quote q;
-        q.last = state.currentPrice;
-        q.bid = state.currentPrice * (1.0 - state.spread / 2.0);
-        q.ask = state.currentPrice * (1.0 + state.spread / 2.0);
-        q.volume = state.dailyVolume;
-        q.timestamp = state.lastUpdate;
-        
-        return q;
+        return getQuote(*id);
+    }
+    
+    /**
+     * @brief Получить текущую котировку по id
+     */
+    std::optional<Quote> getQuote(InstrumentId id) const {
+        auto state = store_.read(id);
+        if (!state) {
+            return std::nullopt;
+        }
+        return toQuote(*state);
     }
     
     /**
@@ -150,24 +174,112 @@ public:
      * @return Новая цена или 0.0 если инструмент не найден
      */
     double tick(const std::string& figi) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
+        auto id = store_.find(figi);
+        if (!id) {
             return 0.0;
         }
+        return tick(*id);
+    }
+    
+    /**
+     * @brief Симилировать один тик по id
+     */
+    double tick(InstrumentId id) {
+        return update(id, 0.0, [this](State& state) {
+            // Random walk с нормальным распределением
+            std::normal_distribution<double> dist(0.0, state.volatility);
+            double change = dist(rng_);
+            
+            state.price *= (1.0 + change);
+            state.price = std::max(0.01, state.price);  // Минимум 1 копейка
+            state.lastUpdate = std::chrono::system_clock::now();
+            return state.price;
+        });
+    }
+    
+    /**
+     * @brief Пакетный тик: сдвинуть цены всех инструментов за один проход
+     * 
+     * В отличие от tick() по одному FIGI:
+     * - мьютекс писателей берётся один раз на весь пакет;
+     * - состояние собирается в колонки (price/volatility/spread), и
+     *   шаг цены, bid/ask считаются простыми циклами по массивам,
+     *   которые компилятор векторизует;
+     * - Z ~ N(0, 1) генерируется парами по Box–Muller из равномерных
+     *   чисел rng_, без создания std::normal_distribution на тик.
+     * 
+     * Удалённые/неизвестные id пропускаются.
+     * 
+     * @param ids Инструменты для тика
+     * @param out Котировки после тика (перезаписывается, только активные)
+     * @return Количество обновлённых инструментов
+     */
+    size_t tickBatch(const std::vector<InstrumentId>& ids, std::vector<BatchQuote>& out) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        out.clear();
         
-        auto& state = it->second;
+        // 1. Gather: активные слоты -> колонки
+        batch_.resize(ids.size());
+        size_t n = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            auto state = store_.read(ids[i]);
+            if (!state) continue;
+            batch_.index[n] = i;
+            batch_.price[n] = state->price;
+            batch_.volatility[n] = state->volatility;
+            batch_.spread[n] = state->spread;
+            batch_.volume[n] = state->dailyVolume;
+            ++n;
+        }
+        if (n == 0) {
+            return 0;
+        }
         
-        // Random walk с нормальным распределением
-        std::normal_distribution<double> dist(0.0, state.volatility);
-        double change = dist(rng_);
+        // 2. Z ~ N(0, 1)
+        fillGaussian(batch_.z.data(), n);
         
-        state.currentPrice *= (1.0 + change);
-        state.currentPrice = std::max(0.01, state.currentPrice);  // Минимум 1 копейка
-        state.lastUpdate = std::chrono::system_clock::now();
+        // 3. Шаг цены и bid/ask - векторизуемые циклы по колонкам
+        double* price = batch_.price.data();
+        const double* vol = batch_.volatility.data();
+        const double* spread = batch_.spread.data();
+        const double* z = batch_.z.data();
+        double* bid = batch_.bid.data();
+        double* ask = batch_.ask.data();
+        
+        for (size_t i = 0; i < n; ++i) {
+            double p = price[i] * (1.0 + vol[i] * z[i]);
+            price[i] = p < 0.01 ? 0.01 : p;  // Минимум 1 копейка
+        }
+        for (size_t i = 0; i < n; ++i) {
+            double half = spread[i] * 0.5;
+            bid[i] = price[i] * (1.0 - half);
+            ask[i] = price[i] * (1.0 + half);
+        }
+        
+        // 4. Scatter: запись в слоты + контигуальный результат
+        auto now = std::chrono::system_clock::now();
+        out.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            size_t src = batch_.index[i];
+            
+            State state;
+            state.price = price[i];
+            state.spread = spread[i];
+            state.volatility = vol[i];
+            state.dailyVolume = batch_.volume[i];
+            state.lastUpdate = now;
+            store_.write(ids[src], state);
+            
+            BatchQuote& bq = out[i];
+            bq.index = src;
+            bq.quote.last = price[i];
+            bq.quote.bid = bid[i];
+            bq.quote.ask = ask[i];
+            bq.quote.volume = batch_.volume[i];
+            bq.quote.timestamp = now;
+        }
         
-        return state.currentPrice;
+        return n;
     }
     
     /**
@@ -193,16 +305,11 @@ public:
      * @return true если инструмент найден
      */
     bool setPrice(const std::string& figi, double price) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
-            return false;
-        }
-        
-        it->second.currentPrice = std::max(0.01, price);
-        it->second.lastUpdate = std::chrono::system_clock::now();
-        return true;
+        return update(figi, false, [price](State& state) {
+            state.price = std::max(0.01, price);
+            state.lastUpdate = std::chrono::system_clock::now();
+            return true;
+        });
     }
     
     /**
@@ -213,16 +320,11 @@ public:
      * @return Новая цена или 0.0 если инструмент не найден
      */
     double movePrice(const std::string& figi, double delta) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
-            return 0.0;
-        }
-        
-        it->second.currentPrice = std::max(0.01, it->second.currentPrice + delta);
-        it->second.lastUpdate = std::chrono::system_clock::now();
-        return it->second.currentPrice;
+        return update(figi, 0.0, [delta](State& state) {
+            state.price = std::max(0.01, state.price + delta);
+            state.lastUpdate = std::chrono::system_clock::now();
+            return state.price;
+        });
     }
     
     /**
@@ -233,98 +335,177 @@ public:
      * @return Новая цена или 0.0 если инструмент не найден
      */
     double movePricePercent(const std::string& figi, double percent) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
-            return 0.0;
-        }
-        
-        it->second.currentPrice *= (1.0 + percent / 100.0);
-        it->second.currentPrice = std::max(0.01, it->second.currentPrice);
-        it->second.lastUpdate = std::chrono::system_clock::now();
-        return it->second.currentPrice;
+        return update(figi, 0.0, [percent](State& state) {
+            state.price *= (1.0 + percent / 100.0);
+            state.price = std::max(0.01, state.price);
+            state.lastUpdate = std::chrono::system_clock::now();
+            return state.price;
+        });
     }
     
     /**
      * @brief Получить текущую цену (без bid/ask)
      */
     double getPrice(const std::string& figi) const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
+        auto id = store_.find(figi);
+        if (!id) {
             return 0.0;
         }
-        return it->second.currentPrice;
+        auto state = store_.read(*id);
+        return state ? state->price : 0.0;
     }
     
     /**
      * @brief Изменить волатильность инструмента
      */
     bool setVolatility(const std::string& figi, double volatility) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
-            return false;
-        }
-        
-        it->second.volatility = std::max(0.0, volatility);
-        return true;
+        return update(figi, false, [volatility](State& state) {
+            state.volatility = std::max(0.0, volatility);
+            return true;
+        });
     }
     
     /**
      * @brief Изменить спред инструмента
      */
     bool setSpread(const std::string& figi, double spread) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        
-        auto it = instruments_.find(figi);
-        if (it == instruments_.end()) {
-            return false;
-        }
-        
-        it->second.spread = std::max(0.0, spread);
-        return true;
+        return update(figi, false, [spread](State& state) {
+            state.spread = std::max(0.0, spread);
+            return true;
+        });
     }
     
     /**
      * @brief Удалить инструмент
      */
     bool removeInstrument(const std::string& figi) {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return instruments_.erase(figi) > 0;
+        auto id = store_.find(figi);
+        if (!id) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        return store_.deactivate(*id);
     }
     
     /**
      * @brief Очистить все инструменты
      */
     void clear() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        instruments_.clear();
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        store_.deactivateAll();
     }
     
     /**
      * @brief Получить количество инструментов
      */
     size_t size() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return instruments_.size();
+        return store_.size();
     }
 
 private:
-    struct InstrumentState {
-        double currentPrice = 100.0;
-        double spread = 0.001;       // 0.1%
-        double volatility = 0.002;   // 0.2% per tick
-        int64_t dailyVolume = 1000000;
-        std::chrono::system_clock::time_point lastUpdate;
+    using State = InstrumentStateStore::State;
+    
+    /**
+     * @brief Колонки для tickBatch (переиспользуются между тиками)
+     */
+    struct BatchColumns {
+        std::vector<size_t> index;
+        std::vector<double> price;
+        std::vector<double> volatility;
+        std::vector<double> spread;
+        std::vector<int64_t> volume;
+        std::vector<double> z;
+        std::vector<double> u1;
+        std::vector<double> u2;
+        std::vector<double> bid;
+        std::vector<double> ask;
+        
+        void resize(size_t n) {
+            if (price.size() >= n) return;
+            index.resize(n);
+            price.resize(n);
+            volatility.resize(n);
+            spread.resize(n);
+            volume.resize(n);
+            z.resize(n + 1);        // Box–Muller даёт пары
+            u1.resize(n / 2 + 1);
+            u2.resize(n / 2 + 1);
+            bid.resize(n);
+            ask.resize(n);
+        }
     };
     
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, InstrumentState> instruments_;
+    InstrumentStateStore store_;
+    std::mutex writeMutex_;      ///< Сериализует писателей, защищает rng_ и batch_
     std::mt19937 rng_;
+    BatchColumns batch_;
+    
+    /**
+     * @brief Заполнить z[0..n) величинами N(0, 1) (Box–Muller)
+     * 
+     * Равномерные числа берутся из rng_ последовательно, а преобразование
+     * (log, sqrt, cos, sin) идёт отдельным циклом по массивам без
+     * зависимостей между итерациями.
+     */
+    void fillGaussian(double* z, size_t n) {
+        constexpr double TWO_PI = 6.283185307179586476925286766559;
+        constexpr double INV_2_32 = 1.0 / 4294967296.0;
+        
+        size_t pairs = (n + 1) / 2;
+        double* u1 = batch_.u1.data();
+        double* u2 = batch_.u2.data();
+        
+        // (x + 0.5) / 2^32 лежит в (0, 1): log(u1) конечен
+        for (size_t i = 0; i < pairs; ++i) {
+            u1[i] = (static_cast<double>(rng_()) + 0.5) * INV_2_32;
+            u2[i] = (static_cast<double>(rng_()) + 0.5) * INV_2_32;
+        }
+        
+        for (size_t i = 0; i < pairs; ++i) {
+            double r = std::sqrt(-2.0 * std::log(u1[i]));
+            double theta = TWO_PI * u2[i];
+            z[2 * i] = r * std::cos(theta);
+            z[2 * i + 1] = r * std::sin(theta);
+        }
+    }
+    
+    static Quote toQuote(const State& state) {
+        Quote q;
+        q.last = state.price;
+        q.bid = state.price * (1.0 - state.spread / 2.0);
+        q.ask = state.price * (1.0 + state.spread / 2.0);
+        q.volume = state.dailyVolume;
+        q.timestamp = state.lastUpdate;
+        return q;
+    }
+    
+    /**
+     * @brief Read-modify-write слота под мьютексом писателей
+     * 
+     * @return Результат mutator или notFound, если инструмента нет
+     */
+    template <typename R, typename Mutator>
+    R update(InstrumentId id, R notFound, Mutator mutator) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        
+        auto state = store_.read(id);
+        if (!state) {
+            return notFound;
+        }
+        
+        R result = mutator(*state);
+        store_.write(id, *state);
+        return result;
+    }
+    
+    template <typename R, typename Mutator>
+    R update(const std::string& figi, R notFound, Mutator mutator) {
+        auto id = store_.find(figi);
+        if (!id) {
+            return notFound;
+        }
+        return update(*id, notFound, mutator);
+    }
 };
 
 } // namespace broker::adapters::secondary
\ No newline at end of file
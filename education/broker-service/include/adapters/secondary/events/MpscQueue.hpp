@@ -0,0 +1,89 @@
+// include/adapters/secondary/events/MpscQueue.hpp
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace broker::adapters::secondary {
+
+/**
+ * @brief Lock-free очередь "много писателей - один читатель"
+ *
+ * Интрузивная очередь Вьюкова на односвязном списке:
+ * - push() - один atomic exchange головы и одна release-запись ссылки,
+ *   без блокировок и без CAS-циклов; писатели не мешают друг другу;
+ * - pop() - только из одного потока (в RabbitMQAdapter - поток io_context).
+ *
+ * Между exchange и записью ссылки очередь на мгновение выглядит пустой
+ * для читателя (элемент ещё не связан). Поэтому читатель, увидев пустую
+ * очередь, должен полагаться на внешний сигнал от писателя, а не на
+ * повторный опрос - см. RabbitMQAdapter::drainPublishQueue.
+ *
+ * Thread-safe: push - да (MPSC), pop/empty - один читатель
+ */
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue()
+        : head_(&stub_)
+        , tail_(&stub_)
+    {}
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    ~MpscQueue() {
+        T discarded;
+        while (pop(discarded)) {
+        }
+        if (tail_ != &stub_) {
+            delete tail_;
+        }
+    }
+
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Забрать элемент (только поток-читатель)
+     * @return false если очередь пуста (или писатель ещё не связал элемент)
+     */
+    bool pop(T& out) {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (!next) {
+            return false;
+        }
+        out = std::move(next->value);
+        tail_ = next;
+        if (tail != &stub_) {
+            delete tail;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Есть ли связанные элементы (только поток-читатель)
+     */
+    bool empty() const {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        std::atomic<Node*> next{nullptr};
+        T value{};
+    };
+
+    Node stub_;
+    std::atomic<Node*> head_;   ///< Последний добавленный (писатели)
+    Node* tail_;                ///< Уже прочитанный узел (читатель)
+};
+
+} // namespace broker::adapters::secondary
@@ -4,6 +4,7 @@
 #include "ports/output/IEventPublisher.hpp"
 #include "ports/output/IEventConsumer.hpp"
 #include "settings/RabbitMQSettings.hpp"
+#include "MpscQueue.hpp"
 #include <amqpcpp.h>
 #include <amqpcpp/libboostasio.h>
 #include <boost/asio.hpp>
@@ -11,6 +12,9 @@
 #include <thread>
 #include <atomic>
 #include <mutex>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 #include <iostream>
 
 namespace broker::adapters::secondary {
@@ -28,12 +32,32 @@ namespace broker::adapters::secondary {
  * 
  * Либо используйте startDeferred() который автоматически 
  * делает binding при каждом subscribe().
+ *
+ * Публикация: publish() можно звать из любых потоков (тикер, конвейер
+ * ордеров) - сообщение уходит в lock-free MPSC-очередь, а в канал его
+ * пишет только поток io_context, пачкой за одно пробуждение. Канал
+ * работает в режиме publisher confirms: брокер подтверждает сообщения
+ * пачками (multiple ack), счётчики in-flight/confirmed - в publisherStats().
  */
 class RabbitMQAdapter : public ports::output::IEventPublisher,
                         public ports::output::IEventConsumer {
 public:
+    /**
+     * @brief Счётчики публикации
+     */
+    struct PublisherStats {
+        size_t queued = 0;        ///< В очереди на отправку
+        size_t inFlight = 0;      ///< Отправлено, ждёт confirm от брокера
+        uint64_t sent = 0;        ///< Записано в канал
+        uint64_t confirmed = 0;   ///< Подтверждено брокером (ack)
+        uint64_t nacked = 0;      ///< Отвергнуто брокером (nack)
+        uint64_t dropped = 0;     ///< Отброшено: адаптер не запущен или очередь переполнена
+    };
+
     explicit RabbitMQAdapter(std::shared_ptr<settings::RabbitMQSettings> settings)
         : settings_(std::move(settings))
+        , publishQueueLimit_(static_cast<size_t>(settings_->getPublishQueueLimit()))
+        , binaryWireFormat_(settings_->getWireFormat() == "binary")
         , running_(false)
         , connected_(false)
         , ioContext_()
@@ -42,7 +66,8 @@ public:
         exchangeName_ = settings_->getExchange();
         std::cout << "[RabbitMQAdapter] Created for " 
                   << settings_->getHost() << ":" << settings_->getPort()
-                  << " exchange=" << exchangeName_ << std::endl;
+                  << " exchange=" << exchangeName_
+                  << " wire=" << (binaryWireFormat_ ? "binary" : "json") << std::endl;
         // НЕ вызываем start() здесь! Ждём пока subscribe() зарегистрирует handlers.
     }
 
@@ -54,21 +79,62 @@ public:
     // IEventPublisher
     // =========================================================================
     
+    /**
+     * @brief Поставить сообщение в очередь на отправку
+     *
+     * Не блокируется и не трогает канал из вызывающего потока.
+     * До подключения сообщения копятся (не больше RABBITMQ_PUBLISH_QUEUE_LIMIT)
+     * и уходят, как только объявлен exchange.
+     */
     void publish(const std::string& routingKey, const std::string& message) override {
-        if (!channel_ || !running_) {
-            std::cerr << "[RabbitMQAdapter] Cannot publish: not connected" << std::endl;
+        publish(routingKey, message, "application/json");
+    }
+
+    /**
+     * @brief Поставить сообщение в очередь с заданным AMQP content-type
+     */
+    void publish(const std::string& routingKey, const std::string& message,
+                 const std::string& contentType) override {
+        if (!running_) {
+            drop("not started");
+            return;
+        }
+        if (queued_.fetch_add(1, std::memory_order_relaxed) >= publishQueueLimit_) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            drop("publish queue is full");
             return;
         }
 
-        try {
-            channel_->publish(exchangeName_, routingKey, message);
-            std::cout << "[RabbitMQAdapter] Published " << routingKey 
-                      << ": " << message.substr(0, 100) << "..." << std::endl;
-        } catch (const std::exception& e) {
-            std::cerr << "[RabbitMQAdapter] Publish error: " << e.what() << std::endl;
+        publishQueue_.push(OutgoingMessage{routingKey, message, contentType});
+
+        // Один drain на пачку: пока он запланирован, писатели не постят новых
+        if (!drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+            boost::asio::post(ioContext_, [this]() { drainPublishQueue(); });
         }
     }
 
+    bool binaryWireFormat() const override {
+        return binaryWireFormat_;
+    }
+
+    /**
+     * @brief В очереди на отправку + ждут publisher confirm
+     */
+    size_t pendingMessages() const override {
+        return queued_.load(std::memory_order_relaxed) + inFlight_.load(std::memory_order_relaxed);
+    }
+
+    PublisherStats publisherStats() const {
+        PublisherStats s;
+        s.queued = queued_.load(std::memory_order_relaxed);
+        s.inFlight = inFlight_.load(std::memory_order_relaxed);
+        s.sent = sent_.load(std::memory_order_relaxed);
+        s.confirmed = confirmed_.load(std::memory_order_relaxed);
+        s.nacked = nacked_.load(std::memory_order_relaxed);
+        s.dropped = dropped_.load(std::memory_order_relaxed);
+        return s;
+    }
+
     // =========================================================================
     // IEventConsumer
     // =========================================================================
@@ -89,6 +155,33 @@ public:
         }
     }
 
+    /**
+     * @brief Подписаться с отложенным подтверждением
+     *
+     * Сообщение подтверждается брокеру только когда ack вызовут все
+     * async-обработчики ключа (и отработают синхронные). Вместе с
+     * RABBITMQ_PREFETCH это ограничивает число команд в обработке:
+     * пока обработчик не отпустит сообщение, RabbitMQ не пришлёт сверх окна.
+     *
+     * ack можно вызывать из любого потока - сам basic.ack уходит
+     * в поток io_context. Если обработчик бросил исключение, сообщение
+     * подтверждается сразу.
+     */
+    void subscribeAsync(const std::vector<std::string>& routingKeys,
+                        ports::output::AsyncEventHandler handler) override {
+        std::lock_guard<std::mutex> lock(handlersMutex_);
+
+        for (const auto& key : routingKeys) {
+            asyncHandlers_[key].push_back(handler);
+            pendingBindings_.push_back(key);
+            std::cout << "[RabbitMQAdapter] Registered async handler for: " << key << std::endl;
+        }
+
+        if (connected_ && channel_) {
+            applyPendingBindings();
+        }
+    }
+
     /**
      * @brief Запустить прослушивание
      * 
@@ -119,6 +212,7 @@ public:
         
         running_ = false;
         connected_ = false;
+        publishReady_ = false;
         ioContext_.stop();
         
         if (workerThread_.joinable()) {
@@ -145,10 +239,28 @@ private:
             AMQP::Address(connStr));
         channel_ = std::make_unique<AMQP::TcpChannel>(connection_.get());
         
+        // Publisher confirms: брокер подтверждает опубликованные сообщения
+        channel_->confirmSelect()
+            .onSuccess([]() {
+                std::cout << "[RabbitMQAdapter] Publisher confirms enabled" << std::endl;
+            })
+            .onAck([this](uint64_t deliveryTag, bool multiple) {
+                settle(deliveryTag, multiple, true);
+            })
+            .onNack([this](uint64_t deliveryTag, bool multiple, bool) {
+                settle(deliveryTag, multiple, false);
+            })
+            .onError([](const char* msg) {
+                std::cerr << "[RabbitMQAdapter] Confirm select error: " << msg << std::endl;
+            });
+
         // Объявляем exchange
         channel_->declareExchange(exchangeName_, AMQP::topic, AMQP::durable)
             .onSuccess([this]() {
                 std::cout << "[RabbitMQAdapter] Exchange declared: " << exchangeName_ << std::endl;
+                // Exchange есть - можно отправлять накопленное
+                publishReady_ = true;
+                drainPublishQueue();
                 setupQueue();
             })
             .onError([](const char* msg) {
@@ -199,8 +311,13 @@ private:
     }
 
     void startConsuming() {
-        std::cout << "[RabbitMQAdapter] Starting consumer on queue: " << queueName_ << std::endl;
+        std::cout << "[RabbitMQAdapter] Starting consumer on queue: " << queueName_
+                  << " (prefetch=" << settings_->getPrefetch() << ")" << std::endl;
         
+        // Окно неподтверждённых сообщений: async-обработчики держат ack,
+        // пока команда не пройдёт конвейер, и брокер не шлёт сверх окна
+        channel_->setQos(static_cast<uint16_t>(settings_->getPrefetch()));
+
         channel_->consume(queueName_)
             .onReceived([this](const AMQP::Message& msg, uint64_t tag, bool) {
                 std::string routingKey = msg.routingkey();
@@ -212,6 +329,18 @@ private:
                 // Вызываем handlers
                 std::lock_guard<std::mutex> lock(handlersMutex_);
                 auto it = handlers_.find(routingKey);
+                auto asyncIt = asyncHandlers_.find(routingKey);
+                size_t asyncCount = (asyncIt != asyncHandlers_.end()) ? asyncIt->second.size() : 0;
+
+                // Сообщение подтверждается, когда его отпустят все async-обработчики
+                // и синхронная часть (последний release ниже)
+                auto pending = std::make_shared<std::atomic<size_t>>(asyncCount + 1);
+                auto release = [this, tag, pending]() {
+                    if (pending->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        postAck(tag);
+                    }
+                };
+
                 if (it != handlers_.end()) {
                     for (const auto& handler : it->second) {
                         try {
@@ -220,11 +349,28 @@ private:
                             std::cerr << "[RabbitMQAdapter] Handler error: " << e.what() << std::endl;
                         }
                     }
-                } else {
+                }
+                if (asyncCount > 0) {
+                    for (const auto& handler : asyncIt->second) {
+                        auto acked = std::make_shared<std::atomic<bool>>(false);
+                        auto ack = [release, acked]() {
+                            if (!acked->exchange(true, std::memory_order_acq_rel)) {
+                                release();
+                            }
+                        };
+                        try {
+                            handler(routingKey, body, ack);
+                        } catch (const std::exception& e) {
+                            std::cerr << "[RabbitMQAdapter] Handler error: " << e.what() << std::endl;
+                            ack();
+                        }
+                    }
+                }
+                if (it == handlers_.end() && asyncCount == 0) {
                     std::cout << "[RabbitMQAdapter] No handler for: " << routingKey << std::endl;
                 }
                 
-                channel_->ack(tag);
+                release();
             })
             .onError([](const char* msg) {
                 std::cerr << "[RabbitMQAdapter] Consume error: " << msg << std::endl;
@@ -233,12 +379,143 @@ private:
         std::cout << "[RabbitMQAdapter] Consumer started, waiting for messages..." << std::endl;
     }
 
+    /**
+     * @brief Подтвердить сообщение (basic.ack выполняется в потоке io_context)
+     */
+    void postAck(uint64_t tag) {
+        if (ioContext_.get_executor().running_in_this_thread()) {
+            if (channel_) {
+                channel_->ack(tag);
+            }
+            return;
+        }
+        boost::asio::post(ioContext_, [this, tag]() {
+            if (channel_ && connected_) {
+                channel_->ack(tag);
+            }
+        });
+    }
+
+    // =========================================================================
+    // Публикация (поток io_context)
+    // =========================================================================
+
+    struct OutgoingMessage {
+        std::string routingKey;
+        std::string body;
+        std::string contentType;
+    };
+
+    /// Сколько сообщений отправлять за одно пробуждение, не отдавая io_context
+    static constexpr size_t DRAIN_BATCH = 1024;
+
+    /**
+     * @brief Отправить накопленные сообщения в канал
+     *
+     * Флаг drainScheduled_ снимается только после опустошения очереди,
+     * затем очередь проверяется ещё раз: писатель, увидевший флаг
+     * поднятым, рассчитывает, что его сообщение заберёт этот drain.
+     */
+    void drainPublishQueue() {
+        if (!publishReady_ || !channel_) {
+            return;  // флаг остаётся поднятым - отправим после объявления exchange
+        }
+
+        for (;;) {
+            OutgoingMessage message;
+            size_t batch = 0;
+            while (batch < DRAIN_BATCH && publishQueue_.pop(message)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                send(message);
+                ++batch;
+            }
+            if (batch == DRAIN_BATCH) {
+                // Даём io_context обработать входящие кадры и confirms
+                boost::asio::post(ioContext_, [this]() { drainPublishQueue(); });
+                return;
+            }
+
+            drainScheduled_.exchange(false, std::memory_order_acq_rel);
+            if (publishQueue_.empty()) {
+                return;
+            }
+            if (drainScheduled_.exchange(true, std::memory_order_acq_rel)) {
+                return;  // уже запланирован писателем
+            }
+        }
+    }
+
+    void send(const OutgoingMessage& message) {
+        try {
+            AMQP::Envelope envelope(message.body.data(), message.body.size());
+            envelope.setContentType(message.contentType);
+            if (!channel_->publish(exchangeName_, message.routingKey, envelope)) {
+                drop("channel is not usable");
+                return;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[RabbitMQAdapter] Publish error: " << e.what() << std::endl;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // delivery tag этого сообщения = unconfirmedBase_ + unconfirmed_.size()
+        unconfirmed_.push_back(false);
+        sent_.fetch_add(1, std::memory_order_relaxed);
+        inFlight_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Учесть ack/nack брокера (multiple - все теги до deliveryTag)
+     */
+    void settle(uint64_t deliveryTag, bool multiple, bool ack) {
+        if (deliveryTag < unconfirmedBase_) {
+            return;
+        }
+        uint64_t from = multiple ? unconfirmedBase_ : deliveryTag;
+        size_t settled = 0;
+        for (uint64_t tag = from; tag <= deliveryTag; ++tag) {
+            size_t index = static_cast<size_t>(tag - unconfirmedBase_);
+            if (index >= unconfirmed_.size()) {
+                break;
+            }
+            if (!unconfirmed_[index]) {
+                unconfirmed_[index] = true;
+                ++settled;
+            }
+        }
+        while (!unconfirmed_.empty() && unconfirmed_.front()) {
+            unconfirmed_.pop_front();
+            ++unconfirmedBase_;
+        }
+
+        inFlight_.fetch_sub(settled, std::memory_order_relaxed);
+        if (ack) {
+            confirmed_.fetch_add(settled, std::memory_order_relaxed);
+        } else {
+            nacked_.fetch_add(settled, std::memory_order_relaxed);
+            std::cerr << "[RabbitMQAdapter] Broker nacked " << settled << " message(s)" << std::endl;
+        }
+    }
+
+    /**
+     * @brief Посчитать отброшенное сообщение (в лог - только первое)
+     */
+    void drop(const char* reason) {
+        if (dropped_.fetch_add(1, std::memory_order_relaxed) == 0) {
+            std::cerr << "[RabbitMQAdapter] Message dropped: " << reason
+                      << " (further drops are only counted)" << std::endl;
+        }
+    }
+
     std::shared_ptr<settings::RabbitMQSettings> settings_;
+    const size_t publishQueueLimit_;
+    const bool binaryWireFormat_;
     std::string exchangeName_;
     std::string queueName_;
     
     std::atomic<bool> running_;
     std::atomic<bool> connected_;
+    std::atomic<bool> publishReady_{false};
     boost::asio::io_context ioContext_;
     AMQP::LibBoostAsioHandler handler_;
     
@@ -249,7 +526,20 @@ private:
     
     std::mutex handlersMutex_;
     std::unordered_map<std::string, std::vector<ports::output::EventHandler>> handlers_;
+    std::unordered_map<std::string, std::vector<ports::output::AsyncEventHandler>> asyncHandlers_;
     std::vector<std::string> pendingBindings_;
+
+    MpscQueue<OutgoingMessage> publishQueue_;
+    std::atomic<bool> drainScheduled_{false};
+    std::deque<bool> unconfirmed_;      ///< Флаги "подтверждено" по delivery tag (поток io_context)
+    uint64_t unconfirmedBase_ = 1;      ///< delivery tag первого элемента unconfirmed_
+
+    std::atomic<size_t> queued_{0};
+    std::atomic<size_t> inFlight_{0};
+    std::atomic<uint64_t> sent_{0};
+    std::atomic<uint64_t> confirmed_{0};
+    std::atomic<uint64_t> nacked_{0};
+    std::atomic<uint64_t> dropped_{0};
 };
 
 } // namespace broker::adapters::secondary
@@ -2,6 +2,7 @@
 #pragma once
 
 #include "ports/output/IEventPublisher.hpp"
+#include "application/events/EventWireFormat.hpp"
 #include "domain/Quote.hpp"
 #include "domain/Portfolio.hpp"
 #include <nlohmann/json.hpp>
@@ -17,6 +18,14 @@ namespace broker::application {
  * Публикует события в broker.events exchange:
  * - quote.updated → изменение котировки инструмента
  * - portfolio.updated → изменение портфеля (позиции, баланс)
+ *
+ * quote.updated кодируется бинарным фреймом, если транспорт включил
+ * бинарный формат (IEventPublisher::binaryWireFormat), иначе - JSON.
+ * portfolio.updated всегда JSON.
+ *
+ * Поток котировок тикера сюда не идёт: его схлопывает и рассылает
+ * пачками ConflatingQuotePublisher. publishQuoteUpdate - разовая
+ * публикация одной котировки.
  */
 class MarketDataPublisher {
 public:
@@ -27,6 +36,18 @@ public:
     }
 
     void publishQuoteUpdate(const domain::Quote& quote) {
+        if (eventPublisher_->binaryWireFormat()) {
+            wire::QuoteFrame frame;
+            frame.figi = quote.figi;
+            frame.bid = quote.bidPrice.toDouble();
+            frame.ask = quote.askPrice.toDouble();
+            frame.last = quote.lastPrice.toDouble();
+            frame.currency = quote.lastPrice.currency;
+            frame.timestampMs = getCurrentTimestamp();
+            eventPublisher_->publish("quote.updated", wire::encode(frame), wire::CONTENT_TYPE_BINARY);
+            return;
+        }
+
         nlohmann::json event;
         event["figi"] = quote.figi;
         event["bid"] = quote.bidPrice.toDouble();
@@ -4,15 +4,24 @@
 #include "ports/output/IEventConsumer.hpp"
 #include "ports/output/IEventPublisher.hpp"
 #include "ports/output/IBrokerGateway.hpp"
+#include "settings/OrderPipelineSettings.hpp"
+#include "application/pipeline/BoundedQueue.hpp"
+#include "application/pipeline/LatencyHistogram.hpp"
+#include "application/events/EventWireFormat.hpp"
 #include "domain/OrderRequest.hpp"
 #include "domain/OrderResult.hpp"
 #include "domain/enums/OrderDirection.hpp"
 #include "domain/enums/OrderType.hpp"
 #include "domain/Money.hpp"
 #include <nlohmann/json.hpp>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <iostream>
 #include <chrono>
+#include <thread>
+#include <vector>
 
 namespace broker::application {
 
@@ -29,50 +38,236 @@ namespace broker::application {
  * - order.partially_filled → частичное исполнение
  * - order.rejected → ордер отклонён
  * - order.cancelled → ордер отменён
+ *
+ * Команды проходят конвейер из трёх стадий, чтобы медленный placeOrder
+ * (синхронные запросы в Postgres) не держал поток io_context RabbitMQ:
+ * 1. decode - разбор JSON и валидация, прямо в потоке консьюмера;
+ * 2. execute - пул воркеров; воркер выбирается по hash(account_id),
+ *    поэтому команды одного аккаунта исполняются строго по порядку;
+ * 3. publish - один поток забирает результаты пачками, публикует
+ *    события и подтверждает (ack) исходные команды.
+ *
+ * Очереди между стадиями ограничены (BROKER_ORDER_QUEUE_CAPACITY).
+ * Команда подтверждается брокеру только после публикации результатов,
+ * поэтому RABBITMQ_PREFETCH задаёт предел команд в конвейере: когда окно
+ * выбрано, RabbitMQ сам перестаёт доставлять новые.
+ *
+ * Глубина очередей и гистограммы задержек по стадиям - в stats().
+ *
+ * При RABBITMQ_WIRE_FORMAT=binary события order.* кодируются в
+ * wire::OrderFrame вместо JSON (см. EventWireFormat.hpp).
  */
 class OrderCommandHandler {
 public:
+    /**
+     * @brief Измеряемые участки конвейера
+     */
+    enum class Stage {
+        DECODE,           ///< Разбор и валидация команды
+        EXECUTE_QUEUE,    ///< Ожидание свободного воркера
+        EXECUTE,          ///< placeOrder / cancelOrder
+        PUBLISH_QUEUE,    ///< Ожидание потока публикации
+        PUBLISH,          ///< Публикация пачки событий (одно наблюдение на пачку)
+        TOTAL             ///< От получения до ack
+    };
+
+    static constexpr size_t STAGE_COUNT = 6;
+
+    static const char* toString(Stage stage) {
+        switch (stage) {
+            case Stage::DECODE:        return "decode";
+            case Stage::EXECUTE_QUEUE: return "execute_queue";
+            case Stage::EXECUTE:       return "execute";
+            case Stage::PUBLISH_QUEUE: return "publish_queue";
+            case Stage::PUBLISH:       return "publish";
+            case Stage::TOTAL:         return "total";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Снимок метрик конвейера
+     */
+    struct Stats {
+        size_t workers = 0;
+        size_t queueCapacity = 0;       ///< Ёмкость очереди одного воркера / публикации
+        size_t executeQueueDepth = 0;   ///< Команд в очередях воркеров (сумма)
+        size_t publishQueueDepth = 0;   ///< Результатов в очереди публикации
+        size_t inFlight = 0;            ///< Принято, но ещё не подтверждено
+        uint64_t received = 0;
+        uint64_t completed = 0;
+        uint64_t decodeErrors = 0;      ///< Нечитаемые команды (подтверждены без обработки)
+        uint64_t publishBatches = 0;
+        std::array<pipeline::LatencyHistogram::Snapshot, STAGE_COUNT> latency{};
+    };
+
     OrderCommandHandler(
         std::shared_ptr<ports::output::IEventConsumer> eventConsumer,
         std::shared_ptr<ports::output::IEventPublisher> eventPublisher,
-        std::shared_ptr<ports::output::IBrokerGateway> brokerGateway
+        std::shared_ptr<ports::output::IBrokerGateway> brokerGateway,
+        std::shared_ptr<settings::OrderPipelineSettings> settings
     ) : eventConsumer_(std::move(eventConsumer))
       , eventPublisher_(std::move(eventPublisher))
       , brokerGateway_(std::move(brokerGateway))
+      , binaryWireFormat_(eventPublisher_->binaryWireFormat())
+      , queueCapacity_(static_cast<size_t>(settings->getQueueCapacity()))
+      , publishBatch_(static_cast<size_t>(settings->getPublishBatch()))
+      , publishQueue_(queueCapacity_)
     {
-        std::cout << "[OrderCommandHandler] Created" << std::endl;
+        size_t workers = static_cast<size_t>(settings->getWorkers());
+        for (size_t i = 0; i < workers; ++i) {
+            workerQueues_.push_back(std::make_unique<pipeline::BoundedQueue<Command>>(queueCapacity_));
+        }
+        for (size_t i = 0; i < workers; ++i) {
+            workerThreads_.emplace_back([this, i] { runWorker(i); });
+        }
+        publisherThread_ = std::thread([this] { runPublisher(); });
+
+        std::cout << "[OrderCommandHandler] Created (workers=" << workers
+                  << ", queue=" << queueCapacity_
+                  << ", publishBatch=" << publishBatch_ << ")" << std::endl;
         subscribe();
     }
 
+    ~OrderCommandHandler() {
+        stop();
+    }
+
+    OrderCommandHandler(const OrderCommandHandler&) = delete;
+    OrderCommandHandler& operator=(const OrderCommandHandler&) = delete;
+
+    /**
+     * @brief Остановить конвейер, дообработав уже принятые команды
+     *
+     * Команды, пришедшие после stop(), не подтверждаются и будут
+     * доставлены брокером повторно.
+     */
+    void stop() {
+        if (stopped_.exchange(true)) {
+            return;
+        }
+        for (auto& queue : workerQueues_) {
+            queue->close();
+        }
+        for (auto& thread : workerThreads_) {
+            if (thread.joinable()) {
+                thread.join();
+            }
+        }
+        publishQueue_.close();
+        if (publisherThread_.joinable()) {
+            publisherThread_.join();
+        }
+        std::cout << "[OrderCommandHandler] Stopped" << std::endl;
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.workers = workerQueues_.size();
+        s.queueCapacity = queueCapacity_;
+        for (const auto& queue : workerQueues_) {
+            s.executeQueueDepth += queue->size();
+        }
+        s.publishQueueDepth = publishQueue_.size();
+        s.inFlight = inFlight_.load(std::memory_order_relaxed);
+        s.received = received_.load(std::memory_order_relaxed);
+        s.completed = completed_.load(std::memory_order_relaxed);
+        s.decodeErrors = decodeErrors_.load(std::memory_order_relaxed);
+        s.publishBatches = publishBatches_.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < STAGE_COUNT; ++i) {
+            s.latency[i] = latency_[i].snapshot();
+        }
+        return s;
+    }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event {
+        std::string routingKey;
+        std::string payload;
+        std::string contentType = wire::CONTENT_TYPE_JSON;
+    };
+
+    /**
+     * @brief Разобранная команда (decode → execute)
+     */
+    struct Command {
+        enum class Kind { CREATE, CANCEL, REJECT };
+
+        Kind kind = Kind::REJECT;
+        domain::OrderRequest request;   ///< orderId, accountId, figi - для всех видов
+        std::string rejectReason;       ///< Для REJECT: причина отказа валидации
+        ports::output::AckCallback ack;
+        Clock::time_point receivedAt;
+        Clock::time_point enqueuedAt;
+    };
+
+    /**
+     * @brief Результат исполнения команды (execute → publish)
+     */
+    struct Publication {
+        std::vector<Event> events;
+        ports::output::AckCallback ack;
+        Clock::time_point receivedAt;
+        Clock::time_point enqueuedAt;
+    };
+
     void subscribe() {
         std::cout << "[OrderCommandHandler] Subscribing to order.create, order.cancel" << std::endl;
         
-        eventConsumer_->subscribe(
+        eventConsumer_->subscribeAsync(
             {"order.create", "order.cancel"},
-            [this](const std::string& routingKey, const std::string& message) {
-                handleCommand(routingKey, message);
+            [this](const std::string& routingKey, const std::string& message,
+                   ports::output::AckCallback ack) {
+                handleCommand(routingKey, message, std::move(ack));
             }
         );
     }
 
-    void handleCommand(const std::string& routingKey, const std::string& message) {
+    // =========================================================================
+    // Стадия 1: decode (поток консьюмера)
+    // =========================================================================
+
+    void handleCommand(const std::string& routingKey, const std::string& message,
+                       ports::output::AckCallback ack) {
+        auto receivedAt = Clock::now();
+        received_.fetch_add(1, std::memory_order_relaxed);
         std::cout << "[OrderCommandHandler] Received " << routingKey << std::endl;
-        
+
+        Command command;
         try {
             auto json = nlohmann::json::parse(message);
             
             if (routingKey == "order.create") {
-                handleCreateOrder(json);
+                decodeCreateOrder(json, command);
             } else if (routingKey == "order.cancel") {
-                handleCancelOrder(json);
+                decodeCancelOrder(json, command);
+            } else {
+                ack();
+                return;
             }
         } catch (const std::exception& e) {
             std::cerr << "[OrderCommandHandler] Error: " << e.what() << std::endl;
+            decodeErrors_.fetch_add(1, std::memory_order_relaxed);
+            ack();
+            return;
+        }
+
+        command.ack = std::move(ack);
+        command.receivedAt = receivedAt;
+        command.enqueuedAt = Clock::now();
+        observe(Stage::DECODE, receivedAt, command.enqueuedAt);
+
+        auto& queue = *workerQueues_[workerFor(command.request.accountId)];
+        inFlight_.fetch_add(1, std::memory_order_relaxed);
+        if (!queue.push(std::move(command))) {
+            inFlight_.fetch_sub(1, std::memory_order_relaxed);
+            std::cerr << "[OrderCommandHandler] Stopped, " << routingKey << " left unacknowledged" << std::endl;
         }
     }
 
-    void handleCreateOrder(const nlohmann::json& json) {
+    void decodeCreateOrder(const nlohmann::json& json, Command& command) {
         std::string orderId = json.value("order_id", "");
         std::string accountId = json.value("account_id", "");
         std::string figi = json.value("figi", "");
@@ -82,30 +277,32 @@ private:
         double price = json.value("price", 0.0);
         std::string currency = json.value("currency", "RUB");
         
+        command.request.orderId = orderId;
+        command.request.accountId = accountId;
+        command.request.figi = figi;
+
         // Валидация обязательных полей
         if (orderId.empty()) {
             std::cerr << "[OrderCommandHandler] Rejected: missing order_id" << std::endl;
-            publishOrderRejected("unknown", accountId, figi, "Missing required field: order_id");
+            reject(command, "unknown", "Missing required field: order_id");
             return;
         }
         if (accountId.empty()) {
             std::cerr << "[OrderCommandHandler] Rejected: missing account_id" << std::endl;
-            publishOrderRejected(orderId, "", figi, "Missing required field: account_id");
+            reject(command, orderId, "Missing required field: account_id");
             return;
         }
         if (figi.empty()) {
             std::cerr << "[OrderCommandHandler] Rejected: missing figi" << std::endl;
-            publishOrderRejected(orderId, accountId, "", "Missing required field: figi");
+            reject(command, orderId, "Missing required field: figi");
             return;
         }
         if (quantity <= 0) {
             std::cerr << "[OrderCommandHandler] Rejected: invalid quantity" << std::endl;
-            publishOrderRejected(orderId, accountId, figi, "Invalid quantity: must be > 0");
+            reject(command, orderId, "Invalid quantity: must be > 0");
             return;
         }
         
-        std::cout << "[OrderCommandHandler] Creating order " << orderId << std::endl;
-        
         domain::OrderDirection direction = (directionStr == "SELL") 
             ? domain::OrderDirection::SELL 
             : domain::OrderDirection::BUY;
@@ -114,64 +311,180 @@ private:
             ? domain::OrderType::LIMIT 
             : domain::OrderType::MARKET;
         
-        // Создаём request с orderId от trading-service
-        domain::OrderRequest request;
-        request.orderId = orderId;  // ВАЖНО: передаём orderId!
-        request.figi = figi;
-        request.quantity = quantity;
-        request.direction = direction;
-        request.type = type;
-        request.price = domain::Money::fromDouble(price, currency);
-        
-        // Публикуем order.created
-        publishOrderCreated(orderId, accountId, figi);
+        // Request с orderId от trading-service
+        command.kind = Command::Kind::CREATE;
+        command.request.quantity = quantity;
+        command.request.direction = direction;
+        command.request.type = type;
+        command.request.price = domain::Money::fromDouble(price, currency);
+    }
+
+    void decodeCancelOrder(const nlohmann::json& json, Command& command) {
+        command.kind = Command::Kind::CANCEL;
+        command.request.orderId = json.value("order_id", "");
+        command.request.accountId = json.value("account_id", "");
+    }
+
+    /**
+     * @brief Отказ валидации тоже идёт через воркер аккаунта,
+     *        чтобы не обогнать его предыдущие команды
+     */
+    static void reject(Command& command, const std::string& orderId, const std::string& reason) {
+        command.kind = Command::Kind::REJECT;
+        command.request.orderId = orderId;
+        command.rejectReason = reason;
+    }
+
+    size_t workerFor(const std::string& accountId) const {
+        return std::hash<std::string>{}(accountId) % workerQueues_.size();
+    }
+
+    // =========================================================================
+    // Стадия 2: execute (пул воркеров)
+    // =========================================================================
+
+    void runWorker(size_t index) {
+        auto& queue = *workerQueues_[index];
+        Command command;
+        while (queue.pop(command)) {
+            auto startedAt = Clock::now();
+            observe(Stage::EXECUTE_QUEUE, command.enqueuedAt, startedAt);
+
+            Publication publication;
+            try {
+                execute(command, publication.events);
+            } catch (const std::exception& e) {
+                std::cerr << "[OrderCommandHandler] Error: " << e.what() << std::endl;
+            }
+
+            publication.ack = std::move(command.ack);
+            publication.receivedAt = command.receivedAt;
+            publication.enqueuedAt = Clock::now();
+            observe(Stage::EXECUTE, startedAt, publication.enqueuedAt);
+
+            publishQueue_.push(std::move(publication));
+        }
+    }
+
+    void execute(const Command& command, std::vector<Event>& events) {
+        const auto& request = command.request;
+        switch (command.kind) {
+            case Command::Kind::CREATE:
+                executeCreateOrder(request, events);
+                break;
+            case Command::Kind::CANCEL:
+                executeCancelOrder(request, events);
+                break;
+            case Command::Kind::REJECT:
+                addOrderRejected(events, request.orderId, request.accountId, request.figi, command.rejectReason);
+                break;
+        }
+    }
+
+    void executeCreateOrder(const domain::OrderRequest& request, std::vector<Event>& events) {
+        std::cout << "[OrderCommandHandler] Creating order " << request.orderId << std::endl;
+
+        // order.created публикуется первым в пачке результата
+        addOrderCreated(events, request.orderId, request.accountId, request.figi);
         
         // Исполняем (FakeBrokerAdapter использует request.orderId)
-        auto result = brokerGateway_->placeOrder(accountId, request);
+        auto result = brokerGateway_->placeOrder(request.accountId, request);
         
-        // Публикуем результат
         if (result.status == domain::OrderStatus::FILLED) {
-            publishOrderFilled(result, accountId, figi);
+            addOrderFilled(events, result, request.accountId, request.figi);
         } else if (result.status == domain::OrderStatus::PARTIALLY_FILLED) {
-            publishOrderPartiallyFilled(result, accountId, figi);
+            addOrderPartiallyFilled(events, result, request.accountId, request.figi);
         } else if (result.status == domain::OrderStatus::REJECTED) {
-            publishOrderRejected(orderId, accountId, figi, result.message);
+            addOrderRejected(events, request.orderId, request.accountId, request.figi, result.message);
         }
     }
 
-    void handleCancelOrder(const nlohmann::json& json) {
-        std::string orderId = json.value("order_id", "");
-        std::string accountId = json.value("account_id", "");
-        
-        std::cout << "[OrderCommandHandler] CANCEL order_id=" << orderId << " account_id=" << accountId << std::endl;
+    void executeCancelOrder(const domain::OrderRequest& request, std::vector<Event>& events) {
+        std::cout << "[OrderCommandHandler] CANCEL order_id=" << request.orderId
+                  << " account_id=" << request.accountId << std::endl;
         
-        bool cancelled = brokerGateway_->cancelOrder(accountId, orderId);
+        bool cancelled = brokerGateway_->cancelOrder(request.accountId, request.orderId);
         
         std::cout << "[OrderCommandHandler] cancelOrder=" << (cancelled ? "true" : "false") << std::endl;
         
         if (cancelled) {
-            publishOrderCancelled(orderId, accountId);
-            std::cout << "[OrderCommandHandler] Published order.cancelled" << std::endl;
+            addOrderCancelled(events, request.orderId, request.accountId);
         }
     }
 
-    void publishOrderCreated(const std::string& orderId, const std::string& accountId, const std::string& figi) {
+    // =========================================================================
+    // Стадия 3: publish (один поток, пачками)
+    // =========================================================================
+
+    void runPublisher() {
+        std::vector<Publication> batch;
+        batch.reserve(publishBatch_);
+
+        while (publishQueue_.popBatch(batch, publishBatch_) > 0) {
+            auto startedAt = Clock::now();
+            for (const auto& publication : batch) {
+                observe(Stage::PUBLISH_QUEUE, publication.enqueuedAt, startedAt);
+                for (const auto& event : publication.events) {
+                    try {
+                        eventPublisher_->publish(event.routingKey, event.payload, event.contentType);
+                    } catch (const std::exception& e) {
+                        std::cerr << "[OrderCommandHandler] Publish error: " << e.what() << std::endl;
+                    }
+                }
+            }
+            auto finishedAt = Clock::now();
+            observe(Stage::PUBLISH, startedAt, finishedAt);
+
+            // Подтверждаем команды только после публикации их результатов
+            for (auto& publication : batch) {
+                if (publication.ack) {
+                    publication.ack();
+                }
+                observe(Stage::TOTAL, publication.receivedAt, finishedAt);
+                inFlight_.fetch_sub(1, std::memory_order_relaxed);
+                completed_.fetch_add(1, std::memory_order_relaxed);
+            }
+            publishBatches_.fetch_add(1, std::memory_order_relaxed);
+            batch.clear();
+        }
+    }
+
+    // =========================================================================
+    // События
+    // =========================================================================
+
+    void addOrderCreated(std::vector<Event>& events, const std::string& orderId,
+                         const std::string& accountId, const std::string& figi) {
+        if (binaryWireFormat_) {
+            auto frame = orderFrame(orderId, accountId, figi, wire::OrderStatus::PENDING);
+            addBinary(events, "order.created", frame);
+            return;
+        }
         nlohmann::json event;
         event["order_id"] = orderId;
         event["account_id"] = accountId;
         event["figi"] = figi;
         event["status"] = "PENDING";
         event["timestamp"] = getCurrentTimestamp();
-        eventPublisher_->publish("order.created", event.dump());
+        events.push_back(Event{"order.created", event.dump()});
     }
 
-    void publishOrderFilled(const domain::OrderResult& result, const std::string& accountId, const std::string& figi) {
+    void addOrderFilled(std::vector<Event>& events, const domain::OrderResult& result,
+                        const std::string& accountId, const std::string& figi) {
         std::cout << "[OrderCommandHandler] FILLED order=" << result.orderId 
                   << " account=" << accountId 
                   << " figi=" << figi 
                   << " lots=" << result.executedLots 
                   << " price=" << result.executedPrice.toDouble() << std::endl;
         
+        if (binaryWireFormat_) {
+            auto frame = orderFrame(result.orderId, accountId, figi, wire::OrderStatus::FILLED);
+            frame.lots = result.executedLots;
+            frame.price = result.executedPrice.toDouble();
+            frame.currency = result.executedPrice.currency;
+            addBinary(events, "order.filled", frame);
+            return;
+        }
         nlohmann::json event;
         event["order_id"] = result.orderId;
         event["account_id"] = accountId;
@@ -181,10 +494,19 @@ private:
         event["executed_price"] = result.executedPrice.toDouble();
         event["currency"] = result.executedPrice.currency;
         event["timestamp"] = getCurrentTimestamp();
-        eventPublisher_->publish("order.filled", event.dump());
+        events.push_back(Event{"order.filled", event.dump()});
     }
 
-    void publishOrderPartiallyFilled(const domain::OrderResult& result, const std::string& accountId, const std::string& figi) {
+    void addOrderPartiallyFilled(std::vector<Event>& events, const domain::OrderResult& result,
+                                 const std::string& accountId, const std::string& figi) {
+        if (binaryWireFormat_) {
+            auto frame = orderFrame(result.orderId, accountId, figi, wire::OrderStatus::PARTIALLY_FILLED);
+            frame.lots = result.executedLots;
+            frame.price = result.executedPrice.toDouble();
+            frame.currency = result.executedPrice.currency;
+            addBinary(events, "order.partially_filled", frame);
+            return;
+        }
         nlohmann::json event;
         event["order_id"] = result.orderId;
         event["account_id"] = accountId;
@@ -193,15 +515,22 @@ private:
         event["filled_lots"] = result.executedLots;
         event["executed_price"] = result.executedPrice.toDouble();
         event["timestamp"] = getCurrentTimestamp();
-        eventPublisher_->publish("order.partially_filled", event.dump());
+        events.push_back(Event{"order.partially_filled", event.dump()});
     }
 
-    void publishOrderRejected(const std::string& orderId, const std::string& accountId, const std::string& figi, const std::string& reason) {
+    void addOrderRejected(std::vector<Event>& events, const std::string& orderId, const std::string& accountId,
+                          const std::string& figi, const std::string& reason) {
         std::cout << "[OrderCommandHandler] REJECTED order=" << orderId 
                   << " account=" << accountId 
                   << " figi=" << figi 
                   << " reason=" << reason << std::endl;
         
+        if (binaryWireFormat_) {
+            auto frame = orderFrame(orderId, accountId, figi, wire::OrderStatus::REJECTED);
+            frame.reason = reason;
+            addBinary(events, "order.rejected", frame);
+            return;
+        }
         nlohmann::json event;
         event["order_id"] = orderId;
         event["account_id"] = accountId;
@@ -209,16 +538,41 @@ private:
         event["status"] = "REJECTED";
         event["reason"] = reason;
         event["timestamp"] = getCurrentTimestamp();
-        eventPublisher_->publish("order.rejected", event.dump());
+        events.push_back(Event{"order.rejected", event.dump()});
     }
 
-    void publishOrderCancelled(const std::string& orderId, const std::string& accountId) {
+    void addOrderCancelled(std::vector<Event>& events, const std::string& orderId, const std::string& accountId) {
+        if (binaryWireFormat_) {
+            auto frame = orderFrame(orderId, accountId, "", wire::OrderStatus::CANCELLED);
+            addBinary(events, "order.cancelled", frame);
+            return;
+        }
         nlohmann::json event;
         event["order_id"] = orderId;
         event["account_id"] = accountId;
         event["status"] = "CANCELLED";
         event["timestamp"] = getCurrentTimestamp();
-        eventPublisher_->publish("order.cancelled", event.dump());
+        events.push_back(Event{"order.cancelled", event.dump()});
+    }
+
+    wire::OrderFrame orderFrame(std::string_view orderId, std::string_view accountId,
+                                std::string_view figi, wire::OrderStatus status) {
+        wire::OrderFrame frame;
+        frame.orderId = orderId;
+        frame.accountId = accountId;
+        frame.figi = figi;
+        frame.status = status;
+        frame.timestampMs = getCurrentTimestamp();
+        return frame;
+    }
+
+    void addBinary(std::vector<Event>& events, const char* routingKey, const wire::OrderFrame& frame) {
+        events.push_back(Event{routingKey, wire::encode(frame), wire::CONTENT_TYPE_BINARY});
+    }
+
+    void observe(Stage stage, Clock::time_point from, Clock::time_point to) {
+        latency_[static_cast<size_t>(stage)].observe(
+            std::chrono::duration_cast<std::chrono::microseconds>(to - from).count());
     }
 
     int64_t getCurrentTimestamp() {
@@ -229,6 +583,23 @@ private:
     std::shared_ptr<ports::output::IEventConsumer> eventConsumer_;
     std::shared_ptr<ports::output::IEventPublisher> eventPublisher_;
     std::shared_ptr<ports::output::IBrokerGateway> brokerGateway_;
+    const bool binaryWireFormat_;
+
+    const size_t queueCapacity_;
+    const size_t publishBatch_;
+
+    std::vector<std::unique_ptr<pipeline::BoundedQueue<Command>>> workerQueues_;
+    pipeline::BoundedQueue<Publication> publishQueue_;
+    std::vector<std::thread> workerThreads_;
+    std::thread publisherThread_;
+    std::atomic<bool> stopped_{false};
+
+    std::atomic<size_t> inFlight_{0};
+    std::atomic<uint64_t> received_{0};
+    std::atomic<uint64_t> completed_{0};
+    std::atomic<uint64_t> decodeErrors_{0};
+    std::atomic<uint64_t> publishBatches_{0};
+    std::array<pipeline::LatencyHistogram, STAGE_COUNT> latency_;
 };
 
 } // namespace broker::application
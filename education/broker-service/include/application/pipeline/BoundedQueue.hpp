@@ -0,0 +1,116 @@
+// include/application/pipeline/BoundedQueue.hpp
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace broker::application::pipeline {
+
+/**
+ * @brief Ограниченная блокирующая очередь между стадиями конвейера
+ *
+ * push() ждёт, пока в очереди освободится место - так переполнение
+ * следующей стадии доходит до предыдущей (backpressure), а не копится
+ * в памяти. После close() новые элементы не принимаются, а pop()
+ * отдаёт оставшиеся и затем возвращает false.
+ *
+ * Thread-safe: да (MPMC)
+ */
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity)
+        : capacity_(capacity > 0 ? capacity : 1)
+    {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Положить элемент, дождавшись свободного места
+     * @return false если очередь закрыта
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Забрать элемент, дождавшись его появления
+     * @return false если очередь закрыта и пуста
+     */
+    bool pop(T& out) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        out = std::move(items_.front());
+        items_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Забрать до maxItems элементов разом (ждёт хотя бы один)
+     * @return Количество добавленных в out; 0 - очередь закрыта и пуста
+     */
+    size_t popBatch(std::vector<T>& out, size_t maxItems) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+
+        size_t count = 0;
+        while (!items_.empty() && count < maxItems) {
+            out.push_back(std::move(items_.front()));
+            items_.pop_front();
+            ++count;
+        }
+        lock.unlock();
+        if (count > 0) {
+            notFull_.notify_all();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Закрыть очередь: разбудить всех ждущих, новые push() отклоняются
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+private:
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+} // namespace broker::application::pipeline
@@ -0,0 +1,72 @@
+// include/application/pipeline/LatencyHistogram.hpp
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace broker::application::pipeline {
+
+/**
+ * @brief Гистограмма задержек с фиксированными границами корзин
+ *
+ * Границы - от 50 мкс до 1 с, последняя корзина (+Inf) ловит всё остальное.
+ * observe() - несколько relaxed-инкрементов без блокировок, поэтому
+ * вызывается прямо на горячем пути стадии.
+ *
+ * Снимок отдаёт накопительные (cumulative) счётчики, как ждёт формат
+ * Prometheus histogram.
+ *
+ * Thread-safe: да
+ */
+class LatencyHistogram {
+public:
+    static constexpr size_t BOUND_COUNT = 14;
+
+    /// Верхние границы корзин, мкс
+    static constexpr std::array<int64_t, BOUND_COUNT> BOUNDS_MICROS = {
+        50, 100, 250, 500,
+        1000, 2500, 5000, 10000, 25000, 50000,
+        100000, 250000, 500000, 1000000
+    };
+
+    /**
+     * @brief Снимок гистограммы
+     */
+    struct Snapshot {
+        std::array<uint64_t, BOUND_COUNT> cumulative{};   ///< Наблюдений <= BOUNDS_MICROS[i]
+        uint64_t count = 0;                               ///< Всего наблюдений (= корзина +Inf)
+        int64_t sumMicros = 0;
+    };
+
+    void observe(int64_t micros) {
+        if (micros < 0) {
+            micros = 0;
+        }
+        size_t bucket = 0;
+        while (bucket < BOUND_COUNT && micros > BOUNDS_MICROS[bucket]) {
+            ++bucket;
+        }
+        buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        sumMicros_.fetch_add(micros, std::memory_order_relaxed);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot s;
+        uint64_t running = 0;
+        for (size_t i = 0; i < BOUND_COUNT; ++i) {
+            running += buckets_[i].load(std::memory_order_relaxed);
+            s.cumulative[i] = running;
+        }
+        s.count = running + buckets_[BOUND_COUNT].load(std::memory_order_relaxed);
+        s.sumMicros = sumMicros_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, BOUND_COUNT + 1> buckets_{};
+    std::atomic<int64_t> sumMicros_{0};
+};
+
+} // namespace broker::application::pipeline
@@ -1,6 +1,7 @@
 // include/domain/BrokerOrder.hpp
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace broker::domain {
@@ -21,6 +22,7 @@ struct BrokerOrder {
     double executedPrice = 0;
     std::string createdAt;
     std::string updatedAt;
+    int64_t receivedAtUs = 0;   ///< received_at в мкс - ключ курсора истории
 };
 
 } // namespace broker::domain
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Order.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace broker::domain {
+
+/**
+ * @brief Позиция в истории ордеров аккаунта: последний отданный ордер
+ *
+ * История упорядочена по (received_at DESC, order_id DESC); следующая
+ * страница начинается строго после этой пары. Клиенту отдаётся как
+ * непрозрачная строка "<received_at в мкс>_<order_id>".
+ */
+struct OrderCursor {
+    int64_t receivedAtUs = 0;
+    std::string orderId;
+
+    std::string encode() const {
+        return std::to_string(receivedAtUs) + "_" + orderId;
+    }
+
+    /**
+     * @return nullopt, если строка - не курсор
+     */
+    static std::optional<OrderCursor> decode(const std::string& token) {
+        auto sep = token.find('_');
+        if (sep == 0 || sep == std::string::npos || sep + 1 == token.size()) {
+            return std::nullopt;
+        }
+        for (size_t i = 0; i < sep; ++i) {
+            if (token[i] < '0' || token[i] > '9') {
+                return std::nullopt;
+            }
+        }
+        OrderCursor cursor;
+        cursor.receivedAtUs = std::strtoll(token.c_str(), nullptr, 10);
+        cursor.orderId = token.substr(sep + 1);
+        return cursor;
+    }
+};
+
+/**
+ * @brief Фильтр и страница истории ордеров
+ */
+struct OrderQuery {
+    std::optional<std::chrono::system_clock::time_point> from;   ///< received_at >= from
+    std::optional<std::chrono::system_clock::time_point> to;     ///< received_at < to
+    std::optional<OrderStatus> status;
+    std::optional<OrderCursor> after;   ///< nullopt - с самого нового
+    size_t limit = 100;
+};
+
+/**
+ * @brief Страница истории; nextCursor = nullopt - страница последняя
+ */
+struct OrderPage {
+    std::vector<Order> orders;
+    std::optional<std::string> nextCursor;
+};
+
+} // namespace broker::domain
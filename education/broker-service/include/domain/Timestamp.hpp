@@ -2,8 +2,11 @@
 #pragma once
 
 #include <string>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <iomanip>
+#include <optional>
 #include <sstream>
 #include <ctime>
 
@@ -43,6 +46,32 @@ struct Timestamp {
         return Timestamp(tp);
     }
 
+    /**
+     * @brief Strict parse of a query parameter: Unix milliseconds or "2025-12-16T10:30:00[Z]" (UTC)
+     * @return nullopt for anything else, including an offset ("+03:00") or trailing junk
+     */
+    static std::optional<Timestamp> parseUtc(const std::string& str) {
+        if (!str.empty() && str.size() <= 18 &&
+            std::all_of(str.begin(), str.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            return fromUnixMillis(std::stoll(str));
+        }
+
+        std::tm tm = {};
+        std::istringstream ss(str);
+        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        if (ss.fail()) {
+            return std::nullopt;
+        }
+        if (ss.peek() == 'Z') {
+            ss.get();
+        }
+        ss >> std::ws;
+        if (ss.peek() != std::char_traits<char>::eof()) {
+            return std::nullopt;
+        }
+        return Timestamp(std::chrono::system_clock::from_time_t(timegm(&tm)));
+    }
+
     /**
      * @brief Convert to ISO 8601 string
      */
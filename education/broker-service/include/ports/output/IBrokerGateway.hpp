@@ -7,6 +7,7 @@
 #include "domain/Quote.hpp"
 #include "domain/Position.hpp"
 #include "domain/Order.hpp"
+#include "domain/OrderQuery.hpp"
 #include <string>
 #include <vector>
 #include <optional>
@@ -182,19 +183,17 @@ public:
     virtual std::vector<domain::Order> getOrders(const std::string& accountId) = 0;
 
     /**
-     * @brief Получить историю ордеров аккаунта
+     * @brief Получить страницу истории ордеров аккаунта, новые первыми
      * 
      * Использует токен, зарегистрированный для этого accountId
      * 
      * @param accountId ID аккаунта
-     * @param from Начальная дата (опционально)
-     * @param to Конечная дата (опционально)
-     * @return Список ордеров за период
+     * @param query Период, статус, курсор и размер страницы
+     * @return Ордера страницы и курсор следующей
      */
-    virtual std::vector<domain::Order> getOrderHistory(
+    virtual domain::OrderPage getOrderHistory(
         const std::string& accountId,
-        const std::optional<std::chrono::system_clock::time_point>& from = std::nullopt,
-        const std::optional<std::chrono::system_clock::time_point>& to = std::nullopt
+        const domain::OrderQuery& query
     ) = 0;
 };
 
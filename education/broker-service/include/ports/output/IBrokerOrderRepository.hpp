@@ -2,6 +2,7 @@
 #pragma once
 
 #include "domain/BrokerOrder.hpp"
+#include "domain/OrderQuery.hpp"
 #include <vector>
 #include <optional>
 #include <string>
@@ -16,6 +17,15 @@ public:
     virtual ~IBrokerOrderRepository() = default;
 
     virtual std::vector<domain::BrokerOrder> findByAccountId(const std::string& accountId) = 0;
+
+    /**
+     * @brief Страница истории аккаунта, новые первыми
+     *
+     * Не больше query.limit строк, строго после query.after; фильтры
+     * from/to/status применяются в хранилище.
+     */
+    virtual std::vector<domain::BrokerOrder> findPage(
+        const std::string& accountId, const domain::OrderQuery& query) = 0;
     virtual std::optional<domain::BrokerOrder> findById(const std::string& orderId) = 0;
     virtual void save(const domain::BrokerOrder& order) = 0;
     virtual void update(const domain::BrokerOrder& order) = 0;
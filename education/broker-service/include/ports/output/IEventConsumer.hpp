@@ -17,6 +17,25 @@ namespace broker::ports::output {
  */
 using EventHandler = std::function<void(const std::string& routingKey, const std::string& message)>;
 
+/**
+ * @brief Подтверждение обработки сообщения
+ *
+ * Вызывается ровно один раз, из любого потока, когда сообщение
+ * обработано до конца. До вызова сообщение считается "в работе"
+ * и занимает место в окне prefetch брокера сообщений.
+ */
+using AckCallback = std::function<void()>;
+
+/**
+ * @brief Обработчик событий с отложенным подтверждением
+ *
+ * Обработчик может вернуть управление сразу, а ack вызвать позже -
+ * после асинхронной обработки в другом потоке.
+ */
+using AsyncEventHandler = std::function<void(const std::string& routingKey,
+                                             const std::string& message,
+                                             AckCallback ack)>;
+
 /**
  * @brief Интерфейс потребителя событий
  * 
@@ -45,6 +64,23 @@ public:
      * @param handler Обработчик событий
      */
     virtual void subscribe(const std::vector<std::string>& routingKeys, EventHandler handler) = 0;
+
+    /**
+     * @brief Подписаться с отложенным подтверждением
+     *
+     * Реализация, поддерживающая ack, не подтверждает сообщение брокеру,
+     * пока обработчик не вызовет ack. По умолчанию - обычная подписка,
+     * сообщение подтверждается сразу после возврата из обработчика.
+     *
+     * @param routingKeys Список ключей маршрутизации для подписки
+     * @param handler Обработчик событий
+     */
+    virtual void subscribeAsync(const std::vector<std::string>& routingKeys, AsyncEventHandler handler) {
+        subscribe(routingKeys, [handler = std::move(handler)](const std::string& routingKey,
+                                                              const std::string& message) {
+            handler(routingKey, message, [] {});
+        });
+    }
     
     /**
      * @brief Запустить прослушивание событий
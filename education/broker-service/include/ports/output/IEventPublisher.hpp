@@ -1,6 +1,7 @@
 // include/ports/output/IEventPublisher.hpp
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace broker::ports::output {
@@ -9,7 +10,8 @@ namespace broker::ports::output {
  * @brief Интерфейс издателя событий
  * 
  * Использует строковый интерфейс (routingKey + message) для совместимости
- * с RabbitMQ и другими брокерами сообщений.
+ * с RabbitMQ и другими брокерами сообщений. Тело - JSON либо бинарный
+ * фрейм application/events/EventWireFormat.hpp (см. binaryWireFormat()).
  * 
  * @example
  * ```cpp
@@ -26,6 +28,41 @@ public:
      * @param message JSON-сообщение с данными события
      */
     virtual void publish(const std::string& routingKey, const std::string& message) = 0;
+
+    /**
+     * @brief Опубликовать событие с явным форматом тела
+     *
+     * По умолчанию content-type игнорируется (транспорт без метаданных).
+     *
+     * @param routingKey Ключ маршрутизации
+     * @param message Тело сообщения (JSON или бинарный фрейм)
+     * @param contentType MIME-тип тела, например "application/json"
+     */
+    virtual void publish(const std::string& routingKey, const std::string& message,
+                         const std::string& /*contentType*/) {
+        publish(routingKey, message);
+    }
+
+    /**
+     * @brief Включён ли бинарный формат событий (RABBITMQ_WIRE_FORMAT=binary)
+     *
+     * Издатели событий quote.updated и order.* спрашивают транспорт,
+     * в каком формате кодировать тело.
+     */
+    virtual bool binaryWireFormat() const {
+        return false;
+    }
+
+    /**
+     * @brief Сколько сообщений принято, но ещё не подтверждено брокером
+     *
+     * Рост значения - признак того, что брокер (и его потребители) не
+     * успевают; рассылка котировок в этом случае пропускает пачки.
+     * Транспорт без очереди отправки возвращает 0.
+     */
+    virtual size_t pendingMessages() const {
+        return 0;
+    }
 };
 
 } // namespace broker::ports::output
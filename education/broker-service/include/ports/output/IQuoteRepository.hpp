@@ -4,6 +4,7 @@
 #include "domain/Quote.hpp"
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace broker::ports::output {
 
@@ -16,6 +17,18 @@ public:
 
     virtual std::optional<domain::Quote> findByFigi(const std::string& figi) = 0;
     virtual void save(const domain::Quote& quote) = 0;
+
+    /**
+     * @brief Сохранить пачку котировок (FIGI в пачке уникальны)
+     *
+     * По умолчанию - save() на каждую котировку; реализации с БД
+     * переопределяют одним запросом.
+     */
+    virtual void saveBatch(const std::vector<domain::Quote>& quotes) {
+        for (const auto& quote : quotes) {
+            save(quote);
+        }
+    }
 };
 
 } // namespace broker::ports::output
@@ -15,12 +15,13 @@ namespace broker::settings {
  * для тестирования и демонстрации.
  * 
  * Переменные окружения:
- * - BROKER_FILL_BEHAVIOR: IMMEDIATE, REALISTIC, PARTIAL, ALWAYS_REJECT
- * - BROKER_SLIPPAGE: проскальзывание (0.001 = 0.1%)
+ * - BROKER_FILL_BEHAVIOR: IMMEDIATE, REALISTIC, PARTIAL, ALWAYS_REJECT, MATCHING
+ * - BROKER_SLIPPAGE: проскальзывание (0.001 = 0.1%), запас резерва MARKET BUY сверх ask
  * - BROKER_PARTIAL_RATIO: доля частичного исполнения (0.5 = 50%)
  * - BROKER_TICK_INTERVAL_MS: интервал тиков в мс
  * - BROKER_ENABLE_TICKER: включить фоновую симуляцию цен
  * - BROKER_SEED: seed для RNG (0 = random)
+ * - BROKER_QUOTE_FLUSH_INTERVAL_MS: период записи котировок в БД в мс (> 0)
  * 
  * @example K8s ConfigMap:
  * ```yaml
@@ -35,12 +36,14 @@ namespace broker::settings {
  *   BROKER_TICK_INTERVAL_MS: "100"
  *   BROKER_ENABLE_TICKER: "true"
  *   BROKER_SEED: "0"
+ *   BROKER_QUOTE_FLUSH_INTERVAL_MS: "1000"
  * ```
  */
 class BrokerSettings {
 public:
     /**
      * @brief Конструктор - читает настройки из ENV
+     * @throws std::invalid_argument если BROKER_QUOTE_FLUSH_INTERVAL_MS <= 0
      */
     BrokerSettings() {
         fillBehavior_ = getEnvOrDefault("BROKER_FILL_BEHAVIOR", "REALISTIC");
@@ -49,11 +52,17 @@ public:
         tickIntervalMs_ = std::stoi(getEnvOrDefault("BROKER_TICK_INTERVAL_MS", "100"));
         enableTicker_ = getEnvOrDefault("BROKER_ENABLE_TICKER", "true") == "true";
         seed_ = static_cast<unsigned int>(std::stoul(getEnvOrDefault("BROKER_SEED", "0")));
+        quoteFlushIntervalMs_ = std::stoi(getEnvOrDefault("BROKER_QUOTE_FLUSH_INTERVAL_MS", "1000"));
+
+        // При 0 поток write-behind крутился бы без ожидания
+        if (quoteFlushIntervalMs_ <= 0) {
+            throw std::invalid_argument("[BrokerSettings] quote flush interval must be > 0");
+        }
     }
     
     /**
      * @brief Получить режим исполнения ордеров
-     * @return IMMEDIATE, REALISTIC, PARTIAL, ALWAYS_REJECT
+     * @return IMMEDIATE, REALISTIC, PARTIAL, ALWAYS_REJECT, MATCHING
      */
     std::string getFillBehavior() const { return fillBehavior_; }
     
@@ -84,6 +93,11 @@ public:
      * @return 0 = random seed
      */
     unsigned int getSeed() const { return seed_; }
+    
+    /**
+     * @brief Получить период write-behind записи котировок в БД
+     */
+    int getQuoteFlushIntervalMs() const { return quoteFlushIntervalMs_; }
 
 private:
     std::string fillBehavior_;
@@ -92,6 +106,7 @@ private:
     int tickIntervalMs_;
     bool enableTicker_;
     unsigned int seed_;
+    int quoteFlushIntervalMs_;
     
     /**
      * @brief Получить значение ENV или вернуть default
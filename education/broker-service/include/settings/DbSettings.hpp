@@ -12,6 +12,10 @@ namespace broker::settings
      * @brief Настройки подключения к PostgreSQL
      *
      * Читает параметры из переменных окружения (K8s ENV).
+     *
+     * Пул соединений:
+     * - BROKER_DB_POOL_SIZE: максимум соединений (default: 8)
+     * - BROKER_DB_POOL_TIMEOUT_MS: ожидание свободного соединения (default: 2000)
      */
     class DbSettings
     {
@@ -23,6 +27,8 @@ namespace broker::settings
             name_ = getEnvOrDefault("BROKER_DB_NAME", "broker_db");
             user_ = getEnvOrDefault("BROKER_DB_USER", "broker_user");
             password_ = getEnvOrDefault("BROKER_DB_PASSWORD", "broker_secret_password");
+            poolSize_ = std::stoi(getEnvOrDefault("BROKER_DB_POOL_SIZE", "8"));
+            poolTimeoutMs_ = std::stoi(getEnvOrDefault("BROKER_DB_POOL_TIMEOUT_MS", "2000"));
         }
 
         std::string getHost() const { return host_; }
@@ -30,6 +36,8 @@ namespace broker::settings
         std::string getName() const { return name_; }
         std::string getUser() const { return user_; }
         std::string getPassword() const { return password_; }
+        int getPoolSize() const { return poolSize_; }
+        int getPoolTimeoutMs() const { return poolTimeoutMs_; }
 
         std::string getConnectionString() const
         {
@@ -43,6 +51,8 @@ namespace broker::settings
         std::string name_;
         std::string user_;
         std::string password_;
+        int poolSize_;
+        int poolTimeoutMs_;
 
         static std::string getEnvOrDefault(const char *name, const char *defaultValue)
         {
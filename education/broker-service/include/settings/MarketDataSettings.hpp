@@ -0,0 +1,50 @@
+// include/settings/MarketDataSettings.hpp
+#pragma once
+
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace broker::settings {
+
+/**
+ * @brief Настройки рассылки котировок (ConflatingQuotePublisher)
+ *
+ * Читает параметры из переменных окружения (K8s ENV).
+ *
+ * Переменные:
+ * - BROKER_QUOTE_CONFLATION_MS: период отправки пачек quote.batch
+ *   (по умолчанию 250; 0 - старый режим, quote.updated на каждый тик)
+ * - BROKER_QUOTE_FRAME_MAX: максимум котировок в одном фрейме (по умолчанию 1000)
+ * - BROKER_QUOTE_MAX_BACKLOG: сколько неподтверждённых сообщений у транспорта
+ *   считается отставанием подписчика - пачка пропускается (по умолчанию 1000)
+ */
+class MarketDataSettings {
+public:
+    MarketDataSettings() {
+        conflationMs_ = std::stoi(getEnvOrDefault("BROKER_QUOTE_CONFLATION_MS", "250"));
+        frameMax_ = std::stoi(getEnvOrDefault("BROKER_QUOTE_FRAME_MAX", "1000"));
+        maxBacklog_ = std::stoi(getEnvOrDefault("BROKER_QUOTE_MAX_BACKLOG", "1000"));
+
+        if (conflationMs_ < 0 || frameMax_ <= 0 || frameMax_ > 65535 || maxBacklog_ <= 0) {
+            throw std::invalid_argument(
+                "[MarketDataSettings] conflation must be >= 0, frame max in 1..65535, backlog > 0");
+        }
+    }
+
+    int getConflationMs() const { return conflationMs_; }
+    int getFrameMax() const { return frameMax_; }
+    int getMaxBacklog() const { return maxBacklog_; }
+
+private:
+    int conflationMs_;
+    int frameMax_;
+    int maxBacklog_;
+
+    static std::string getEnvOrDefault(const char* name, const char* defaultValue) {
+        const char* value = std::getenv(name);
+        return value ? std::string(value) : std::string(defaultValue);
+    }
+};
+
+} // namespace broker::settings
@@ -0,0 +1,60 @@
+// include/settings/OrderPipelineSettings.hpp
+#pragma once
+
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+namespace broker::settings {
+
+/**
+ * @brief Настройки конвейера обработки команд ордеров (OrderCommandHandler)
+ *
+ * Читает параметры из переменных окружения (K8s ENV).
+ *
+ * Переменные:
+ * - BROKER_ORDER_WORKERS: потоков исполнения ордеров (по умолчанию 4)
+ * - BROKER_ORDER_QUEUE_CAPACITY: ёмкость очереди каждой стадии (по умолчанию 64)
+ * - BROKER_ORDER_PUBLISH_BATCH: максимум команд в одной пачке публикации (по умолчанию 32)
+ *
+ * Ёмкость очереди должна быть не меньше RABBITMQ_PREFETCH (читается здесь
+ * же, по умолчанию 64): тогда приём ограничивает сам RabbitMQ (не больше
+ * prefetch неподтверждённых команд), и поток io_context не блокируется на
+ * переполненной очереди, держа handlersMutex_ адаптера. Иначе - исключение
+ * при старте.
+ */
+class OrderPipelineSettings {
+public:
+    OrderPipelineSettings() {
+        workers_ = std::stoi(getEnvOrDefault("BROKER_ORDER_WORKERS", "4"));
+        queueCapacity_ = std::stoi(getEnvOrDefault("BROKER_ORDER_QUEUE_CAPACITY", "64"));
+        publishBatch_ = std::stoi(getEnvOrDefault("BROKER_ORDER_PUBLISH_BATCH", "32"));
+
+        int prefetch = std::stoi(getEnvOrDefault("RABBITMQ_PREFETCH", "64"));
+
+        if (workers_ <= 0 || queueCapacity_ <= 0 || publishBatch_ <= 0) {
+            throw std::invalid_argument("[OrderPipelineSettings] values must be > 0");
+        }
+        if (queueCapacity_ < prefetch) {
+            throw std::invalid_argument(
+                "[OrderPipelineSettings] BROKER_ORDER_QUEUE_CAPACITY (" + std::to_string(queueCapacity_) +
+                ") must be >= RABBITMQ_PREFETCH (" + std::to_string(prefetch) + ")");
+        }
+    }
+
+    int getWorkers() const { return workers_; }
+    int getQueueCapacity() const { return queueCapacity_; }
+    int getPublishBatch() const { return publishBatch_; }
+
+private:
+    int workers_;
+    int queueCapacity_;
+    int publishBatch_;
+
+    static std::string getEnvOrDefault(const char* name, const char* defaultValue) {
+        const char* value = std::getenv(name);
+        return value ? std::string(value) : std::string(defaultValue);
+    }
+};
+
+} // namespace broker::settings
@@ -18,6 +18,9 @@ namespace broker::settings {
  * - RABBITMQ_USER: пользователь (по умолчанию "guest")
  * - RABBITMQ_PASSWORD: пароль (обязательный)
  * - RABBITMQ_EXCHANGE: имя exchange (по умолчанию "broker.events")
+ * - RABBITMQ_PREFETCH: максимум неподтверждённых сообщений у консьюмера (по умолчанию 64)
+ * - RABBITMQ_PUBLISH_QUEUE_LIMIT: максимум сообщений в очереди на отправку (по умолчанию 100000)
+ * - RABBITMQ_WIRE_FORMAT: формат событий quote/order - json или binary (по умолчанию json)
  */
 class RabbitMQSettings {
 public:
@@ -27,6 +30,12 @@ public:
         user_ = getEnvOrDefault("RABBITMQ_USER", "guest");
         password_ = getEnvOrDefault("RABBITMQ_PASSWORD", "guest");
         exchange_ = getEnvOrDefault("RABBITMQ_EXCHANGE", "broker.events");
+        prefetch_ = std::stoi(getEnvOrDefault("RABBITMQ_PREFETCH", "64"));
+        publishQueueLimit_ = std::stoi(getEnvOrDefault("RABBITMQ_PUBLISH_QUEUE_LIMIT", "100000"));
+        wireFormat_ = getEnvOrDefault("RABBITMQ_WIRE_FORMAT", "json");
+        if (wireFormat_ != "json" && wireFormat_ != "binary") {
+            throw std::invalid_argument("[RabbitMQSettings] RABBITMQ_WIRE_FORMAT must be json or binary");
+        }
     }
     
     std::string getHost() const { return host_; }
@@ -34,6 +43,9 @@ public:
     std::string getUser() const { return user_; }
     std::string getPassword() const { return password_; }
     std::string getExchange() const { return exchange_; }
+    int getPrefetch() const { return prefetch_; }
+    int getPublishQueueLimit() const { return publishQueueLimit_; }
+    std::string getWireFormat() const { return wireFormat_; }
 
 private:
     std::string host_;
@@ -41,6 +53,9 @@ private:
     std::string user_;
     std::string password_;
     std::string exchange_;
+    int prefetch_;
+    int publishQueueLimit_;
+    std::string wireFormat_;
     
     static std::string getEnvOrDefault(const char* name, const char* defaultValue) {
         const char* value = std::getenv(name);
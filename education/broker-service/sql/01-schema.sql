@@ -54,6 +54,7 @@ CREATE TABLE IF NOT EXISTS broker_balances (
 
 -- Индексы
 CREATE INDEX IF NOT EXISTS idx_broker_orders_account_id ON broker_orders(account_id);
+CREATE INDEX IF NOT EXISTS idx_broker_orders_account_history ON broker_orders(account_id, received_at DESC, order_id DESC);
 CREATE INDEX IF NOT EXISTS idx_broker_orders_status ON broker_orders(status);
 CREATE INDEX IF NOT EXISTS idx_broker_orders_figi ON broker_orders(figi);
 CREATE INDEX IF NOT EXISTS idx_broker_positions_account_id ON broker_positions(account_id);
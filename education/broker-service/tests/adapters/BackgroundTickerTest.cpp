@@ -162,3 +162,63 @@ TEST_F(BackgroundTickerTest, SetInterval_WhileRunning) {
     // More ticks should have occurred with shorter interval
     EXPECT_GT(ticker.getTickCount(), 0u);
 }
+
+TEST_F(BackgroundTickerTest, TickBatch_ReturnsQuotePerInstrument) {
+    BackgroundTicker ticker(priceSimulator_, orderProcessor_);
+    ticker.addInstrument("SBER");
+    ticker.addInstrument("GAZP");
+    
+    const auto& batch = ticker.tickBatch();
+    
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch[0].figi, "SBER");
+    EXPECT_EQ(batch[1].figi, "GAZP");
+    for (const auto& update : batch) {
+        EXPECT_LT(update.bid, update.ask);
+        EXPECT_DOUBLE_EQ(update.last, priceSimulator_->getPrice(update.figi));
+    }
+}
+
+TEST_F(BackgroundTickerTest, TickBatch_SkipsUnknownUntilInitialized) {
+    BackgroundTicker ticker(priceSimulator_, orderProcessor_);
+    ticker.addInstrument("SBER");
+    ticker.addInstrument("LKOH");  // ещё нет в симуляторе
+    
+    EXPECT_EQ(ticker.tickBatch().size(), 1u);
+    
+    priceSimulator_->initInstrument("LKOH", 7200.0);
+    EXPECT_EQ(ticker.tickBatch().size(), 2u);
+}
+
+TEST_F(BackgroundTickerTest, TickBatch_RemovedInstrumentNotTicked) {
+    BackgroundTicker ticker(priceSimulator_, orderProcessor_);
+    ticker.addInstrument("SBER");
+    ticker.addInstrument("GAZP");
+    
+    ticker.removeInstrument("GAZP");
+    
+    const auto& batch = ticker.tickBatch();
+    ASSERT_EQ(batch.size(), 1u);
+    EXPECT_EQ(batch[0].figi, "SBER");
+}
+
+TEST_F(BackgroundTickerTest, ManualTick_DeliversBatchAndSingleCallbacks) {
+    BackgroundTicker ticker(priceSimulator_, orderProcessor_);
+    ticker.addInstrument("SBER");
+    ticker.addInstrument("GAZP");
+    
+    size_t batchSize = 0;
+    int singleCalls = 0;
+    ticker.setBatchCallback([&](const std::vector<QuoteUpdate>& batch) {
+        batchSize = batch.size();
+    });
+    ticker.setQuoteCallback([&](const QuoteUpdate&) {
+        ++singleCalls;
+    });
+    
+    ticker.manualTick();
+    
+    EXPECT_EQ(batchSize, 2u);
+    EXPECT_EQ(singleCalls, 2);
+    EXPECT_EQ(ticker.getTickCount(), 1u);
+}
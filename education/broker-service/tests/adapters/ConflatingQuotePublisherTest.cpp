@@ -0,0 +1,310 @@
+/**
+ * @file ConflatingQuotePublisherTest.cpp
+ * @brief Unit tests for ConflatingQuotePublisher
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/ConflatingQuotePublisher.hpp"
+
+#include <nlohmann/json.hpp>
+#include <cstdlib>
+#include <map>
+
+using namespace broker;
+using namespace broker::adapters::secondary;
+using namespace broker::application;
+
+// ============================================================================
+// FAKES
+// ============================================================================
+
+class RecordingEventPublisher : public ports::output::IEventPublisher {
+public:
+    struct Published {
+        std::string routingKey;
+        std::string payload;
+        std::string contentType;
+    };
+
+    void publish(const std::string& routingKey, const std::string& message) override {
+        publish(routingKey, message, wire::CONTENT_TYPE_JSON);
+    }
+
+    void publish(const std::string& routingKey, const std::string& message,
+                 const std::string& contentType) override {
+        messages.push_back({routingKey, message, contentType});
+    }
+
+    bool binaryWireFormat() const override { return binary; }
+    size_t pendingMessages() const override { return pending; }
+
+    std::vector<Published> messages;
+    bool binary = false;
+    size_t pending = 0;
+};
+
+class RecordingEventConsumer : public ports::output::IEventConsumer {
+public:
+    void subscribe(const std::vector<std::string>& routingKeys, ports::output::EventHandler handler) override {
+        for (const auto& key : routingKeys) {
+            handlers[key] = handler;
+        }
+    }
+
+    void start() override {}
+    void stop() override {}
+
+    std::map<std::string, ports::output::EventHandler> handlers;
+};
+
+/**
+ * @brief Подписчик, который запоминает JSON-фреймы и может "тормозить"
+ */
+struct RecordingSink {
+    struct Frame {
+        std::string routingKey;
+        nlohmann::json body;
+    };
+
+    ConflatingQuotePublisher::FrameSink sink() {
+        return [this](const std::string& routingKey, const std::string& payload, const std::string&) {
+            if (slow) {
+                return false;
+            }
+            frames.push_back({routingKey, nlohmann::json::parse(payload)});
+            return true;
+        };
+    }
+
+    std::vector<Frame> frames;
+    bool slow = false;
+};
+
+// ============================================================================
+// FIXTURE
+// ============================================================================
+
+class ConflatingQuotePublisherTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        setenv("BROKER_QUOTE_CONFLATION_MS", "50", 1);
+        setenv("BROKER_QUOTE_FRAME_MAX", "100", 1);
+        setenv("BROKER_QUOTE_MAX_BACKLOG", "10", 1);
+        publisher_ = std::make_shared<RecordingEventPublisher>();
+        consumer_ = std::make_shared<RecordingEventConsumer>();
+    }
+
+    void TearDown() override {
+        unsetenv("BROKER_QUOTE_CONFLATION_MS");
+        unsetenv("BROKER_QUOTE_FRAME_MAX");
+        unsetenv("BROKER_QUOTE_MAX_BACKLOG");
+    }
+
+    std::unique_ptr<ConflatingQuotePublisher> create() {
+        return std::make_unique<ConflatingQuotePublisher>(
+            publisher_, consumer_, std::make_shared<settings::MarketDataSettings>());
+    }
+
+    static domain::Quote makeQuote(const std::string& figi, double last) {
+        domain::Quote q;
+        q.figi = figi;
+        q.lastPrice = domain::Money::fromDouble(last, "RUB");
+        q.bidPrice = domain::Money::fromDouble(last - 0.5, "RUB");
+        q.askPrice = domain::Money::fromDouble(last + 0.5, "RUB");
+        return q;
+    }
+
+    std::shared_ptr<RecordingEventPublisher> publisher_;
+    std::shared_ptr<RecordingEventConsumer> consumer_;
+};
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST_F(ConflatingQuotePublisherTest, ZeroInterval_Disabled) {
+    setenv("BROKER_QUOTE_CONFLATION_MS", "0", 1);
+    auto quotes = create();
+
+    EXPECT_FALSE(quotes->isEnabled());
+    EXPECT_TRUE(consumer_->handlers.empty());
+    EXPECT_EQ(quotes->stats().subscribers, 0u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Flush_SendsLatestQuotePerFigiInOneFrame) {
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->offer(makeQuote("SBER", 101.0));
+    quotes->offer(makeQuote("SBER", 102.0));
+    quotes->offer(makeQuote("GAZP", 200.0));
+
+    EXPECT_EQ(quotes->flush(), 2u);
+
+    ASSERT_EQ(publisher_->messages.size(), 1u);
+    EXPECT_EQ(publisher_->messages[0].routingKey, "quote.batch");
+    auto frame = nlohmann::json::parse(publisher_->messages[0].payload);
+    EXPECT_EQ(frame["seq"], 1);
+    EXPECT_FALSE(frame["snapshot"].get<bool>());
+    ASSERT_EQ(frame["quotes"].size(), 2u);
+    for (const auto& q : frame["quotes"]) {
+        if (q["figi"] == "SBER") {
+            EXPECT_DOUBLE_EQ(q["last_price"].get<double>(), 102.0);
+        }
+    }
+
+    auto s = quotes->stats();
+    EXPECT_EQ(s.offered, 4u);
+    EXPECT_EQ(s.published, 2u);
+    EXPECT_EQ(s.frames, 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Flush_NothingChanged_NoFrame) {
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+    quotes->flush();
+
+    EXPECT_EQ(publisher_->messages.size(), 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Subscribe_ReceivesSnapshotFirst) {
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->offer(makeQuote("GAZP", 200.0));
+
+    RecordingSink sink;
+    quotes->subscribe(sink.sink());
+
+    ASSERT_EQ(sink.frames.size(), 1u);
+    EXPECT_EQ(sink.frames[0].routingKey, "quote.snapshot");
+    EXPECT_TRUE(sink.frames[0].body["snapshot"].get<bool>());
+    EXPECT_EQ(sink.frames[0].body["seq"], 1);
+    EXPECT_EQ(sink.frames[0].body["quotes"].size(), 2u);
+
+    // Дальше - только изменения, seq продолжается
+    quotes->offer(makeQuote("SBER", 101.0));
+    quotes->flush();
+    ASSERT_EQ(sink.frames.size(), 2u);
+    EXPECT_EQ(sink.frames[1].routingKey, "quote.batch");
+    EXPECT_EQ(sink.frames[1].body["seq"], 2);
+    EXPECT_EQ(sink.frames[1].body["quotes"].size(), 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, SlowSubscriber_IntermediateUpdatesDropped) {
+    auto quotes = create();
+    RecordingSink sink;
+    quotes->subscribe(sink.sink());
+
+    sink.slow = true;
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+    quotes->offer(makeQuote("SBER", 101.0));
+    quotes->flush();
+    EXPECT_EQ(quotes->stats().skippedFrames, 2u);
+
+    sink.slow = false;
+    quotes->offer(makeQuote("SBER", 102.0));
+    quotes->flush();
+
+    ASSERT_EQ(sink.frames.size(), 1u);
+    EXPECT_EQ(sink.frames[0].body["seq"], 1);   // пропущенные фреймы не расходуют seq
+    ASSERT_EQ(sink.frames[0].body["quotes"].size(), 1u);
+    EXPECT_DOUBLE_EQ(sink.frames[0].body["quotes"][0]["last_price"].get<double>(), 102.0);
+}
+
+TEST_F(ConflatingQuotePublisherTest, SlowSubscriber_DoesNotDelayOthers) {
+    auto quotes = create();
+    RecordingSink slow;
+    RecordingSink fast;
+    quotes->subscribe(slow.sink());
+    quotes->subscribe(fast.sink());
+    slow.slow = true;
+
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+
+    EXPECT_TRUE(slow.frames.empty());
+    EXPECT_EQ(fast.frames.size(), 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Exchange_SkipsFramesWhileTransportBacklogged) {
+    auto quotes = create();
+    publisher_->pending = 11;
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+    EXPECT_TRUE(publisher_->messages.empty());
+
+    publisher_->pending = 0;
+    quotes->flush();
+    EXPECT_EQ(publisher_->messages.size(), 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, FrameMax_SplitsIntoConsecutiveFrames) {
+    setenv("BROKER_QUOTE_FRAME_MAX", "2", 1);
+    auto quotes = create();
+    for (int i = 0; i < 5; ++i) {
+        quotes->offer(makeQuote("FIGI" + std::to_string(i), 100.0 + i));
+    }
+    quotes->flush();
+
+    ASSERT_EQ(publisher_->messages.size(), 3u);
+    for (size_t i = 0; i < 3; ++i) {
+        auto frame = nlohmann::json::parse(publisher_->messages[i].payload);
+        EXPECT_EQ(frame["seq"], i + 1);
+    }
+}
+
+TEST_F(ConflatingQuotePublisherTest, SnapshotRequest_PublishesFullSnapshot) {
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->offer(makeQuote("GAZP", 200.0));
+    quotes->flush();
+
+    ASSERT_EQ(consumer_->handlers.count("quote.snapshot.request"), 1u);
+    consumer_->handlers["quote.snapshot.request"]("quote.snapshot.request", "{}");
+
+    ASSERT_EQ(publisher_->messages.size(), 2u);
+    EXPECT_EQ(publisher_->messages[1].routingKey, "quote.snapshot");
+    auto frame = nlohmann::json::parse(publisher_->messages[1].payload);
+    EXPECT_EQ(frame["quotes"].size(), 2u);
+    EXPECT_EQ(frame["seq"], 2);
+    EXPECT_EQ(quotes->stats().snapshotFrames, 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, BinaryWireFormat_EncodesQuoteBatchFrame) {
+    publisher_->binary = true;
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+
+    ASSERT_EQ(publisher_->messages.size(), 1u);
+    EXPECT_EQ(publisher_->messages[0].contentType, wire::CONTENT_TYPE_BINARY);
+    auto frame = wire::decodeQuoteBatch(publisher_->messages[0].payload);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->seq, 1u);
+    ASSERT_EQ(frame->quotes.size(), 1u);
+    EXPECT_EQ(frame->quotes[0].figi, "SBER");
+    EXPECT_DOUBLE_EQ(frame->quotes[0].last, 100.0);
+    EXPECT_DOUBLE_EQ(frame->quotes[0].bid, 99.5);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Stats_FrameSizeHistogram) {
+    auto quotes = create();
+    quotes->offer(makeQuote("SBER", 100.0));
+    quotes->flush();
+
+    auto s = quotes->stats();
+    EXPECT_EQ(s.frames, 1u);
+    EXPECT_EQ(s.frameBytes, publisher_->messages[0].payload.size());
+    EXPECT_EQ(s.frameBytesCumulative[ConflatingQuotePublisher::FRAME_BOUND_COUNT - 1], 1u);
+}
+
+TEST_F(ConflatingQuotePublisherTest, Start_FlushesPeriodically) {
+    auto quotes = create();
+    quotes->start();
+    quotes->offer(makeQuote("SBER", 100.0));
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    quotes->stop();
+
+    EXPECT_EQ(quotes->stats().published, 1u);
+}
@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include "adapters/secondary/broker/EnhancedFakeBroker.hpp"
 #include "settings/BrokerSettings.hpp"
+#include <atomic>
+#include <thread>
 
 using namespace broker::adapters::secondary;
 using namespace broker::settings;
@@ -240,7 +242,6 @@ TEST_F(EnhancedFakeBrokerTest, GetAllInstruments_ReturnsMultiple) {
 // RESET
 // ============================================================================
 
-/* TODO: нестабильны тест, потом разобраться
 TEST_F(EnhancedFakeBrokerTest, Reset_ClearsAllData) {
     auto req = createBuyMarket(SBER_FIGI, 10);
     broker_->placeOrder(TEST_ACCOUNT, req);
@@ -248,8 +249,8 @@ TEST_F(EnhancedFakeBrokerTest, Reset_ClearsAllData) {
     broker_->reset();
     
     EXPECT_FALSE(broker_->hasAccount(TEST_ACCOUNT));
+    EXPECT_TRUE(broker_->getInstrument(SBER_FIGI).has_value());
 }
-*/
 
 
 // ============================================================================
@@ -264,3 +265,252 @@ TEST_F(EnhancedFakeBrokerTest, UsesSettingsFromDI) {
     auto quote = broker_->getQuote(SBER_FIGI);
     ASSERT_TRUE(quote.has_value());
 }
+
+// ============================================================================
+// MATCHING
+// ============================================================================
+
+TEST_F(EnhancedFakeBrokerTest, Matching_TradeBetweenAccounts_UpdatesBothPortfolios) {
+    const std::string SELLER = "seller-account";
+    broker_->registerAccount(SELLER, "seller-token");
+    broker_->importPosition(SELLER, SBER_FIGI, "SBER", 100, 270.0);
+    broker_->setScenario(SBER_FIGI, MarketScenario::matching(280.0));
+    
+    BrokerOrderRequest ask;
+    ask.orderId = "ask-1";
+    ask.accountId = SELLER;
+    ask.figi = SBER_FIGI;
+    ask.direction = Direction::SELL;
+    ask.type = Type::LIMIT;
+    ask.quantity = 5;
+    ask.price = 281.0;
+    EXPECT_EQ(broker_->placeOrder(SELLER, ask).status, Status::PENDING);
+    
+    auto bid = createBuyLimit(SBER_FIGI, 5, 282.0);
+    bid.orderId = "bid-1";
+    auto result = broker_->placeOrder(TEST_ACCOUNT, bid);
+    
+    EXPECT_EQ(result.status, Status::FILLED);
+    EXPECT_DOUBLE_EQ(result.executedPrice, 281.0);
+    
+    // SBER: лот 10 -> 5 лотов = 50 акций
+    auto buyer = broker_->getPortfolio(TEST_ACCOUNT);
+    ASSERT_EQ(buyer.positions.size(), 1u);
+    EXPECT_EQ(buyer.positions[0].quantity, 50);
+    EXPECT_DOUBLE_EQ(buyer.cash, 100000.0 - 281.0 * 50);
+    
+    auto seller = broker_->getPortfolio(SELLER);
+    ASSERT_EQ(seller.positions.size(), 1u);
+    EXPECT_EQ(seller.positions[0].quantity, 50);
+    EXPECT_DOUBLE_EQ(seller.cash, 100000.0 + 281.0 * 50);
+    
+    EXPECT_EQ(broker_->pendingOrderCount(), 0u);
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST_F(EnhancedFakeBrokerTest, ConcurrentOrders_DifferentAccounts_Consistent) {
+    const int threads = 8;
+    const int ordersPerThread = 200;
+    for (int t = 0; t < threads; ++t) {
+        broker_->registerAccount("acc-" + std::to_string(t), "token", 1e9);
+    }
+    broker_->setPrice(SBER_FIGI, 100.0);
+    
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::string account = "acc-" + std::to_string(t);
+            for (int i = 0; i < ordersPerThread; ++i) {
+                auto req = createBuyMarket(SBER_FIGI, 1);
+                req.accountId = account;
+                broker_->placeOrder(account, req);
+            }
+        });
+    }
+    // Параллельно меняем справочник сценариев
+    workers.emplace_back([&] {
+        for (int i = 0; i < 50; ++i) {
+            broker_->setDefaultScenario(MarketScenario::realistic(100.0));
+        }
+    });
+    for (auto& w : workers) {
+        w.join();
+    }
+    
+    for (int t = 0; t < threads; ++t) {
+        auto portfolio = broker_->getPortfolio("acc-" + std::to_string(t));
+        ASSERT_EQ(portfolio.positions.size(), 1u);
+        EXPECT_EQ(portfolio.positions[0].quantity, ordersPerThread * 10);  // лот SBER = 10
+    }
+}
+
+// ============================================================================
+// RESERVATIONS
+// ============================================================================
+
+TEST_F(EnhancedFakeBrokerTest, PendingLimitBuy_ReservesCash_CancelReleases) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI, MarketScenario::realistic(3500.0).withVolatility(0.0));
+    
+    auto req = createBuyLimit(YNDX_FIGI, 2, 3000.0);  // ниже рынка -> pending
+    req.orderId = "limit-1";
+    auto result = broker_->placeOrder(TEST_ACCOUNT, req);
+    ASSERT_EQ(result.status, Status::PENDING);
+    
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 6000.0);
+    EXPECT_DOUBLE_EQ(broker_->getBalance(TEST_ACCOUNT), 100000.0);
+    
+    // Свободных денег 94000: ордер на 95000 не проходит
+    auto tooBig = createBuyLimit(YNDX_FIGI, 19, 5000.0);
+    tooBig.orderId = "limit-2";
+    EXPECT_EQ(broker_->placeOrder(TEST_ACCOUNT, tooBig).status, Status::REJECTED);
+    
+    EXPECT_TRUE(broker_->cancelOrder(TEST_ACCOUNT, "limit-1"));
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    EXPECT_DOUBLE_EQ(broker_->getBalance(TEST_ACCOUNT), 100000.0);
+}
+
+TEST_F(EnhancedFakeBrokerTest, PartialFill_ReleasesUnfilledReserve) {
+    const std::string MGNT_FIGI = "BBG004RVFCY3";
+    
+    auto req = createBuyMarket(MGNT_FIGI, 10);
+    req.orderId = "partial-1";
+    auto result = broker_->placeOrder(TEST_ACCOUNT, req);
+    
+    ASSERT_EQ(result.status, Status::PARTIALLY_FILLED);
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    EXPECT_NEAR(broker_->getBalance(TEST_ACCOUNT),
+                100000.0 - result.executedPrice * result.executedQuantity, 1e-6);
+}
+
+TEST_F(EnhancedFakeBrokerTest, PendingSell_ReservesPosition) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI, MarketScenario::realistic(3500.0).withVolatility(0.0));
+    broker_->importPosition(TEST_ACCOUNT, YNDX_FIGI, "YNDX", 5, 3400.0);
+    
+    BrokerOrderRequest sell;
+    sell.orderId = "sell-1";
+    sell.accountId = TEST_ACCOUNT;
+    sell.figi = YNDX_FIGI;
+    sell.direction = Direction::SELL;
+    sell.type = Type::LIMIT;
+    sell.quantity = 4;
+    sell.price = 4000.0;  // выше рынка -> pending
+    ASSERT_EQ(broker_->placeOrder(TEST_ACCOUNT, sell).status, Status::PENDING);
+    
+    // Зарезервировано 4 из 5: вторая продажа 2 лотов отклоняется
+    sell.orderId = "sell-2";
+    sell.quantity = 2;
+    auto second = broker_->placeOrder(TEST_ACCOUNT, sell);
+    EXPECT_EQ(second.status, Status::REJECTED);
+    EXPECT_NE(second.message.find("have 1 lots"), std::string::npos);
+}
+
+TEST_F(EnhancedFakeBrokerTest, ConcurrentPendingBuys_NeverOverspend) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI, MarketScenario::realistic(3500.0).withVolatility(0.0));
+    broker_->setCash(TEST_ACCOUNT, 10 * 3000.0);  // ровно на 10 ордеров
+    
+    std::atomic<int> accepted{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 8; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < 10; ++i) {
+                auto req = createBuyLimit(YNDX_FIGI, 1, 3000.0);
+                req.orderId = "t" + std::to_string(t) + "-" + std::to_string(i);
+                if (broker_->placeOrder(TEST_ACCOUNT, req).status == Status::PENDING) {
+                    ++accepted;
+                }
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    
+    EXPECT_EQ(accepted.load(), 10);
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 30000.0);
+}
+
+TEST_F(EnhancedFakeBrokerTest, PendingFill_CommitsReserveAtFillPrice) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI, MarketScenario::realistic(3500.0).withVolatility(0.0));
+    
+    auto req = createBuyLimit(YNDX_FIGI, 1, 3400.0);
+    req.orderId = "limit-fill";
+    ASSERT_EQ(broker_->placeOrder(TEST_ACCOUNT, req).status, Status::PENDING);
+    
+    broker_->setPrice(YNDX_FIGI, 3000.0);
+    broker_->manualTick();
+    
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    auto portfolio = broker_->getPortfolio(TEST_ACCOUNT);
+    ASSERT_EQ(portfolio.positions.size(), 1u);
+    // Исполнено по ask (< лимита), разница вернулась в свободные
+    EXPECT_LT(portfolio.positions[0].averagePrice, 3400.0);
+    EXPECT_NEAR(portfolio.cash, 100000.0 - portfolio.positions[0].averagePrice, 1e-6);
+}
+
+TEST_F(EnhancedFakeBrokerTest, MarketBuy_ReservesSlippage_AvailableNeverNegative) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI, MarketScenario::lowLiquidity(3500.0, 100).withVolatility(0.0));
+    double ask = broker_->getQuote(YNDX_FIGI)->askPrice;
+    
+    // 50 из 100 лотов ликвидности: исполнение на 0.5% выше ask.
+    // Денег хватает по ask, но не по цене исполнения
+    broker_->setCash(TEST_ACCOUNT, ask * 50 * 1.002);
+    auto req = createBuyMarket(YNDX_FIGI, 50);
+    req.orderId = "slip-1";
+    auto result = broker_->placeOrder(TEST_ACCOUNT, req);
+    
+    EXPECT_EQ(result.status, Status::REJECTED);
+    EXPECT_EQ(result.message, "Insufficient funds");
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    EXPECT_DOUBLE_EQ(broker_->getBalance(TEST_ACCOUNT), ask * 50 * 1.002);
+    
+    // С запасом на проскальзывание - исполняется выше ask, остаток не отрицательный
+    broker_->setCash(TEST_ACCOUNT, ask * 50 * 1.01);
+    req.orderId = "slip-2";
+    result = broker_->placeOrder(TEST_ACCOUNT, req);
+    
+    ASSERT_EQ(result.status, Status::FILLED);
+    EXPECT_GT(result.executedPrice, ask);
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    EXPECT_NEAR(broker_->getBalance(TEST_ACCOUNT), ask * 50 * 1.01 - result.executedPrice * 50, 1e-6);
+    EXPECT_GE(broker_->getBalance(TEST_ACCOUNT), 0.0);
+}
+
+TEST_F(EnhancedFakeBrokerTest, DelayedMarketBuy_FillPriceAboveReserve_WaitsInsteadOfOverspending) {
+    const std::string YNDX_FIGI = "BBG006L8G4H1";
+    broker_->setScenario(YNDX_FIGI,
+        MarketScenario::delayed(3500.0, std::chrono::milliseconds{0}).withVolatility(0.0));
+    double ask = broker_->getQuote(YNDX_FIGI)->askPrice;
+    broker_->setCash(TEST_ACCOUNT, ask * 2 * 1.002);
+    
+    auto req = createBuyMarket(YNDX_FIGI, 2);
+    req.orderId = "delayed-1";
+    ASSERT_EQ(broker_->placeOrder(TEST_ACCOUNT, req).status, Status::PENDING);
+    double reserved = broker_->getReservedBalance(TEST_ACCOUNT);
+    EXPECT_GT(reserved, ask * 2);
+    
+    // До исполнения цена ушла на 10% выше резерва: сделка не проводится
+    broker_->setPrice(YNDX_FIGI, 3850.0);
+    broker_->manualTick();
+    
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), reserved);
+    EXPECT_TRUE(broker_->getPortfolio(TEST_ACCOUNT).positions.empty());
+    EXPECT_EQ(broker_->pendingOrderCount(), 1u);
+    
+    // Цена вернулась - исполнение в пределах резерва
+    broker_->setPrice(YNDX_FIGI, 3500.0);
+    broker_->manualTick();
+    
+    EXPECT_DOUBLE_EQ(broker_->getReservedBalance(TEST_ACCOUNT), 0.0);
+    auto portfolio = broker_->getPortfolio(TEST_ACCOUNT);
+    ASSERT_EQ(portfolio.positions.size(), 1u);
+    EXPECT_GE(portfolio.cash, 0.0);
+    EXPECT_NEAR(portfolio.cash, ask * 2 * 1.002 - portfolio.positions[0].averagePrice * 2, 1e-6);
+}
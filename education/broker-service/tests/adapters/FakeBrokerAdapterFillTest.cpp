@@ -0,0 +1,235 @@
+/**
+ * @file FakeBrokerAdapterFillTest.cpp
+ * @brief События исполнения встречных (maker) ордеров из книги
+ *
+ * Лимитный ордер, исполненный двумя сделками: первая публикует
+ * order.partially_filled, вторая - order.filled; в событии накопленное
+ * исполнение ордера, а не размер сделки. Заодно - нумерация version
+ * в portfolio.updated по аккаунту.
+ */
+
+#include <gtest/gtest.h>
+
+#include "adapters/secondary/broker/FakeBrokerAdapter.hpp"
+#include "adapters/secondary/broker/EnhancedFakeBroker.hpp"
+#include "settings/BrokerSettings.hpp"
+
+#include <nlohmann/json.hpp>
+#include <map>
+#include <mutex>
+
+using namespace broker;
+using namespace broker::adapters::secondary;
+using namespace broker::application;
+
+namespace {
+
+const std::string SBER_FIGI = "BBG004730N88";
+
+class FillRecordingPublisher : public ports::output::IEventPublisher {
+public:
+    struct Published {
+        std::string routingKey;
+        std::string payload;
+    };
+
+    void publish(const std::string& routingKey, const std::string& message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back({routingKey, message});
+    }
+
+    void publish(const std::string& routingKey, const std::string& message,
+                 const std::string& /*contentType*/) override {
+        publish(routingKey, message);
+    }
+
+    bool binaryWireFormat() const override { return binary; }
+
+    /// Только order.*: portfolio.updated здесь не проверяем
+    std::vector<Published> orderEvents() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Published> result;
+        for (const auto& m : messages_) {
+            if (m.routingKey.rfind("order.", 0) == 0) {
+                result.push_back(m);
+            }
+        }
+        return result;
+    }
+
+    /// version событий portfolio.updated аккаунта в порядке публикации
+    std::vector<uint64_t> portfolioVersions(const std::string& accountId) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<uint64_t> result;
+        for (const auto& m : messages_) {
+            if (m.routingKey != "portfolio.updated") continue;
+            auto event = nlohmann::json::parse(m.payload);
+            if (event["account_id"] == accountId) {
+                result.push_back(event["version"].get<uint64_t>());
+            }
+        }
+        return result;
+    }
+
+    bool binary = false;
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<Published> messages_;
+};
+
+class InMemoryOrderRepository : public ports::output::IBrokerOrderRepository {
+public:
+    std::vector<domain::BrokerOrder> findByAccountId(const std::string& accountId) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<domain::BrokerOrder> result;
+        for (const auto& [id, order] : orders_) {
+            if (order.accountId == accountId) {
+                result.push_back(order);
+            }
+        }
+        return result;
+    }
+
+    std::vector<domain::BrokerOrder> findPage(const std::string& accountId,
+                                              const domain::OrderQuery&) override {
+        return findByAccountId(accountId);
+    }
+
+    std::optional<domain::BrokerOrder> findById(const std::string& orderId) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = orders_.find(orderId);
+        if (it == orders_.end()) return std::nullopt;
+        return it->second;
+    }
+
+    void save(const domain::BrokerOrder& order) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        orders_[order.orderId] = order;
+    }
+
+    void update(const domain::BrokerOrder& order) override {
+        save(order);
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, domain::BrokerOrder> orders_;
+};
+
+}  // namespace
+
+class FakeBrokerAdapterFillTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        broker_ = std::make_shared<EnhancedFakeBroker>(std::make_shared<settings::BrokerSettings>());
+        broker_->setScenario(SBER_FIGI, MarketScenario::matching(280.0));
+
+        publisher_ = std::make_shared<FillRecordingPublisher>();
+        orderRepo_ = std::make_shared<InMemoryOrderRepository>();
+        adapter_ = std::make_unique<FakeBrokerAdapter>(
+            broker_, publisher_, nullptr, nullptr, orderRepo_, nullptr, nullptr, nullptr, nullptr);
+
+        broker_->registerAccount(SELLER, "seller-token", 100000.0);
+        // SBER: лот 10 -> 100 акций = 10 лотов
+        broker_->importPosition(SELLER, SBER_FIGI, "SBER", 100, 270.0);
+    }
+
+    /// Лимитная покупка 10 лотов встаёт в книгу (maker)
+    void placeRestingBid() {
+        domain::OrderRequest bid;
+        bid.orderId = "bid-1";
+        bid.accountId = BUYER;
+        bid.figi = SBER_FIGI;
+        bid.direction = domain::OrderDirection::BUY;
+        bid.type = domain::OrderType::LIMIT;
+        bid.quantity = 10;
+        bid.price = domain::Money::fromDouble(280.0, "RUB");
+        ASSERT_EQ(adapter_->placeOrder(BUYER, bid).status, domain::OrderStatus::PENDING);
+    }
+
+    /// Встречная продажа по цене bid-1 - сделка с ним
+    void sellCrossing(const std::string& orderId, int64_t lots) {
+        BrokerOrderRequest sell;
+        sell.orderId = orderId;
+        sell.accountId = SELLER;
+        sell.figi = SBER_FIGI;
+        sell.direction = Direction::SELL;
+        sell.type = Type::LIMIT;
+        sell.quantity = lots;
+        sell.price = 280.0;
+        ASSERT_EQ(broker_->placeOrder(SELLER, sell).status, Status::FILLED);
+    }
+
+    const std::string BUYER = "sandbox-buyer";
+    const std::string SELLER = "seller";
+
+    std::shared_ptr<EnhancedFakeBroker> broker_;
+    std::shared_ptr<FillRecordingPublisher> publisher_;
+    std::shared_ptr<InMemoryOrderRepository> orderRepo_;
+    std::unique_ptr<FakeBrokerAdapter> adapter_;
+};
+
+TEST_F(FakeBrokerAdapterFillTest, MakerFilledInTwoTrades_PartialThenFilledWithCumulativeLots) {
+    placeRestingBid();
+    sellCrossing("ask-1", 4);
+    sellCrossing("ask-2", 6);
+
+    auto events = publisher_->orderEvents();
+    ASSERT_EQ(events.size(), 2u);
+
+    EXPECT_EQ(events[0].routingKey, "order.partially_filled");
+    auto first = nlohmann::json::parse(events[0].payload);
+    EXPECT_EQ(first["order_id"], "bid-1");
+    EXPECT_EQ(first["account_id"], BUYER);
+    EXPECT_EQ(first["status"], "PARTIALLY_FILLED");
+    EXPECT_EQ(first["executed_lots"], 4);
+    EXPECT_EQ(first["last_fill_lots"], 4);
+
+    EXPECT_EQ(events[1].routingKey, "order.filled");
+    auto second = nlohmann::json::parse(events[1].payload);
+    EXPECT_EQ(second["status"], "FILLED");
+    EXPECT_EQ(second["executed_lots"], 10);
+    EXPECT_EQ(second["last_fill_lots"], 6);
+
+    auto stored = orderRepo_->findById("bid-1");
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ(stored->status, "FILLED");
+    EXPECT_EQ(stored->executedLots, 10);
+}
+
+TEST_F(FakeBrokerAdapterFillTest, BinaryWireFormat_PartialFrameCarriesCumulativeLots) {
+    publisher_->binary = true;
+    placeRestingBid();
+    sellCrossing("ask-1", 4);
+
+    auto events = publisher_->orderEvents();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].routingKey, "order.partially_filled");
+
+    auto frame = wire::decodeOrder(events[0].payload);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->status, wire::OrderStatus::PARTIALLY_FILLED);
+    EXPECT_EQ(frame->lots, 4);
+
+    sellCrossing("ask-2", 6);
+    events = publisher_->orderEvents();
+    ASSERT_EQ(events.size(), 2u);
+    frame = wire::decodeOrder(events[1].payload);
+    ASSERT_TRUE(frame.has_value());
+    EXPECT_EQ(frame->status, wire::OrderStatus::FILLED);
+    EXPECT_EQ(frame->lots, 10);
+}
+
+TEST_F(FakeBrokerAdapterFillTest, PortfolioUpdated_VersionsConsecutivePerAccount) {
+    placeRestingBid();
+    sellCrossing("ask-1", 4);
+    sellCrossing("ask-2", 6);
+
+    auto versions = publisher_->portfolioVersions(BUYER);
+    ASSERT_GE(versions.size(), 2u);
+    for (size_t i = 0; i < versions.size(); ++i) {
+        EXPECT_EQ(versions[i], i + 1);
+    }
+    EXPECT_TRUE(publisher_->portfolioVersions(SELLER).empty());
+}
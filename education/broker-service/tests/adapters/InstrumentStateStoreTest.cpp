@@ -0,0 +1,79 @@
+/**
+ * @file InstrumentStateStoreTest.cpp
+ * @brief Unit tests for InstrumentStateStore
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/broker/InstrumentStateStore.hpp"
+
+using namespace broker::adapters::secondary;
+
+class InstrumentStateStoreTest : public ::testing::Test {
+protected:
+    InstrumentStateStore store;
+
+    static InstrumentStateStore::State makeState(double price) {
+        InstrumentStateStore::State state;
+        state.price = price;
+        state.spread = 0.002;
+        state.volatility = 0.01;
+        state.dailyVolume = 42;
+        state.lastUpdate = std::chrono::system_clock::now();
+        return state;
+    }
+};
+
+TEST_F(InstrumentStateStoreTest, Resolve_AssignsDenseIds) {
+    EXPECT_EQ(store.resolve("A"), 0u);
+    EXPECT_EQ(store.resolve("B"), 1u);
+    EXPECT_EQ(store.resolve("A"), 0u);
+    EXPECT_EQ(store.idCount(), 2u);
+    EXPECT_EQ(store.figiOf(1), "B");
+}
+
+TEST_F(InstrumentStateStoreTest, ResolvedButInactive_NotVisible) {
+    auto id = store.resolve("A");
+
+    EXPECT_FALSE(store.find("A").has_value());
+    EXPECT_FALSE(store.read(id).has_value());
+    EXPECT_EQ(store.size(), 0u);
+}
+
+TEST_F(InstrumentStateStoreTest, Activate_ThenRead_ReturnsState) {
+    auto id = store.resolve("A");
+    store.activate(id, makeState(123.0));
+
+    auto state = store.read(id);
+    ASSERT_TRUE(state.has_value());
+    EXPECT_DOUBLE_EQ(state->price, 123.0);
+    EXPECT_DOUBLE_EQ(state->spread, 0.002);
+    EXPECT_DOUBLE_EQ(state->volatility, 0.01);
+    EXPECT_EQ(state->dailyVolume, 42);
+    EXPECT_EQ(store.find("A"), id);
+    EXPECT_EQ(store.size(), 1u);
+}
+
+TEST_F(InstrumentStateStoreTest, Deactivate_HidesAndCountsOnce) {
+    auto id = store.resolve("A");
+    store.activate(id, makeState(1.0));
+
+    EXPECT_TRUE(store.deactivate(id));
+    EXPECT_FALSE(store.deactivate(id));
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_FALSE(store.read(id).has_value());
+}
+
+TEST_F(InstrumentStateStoreTest, DeactivateAll_ClearsEverything) {
+    store.activate(store.resolve("A"), makeState(1.0));
+    store.activate(store.resolve("B"), makeState(2.0));
+
+    store.deactivateAll();
+
+    EXPECT_EQ(store.size(), 0u);
+    EXPECT_FALSE(store.find("A").has_value());
+    EXPECT_FALSE(store.find("B").has_value());
+}
+
+TEST_F(InstrumentStateStoreTest, Read_UnknownId_Nullopt) {
+    EXPECT_FALSE(store.read(999999).has_value());
+}
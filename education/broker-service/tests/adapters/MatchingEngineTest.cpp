@@ -0,0 +1,182 @@
+/**
+ * @file MatchingEngineTest.cpp
+ * @brief Unit tests for MatchingBook / MatchingEngine
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/broker/MatchingEngine.hpp"
+
+using namespace broker::adapters::secondary;
+
+class MatchingEngineTest : public ::testing::Test {
+protected:
+    static OrderRequest order(const std::string& id, const std::string& account,
+                              Direction dir, Type type, int64_t qty, double price = 0.0) {
+        OrderRequest req;
+        req.orderId = id;
+        req.accountId = account;
+        req.figi = "SBER";
+        req.direction = dir;
+        req.type = type;
+        req.quantity = qty;
+        req.price = price;
+        return req;
+    }
+
+    static OrderRequest buy(const std::string& id, int64_t qty, double price) {
+        return order(id, "buyer", Direction::BUY, Type::LIMIT, qty, price);
+    }
+
+    static OrderRequest sell(const std::string& id, int64_t qty, double price) {
+        return order(id, "seller", Direction::SELL, Type::LIMIT, qty, price);
+    }
+
+    MatchingBook book_;
+};
+
+// ============================================================================
+// ПОСТАНОВКА
+// ============================================================================
+
+TEST_F(MatchingEngineTest, NonCrossing_RestsOnBothSides) {
+    auto b = book_.submit(buy("b1", 10, 99.0));
+    auto s = book_.submit(sell("s1", 10, 101.0));
+
+    EXPECT_TRUE(b.trades.empty());
+    EXPECT_EQ(b.resting, 10);
+    EXPECT_TRUE(s.trades.empty());
+    EXPECT_EQ(book_.size(), 2u);
+    EXPECT_DOUBLE_EQ(book_.bestBid(), 99.0);
+    EXPECT_DOUBLE_EQ(book_.bestAsk(), 101.0);
+}
+
+TEST_F(MatchingEngineTest, Crossing_TradesAtMakerPrice) {
+    book_.submit(sell("s1", 10, 100.0));
+
+    auto r = book_.submit(buy("b1", 10, 105.0));
+
+    ASSERT_EQ(r.trades.size(), 1u);
+    EXPECT_EQ(r.trades[0].makerOrderId, "s1");
+    EXPECT_EQ(r.trades[0].makerAccountId, "seller");
+    EXPECT_DOUBLE_EQ(r.trades[0].price, 100.0);
+    EXPECT_TRUE(r.trades[0].makerDone);
+    EXPECT_EQ(r.filled, 10);
+    EXPECT_EQ(r.resting, 0);
+    EXPECT_EQ(book_.size(), 0u);
+    EXPECT_EQ(book_.levelCount(), 0u);
+}
+
+// ============================================================================
+// PRICE-TIME PRIORITY
+// ============================================================================
+
+TEST_F(MatchingEngineTest, BestPriceFirst_ThenTime) {
+    book_.submit(sell("s-102", 5, 102.0));
+    book_.submit(sell("s-101a", 5, 101.0));
+    book_.submit(sell("s-101b", 5, 101.0));
+
+    auto r = book_.submit(buy("b1", 12, 102.0));
+
+    ASSERT_EQ(r.trades.size(), 3u);
+    EXPECT_EQ(r.trades[0].makerOrderId, "s-101a");
+    EXPECT_EQ(r.trades[1].makerOrderId, "s-101b");
+    EXPECT_EQ(r.trades[2].makerOrderId, "s-102");
+    EXPECT_EQ(r.trades[2].quantity, 2);
+    EXPECT_FALSE(r.trades[2].makerDone);
+    EXPECT_DOUBLE_EQ(r.notional, 5 * 101.0 + 5 * 101.0 + 2 * 102.0);
+    EXPECT_EQ(book_.size(), 1u);
+}
+
+TEST_F(MatchingEngineTest, LimitStopsAtWorsePrice_RestRests) {
+    book_.submit(sell("s1", 5, 100.0));
+    book_.submit(sell("s2", 5, 103.0));
+
+    auto r = book_.submit(buy("b1", 8, 101.0));
+
+    EXPECT_EQ(r.filled, 5);
+    EXPECT_EQ(r.resting, 3);
+    EXPECT_DOUBLE_EQ(book_.bestBid(), 101.0);
+    EXPECT_DOUBLE_EQ(book_.bestAsk(), 103.0);
+}
+
+TEST_F(MatchingEngineTest, Market_SweepsAndDiscardsRest) {
+    book_.submit(buy("b1", 4, 99.0));
+    book_.submit(buy("b2", 4, 98.0));
+
+    auto r = book_.submit(order("m1", "seller", Direction::SELL, Type::MARKET, 10));
+
+    EXPECT_EQ(r.filled, 8);
+    EXPECT_EQ(r.resting, 0);
+    EXPECT_EQ(book_.size(), 0u);
+}
+
+TEST_F(MatchingEngineTest, MarketBuy_ProtectionPrice_StopsSweep) {
+    book_.submit(sell("s1", 4, 100.0));
+    book_.submit(sell("s2", 4, 103.0));
+
+    // Деньги зарезервированы по 101: уровень 103 не трогаем, остаток не встаёт
+    auto r = book_.submit(order("m1", "buyer", Direction::BUY, Type::MARKET, 8, 101.0));
+
+    EXPECT_EQ(r.filled, 4);
+    EXPECT_DOUBLE_EQ(r.notional, 400.0);
+    EXPECT_EQ(r.resting, 0);
+    EXPECT_EQ(book_.size(), 1u);
+    EXPECT_DOUBLE_EQ(book_.bestAsk(), 103.0);
+}
+
+// ============================================================================
+// ОТМЕНА И ПУЛ УЗЛОВ
+// ============================================================================
+
+TEST_F(MatchingEngineTest, Cancel_FromMiddleOfLevel_KeepsQueueOrder) {
+    book_.submit(sell("s1", 1, 100.0));
+    book_.submit(sell("s2", 1, 100.0));
+    book_.submit(sell("s3", 1, 100.0));
+
+    EXPECT_TRUE(book_.cancel("s2"));
+    EXPECT_FALSE(book_.cancel("s2"));
+
+    auto r = book_.submit(buy("b1", 2, 100.0));
+    ASSERT_EQ(r.trades.size(), 2u);
+    EXPECT_EQ(r.trades[0].makerOrderId, "s1");
+    EXPECT_EQ(r.trades[1].makerOrderId, "s3");
+}
+
+TEST_F(MatchingEngineTest, Cancel_LastOrder_RemovesLevel) {
+    book_.submit(buy("b1", 1, 99.0));
+    book_.submit(buy("b2", 1, 98.0));
+
+    book_.cancel("b1");
+
+    EXPECT_EQ(book_.levelCount(), 1u);
+    EXPECT_DOUBLE_EQ(book_.bestBid(), 98.0);
+}
+
+TEST_F(MatchingEngineTest, ManyOrders_NodesReused) {
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 1000; ++i) {
+            book_.submit(sell("s" + std::to_string(i), 1, 100.0 + i % 10));
+        }
+        auto r = book_.submit(order("m", "buyer", Direction::BUY, Type::MARKET, 1000));
+        EXPECT_EQ(r.filled, 1000);
+        EXPECT_EQ(book_.size(), 0u);
+    }
+}
+
+TEST_F(MatchingEngineTest, Engine_CancelByIdAcrossBooks) {
+    MatchingEngine engine;
+    auto req = buy("b1", 10, 99.0);
+    req.figi = "GAZP";
+    engine.submit(req);
+    engine.submit(buy("b2", 10, 99.0));
+
+    EXPECT_EQ(engine.restingCount(), 2u);
+    EXPECT_TRUE(engine.cancel("b1"));
+    EXPECT_EQ(engine.restingCount(), 1u);
+
+    std::vector<PendingOrder> resting;
+    engine.appendResting(resting);
+    ASSERT_EQ(resting.size(), 1u);
+    EXPECT_EQ(resting[0].orderId, "b2");
+    EXPECT_EQ(resting[0].figi, "SBER");
+}
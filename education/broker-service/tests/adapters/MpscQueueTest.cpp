@@ -0,0 +1,92 @@
+/**
+ * @file MpscQueueTest.cpp
+ * @brief Unit-тесты lock-free очереди публикации RabbitMQAdapter
+ */
+
+#include <gtest/gtest.h>
+
+#include "adapters/secondary/events/MpscQueue.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace broker::adapters::secondary;
+
+TEST(MpscQueueTest, Empty_PopReturnsFalse) {
+    MpscQueue<int> queue;
+    int value = 0;
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(MpscQueueTest, SingleProducer_Fifo) {
+    MpscQueue<std::string> queue;
+    queue.push("a");
+    queue.push("b");
+    queue.push("c");
+
+    std::string value;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "a");
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "b");
+    EXPECT_FALSE(queue.empty());
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, "c");
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MpscQueueTest, Destructor_FreesRemaining) {
+    auto tracked = std::make_shared<int>(0);
+    {
+        MpscQueue<std::shared_ptr<int>> queue;
+        queue.push(tracked);
+        queue.push(tracked);
+        std::shared_ptr<int> value;
+        queue.pop(value);
+        EXPECT_EQ(tracked.use_count(), 3);
+    }
+    EXPECT_EQ(tracked.use_count(), 1);
+}
+
+TEST(MpscQueueTest, ManyProducers_NoLossAndPerProducerOrder) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+
+    MpscQueue<std::pair<int, int>> queue;
+    std::atomic<int> ready{0};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            ready.fetch_add(1);
+            while (ready.load() < PRODUCERS) {
+            }
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push({p, i});
+            }
+        });
+    }
+
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    std::pair<int, int> value;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        if (!queue.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(value.second, next[value.first]) << "producer " << value.first;
+        ++next[value.first];
+        ++received;
+    }
+
+    for (auto& t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
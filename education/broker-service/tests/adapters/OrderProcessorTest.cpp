@@ -146,6 +146,27 @@ TEST_F(OrderProcessorTest, Realistic_MarketSell_WithSlippage) {
     EXPECT_EQ(result.status, Status::FILLED);
 }
 
+TEST_F(OrderProcessorTest, Realistic_MarketBuy_AboveProtectionPrice_Rejected) {
+    auto scenario = MarketScenario::lowLiquidity(280.0, 100);
+    auto ask = priceSimulator_->getQuote("SBER")->ask;
+    
+    // Резерв по ask, исполнение с проскальзыванием 0.5% - дороже резерва
+    auto req = createBuyMarket("SBER", 50);
+    req.price = ask;
+    auto result = processor_->processOrder(req, scenario);
+    
+    EXPECT_EQ(result.status, Status::REJECTED);
+    EXPECT_EQ(result.executedQuantity, 0);
+    EXPECT_NE(result.message.find("exceeds reserved price"), std::string::npos);
+    
+    // Запаса на проскальзывание хватает - исполняется выше ask
+    req.price = ask * 1.01;
+    result = processor_->processOrder(req, scenario);
+    EXPECT_EQ(result.status, Status::FILLED);
+    EXPECT_GT(result.executedPrice, ask);
+    EXPECT_LE(result.executedPrice, req.price);
+}
+
 TEST_F(OrderProcessorTest, Realistic_SmallOrder_NoSlippage) {
     auto scenario = MarketScenario::realistic(280.0);
     scenario.availableLiquidity = 10000;
@@ -346,3 +367,111 @@ TEST_F(OrderProcessorTest, FillCallback_CalledOnPendingFill) {
     EXPECT_EQ(receivedEvent.orderId, result.orderId);
     EXPECT_EQ(receivedEvent.quantity, 10);
 }
+
+TEST_F(OrderProcessorTest, PendingLimit_NotCrossed_StaysQueued) {
+    int fills = 0;
+    processor_->setFillCallback([&](const OrderFillEvent&) { ++fills; });
+    
+    auto scenario = MarketScenario::realistic(280.0);
+    auto req = createSellLimit("SBER", 10, 400.0);
+    req.orderId = "far-sell";
+    processor_->processOrder(req, scenario);
+    
+    processor_->processPendingOrders(scenario);
+    
+    EXPECT_EQ(fills, 0);
+    EXPECT_EQ(processor_->pendingCount(), 1u);
+}
+
+TEST_F(OrderProcessorTest, DelayedMarket_FilledAfterDelay) {
+    std::vector<std::string> filled;
+    processor_->setFillCallback([&](const OrderFillEvent& e) { filled.push_back(e.orderId); });
+    
+    auto scenario = MarketScenario::realistic(280.0);
+    scenario.fillBehavior = OrderFillBehavior::DELAYED;
+    scenario.fillDelay = std::chrono::milliseconds{0};
+    
+    auto req = createBuyMarket("SBER", 10);
+    req.orderId = "delayed-1";
+    processor_->processOrder(req, scenario);
+    processor_->processPendingOrders(scenario);
+    
+    ASSERT_EQ(filled.size(), 1u);
+    EXPECT_EQ(filled[0], "delayed-1");
+    EXPECT_EQ(processor_->pendingCount(), 0u);
+}
+
+// ============================================================================
+// MATCHING MODE TESTS
+// ============================================================================
+
+TEST_F(OrderProcessorTest, Matching_NoCounterparty_LimitQueued_MarketRejected) {
+    auto scenario = MarketScenario::matching(280.0);
+    
+    auto limitReq = createBuyLimit("SBER", 10, 279.0);
+    limitReq.orderId = "bid-1";
+    auto marketReq = createSellMarket("GAZP", 5);
+    marketReq.orderId = "mkt-1";
+    
+    EXPECT_EQ(processor_->processOrder(limitReq, scenario).status, Status::PENDING);
+    EXPECT_EQ(processor_->processOrder(marketReq, scenario).status, Status::REJECTED);
+    EXPECT_EQ(processor_->pendingCount(), 1u);
+}
+
+TEST_F(OrderProcessorTest, Matching_CrossAccounts_FillsBothSides) {
+    std::vector<OrderFillEvent> makerFills;
+    processor_->setFillCallback([&](const OrderFillEvent& e) { makerFills.push_back(e); });
+    auto scenario = MarketScenario::matching(280.0);
+    
+    auto ask = createSellLimit("SBER", 10, 281.5);
+    ask.orderId = "ask-1";
+    ask.accountId = "seller";
+    processor_->processOrder(ask, scenario);
+    
+    auto bid = createBuyLimit("SBER", 4, 282.0);
+    bid.orderId = "bid-1";
+    bid.accountId = "buyer";
+    auto result = processor_->processOrder(bid, scenario);
+    
+    EXPECT_EQ(result.status, Status::FILLED);
+    EXPECT_EQ(result.executedQuantity, 4);
+    EXPECT_DOUBLE_EQ(result.executedPrice, 281.5);
+    
+    ASSERT_EQ(makerFills.size(), 1u);
+    EXPECT_EQ(makerFills[0].orderId, "ask-1");
+    EXPECT_EQ(makerFills[0].accountId, "seller");
+    EXPECT_EQ(makerFills[0].direction, Direction::SELL);
+    EXPECT_TRUE(makerFills[0].partial);
+    
+    // Цена сделки становится последней ценой
+    EXPECT_DOUBLE_EQ(priceSimulator_->getPrice("SBER"), 281.5);
+    EXPECT_EQ(processor_->pendingCount(), 1u);
+}
+
+TEST_F(OrderProcessorTest, Matching_PartialTaker_RestQueued) {
+    auto scenario = MarketScenario::matching(280.0);
+    
+    auto ask = createSellLimit("SBER", 3, 280.0);
+    ask.orderId = "ask-1";
+    processor_->processOrder(ask, scenario);
+    
+    auto bid = createBuyLimit("SBER", 10, 280.0);
+    bid.orderId = "bid-1";
+    auto result = processor_->processOrder(bid, scenario);
+    
+    EXPECT_EQ(result.status, Status::PARTIALLY_FILLED);
+    EXPECT_EQ(result.executedQuantity, 3);
+    EXPECT_EQ(processor_->bookTop("SBER").first, 280.0);
+    
+    EXPECT_TRUE(processor_->cancelOrder("bid-1"));
+    EXPECT_EQ(processor_->pendingCount(), 0u);
+}
+
+TEST_F(OrderProcessorTest, Matching_DuplicateOrderId_Rejected) {
+    auto scenario = MarketScenario::matching(280.0);
+    auto bid = createBuyLimit("SBER", 1, 270.0);
+    bid.orderId = "dup";
+    processor_->processOrder(bid, scenario);
+    
+    EXPECT_EQ(processor_->processOrder(bid, scenario).status, Status::REJECTED);
+}
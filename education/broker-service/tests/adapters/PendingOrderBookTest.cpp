@@ -0,0 +1,192 @@
+/**
+ * @file PendingOrderBookTest.cpp
+ * @brief Unit tests for PendingOrderBook
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/broker/PendingOrderBook.hpp"
+#include <map>
+
+using namespace broker::adapters::secondary;
+
+class PendingOrderBookTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        now_ = std::chrono::system_clock::now();
+        setQuote("SBER", 279.0, 281.0);
+    }
+
+    void setQuote(const std::string& figi, double bid, double ask) {
+        PriceSimulator::Quote q;
+        q.bid = bid;
+        q.ask = ask;
+        q.last = (bid + ask) / 2;
+        quotes_[figi] = q;
+    }
+
+    std::vector<PendingOrderBook::Fill> take() {
+        return book_.takeExecutable(now_, [this](const std::string& figi)
+            -> std::optional<PriceSimulator::Quote> {
+            ++lookups_;
+            auto it = quotes_.find(figi);
+            if (it == quotes_.end()) return std::nullopt;
+            return it->second;
+        });
+    }
+
+    static PendingOrder limit(const std::string& id, Direction dir, double price,
+                              const std::string& figi = "SBER") {
+        PendingOrder o;
+        o.orderId = id;
+        o.accountId = "acc";
+        o.figi = figi;
+        o.direction = dir;
+        o.type = Type::LIMIT;
+        o.quantity = 1;
+        o.limitPrice = price;
+        return o;
+    }
+
+    PendingOrder delayedMarket(const std::string& id, std::chrono::milliseconds after) {
+        PendingOrder o = limit(id, Direction::BUY, 0.0);
+        o.type = Type::MARKET;
+        o.isDelayedMarket = true;
+        o.fillAfter = now_ + after;
+        return o;
+    }
+
+    PendingOrderBook book_;
+    std::map<std::string, PriceSimulator::Quote> quotes_;
+    std::chrono::system_clock::time_point now_;
+    int lookups_ = 0;
+};
+
+// ============================================================================
+// LIMIT
+// ============================================================================
+
+TEST_F(PendingOrderBookTest, Limit_NotCrossed_Stays) {
+    book_.add(limit("b1", Direction::BUY, 270.0));
+    book_.add(limit("s1", Direction::SELL, 290.0));
+
+    EXPECT_TRUE(take().empty());
+    EXPECT_EQ(book_.size(), 2u);
+}
+
+TEST_F(PendingOrderBookTest, Limit_OnlyCrossedPrefixFills) {
+    book_.add(limit("b-low", Direction::BUY, 270.0));
+    book_.add(limit("b-high", Direction::BUY, 285.0));
+    book_.add(limit("b-mid", Direction::BUY, 281.0));
+    book_.add(limit("s-low", Direction::SELL, 275.0));
+    book_.add(limit("s-high", Direction::SELL, 300.0));
+
+    auto fills = take();
+
+    ASSERT_EQ(fills.size(), 3u);
+    EXPECT_EQ(fills[0].order.orderId, "b-high");
+    EXPECT_DOUBLE_EQ(fills[0].price, 281.0);
+    EXPECT_EQ(fills[1].order.orderId, "b-mid");
+    EXPECT_EQ(fills[2].order.orderId, "s-low");
+    EXPECT_DOUBLE_EQ(fills[2].price, 279.0);
+    EXPECT_EQ(book_.size(), 2u);
+}
+
+TEST_F(PendingOrderBookTest, Limit_SamePrice_Fifo) {
+    book_.add(limit("first", Direction::BUY, 285.0));
+    book_.add(limit("second", Direction::BUY, 285.0));
+
+    auto fills = take();
+
+    ASSERT_EQ(fills.size(), 2u);
+    EXPECT_EQ(fills[0].order.orderId, "first");
+    EXPECT_EQ(fills[1].order.orderId, "second");
+}
+
+TEST_F(PendingOrderBookTest, Remove_TakesOrderOutOfLadder) {
+    book_.add(limit("b1", Direction::BUY, 285.0));
+
+    EXPECT_TRUE(book_.remove("b1"));
+    EXPECT_FALSE(book_.remove("b1"));
+    EXPECT_TRUE(take().empty());
+    EXPECT_EQ(book_.figiCount(), 0u);
+}
+
+TEST_F(PendingOrderBookTest, Add_SameId_Replaces) {
+    book_.add(limit("o1", Direction::BUY, 270.0));
+    book_.add(limit("o1", Direction::BUY, 285.0));
+
+    EXPECT_EQ(book_.size(), 1u);
+    ASSERT_EQ(take().size(), 1u);
+    EXPECT_EQ(book_.size(), 0u);
+}
+
+TEST_F(PendingOrderBookTest, QuoteLookup_OncePerFigi) {
+    for (int i = 0; i < 100; ++i) {
+        book_.add(limit("b" + std::to_string(i), Direction::BUY, 200.0 + i * 0.1));
+    }
+
+    take();
+
+    EXPECT_EQ(lookups_, 1);
+}
+
+TEST_F(PendingOrderBookTest, UnknownFigi_Stays) {
+    book_.add(limit("x1", Direction::BUY, 1000.0, "UNKNOWN"));
+
+    EXPECT_TRUE(take().empty());
+    EXPECT_EQ(book_.size(), 1u);
+}
+
+// ============================================================================
+// DELAYED MARKET
+// ============================================================================
+
+TEST_F(PendingOrderBookTest, Delayed_FillsOnlyWhenDue) {
+    book_.add(delayedMarket("later", std::chrono::milliseconds{100}));
+    book_.add(delayedMarket("due", std::chrono::milliseconds{-1}));
+
+    auto fills = take();
+
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0].order.orderId, "due");
+    EXPECT_DOUBLE_EQ(fills[0].price, 281.0);
+
+    now_ += std::chrono::milliseconds{200};
+    fills = take();
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0].order.orderId, "later");
+}
+
+TEST_F(PendingOrderBookTest, Delayed_CancelledNotFilled) {
+    book_.add(delayedMarket("d1", std::chrono::milliseconds{-1}));
+    book_.remove("d1");
+
+    EXPECT_TRUE(take().empty());
+}
+
+TEST_F(PendingOrderBookTest, Delayed_NoQuote_RetriedNextTick) {
+    auto order = delayedMarket("d1", std::chrono::milliseconds{-1});
+    order.figi = "GAZP";
+    book_.add(order);
+
+    EXPECT_TRUE(take().empty());
+
+    setQuote("GAZP", 149.0, 151.0);
+    ASSERT_EQ(take().size(), 1u);
+    EXPECT_EQ(book_.size(), 0u);
+}
+
+TEST_F(PendingOrderBookTest, Delayed_BuyAboveProtectionPrice_WaitsAsLimit) {
+    auto order = delayedMarket("d1", std::chrono::milliseconds{-1});
+    order.limitPrice = 280.0;  // резерв взят по 280, ask уже 281
+    book_.add(order);
+
+    EXPECT_TRUE(take().empty());
+    EXPECT_EQ(book_.size(), 1u);
+
+    setQuote("SBER", 278.0, 279.5);
+    auto fills = take();
+    ASSERT_EQ(fills.size(), 1u);
+    EXPECT_EQ(fills[0].order.orderId, "d1");
+    EXPECT_DOUBLE_EQ(fills[0].price, 279.5);
+}
@@ -379,4 +379,156 @@ TEST_F(PriceSimulatorTest, DeterministicSeed_SameResults) {
         double price2 = sim2.tick(SBER_FIGI);
         EXPECT_DOUBLE_EQ(price1, price2);
     }
-}
\ No newline at end of file
+}
+// ================================================================
+// INSTRUMENT ID
+// ================================================================
+
+TEST_F(PriceSimulatorTest, InstrumentId_StableAcrossRemoveAndReinit) {
+    simulator.initInstrument(SBER_FIGI, 280.0);
+    auto id = simulator.instrumentId(SBER_FIGI);
+    ASSERT_TRUE(id.has_value());
+    
+    simulator.removeInstrument(SBER_FIGI);
+    EXPECT_FALSE(simulator.instrumentId(SBER_FIGI).has_value());
+    EXPECT_FALSE(simulator.getQuote(*id).has_value());
+    
+    simulator.initInstrument(SBER_FIGI, 300.0);
+    EXPECT_EQ(simulator.instrumentId(SBER_FIGI), id);
+    EXPECT_DOUBLE_EQ(simulator.getQuote(*id)->last, 300.0);
+}
+
+TEST_F(PriceSimulatorTest, GetQuoteById_MatchesFigiLookup) {
+    simulator.initInstrument(SBER_FIGI, 280.0, 0.01, 0.002);
+    auto id = simulator.instrumentId(SBER_FIGI);
+    ASSERT_TRUE(id.has_value());
+    
+    simulator.tick(*id);
+    
+    auto byId = simulator.getQuote(*id);
+    auto byFigi = simulator.getQuote(SBER_FIGI);
+    ASSERT_TRUE(byId && byFigi);
+    EXPECT_DOUBLE_EQ(byId->last, byFigi->last);
+    EXPECT_DOUBLE_EQ(byId->bid, byFigi->bid);
+}
+
+TEST_F(PriceSimulatorTest, ManyInstruments_AcrossChunks) {
+    const int count = static_cast<int>(InstrumentStateStore::CHUNK_SIZE) * 3 + 7;
+    for (int i = 0; i < count; ++i) {
+        simulator.initInstrument("FIGI" + std::to_string(i), 100.0 + i);
+    }
+    
+    EXPECT_EQ(simulator.size(), static_cast<size_t>(count));
+    EXPECT_DOUBLE_EQ(simulator.getPrice("FIGI0"), 100.0);
+    EXPECT_DOUBLE_EQ(simulator.getPrice("FIGI" + std::to_string(count - 1)), 100.0 + count - 1);
+}
+
+TEST_F(PriceSimulatorTest, ConcurrentReaders_SeeConsistentQuote) {
+    // Спред фиксирован, поэтому bid/ask/last из одного снимка
+    // всегда связаны: ask - bid == last * spread
+    simulator.initInstrument(SBER_FIGI, 280.0, 0.01, 0.05);
+    std::atomic<bool> running{true};
+    std::atomic<int> torn{0};
+    
+    std::thread writer([this, &running]() {
+        while (running) {
+            simulator.tick(SBER_FIGI);
+        }
+    });
+    
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i) {
+        readers.emplace_back([this, &running, &torn]() {
+            while (running) {
+                auto quote = simulator.getQuote(SBER_FIGI);
+                if (quote && std::abs(quote->spreadAbs() - quote->last * 0.01) > 1e-9 * quote->last) {
+                    ++torn;
+                }
+            }
+        });
+    }
+    
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    running = false;
+    
+    writer.join();
+    for (auto& r : readers) {
+        r.join();
+    }
+    EXPECT_EQ(torn.load(), 0);
+}
+
+// ================================================================
+// BATCH TICK
+// ================================================================
+
+TEST_F(PriceSimulatorTest, TickBatch_UpdatesAllAndWritesBack) {
+    simulator.initInstrument(SBER_FIGI, 280.0, 0.01, 0.01);
+    simulator.initInstrument(GAZP_FIGI, 160.0, 0.02, 0.01);
+    std::vector<PriceSimulator::InstrumentId> ids = {
+        *simulator.instrumentId(SBER_FIGI),
+        *simulator.instrumentId(GAZP_FIGI)
+    };
+    std::vector<PriceSimulator::BatchQuote> out;
+    
+    EXPECT_EQ(simulator.tickBatch(ids, out), 2u);
+    
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].index, 0u);
+    EXPECT_EQ(out[1].index, 1u);
+    EXPECT_DOUBLE_EQ(out[0].quote.last, simulator.getPrice(SBER_FIGI));
+    EXPECT_DOUBLE_EQ(out[1].quote.last, simulator.getPrice(GAZP_FIGI));
+    EXPECT_NEAR(out[1].quote.spreadPercent(), 2.0, 1e-9);
+}
+
+TEST_F(PriceSimulatorTest, TickBatch_SkipsRemovedInstruments) {
+    simulator.initInstrument(SBER_FIGI, 280.0);
+    simulator.initInstrument(GAZP_FIGI, 160.0);
+    std::vector<PriceSimulator::InstrumentId> ids = {
+        *simulator.instrumentId(SBER_FIGI),
+        *simulator.instrumentId(GAZP_FIGI)
+    };
+    simulator.removeInstrument(SBER_FIGI);
+    std::vector<PriceSimulator::BatchQuote> out;
+    
+    EXPECT_EQ(simulator.tickBatch(ids, out), 1u);
+    ASSERT_EQ(out.size(), 1u);
+    EXPECT_EQ(out[0].index, 1u);
+}
+
+TEST_F(PriceSimulatorTest, TickBatch_NeverBelowMinimumPrice) {
+    simulator.initInstrument(SBER_FIGI, 0.02, 0.001, 0.9);
+    std::vector<PriceSimulator::InstrumentId> ids = { *simulator.instrumentId(SBER_FIGI) };
+    std::vector<PriceSimulator::BatchQuote> out;
+    
+    for (int i = 0; i < 1000; ++i) {
+        simulator.tickBatch(ids, out);
+        ASSERT_GE(out[0].quote.last, 0.01);
+    }
+}
+
+TEST_F(PriceSimulatorTest, TickBatch_GaussianStatistics) {
+    // Лог-доходности за тик должны иметь среднее ~0 и σ ~ volatility
+    const int count = 2000;
+    const double volatility = 0.001;
+    std::vector<PriceSimulator::InstrumentId> ids;
+    for (int i = 0; i < count; ++i) {
+        std::string figi = "F" + std::to_string(i);
+        simulator.initInstrument(figi, 100.0, 0.001, volatility);
+        ids.push_back(*simulator.instrumentId(figi));
+    }
+    std::vector<PriceSimulator::BatchQuote> out;
+    simulator.tickBatch(ids, out);
+    
+    double sum = 0.0, sumSq = 0.0;
+    for (const auto& bq : out) {
+        double r = bq.quote.last / 100.0 - 1.0;
+        sum += r;
+        sumSq += r * r;
+    }
+    double mean = sum / count;
+    double stddev = std::sqrt(sumSq / count - mean * mean);
+    
+    EXPECT_NEAR(mean, 0.0, 4 * volatility / std::sqrt(count));
+    EXPECT_NEAR(stddev, volatility, volatility * 0.1);
+}
@@ -0,0 +1,182 @@
+/**
+ * @file QuoteWriteBehindSinkTest.cpp
+ * @brief Unit tests for QuoteWriteBehindSink
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/QuoteWriteBehindSink.hpp"
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+
+using namespace broker;
+using namespace broker::adapters::secondary;
+
+// ============================================================================
+// FAKE REPOSITORY
+// ============================================================================
+
+/**
+ * @brief Запоминает пачки, переданные в saveBatch
+ */
+class RecordingQuoteRepository : public ports::output::IQuoteRepository {
+public:
+    std::optional<domain::Quote> findByFigi(const std::string& figi) override {
+        auto it = rows.find(figi);
+        if (it == rows.end()) return std::nullopt;
+        return it->second;
+    }
+
+    void save(const domain::Quote& quote) override {
+        ++singleSaves;
+        rows[quote.figi] = quote;
+    }
+
+    void saveBatch(const std::vector<domain::Quote>& quotes) override {
+        if (failNext) {
+            failNext = false;
+            throw std::runtime_error("db down");
+        }
+        batchSizes.push_back(quotes.size());
+        for (const auto& q : quotes) {
+            rows[q.figi] = q;
+        }
+    }
+
+    std::map<std::string, domain::Quote> rows;
+    std::vector<size_t> batchSizes;
+    int singleSaves = 0;
+    bool failNext = false;
+};
+
+class QuoteWriteBehindSinkTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        repo_ = std::make_shared<RecordingQuoteRepository>();
+        sink_ = std::make_shared<QuoteWriteBehindSink>(
+            repo_, std::make_shared<settings::BrokerSettings>());
+    }
+
+    static domain::Quote makeQuote(const std::string& figi, double last) {
+        domain::Quote q;
+        q.figi = figi;
+        q.lastPrice = domain::Money::fromDouble(last);
+        q.bidPrice = domain::Money::fromDouble(last - 0.1);
+        q.askPrice = domain::Money::fromDouble(last + 0.1);
+        return q;
+    }
+
+    std::shared_ptr<RecordingQuoteRepository> repo_;
+    std::shared_ptr<QuoteWriteBehindSink> sink_;
+};
+
+// ============================================================================
+// COALESCING
+// ============================================================================
+
+TEST_F(QuoteWriteBehindSinkTest, Offer_DoesNotTouchRepository) {
+    sink_->offer(makeQuote("SBER", 280.0));
+
+    EXPECT_TRUE(repo_->rows.empty());
+    EXPECT_EQ(sink_->stats().pending, 1u);
+}
+
+TEST_F(QuoteWriteBehindSinkTest, Flush_KeepsLatestQuotePerFigi) {
+    sink_->offer(makeQuote("SBER", 280.0));
+    sink_->offer(makeQuote("SBER", 281.0));
+    sink_->offer(makeQuote("SBER", 282.0));
+    sink_->offer(makeQuote("GAZP", 150.0));
+
+    EXPECT_EQ(sink_->flush(), 2u);
+
+    ASSERT_EQ(repo_->batchSizes.size(), 1u);
+    EXPECT_EQ(repo_->batchSizes[0], 2u);
+    EXPECT_DOUBLE_EQ(repo_->rows["SBER"].lastPrice.toDouble(), 282.0);
+    EXPECT_DOUBLE_EQ(repo_->rows["GAZP"].lastPrice.toDouble(), 150.0);
+    EXPECT_EQ(repo_->singleSaves, 0);
+}
+
+TEST_F(QuoteWriteBehindSinkTest, Stats_CountCoalescedAndWritten) {
+    sink_->offer(makeQuote("SBER", 280.0));
+    sink_->offer(makeQuote("SBER", 281.0));
+    sink_->offer(makeQuote("GAZP", 150.0));
+    sink_->flush();
+
+    auto stats = sink_->stats();
+    EXPECT_EQ(stats.offered, 3u);
+    EXPECT_EQ(stats.coalesced, 1u);
+    EXPECT_EQ(stats.written, 2u);
+    EXPECT_EQ(stats.flushes, 1u);
+    EXPECT_EQ(stats.failures, 0u);
+    EXPECT_EQ(stats.pending, 0u);
+}
+
+TEST_F(QuoteWriteBehindSinkTest, Flush_Empty_NoBatch) {
+    EXPECT_EQ(sink_->flush(), 0u);
+    EXPECT_TRUE(repo_->batchSizes.empty());
+}
+
+// ============================================================================
+// ОШИБКИ
+// ============================================================================
+
+TEST_F(QuoteWriteBehindSinkTest, FailedFlush_RequeuesBatch) {
+    sink_->offer(makeQuote("SBER", 280.0));
+    repo_->failNext = true;
+
+    EXPECT_EQ(sink_->flush(), 0u);
+    EXPECT_EQ(sink_->stats().failures, 1u);
+    EXPECT_EQ(sink_->stats().pending, 1u);
+
+    EXPECT_EQ(sink_->flush(), 1u);
+    EXPECT_DOUBLE_EQ(repo_->rows["SBER"].lastPrice.toDouble(), 280.0);
+}
+
+TEST_F(QuoteWriteBehindSinkTest, FailedFlush_DoesNotOverwriteNewerQuote) {
+    sink_->offer(makeQuote("SBER", 280.0));
+    repo_->failNext = true;
+    sink_->flush();
+
+    // Пока пачка "висела", пришла свежая котировка
+    sink_->offer(makeQuote("SBER", 290.0));
+    sink_->flush();
+
+    EXPECT_DOUBLE_EQ(repo_->rows["SBER"].lastPrice.toDouble(), 290.0);
+}
+
+// ============================================================================
+// ФОНОВЫЙ ПОТОК
+// ============================================================================
+
+TEST_F(QuoteWriteBehindSinkTest, Stop_FlushesRemainder) {
+    sink_->start();
+    EXPECT_TRUE(sink_->isRunning());
+
+    sink_->offer(makeQuote("SBER", 280.0));
+    sink_->stop();
+
+    EXPECT_FALSE(sink_->isRunning());
+    EXPECT_EQ(repo_->rows.count("SBER"), 1u);
+}
+
+TEST_F(QuoteWriteBehindSinkTest, Destructor_FlushesWithoutStart) {
+    sink_->offer(makeQuote("SBER", 280.0));
+    sink_.reset();
+
+    EXPECT_EQ(repo_->rows.count("SBER"), 1u);
+}
+
+// ============================================================================
+// SETTINGS
+// ============================================================================
+
+TEST(BrokerSettingsTest, NonPositiveFlushInterval_Throws) {
+    for (const char* value : {"0", "-5"}) {
+        setenv("BROKER_QUOTE_FLUSH_INTERVAL_MS", value, 1);
+        EXPECT_THROW(settings::BrokerSettings(), std::invalid_argument) << value;
+    }
+
+    setenv("BROKER_QUOTE_FLUSH_INTERVAL_MS", "1", 1);
+    EXPECT_NO_THROW(settings::BrokerSettings());
+    unsetenv("BROKER_QUOTE_FLUSH_INTERVAL_MS");
+}
@@ -0,0 +1,118 @@
+/**
+ * @file BoundedQueueTest.cpp
+ * @brief Unit-тесты примитивов конвейера: BoundedQueue и LatencyHistogram
+ */
+
+#include <gtest/gtest.h>
+
+#include "application/pipeline/BoundedQueue.hpp"
+#include "application/pipeline/LatencyHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace broker::application::pipeline;
+
+// ============================================================================
+// BoundedQueue
+// ============================================================================
+
+TEST(BoundedQueueTest, PushPop_Fifo) {
+    BoundedQueue<int> queue(4);
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    int value = 0;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 1);
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(BoundedQueueTest, Push_BlocksWhenFull) {
+    BoundedQueue<int> queue(2);
+    queue.push(1);
+    queue.push(2);
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] {
+        queue.push(3);
+        pushed = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(pushed.load());
+
+    int value = 0;
+    queue.pop(value);
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(BoundedQueueTest, PopBatch_TakesUpToMax) {
+    BoundedQueue<int> queue(8);
+    for (int i = 0; i < 5; ++i) {
+        queue.push(i);
+    }
+
+    std::vector<int> batch;
+    EXPECT_EQ(queue.popBatch(batch, 3), 3u);
+    EXPECT_EQ(batch, (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(queue.size(), 2u);
+}
+
+TEST(BoundedQueueTest, Close_DrainsThenStops) {
+    BoundedQueue<int> queue(4);
+    queue.push(7);
+    queue.close();
+
+    EXPECT_FALSE(queue.push(8));
+
+    int value = 0;
+    ASSERT_TRUE(queue.pop(value));
+    EXPECT_EQ(value, 7);
+    EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(BoundedQueueTest, Close_WakesBlockedConsumer) {
+    BoundedQueue<int> queue(4);
+    std::thread consumer([&] {
+        int value = 0;
+        EXPECT_FALSE(queue.pop(value));
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.close();
+    consumer.join();
+}
+
+// ============================================================================
+// LatencyHistogram
+// ============================================================================
+
+TEST(LatencyHistogramTest, Snapshot_IsCumulative) {
+    LatencyHistogram histogram;
+    histogram.observe(10);        // <= 50
+    histogram.observe(300);       // <= 500
+    histogram.observe(2000000);   // +Inf
+
+    auto s = histogram.snapshot();
+    EXPECT_EQ(s.count, 3u);
+    EXPECT_EQ(s.sumMicros, 2000310);
+    EXPECT_EQ(s.cumulative[0], 1u);                                  // le=50us
+    EXPECT_EQ(s.cumulative[2], 1u);                                  // le=250us
+    EXPECT_EQ(s.cumulative[3], 2u);                                  // le=500us
+    EXPECT_EQ(s.cumulative[LatencyHistogram::BOUND_COUNT - 1], 2u);  // le=1s
+}
+
+TEST(LatencyHistogramTest, Observe_BoundaryGoesToLowerBucket) {
+    LatencyHistogram histogram;
+    histogram.observe(50);
+
+    auto s = histogram.snapshot();
+    EXPECT_EQ(s.cumulative[0], 1u);
+}
@@ -0,0 +1,145 @@
+/**
+ * @file EventWireFormatTest.cpp
+ * @brief Unit-тесты бинарного формата событий quote.updated / order.*
+ */
+
+#include <gtest/gtest.h>
+
+#include "application/events/EventWireFormat.hpp"
+
+#include <string>
+
+using namespace broker::application;
+
+namespace {
+
+wire::OrderFrame sampleOrder() {
+    wire::OrderFrame frame;
+    frame.orderId = "ord-1";
+    frame.accountId = "acc-1";
+    frame.figi = "BBG004730N88";
+    frame.status = wire::OrderStatus::REJECTED;
+    frame.lots = 7;
+    frame.price = 265.5;
+    frame.currency = "RUB";
+    frame.reason = "Insufficient funds";
+    frame.timestampMs = 1700000000123;
+    return frame;
+}
+
+} // namespace
+
+TEST(EventWireFormatTest, Quote_Roundtrip) {
+    wire::QuoteFrame frame;
+    frame.figi = "BBG004730N88";
+    frame.bid = 265.1;
+    frame.ask = 265.3;
+    frame.last = 265.2;
+    frame.currency = "RUB";
+    frame.timestampMs = 1700000000123;
+
+    std::string encoded = wire::encode(frame);
+    auto decoded = wire::decodeQuote(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->figi, "BBG004730N88");
+    EXPECT_DOUBLE_EQ(decoded->bid, 265.1);
+    EXPECT_DOUBLE_EQ(decoded->ask, 265.3);
+    EXPECT_DOUBLE_EQ(decoded->last, 265.2);
+    EXPECT_EQ(decoded->currency, "RUB");
+    EXPECT_EQ(decoded->timestampMs, 1700000000123);
+}
+
+TEST(EventWireFormatTest, Order_Roundtrip) {
+    std::string encoded = wire::encode(sampleOrder());
+    auto decoded = wire::decodeOrder(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->orderId, "ord-1");
+    EXPECT_EQ(decoded->accountId, "acc-1");
+    EXPECT_EQ(decoded->figi, "BBG004730N88");
+    EXPECT_EQ(decoded->status, wire::OrderStatus::REJECTED);
+    EXPECT_EQ(decoded->lots, 7);
+    EXPECT_DOUBLE_EQ(decoded->price, 265.5);
+    EXPECT_EQ(decoded->currency, "RUB");
+    EXPECT_EQ(decoded->reason, "Insufficient funds");
+    EXPECT_EQ(decoded->timestampMs, 1700000000123);
+}
+
+TEST(EventWireFormatTest, QuoteBatch_Roundtrip) {
+    wire::QuoteBatchFrame batch;
+    batch.seq = 42;
+    batch.snapshot = true;
+    for (int i = 0; i < 3; ++i) {
+        wire::QuoteFrame q;
+        q.figi = i == 0 ? "SBER" : (i == 1 ? "GAZP" : "LKOH");
+        q.last = 100.0 + i;
+        q.currency = "RUB";
+        q.timestampMs = 1700000000000 + i;
+        batch.quotes.push_back(q);
+    }
+
+    std::string encoded = wire::encode(batch);
+    auto decoded = wire::decodeQuoteBatch(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->seq, 42u);
+    EXPECT_TRUE(decoded->snapshot);
+    ASSERT_EQ(decoded->quotes.size(), 3u);
+    EXPECT_EQ(decoded->quotes[1].figi, "GAZP");
+    EXPECT_DOUBLE_EQ(decoded->quotes[2].last, 102.0);
+    EXPECT_EQ(decoded->quotes[2].timestampMs, 1700000000002);
+}
+
+TEST(EventWireFormatTest, QuoteBatch_CountBeyondPayload_Rejected) {
+    wire::QuoteBatchFrame batch;
+    batch.quotes.resize(1);
+    std::string encoded = wire::encode(batch);
+    encoded[4 + 8 + 1] = static_cast<char>(0xFF);   // count lo
+    encoded[4 + 8 + 2] = static_cast<char>(0xFF);   // count hi
+
+    EXPECT_FALSE(wire::decodeQuoteBatch(encoded).has_value());
+}
+
+TEST(EventWireFormatTest, Decode_PointsIntoSourceBuffer) {
+    std::string encoded = wire::encode(sampleOrder());
+    auto decoded = wire::decodeOrder(encoded);
+
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_GE(decoded->orderId.data(), encoded.data());
+    EXPECT_LT(decoded->orderId.data(), encoded.data() + encoded.size());
+}
+
+TEST(EventWireFormatTest, Truncated_Rejected) {
+    std::string encoded = wire::encode(sampleOrder());
+    for (size_t n = 0; n < encoded.size(); ++n) {
+        EXPECT_FALSE(wire::decodeOrder(std::string_view(encoded.data(), n)).has_value()) << n;
+    }
+}
+
+TEST(EventWireFormatTest, BadHeader_Rejected) {
+    std::string encoded = wire::encode(sampleOrder());
+
+    std::string badMagic = encoded;
+    badMagic[0] = '{';
+    EXPECT_FALSE(wire::decodeOrder(badMagic).has_value());
+
+    std::string badVersion = encoded;
+    badVersion[1] = static_cast<char>(wire::VERSION + 1);
+    EXPECT_FALSE(wire::decodeOrder(badVersion).has_value());
+
+    // Кадр ордера не читается как котировка
+    EXPECT_FALSE(wire::decodeQuote(encoded).has_value());
+}
+
+TEST(EventWireFormatTest, UnknownStatus_Rejected) {
+    std::string encoded = wire::encode(sampleOrder());
+    encoded[4 + 24] = 42;   // header + timestamp + lots + price
+    EXPECT_FALSE(wire::decodeOrder(encoded).has_value());
+}
+
+TEST(EventWireFormatTest, IsBinary_OnlyForVendorContentType) {
+    EXPECT_TRUE(wire::isBinary(wire::CONTENT_TYPE_BINARY));
+    EXPECT_FALSE(wire::isBinary(wire::CONTENT_TYPE_JSON));
+    EXPECT_FALSE(wire::isBinary(""));
+}
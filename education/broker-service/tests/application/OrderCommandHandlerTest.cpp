@@ -0,0 +1,469 @@
+/**
+ * @file OrderCommandHandlerTest.cpp
+ * @brief Unit-тесты конвейера OrderCommandHandler
+ *
+ * decode → execute (воркеры по account_id) → publish пачками → ack
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "application/OrderCommandHandler.hpp"
+
+#include <nlohmann/json.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace broker;
+using namespace broker::application;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+// ============================================================================
+// Mock IBrokerGateway
+// ============================================================================
+
+class MockBrokerGateway : public ports::output::IBrokerGateway {
+public:
+    MOCK_METHOD(void, registerAccount, (const std::string&, const std::string&), (override));
+    MOCK_METHOD(void, unregisterAccount, (const std::string&), (override));
+    MOCK_METHOD(std::optional<domain::Quote>, getQuote, (const std::string&), (override));
+    MOCK_METHOD(std::vector<domain::Quote>, getQuotes, (const std::vector<std::string>&), (override));
+    MOCK_METHOD(std::optional<domain::Instrument>, getInstrumentByFigi, (const std::string&), (override));
+    MOCK_METHOD(std::vector<domain::Instrument>, getAllInstruments, (), (override));
+    MOCK_METHOD(std::vector<domain::Instrument>, searchInstruments, (const std::string&), (override));
+    MOCK_METHOD(domain::Portfolio, getPortfolio, (const std::string&), (override));
+    MOCK_METHOD(domain::OrderResult, placeOrder, (const std::string&, const domain::OrderRequest&), (override));
+    MOCK_METHOD(bool, cancelOrder, (const std::string&, const std::string&), (override));
+    MOCK_METHOD(std::vector<domain::Order>, getOrders, (const std::string&), (override));
+    MOCK_METHOD(std::optional<domain::Order>, getOrderStatus, (const std::string&, const std::string&), (override));
+    MOCK_METHOD(domain::OrderPage, getOrderHistory,
+                (const std::string&, const domain::OrderQuery&), (override));
+};
+
+// ============================================================================
+// Fake IEventConsumer / IEventPublisher
+// ============================================================================
+
+class FakeEventConsumer : public ports::output::IEventConsumer {
+public:
+    void subscribe(const std::vector<std::string>&, ports::output::EventHandler) override {
+        FAIL() << "OrderCommandHandler should use subscribeAsync";
+    }
+
+    void subscribeAsync(const std::vector<std::string>& routingKeys,
+                        ports::output::AsyncEventHandler handler) override {
+        keys_ = routingKeys;
+        handler_ = std::move(handler);
+    }
+
+    void start() override {}
+    void stop() override {}
+
+    /**
+     * @brief Доставить сообщение; ack увеличит acked
+     */
+    void deliver(const std::string& routingKey, const std::string& message,
+                 ports::output::AckCallback onAck = {}) {
+        handler_(routingKey, message, [this, onAck]() {
+            if (onAck) {
+                onAck();
+            }
+            acked.fetch_add(1);
+        });
+    }
+
+    const std::vector<std::string>& keys() const { return keys_; }
+
+    std::atomic<int> acked{0};
+
+private:
+    std::vector<std::string> keys_;
+    ports::output::AsyncEventHandler handler_;
+};
+
+class FakeEventPublisher : public ports::output::IEventPublisher {
+public:
+    void publish(const std::string& routingKey, const std::string& message) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.emplace_back(routingKey, nlohmann::json::parse(message));
+    }
+
+    std::vector<std::pair<std::string, nlohmann::json>> events() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_;
+    }
+
+    size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_.size();
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::pair<std::string, nlohmann::json>> events_;
+};
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class OrderCommandHandlerTest : public ::testing::Test {
+protected:
+    static constexpr int WORKERS = 4;
+
+    void SetUp() override {
+        setenv("BROKER_ORDER_WORKERS", std::to_string(WORKERS).c_str(), 1);
+        setenv("BROKER_ORDER_QUEUE_CAPACITY", "16", 1);
+        setenv("BROKER_ORDER_PUBLISH_BATCH", "8", 1);
+        setenv("RABBITMQ_PREFETCH", "16", 1);
+
+        consumer_ = std::make_shared<FakeEventConsumer>();
+        publisher_ = std::make_shared<FakeEventPublisher>();
+        gateway_ = std::make_shared<::testing::NiceMock<MockBrokerGateway>>();
+        handler_ = std::make_unique<OrderCommandHandler>(
+            consumer_, publisher_, gateway_, std::make_shared<settings::OrderPipelineSettings>());
+    }
+
+    void TearDown() override {
+        handler_.reset();
+        unsetenv("BROKER_ORDER_WORKERS");
+        unsetenv("BROKER_ORDER_QUEUE_CAPACITY");
+        unsetenv("BROKER_ORDER_PUBLISH_BATCH");
+        unsetenv("RABBITMQ_PREFETCH");
+    }
+
+    static std::string createCommand(const std::string& orderId, const std::string& accountId,
+                                     const std::string& figi = "BBG004730N88", int64_t quantity = 1) {
+        nlohmann::json json;
+        json["order_id"] = orderId;
+        json["account_id"] = accountId;
+        json["figi"] = figi;
+        json["quantity"] = quantity;
+        json["direction"] = "BUY";
+        json["type"] = "MARKET";
+        return json.dump();
+    }
+
+    static domain::OrderResult filled(const std::string& orderId, int64_t lots = 1) {
+        domain::OrderResult result;
+        result.orderId = orderId;
+        result.status = domain::OrderStatus::FILLED;
+        result.executedLots = lots;
+        result.executedPrice = domain::Money::fromDouble(100.0, "RUB");
+        return result;
+    }
+
+    bool waitAcked(int expected, std::chrono::milliseconds timeout = std::chrono::seconds(5)) {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (consumer_->acked.load() < expected) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    /**
+     * @brief Два аккаунта, попадающие на разные воркеры
+     */
+    static std::pair<std::string, std::string> accountsOnDifferentWorkers() {
+        std::string first = "acc-0";
+        size_t firstWorker = std::hash<std::string>{}(first) % WORKERS;
+        for (int i = 1; i < 100; ++i) {
+            std::string candidate = "acc-" + std::to_string(i);
+            if (std::hash<std::string>{}(candidate) % WORKERS != firstWorker) {
+                return {first, candidate};
+            }
+        }
+        return {first, first};
+    }
+
+    std::shared_ptr<FakeEventConsumer> consumer_;
+    std::shared_ptr<FakeEventPublisher> publisher_;
+    std::shared_ptr<::testing::NiceMock<MockBrokerGateway>> gateway_;
+    std::unique_ptr<OrderCommandHandler> handler_;
+};
+
+// ============================================================================
+// БАЗОВЫЙ ПОТОК
+// ============================================================================
+
+TEST_F(OrderCommandHandlerTest, SubscribesToOrderCommands) {
+    EXPECT_EQ(consumer_->keys(), (std::vector<std::string>{"order.create", "order.cancel"}));
+}
+
+TEST_F(OrderCommandHandlerTest, CreateOrder_PublishesCreatedThenFilled) {
+    EXPECT_CALL(*gateway_, placeOrder("acc-1", _))
+        .WillOnce(Invoke([](const std::string&, const domain::OrderRequest& request) {
+            EXPECT_EQ(request.orderId, "ord-1");
+            EXPECT_EQ(request.figi, "BBG004730N88");
+            EXPECT_EQ(request.quantity, 3);
+            return filled("ord-1", 3);
+        }));
+
+    consumer_->deliver("order.create", createCommand("ord-1", "acc-1", "BBG004730N88", 3));
+    ASSERT_TRUE(waitAcked(1));
+
+    auto events = publisher_->events();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].first, "order.created");
+    EXPECT_EQ(events[0].second["status"], "PENDING");
+    EXPECT_EQ(events[1].first, "order.filled");
+    EXPECT_EQ(events[1].second["order_id"], "ord-1");
+    EXPECT_EQ(events[1].second["executed_lots"], 3);
+}
+
+TEST_F(OrderCommandHandlerTest, Ack_OnlyAfterResultsPublished) {
+    EXPECT_CALL(*gateway_, placeOrder(_, _)).WillOnce(Return(filled("ord-1")));
+
+    std::atomic<size_t> publishedAtAck{0};
+    consumer_->deliver("order.create", createCommand("ord-1", "acc-1"),
+                       [&]() { publishedAtAck = publisher_->count(); });
+    ASSERT_TRUE(waitAcked(1));
+
+    EXPECT_EQ(publishedAtAck.load(), 2u);
+}
+
+TEST_F(OrderCommandHandlerTest, CancelOrder_PublishesCancelled) {
+    EXPECT_CALL(*gateway_, cancelOrder("acc-1", "ord-1")).WillOnce(Return(true));
+
+    consumer_->deliver("order.cancel", R"({"order_id":"ord-1","account_id":"acc-1"})");
+    ASSERT_TRUE(waitAcked(1));
+
+    auto events = publisher_->events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].first, "order.cancelled");
+}
+
+// ============================================================================
+// ОШИБКИ DECODE
+// ============================================================================
+
+TEST_F(OrderCommandHandlerTest, InvalidJson_AckedWithoutExecution) {
+    EXPECT_CALL(*gateway_, placeOrder(_, _)).Times(0);
+
+    consumer_->deliver("order.create", "{not json");
+
+    EXPECT_EQ(consumer_->acked.load(), 1);
+    EXPECT_EQ(handler_->stats().decodeErrors, 1u);
+    EXPECT_EQ(publisher_->count(), 0u);
+}
+
+TEST_F(OrderCommandHandlerTest, MissingField_PublishesRejected) {
+    EXPECT_CALL(*gateway_, placeOrder(_, _)).Times(0);
+
+    consumer_->deliver("order.create", R"({"order_id":"ord-1","account_id":"acc-1","quantity":1})");
+    ASSERT_TRUE(waitAcked(1));
+
+    auto events = publisher_->events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].first, "order.rejected");
+    EXPECT_EQ(events[0].second["reason"], "Missing required field: figi");
+}
+
+// ============================================================================
+// ПОРЯДОК И ПАРАЛЛЕЛИЗМ
+// ============================================================================
+
+TEST_F(OrderCommandHandlerTest, SameAccount_ExecutedInOrder) {
+    std::mutex mutex;
+    std::vector<std::string> executed;
+    ON_CALL(*gateway_, placeOrder(_, _))
+        .WillByDefault(Invoke([&](const std::string&, const domain::OrderRequest& request) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            std::lock_guard<std::mutex> lock(mutex);
+            executed.push_back(request.orderId);
+            return filled(request.orderId);
+        }));
+
+    constexpr int N = 20;
+    for (int i = 0; i < N; ++i) {
+        consumer_->deliver("order.create", createCommand("ord-" + std::to_string(i), "acc-1"));
+    }
+    ASSERT_TRUE(waitAcked(N));
+
+    ASSERT_EQ(executed.size(), static_cast<size_t>(N));
+    for (int i = 0; i < N; ++i) {
+        EXPECT_EQ(executed[i], "ord-" + std::to_string(i));
+    }
+
+    // События тоже в порядке команд
+    std::vector<std::string> filledOrder;
+    for (const auto& [key, json] : publisher_->events()) {
+        if (key == "order.filled") {
+            filledOrder.push_back(json["order_id"]);
+        }
+    }
+    EXPECT_EQ(filledOrder, executed);
+}
+
+TEST_F(OrderCommandHandlerTest, SlowAccount_DoesNotBlockOtherAccounts) {
+    auto [slowAccount, fastAccount] = accountsOnDifferentWorkers();
+    ASSERT_NE(slowAccount, fastAccount);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+
+    ON_CALL(*gateway_, placeOrder(_, _))
+        .WillByDefault(Invoke([&, slow = slowAccount](const std::string& accountId,
+                                                      const domain::OrderRequest& request) {
+            if (accountId == slow) {
+                std::unique_lock<std::mutex> lock(mutex);
+                cv.wait(lock, [&] { return release; });
+            }
+            return filled(request.orderId);
+        }));
+
+    consumer_->deliver("order.create", createCommand("ord-slow", slowAccount));
+    consumer_->deliver("order.create", createCommand("ord-fast", fastAccount));
+
+    // Быстрый аккаунт проходит, пока медленный висит в placeOrder
+    EXPECT_TRUE(waitAcked(1));
+    EXPECT_EQ(handler_->stats().inFlight, 1u);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    EXPECT_TRUE(waitAcked(2));
+}
+
+// ============================================================================
+// МЕТРИКИ И ОСТАНОВКА
+// ============================================================================
+
+TEST_F(OrderCommandHandlerTest, Stats_CountStagesAndDrainQueues) {
+    ON_CALL(*gateway_, placeOrder(_, _))
+        .WillByDefault(Invoke([](const std::string&, const domain::OrderRequest& request) {
+            return filled(request.orderId);
+        }));
+
+    constexpr int N = 10;
+    for (int i = 0; i < N; ++i) {
+        consumer_->deliver("order.create", createCommand("ord-" + std::to_string(i), "acc-" + std::to_string(i)));
+    }
+    ASSERT_TRUE(waitAcked(N));
+
+    auto s = handler_->stats();
+    EXPECT_EQ(s.workers, static_cast<size_t>(WORKERS));
+    EXPECT_EQ(s.queueCapacity, 16u);
+    EXPECT_EQ(s.received, static_cast<uint64_t>(N));
+    EXPECT_EQ(s.completed, static_cast<uint64_t>(N));
+    EXPECT_EQ(s.inFlight, 0u);
+    EXPECT_EQ(s.executeQueueDepth, 0u);
+    EXPECT_EQ(s.publishQueueDepth, 0u);
+    EXPECT_GE(s.publishBatches, 1u);
+    for (size_t i = 0; i < OrderCommandHandler::STAGE_COUNT; ++i) {
+        auto stage = static_cast<OrderCommandHandler::Stage>(i);
+        // publish - одно наблюдение на пачку, остальные этапы - на команду
+        uint64_t expected = stage == OrderCommandHandler::Stage::PUBLISH
+            ? s.publishBatches
+            : static_cast<uint64_t>(N);
+        EXPECT_EQ(s.latency[i].count, expected) << OrderCommandHandler::toString(stage);
+    }
+}
+
+TEST_F(OrderCommandHandlerTest, Stop_DrainsAcceptedCommands) {
+    ON_CALL(*gateway_, placeOrder(_, _))
+        .WillByDefault(Invoke([](const std::string&, const domain::OrderRequest& request) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            return filled(request.orderId);
+        }));
+
+    constexpr int N = 8;
+    for (int i = 0; i < N; ++i) {
+        consumer_->deliver("order.create", createCommand("ord-" + std::to_string(i), "acc-1"));
+    }
+    handler_->stop();
+
+    EXPECT_EQ(consumer_->acked.load(), N);
+    EXPECT_EQ(publisher_->count(), static_cast<size_t>(2 * N));
+}
+
+TEST_F(OrderCommandHandlerTest, AfterStop_CommandLeftUnacknowledged) {
+    handler_->stop();
+
+    consumer_->deliver("order.create", createCommand("ord-1", "acc-1"));
+
+    EXPECT_EQ(consumer_->acked.load(), 0);
+    EXPECT_EQ(publisher_->count(), 0u);
+}
+
+// ============================================================================
+// БИНАРНЫЙ ФОРМАТ
+// ============================================================================
+
+class BinaryEventPublisher : public ports::output::IEventPublisher {
+public:
+    void publish(const std::string& routingKey, const std::string& message) override {
+        publish(routingKey, message, wire::CONTENT_TYPE_JSON);
+    }
+
+    void publish(const std::string& routingKey, const std::string& message,
+                 const std::string& contentType) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events.push_back({routingKey, message, contentType});
+    }
+
+    bool binaryWireFormat() const override { return true; }
+
+    struct Published {
+        std::string routingKey;
+        std::string payload;
+        std::string contentType;
+    };
+
+    std::mutex mutex_;
+    std::vector<Published> events;
+};
+
+TEST_F(OrderCommandHandlerTest, BinaryWireFormat_PublishesOrderFrames) {
+    auto publisher = std::make_shared<BinaryEventPublisher>();
+    auto consumer = std::make_shared<FakeEventConsumer>();
+    OrderCommandHandler handler(consumer, publisher, gateway_,
+                                std::make_shared<settings::OrderPipelineSettings>());
+
+    EXPECT_CALL(*gateway_, placeOrder("acc-1", _)).WillOnce(Return(filled("ord-1", 3)));
+    consumer->deliver("order.create", createCommand("ord-1", "acc-1", "BBG004730N88", 3));
+    handler.stop();
+
+    ASSERT_EQ(publisher->events.size(), 2u);
+    for (const auto& event : publisher->events) {
+        EXPECT_EQ(event.contentType, wire::CONTENT_TYPE_BINARY);
+    }
+
+    auto created = wire::decodeOrder(publisher->events[0].payload);
+    ASSERT_TRUE(created.has_value());
+    EXPECT_EQ(publisher->events[0].routingKey, "order.created");
+    EXPECT_EQ(created->status, wire::OrderStatus::PENDING);
+
+    auto fill = wire::decodeOrder(publisher->events[1].payload);
+    ASSERT_TRUE(fill.has_value());
+    EXPECT_EQ(publisher->events[1].routingKey, "order.filled");
+    EXPECT_EQ(fill->status, wire::OrderStatus::FILLED);
+    EXPECT_EQ(fill->orderId, "ord-1");
+    EXPECT_EQ(fill->accountId, "acc-1");
+    EXPECT_EQ(fill->figi, "BBG004730N88");
+    EXPECT_EQ(fill->lots, 3);
+    EXPECT_DOUBLE_EQ(fill->price, 100.0);
+    EXPECT_EQ(fill->currency, "RUB");
+}
+
+TEST_F(OrderCommandHandlerTest, Settings_QueueSmallerThanPrefetch_Throws) {
+    // Иначе поток io_context блокировался бы на полной очереди
+    setenv("RABBITMQ_PREFETCH", "17", 1);
+    EXPECT_THROW(settings::OrderPipelineSettings(), std::invalid_argument);
+
+    setenv("RABBITMQ_PREFETCH", "16", 1);
+    EXPECT_NO_THROW(settings::OrderPipelineSettings());
+}
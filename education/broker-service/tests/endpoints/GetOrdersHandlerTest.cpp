@@ -2,7 +2,7 @@
  * @file GetOrdersHandlerTest.cpp
  * @brief Unit-тесты для GetOrdersHandler
  * 
- * GET /api/v1/orders?account_id=xxx — список ордеров
+ * GET /api/v1/orders?account_id=xxx — история ордеров страницами
  */
 
 #include <gtest/gtest.h>
@@ -19,6 +19,8 @@ using namespace broker;
 using namespace broker::adapters::primary;
 using ::testing::Return;
 using ::testing::Throw;
+using ::testing::SaveArg;
+using ::testing::DoAll;
 using ::testing::_;
 
 // ============================================================================
@@ -39,10 +41,8 @@ public:
     MOCK_METHOD(bool, cancelOrder, (const std::string&, const std::string&), (override));
     MOCK_METHOD(std::vector<domain::Order>, getOrders, (const std::string&), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderStatus, (const std::string&, const std::string&), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getOrderHistory,
-                (const std::string&,
-                 const std::optional<std::chrono::system_clock::time_point>&,
-                 const std::optional<std::chrono::system_clock::time_point>&), (override));
+    MOCK_METHOD(domain::OrderPage, getOrderHistory,
+                (const std::string&, const domain::OrderQuery&), (override));
 };
 
 // ============================================================================
@@ -112,15 +112,18 @@ private:
 // ТЕСТЫ: GET /api/v1/orders
 // ============================================================================
 
-TEST_F(GetOrdersHandlerTest, ReturnsOrdersArray) {
-    std::vector<domain::Order> orders = {
-        createOrder("ord-111", "acc-001-sandbox"),
-        createOrder("ord-222", "acc-001-sandbox", domain::OrderStatus::PENDING)
+TEST_F(GetOrdersHandlerTest, ReturnsFirstPage) {
+    domain::OrderPage page;
+    page.orders = {
+        createOrder("ord-222", "acc-001-sandbox", domain::OrderStatus::PENDING),
+        createOrder("ord-111", "acc-001-sandbox")
     };
-    
-    EXPECT_CALL(*mockBroker_, getOrders("acc-001-sandbox"))
+    page.nextCursor = "1760000000000000_ord-111";
+
+    domain::OrderQuery query;
+    EXPECT_CALL(*mockBroker_, getOrderHistory("acc-001-sandbox", _))
         .Times(1)
-        .WillOnce(Return(orders));
+        .WillOnce(DoAll(SaveArg<1>(&query), Return(page)));
 
     auto req = createRequest("GET", "/api/v1/orders?account_id=acc-001-sandbox");
     SimpleResponse res;
@@ -128,18 +131,23 @@ TEST_F(GetOrdersHandlerTest, ReturnsOrdersArray) {
     handler_->handle(req, res);
     
     EXPECT_EQ(res.getStatus(), 200);
+    EXPECT_EQ(query.limit, GetOrdersHandler::DEFAULT_LIMIT);
+    EXPECT_FALSE(query.after.has_value());
+    EXPECT_FALSE(query.from.has_value());
+    EXPECT_FALSE(query.status.has_value());
     
     auto json = parseJson(res.getBody());
-    EXPECT_TRUE(json.is_array());
-    EXPECT_EQ(json.size(), 2);
-    EXPECT_EQ(json[0]["order_id"], "ord-111");
-    EXPECT_EQ(json[1]["order_id"], "ord-222");
+    ASSERT_TRUE(json["orders"].is_array());
+    EXPECT_EQ(json["orders"].size(), 2);
+    EXPECT_EQ(json["orders"][0]["order_id"], "ord-222");
+    EXPECT_EQ(json["orders"][1]["order_id"], "ord-111");
+    EXPECT_EQ(json["next_cursor"], "1760000000000000_ord-111");
 }
 
 TEST_F(GetOrdersHandlerTest, EmptyList_Returns200) {
-    EXPECT_CALL(*mockBroker_, getOrders("acc-001-sandbox"))
+    EXPECT_CALL(*mockBroker_, getOrderHistory("acc-001-sandbox", _))
         .Times(1)
-        .WillOnce(Return(std::vector<domain::Order>{}));
+        .WillOnce(Return(domain::OrderPage{}));
 
     auto req = createRequest("GET", "/api/v1/orders?account_id=acc-001-sandbox");
     SimpleResponse res;
@@ -149,12 +157,56 @@ TEST_F(GetOrdersHandlerTest, EmptyList_Returns200) {
     EXPECT_EQ(res.getStatus(), 200);
     
     auto json = parseJson(res.getBody());
-    EXPECT_TRUE(json.is_array());
-    EXPECT_EQ(json.size(), 0);
+    EXPECT_TRUE(json["orders"].is_array());
+    EXPECT_EQ(json["orders"].size(), 0);
+    EXPECT_TRUE(json["next_cursor"].is_null());
+}
+
+TEST_F(GetOrdersHandlerTest, PassesCursorAndFilters) {
+    domain::OrderQuery query;
+    EXPECT_CALL(*mockBroker_, getOrderHistory("acc-001-sandbox", _))
+        .Times(1)
+        .WillOnce(DoAll(SaveArg<1>(&query), Return(domain::OrderPage{})));
+
+    auto req = createRequest("GET",
+        "/api/v1/orders?account_id=acc-001-sandbox&limit=5000&cursor=1760000000123456_ord-111"
+        "&from=1760000000000&to=2026-01-31T10:00:00Z&status=FILLED");
+    SimpleResponse res;
+
+    handler_->handle(req, res);
+
+    EXPECT_EQ(res.getStatus(), 200);
+    EXPECT_EQ(query.limit, GetOrdersHandler::MAX_LIMIT);
+    ASSERT_TRUE(query.after.has_value());
+    EXPECT_EQ(query.after->receivedAtUs, 1760000000123456);
+    EXPECT_EQ(query.after->orderId, "ord-111");
+    ASSERT_TRUE(query.from.has_value());
+    EXPECT_EQ(std::chrono::duration_cast<std::chrono::milliseconds>(
+                  query.from->time_since_epoch()).count(), 1760000000000);
+    ASSERT_TRUE(query.to.has_value());
+    EXPECT_EQ(std::chrono::system_clock::to_time_t(*query.to), 1769853600);
+    ASSERT_TRUE(query.status.has_value());
+    EXPECT_EQ(*query.status, domain::OrderStatus::FILLED);
+}
+
+TEST_F(GetOrdersHandlerTest, InvalidParameters_Return400) {
+    EXPECT_CALL(*mockBroker_, getOrderHistory(_, _)).Times(0);
+
+    for (const char* param : {"limit=0", "limit=abc", "cursor=ord-111", "cursor=12_",
+                              "from=yesterday", "status=DONE",
+                              "from=2024-01-01T10:00:00+03:00", "to=2024-01-01T10:00:00garbage",
+                              "to=2024-01-01T10:00:00Zjunk"}) {
+        auto req = createRequest("GET", std::string("/api/v1/orders?account_id=acc-001-sandbox&") + param);
+        SimpleResponse res;
+
+        handler_->handle(req, res);
+
+        EXPECT_EQ(res.getStatus(), 400) << param;
+    }
 }
 
 TEST_F(GetOrdersHandlerTest, AccountNotFound_Returns404) {
-    EXPECT_CALL(*mockBroker_, getOrders("unknown-account"))
+    EXPECT_CALL(*mockBroker_, getOrderHistory("unknown-account", _))
         .Times(1)
         .WillOnce(Throw(std::runtime_error("Account not found")));
 
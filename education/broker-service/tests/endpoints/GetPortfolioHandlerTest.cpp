@@ -39,10 +39,8 @@ public:
     MOCK_METHOD(bool, cancelOrder, (const std::string&, const std::string&), (override));
     MOCK_METHOD(std::vector<domain::Order>, getOrders, (const std::string&), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderStatus, (const std::string&, const std::string&), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getOrderHistory,
-                (const std::string&,
-                 const std::optional<std::chrono::system_clock::time_point>&,
-                 const std::optional<std::chrono::system_clock::time_point>&), (override));
+    MOCK_METHOD(domain::OrderPage, getOrderHistory,
+                (const std::string&, const domain::OrderQuery&), (override));
 };
 
 // ============================================================================
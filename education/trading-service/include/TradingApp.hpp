@@ -2,7 +2,6 @@
 #pragma once
 
 #include <BoostBeastApplication.hpp>
-#include <HttpClient.hpp>
 #include <boost/di.hpp>
 
 // Settings
@@ -13,6 +12,8 @@
 #include "settings/DbSettings.hpp"
 #include "settings/IMetricsSettings.hpp"
 #include "settings/MetricsSettings.hpp"
+#include "settings/HttpPoolSettings.hpp"
+#include "settings/IdempotencySettings.hpp"
 
 // Ports
 #include "ports/input/IMarketService.hpp"
@@ -26,17 +27,25 @@
 
 // Application
 #include "application/MarketService.hpp"
+#include "application/QuoteReplica.hpp"
+#include "application/PortfolioProjection.hpp"
+#include "application/OrderProjection.hpp"
 #include "application/OrderService.hpp"
 #include "application/PortfolioService.hpp"
 #include "application/TradingEventHandler.hpp"
 #include "application/MetricsService.hpp"
 
 // Secondary Adapters
+#include "adapters/secondary/KeepAliveHttpClient.hpp"
 #include "adapters/secondary/HttpBrokerGateway.hpp"
 #include "adapters/secondary/CachedBrokerGateway.hpp"
 #include "adapters/secondary/HttpAuthClient.hpp"
+#include "adapters/secondary/CachedAuthClient.hpp"
+#include "adapters/secondary/BatchingAuthClient.hpp"
 #include "adapters/secondary/events/RabbitMQAdapter.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
 #include "adapters/secondary/PostgresIdempotencyRepository.hpp"
+#include "adapters/secondary/TieredIdempotencyRepository.hpp"
 
 // Primary Adapters
 #include "HealthHandler.hpp"
@@ -76,7 +85,12 @@ namespace trading
          * @brief Trading Service Application (Event-Driven)
          *
          * Публикует: order.create, order.cancel (в trading.events)
-         * Слушает: order.*, quote.updated, portfolio.updated (из broker.events)
+         * Слушает: order.*, quote.updated, quote.batch, quote.snapshot, portfolio.updated (из broker.events),
+         *          auth.session.revoked (из auth-service)
+         * Котировки из событий держит QuoteReplica - GET /api/v1/quotes читает из неё,
+         * в broker-service по HTTP ходит только при промахе. Так же портфели:
+         * PortfolioProjection из portfolio.updated, HTTP - при холодном старте и пропуске версии;
+         * ордера - OrderProjection из order.*, HTTP - для ордеров, которых в памяти нет
          * HTTP: GET для чтения, POST/DELETE публикуют события в RabbitMQ
          */
         class TradingApp : public BoostBeastApplication
@@ -101,32 +115,62 @@ namespace trading
                             di::bind<settings::RabbitMQSettings>().in(di::singleton));
                         auto rabbitMQAdapter = rabbitInjector.create<std::shared_ptr<adapters::secondary::RabbitMQAdapter>>();
 
+                        // Шаг 1.1: Пулы keep-alive соединений - свой на каждый upstream
+                        auto httpPoolSettings = std::make_shared<settings::HttpPoolSettings>();
+                        auto authClientSettings = std::make_shared<settings::AuthClientSettings>();
+                        auto brokerClientSettings = std::make_shared<settings::BrokerClientSettings>();
+                        auto authHttpClient = std::make_shared<adapters::secondary::KeepAliveHttpClient>(
+                            "auth-service", authClientSettings->getHost(), authClientSettings->getPort(), httpPoolSettings);
+                        auto brokerHttpClient = std::make_shared<adapters::secondary::KeepAliveHttpClient>(
+                            "broker-service", brokerClientSettings->getHost(), brokerClientSettings->getPort(), httpPoolSettings);
+
+                        // Шаг 1.2: Проверенные access-токены кэшируются, auth.session.revoked их сбрасывает;
+                        // одновременные промахи уходят в auth-service одним /validate/batch
+                        auto cacheSettings = std::make_shared<settings::CacheSettings>();
+                        auto authClient = std::make_shared<adapters::secondary::CachedAuthClient>(
+                            std::make_shared<adapters::secondary::BatchingAuthClient>(
+                                std::make_shared<adapters::secondary::HttpAuthClient>(authHttpClient, authClientSettings),
+                                authClientSettings),
+                            rabbitMQAdapter, cacheSettings);
+
+                        // Шаг 1.3: Идемпотентность - LRU в памяти перед пулом соединений к PostgreSQL
+                        auto dbSettings = std::make_shared<settings::DbSettings>();
+                        auto idempotencySettings = std::make_shared<settings::IdempotencySettings>();
+                        auto idempotencyRepository = std::make_shared<adapters::secondary::TieredIdempotencyRepository>(
+                            std::make_shared<adapters::secondary::PostgresIdempotencyRepository>(
+                                std::make_shared<adapters::secondary::PgConnectionPool>(dbSettings), idempotencySettings),
+                            idempotencySettings);
+
+                        // Шаг 1.4: Кэш broker-service - нужен и IBrokerGateway, и /metrics
+                        auto brokerGateway = std::make_shared<adapters::secondary::CachedBrokerGateway>(
+                            std::make_shared<adapters::secondary::HttpBrokerGateway>(brokerHttpClient, brokerClientSettings),
+                            cacheSettings);
+
                         // Шаг 2: Основной injector
                         auto injector = di::make_injector(
                             // Settings
-                            di::bind<settings::DbSettings>().in(di::singleton),
-                            di::bind<settings::AuthClientSettings>().in(di::singleton),
-                            di::bind<settings::IBrokerClientSettings>().to<settings::BrokerClientSettings>().in(di::singleton),
+                            di::bind<settings::DbSettings>().to(dbSettings),
+                            di::bind<settings::AuthClientSettings>().to(authClientSettings),
+                            di::bind<settings::IBrokerClientSettings>().to(brokerClientSettings),
                             di::bind<settings::RabbitMQSettings>().in(di::singleton),
-                            di::bind<settings::CacheSettings>().in(di::singleton),
+                            di::bind<settings::CacheSettings>().to(cacheSettings),
                             di::bind<settings::IMetricsSettings>().to<settings::MetricsSettings>().in(di::singleton),
 
                             // Repositories
-                            di::bind<ports::output::IIdempotencyRepository>()
-                                .to<adapters::secondary::PostgresIdempotencyRepository>()
-                                .in(di::singleton),
+                            di::bind<ports::output::IIdempotencyRepository>().to(idempotencyRepository),
 
                             // Clients
-                            di::bind<IHttpClient>().to<HttpClient>().in(di::singleton),
-                            di::bind<adapters::secondary::HttpBrokerGateway>().in(di::singleton),
-                            di::bind<ports::output::IAuthClient>().to<adapters::secondary::HttpAuthClient>().in(di::singleton),
-                            di::bind<ports::output::IBrokerGateway>().to<adapters::secondary::CachedBrokerGateway>().in(di::singleton),
+                            di::bind<ports::output::IAuthClient>().to(authClient),
+                            di::bind<ports::output::IBrokerGateway>().to(brokerGateway),
 
                             // RabbitMQ
                             di::bind<ports::output::IEventPublisher>().to(rabbitMQAdapter),
                             di::bind<ports::input::IEventConsumer>().to(rabbitMQAdapter),
 
                             // Services
+                            di::bind<application::QuoteReplica>().in(di::singleton),
+                            di::bind<application::PortfolioProjection>().in(di::singleton),
+                            di::bind<application::OrderProjection>().in(di::singleton),
                             di::bind<ports::input::IMetricsService>().to<application::MetricsService>().in(di::singleton),
                             di::bind<ports::input::IMarketService>().to<application::MarketService>().in(di::singleton),
                             di::bind<ports::input::IOrderService>().to<application::OrderService>().in(di::singleton),
@@ -150,7 +194,10 @@ namespace trading
 
                         // Metrics (без middleware — сам себя не считает)
                         registerEndpoint("GET", "/metrics",
-                                         injector.create<std::shared_ptr<adapters::primary::MetricsHandler>>());
+                                         std::make_shared<adapters::primary::MetricsHandler>(
+                                             metricsService,
+                                             std::vector<std::shared_ptr<adapters::secondary::KeepAliveHttpClient>>{authHttpClient, brokerHttpClient},
+                                             brokerGateway));
 
                         // Market (с метриками)
                         auto getQuotesHandler = injector.create<std::shared_ptr<adapters::primary::GetQuotesHandler>>();
@@ -30,7 +30,7 @@ namespace trading::adapters::primary
             auto accountId = req.getAttribute("accountId").value_or("");
             if (accountId.empty())
             {
-                sendError(res, 500, "Internal server error");
+                sendFailure(req, res, 500, "Internal server error");
                 std::cout << "[CancelOrderHandler] Error: accountId must not be null on this step." << std::endl;
                 return;
             }
@@ -41,7 +41,7 @@ namespace trading::adapters::primary
 
                 if (orderId.empty())
                 {
-                    sendError(res, 400, "Order ID is required");
+                    sendFailure(req, res, 400, "Order ID is required");
                     return;
                 }
 
@@ -57,13 +57,13 @@ namespace trading::adapters::primary
                 }
                 else
                 {
-                    sendError(res, 400, "Cannot cancel order");
+                    sendFailure(req, res, 400, "Cannot cancel order");
                 }
             }
             catch (const std::exception &e)
             {
                 std::cerr << "[CancelOrderHandler] Error: " << e.what() << std::endl;
-                sendError(res, 500, "Internal server error");
+                sendFailure(req, res, 500, "Internal server error");
             }
         }
 
@@ -76,6 +76,15 @@ namespace trading::adapters::primary
             error["error"] = message;
             res.setResult(status, "application/json", error.dump());
         }
+
+        /// Как в CreateOrderHandler: статус выставит IdempotencyCacheWriter и отпустит ключ
+        void sendFailure(IRequest &req, IResponse &res, int status, const std::string &message)
+        {
+            nlohmann::json error;
+            error["error"] = message;
+            res.setResult(0, "application/json", error.dump());
+            req.setAttribute("httpStatus", std::to_string(status));
+        }
     };
 
 } // namespace trading::adapters::primary
@@ -34,7 +34,7 @@ namespace trading::adapters::primary
             auto accountId = req.getAttribute("accountId").value_or("");
             if (accountId.empty())
             {
-                sendError(res, 500, "Internal server error");
+                sendFailure(req, res, 500, "Internal server error");
                 std::cout << "[CreateOrderHandler] Error: accountId must not be null on this step." << std::endl;
                 return;
             }
@@ -67,12 +67,12 @@ namespace trading::adapters::primary
 
                 if (orderReq.figi.empty())
                 {
-                    sendError(res, 400, "FIGI is required");
+                    sendFailure(req, res, 400, "FIGI is required");
                     return;
                 }
                 if (orderReq.quantity <= 0)
                 {
-                    sendError(res, 400, "Quantity must be positive");
+                    sendFailure(req, res, 400, "Quantity must be positive");
                     return;
                 }
 
@@ -88,19 +88,19 @@ namespace trading::adapters::primary
                 }
                 response["timestamp"] = result.timestamp.toString();
 
-                // если rejected, то возвращаем статус 400 и прерываем обработку цепочки middleware
-                int httpStatus = (result.status == domain::OrderStatus::REJECTED) ? 400 : 0;
-                res.setResult(httpStatus, "application/json", response.dump()); // статус 0, чтоб не прервать цепочку middleware
-                req.setAttribute("httpStatus", std::to_string(201)); //TODO: специфичное решение, подумать как лучше сделать
+                // rejected - 400: ответ не сохраняется, IdempotencyCacheWriter отпустит ключ
+                int httpStatus = (result.status == domain::OrderStatus::REJECTED) ? 400 : 201;
+                res.setResult(0, "application/json", response.dump()); // статус 0, чтоб не прервать цепочку middleware
+                req.setAttribute("httpStatus", std::to_string(httpStatus)); //TODO: специфичное решение, подумать как лучше сделать
             }
             catch (const nlohmann::json::exception &e)
             {
-                sendError(res, 400, "Invalid JSON");
+                sendFailure(req, res, 400, "Invalid JSON");
             }
             catch (const std::exception &e)
             {
                 std::cerr << "[CreateOrderHandler] Error: " << e.what() << std::endl;
-                sendError(res, 500, "Internal server error");
+                sendFailure(req, res, 500, "Internal server error");
             }
         }
 
@@ -113,6 +113,21 @@ namespace trading::adapters::primary
             error["error"] = message;
             res.setResult(status, "application/json", error.dump());
         }
+
+        /**
+         * @brief Ошибка после IdempotencyCacheReader: статус 0 и httpStatus
+         *
+         * Ненулевой статус остановил бы цепочку до IdempotencyCacheWriter,
+         * и повтор с тем же X-Idempotency-Key ждал бы занятый ключ
+         * IDEMPOTENCY_INFLIGHT_TIMEOUT_MS. Writer выставит статус и отпустит ключ.
+         */
+        void sendFailure(IRequest &req, IResponse &res, int status, const std::string &message)
+        {
+            nlohmann::json error;
+            error["error"] = message;
+            res.setResult(0, "application/json", error.dump());
+            req.setAttribute("httpStatus", std::to_string(status));
+        }
     };
 
 } // namespace trading::adapters::primary
@@ -2,13 +2,31 @@
 
 #include <IHttpHandler.hpp>
 #include "ports/input/IOrderService.hpp"
+#include "domain/Timestamp.hpp"
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
 #include <memory>
 #include <iostream>
+#include <optional>
+#include <stdexcept>
 
 namespace trading::adapters::primary
 {
 
+    /**
+     * @brief GET /api/v1/orders — страница истории ордеров, новые первыми
+     *
+     * Параметры (как у broker-service):
+     * - limit - размер страницы (по умолчанию 100, не больше 1000);
+     * - cursor - next_cursor предыдущей страницы;
+     * - from, to - период по времени получения ордера, [from, to):
+     *   Unix-время в миллисекундах или "2026-01-31T10:00:00Z" (только UTC:
+     *   смещение вроде "+03:00" и любой хвост - 400);
+     * - status - PENDING / PARTIALLY_FILLED / FILLED / CANCELLED / REJECTED.
+     *
+     * Ответ: {"orders": [...], "next_cursor": "..." | null}.
+     */
     class GetOrdersHandler : public IHttpHandler
     {
     public:
@@ -35,19 +53,32 @@ namespace trading::adapters::primary
                 return;
             }
 
+            domain::OrderPageQuery query;
+            std::string invalid = parseQuery(req, query);
+            if (!invalid.empty())
+            {
+                sendError(res, 400, "Invalid parameter '" + invalid + "'");
+                return;
+            }
+
             try
             {
-                auto orders = orderService_->getAllOrders(accountId);
+                auto page = orderService_->getOrders(accountId, query);
 
                 nlohmann::json response;
                 response["orders"] = nlohmann::json::array();
-                for (const auto &order : orders)
+                for (const auto &order : page.orders)
                 {
                     response["orders"].push_back(orderToJson(order));
                 }
+                response["next_cursor"] = page.nextCursor ? nlohmann::json(*page.nextCursor) : nlohmann::json();
 
                 res.setResult(200, "application/json", response.dump());
             }
+            catch (const std::invalid_argument &e)
+            {
+                sendError(res, 400, "Invalid order query");
+            }
             catch (const std::exception &e)
             {
                 std::cerr << "[GetOrdersHandler] Error: " << e.what() << std::endl;
@@ -58,6 +89,63 @@ namespace trading::adapters::primary
     private:
         std::shared_ptr<ports::input::IOrderService> orderService_;
 
+        /**
+         * @return имя неверного параметра или пустая строка
+         */
+        static std::string parseQuery(IRequest &req, domain::OrderPageQuery &query)
+        {
+            if (auto limit = req.getQueryParam("limit"))
+            {
+                auto value = parseUnsigned(*limit);
+                if (!value || *value == 0)
+                    return "limit";
+                query.limit = std::min<size_t>(static_cast<size_t>(*value), domain::OrderPageQuery::MAX_LIMIT);
+            }
+            if (auto cursor = req.getQueryParam("cursor"))
+            {
+                if (cursor->empty())
+                    return "cursor";
+                query.cursor = *cursor;
+            }
+            if (auto from = req.getQueryParam("from"))
+            {
+                query.fromMs = parseTimeMs(*from);
+                if (!query.fromMs)
+                    return "from";
+            }
+            if (auto to = req.getQueryParam("to"))
+            {
+                query.toMs = parseTimeMs(*to);
+                if (!query.toMs)
+                    return "to";
+            }
+            if (auto status = req.getQueryParam("status"))
+            {
+                // parseOrderStatus считает неизвестное PENDING - сверяем обратно
+                auto parsed = domain::parseOrderStatus(*status);
+                if (domain::toString(parsed) != *status)
+                    return "status";
+                query.status = parsed;
+            }
+            return "";
+        }
+
+        static std::optional<uint64_t> parseUnsigned(const std::string &s)
+        {
+            if (s.empty() || s.size() > 18 ||
+                !std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; }))
+                return std::nullopt;
+            return std::stoull(s);
+        }
+
+        static std::optional<int64_t> parseTimeMs(const std::string &s)
+        {
+            auto ts = domain::Timestamp::parseUtc(s);
+            if (!ts)
+                return std::nullopt;
+            return std::chrono::duration_cast<std::chrono::milliseconds>(ts->value.time_since_epoch()).count();
+        }
+
         nlohmann::json orderToJson(const domain::Order &order)
         {
             nlohmann::json j;
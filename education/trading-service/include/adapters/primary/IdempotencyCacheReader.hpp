@@ -21,7 +21,8 @@ namespace trading::adapters::primary
             if (!key || key->empty())
                 return;
 
-            if (auto cached = repo_->find(*key))
+            // Повтор, пришедший пока первый запрос ещё обрабатывается, ждёт его ответа
+            if (auto cached = repo_->claim(*key))
             {
                 res.setHeader("X-Idempotency-Key-Used", "true");
                 res.setResult(cached->status, "application/json", cached->body);
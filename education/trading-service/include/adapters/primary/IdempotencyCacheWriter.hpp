@@ -47,9 +47,12 @@ namespace trading::adapters::primary
 
             if (res.getStatus() >= 200 && res.getStatus() < 300)
             {
-                // TODO: сделать сервис (в котором репозиторий + кэш)
                 repo_->save(key, res.getStatus(), res.getBody());
             }
+            else
+            {
+                repo_->release(key);
+            }
         }
 
     private:
@@ -4,9 +4,13 @@
 #include <IRequest.hpp>
 #include <IResponse.hpp>
 #include "ports/input/IMetricsService.hpp"
+#include "adapters/secondary/KeepAliveHttpClient.hpp"
+#include "adapters/secondary/CachedBrokerGateway.hpp"
 
 #include <memory>
 #include <iostream>
+#include <sstream>
+#include <vector>
 
 namespace trading::adapters::primary {
 
@@ -15,6 +19,9 @@ namespace trading::adapters::primary {
  * 
  * Возвращает метрики в формате Prometheus text format 0.0.4.
  * Prometheus периодически опрашивает этот endpoint для сбора метрик.
+ * К счётчикам IMetricsService добавляются метрики пулов соединений
+ * к upstream-сервисам (trading_upstream_*, label upstream) и кэша
+ * broker-service (trading_broker_cache_*, label kind).
  * 
  * @note Content-Type: text/plain; version=0.0.4; charset=utf-8
  * 
@@ -31,9 +38,16 @@ public:
      * @brief Конструктор
      * 
      * @param metrics Сервис метрик для получения данных
+     * @param upstreams HTTP-клиенты к auth-service / broker-service
+     * @param brokerCache Кэш котировок и инструментов (может быть nullptr)
      */
-    explicit MetricsHandler(std::shared_ptr<ports::input::IMetricsService> metrics)
-        : metrics_(std::move(metrics))
+    MetricsHandler(
+        std::shared_ptr<ports::input::IMetricsService> metrics,
+        std::vector<std::shared_ptr<secondary::KeepAliveHttpClient>> upstreams,
+        std::shared_ptr<secondary::CachedBrokerGateway> brokerCache = nullptr
+    ) : metrics_(std::move(metrics))
+      , upstreams_(std::move(upstreams))
+      , brokerCache_(std::move(brokerCache))
     {
         std::cout << "[MetricsHandler] Created" << std::endl;
     }
@@ -45,11 +59,126 @@ public:
      * @param res HTTP ответ с метриками в Prometheus формате
      */
     void handle(IRequest& req, IResponse& res) override {
-        res.setResult(200, "text/plain; version=0.0.4; charset=utf-8", metrics_->toPrometheusFormat());
+        std::ostringstream oss;
+        oss << metrics_->toPrometheusFormat();
+        if (!upstreams_.empty()) {
+            serializeUpstreams(oss);
+        }
+        if (brokerCache_) {
+            serializeBrokerCache(oss);
+        }
+        res.setResult(200, "text/plain; version=0.0.4; charset=utf-8", oss.str());
     }
 
 private:
     std::shared_ptr<ports::input::IMetricsService> metrics_;
+    std::vector<std::shared_ptr<secondary::KeepAliveHttpClient>> upstreams_;
+    std::shared_ptr<secondary::CachedBrokerGateway> brokerCache_;
+
+    void serializeBrokerCache(std::ostringstream& oss) const {
+        auto stats = brokerCache_->stats();
+        const std::pair<const char*, const secondary::CachedBrokerGateway::Counters*> kinds[] = {
+            {"quote", &stats.quotes}, {"instrument", &stats.instruments}};
+
+        oss << "# HELP trading_broker_cache_requests_total Quote/instrument cache lookups by result\n";
+        oss << "# TYPE trading_broker_cache_requests_total counter\n";
+        for (const auto& [kind, c] : kinds) {
+            oss << "trading_broker_cache_requests_total{kind=\"" << kind << "\",result=\"hit\"} " << c->hits << "\n";
+            oss << "trading_broker_cache_requests_total{kind=\"" << kind << "\",result=\"stale\"} " << c->staleServed << "\n";
+            oss << "trading_broker_cache_requests_total{kind=\"" << kind << "\",result=\"miss\"} " << c->misses << "\n";
+        }
+
+        oss << "# HELP trading_broker_cache_coalesced_total Misses that waited for an in-flight broker-service request\n";
+        oss << "# TYPE trading_broker_cache_coalesced_total counter\n";
+        for (const auto& [kind, c] : kinds) {
+            oss << "trading_broker_cache_coalesced_total{kind=\"" << kind << "\"} " << c->coalesced << "\n";
+        }
+
+        oss << "# HELP trading_broker_cache_refreshes_total Background refreshes of stale entries\n";
+        oss << "# TYPE trading_broker_cache_refreshes_total counter\n";
+        oss << "trading_broker_cache_refreshes_total{result=\"ok\"} " << stats.refreshes << "\n";
+        oss << "trading_broker_cache_refreshes_total{result=\"error\"} " << stats.refreshErrors << "\n";
+
+        oss << "# HELP trading_broker_cache_in_flight Broker-service fetches currently in flight\n";
+        oss << "# TYPE trading_broker_cache_in_flight gauge\n";
+        oss << "trading_broker_cache_in_flight " << stats.inFlight << "\n";
+    }
+
+    void serializeUpstreams(std::ostringstream& oss) const {
+        using secondary::KeepAliveHttpClient;
+        std::vector<KeepAliveHttpClient::Stats> stats;
+        for (const auto& client : upstreams_) {
+            stats.push_back(client->stats());
+        }
+        auto label = [this](size_t i) {
+            return "upstream=\"" + upstreams_[i]->upstream() + "\"";
+        };
+
+        oss << "# HELP trading_upstream_requests_total HTTP requests to upstream services\n";
+        oss << "# TYPE trading_upstream_requests_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_requests_total{" << label(i) << "} " << stats[i].requests << "\n";
+        }
+
+        oss << "# HELP trading_upstream_pool_hits_total Requests served on a pooled keep-alive connection\n";
+        oss << "# TYPE trading_upstream_pool_hits_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_pool_hits_total{" << label(i) << "} " << stats[i].poolHits << "\n";
+        }
+
+        oss << "# HELP trading_upstream_handshakes_total New TCP connections opened\n";
+        oss << "# TYPE trading_upstream_handshakes_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_handshakes_total{" << label(i) << "} " << stats[i].handshakes << "\n";
+        }
+
+        oss << "# HELP trading_upstream_failures_total Failed requests and recovered stale connections\n";
+        oss << "# TYPE trading_upstream_failures_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_failures_total{" << label(i) << ",reason=\"timeout\"} " << stats[i].timeouts << "\n";
+            oss << "trading_upstream_failures_total{" << label(i) << ",reason=\"error\"} " << stats[i].errors << "\n";
+            oss << "trading_upstream_failures_total{" << label(i) << ",reason=\"retried\"} " << stats[i].retries << "\n";
+        }
+
+        oss << "# HELP trading_upstream_evicted_total Idle connections closed by idle timeout\n";
+        oss << "# TYPE trading_upstream_evicted_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_evicted_total{" << label(i) << "} " << stats[i].evicted << "\n";
+        }
+
+        oss << "# HELP trading_upstream_queued_total Requests that waited for an in-flight slot\n";
+        oss << "# TYPE trading_upstream_queued_total counter\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_queued_total{" << label(i) << "} " << stats[i].queued << "\n";
+        }
+
+        oss << "# HELP trading_upstream_connections Upstream connections by state\n";
+        oss << "# TYPE trading_upstream_connections gauge\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_connections{" << label(i) << ",state=\"idle\"} " << stats[i].idle << "\n";
+            oss << "trading_upstream_connections{" << label(i) << ",state=\"in_flight\"} " << stats[i].inFlight << "\n";
+        }
+
+        oss << "# HELP trading_upstream_latency_p99_seconds p99 upstream latency (histogram bucket bound)\n";
+        oss << "# TYPE trading_upstream_latency_p99_seconds gauge\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            oss << "trading_upstream_latency_p99_seconds{" << label(i) << "} " << stats[i].latencyP99Seconds() << "\n";
+        }
+
+        oss << "# HELP trading_upstream_latency_seconds Upstream request latency\n";
+        oss << "# TYPE trading_upstream_latency_seconds histogram\n";
+        for (size_t i = 0; i < stats.size(); ++i) {
+            for (size_t b = 0; b < KeepAliveHttpClient::LATENCY_BOUND_COUNT; ++b) {
+                oss << "trading_upstream_latency_seconds_bucket{" << label(i) << ",le=\""
+                    << KeepAliveHttpClient::LATENCY_BOUNDS_SECONDS[b] << "\"} "
+                    << stats[i].latencyCumulative[b] << "\n";
+            }
+            oss << "trading_upstream_latency_seconds_bucket{" << label(i) << ",le=\"+Inf\"} "
+                << stats[i].latencyCount << "\n";
+            oss << "trading_upstream_latency_seconds_sum{" << label(i) << "} " << stats[i].latencySecondsTotal << "\n";
+            oss << "trading_upstream_latency_seconds_count{" << label(i) << "} " << stats[i].latencyCount << "\n";
+        }
+    }
 };
 
 } // namespace trading::adapters::primary
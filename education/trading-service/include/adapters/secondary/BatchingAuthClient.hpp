@@ -0,0 +1,152 @@
+#pragma once
+
+#include "ports/output/IAuthClient.hpp"
+#include "settings/AuthClientSettings.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <iostream>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief Декоратор IAuthClient: склейка одновременных валидаций в одну пачку
+ *
+ * Первый validateAccessToken() открывает пачку и становится ведущим: ждёт
+ * AUTH_BATCH_WINDOW_MS (или пока пачка не наберёт AUTH_BATCH_MAX_SIZE),
+ * закрывает её и одним delegate->validateAccessTokens() проверяет все
+ * токены, пришедшие за это время. Остальные вызовы ждут ответа ведущего.
+ * Отдельного потока нет - как у SingleFlight, работу делает первый вызов.
+ *
+ * Цена - до AUTH_BATCH_WINDOW_MS задержки на промах кэша токенов; выигрыш -
+ * один HTTP-запрос к auth-service вместо N при всплеске запросов.
+ * Окно 0 - вызовы идут в delegate напрямую.
+ */
+class BatchingAuthClient : public ports::output::IAuthClient {
+public:
+    struct Stats {
+        uint64_t batches = 0;   ///< запросов validateAccessTokens в delegate
+        uint64_t tokens = 0;    ///< токенов в них
+    };
+
+    BatchingAuthClient(
+        std::shared_ptr<ports::output::IAuthClient> delegate,
+        std::shared_ptr<settings::AuthClientSettings> settings
+    ) : delegate_(std::move(delegate))
+      , window_(std::chrono::milliseconds(std::max(0, settings->getBatchWindowMs())))
+      , maxSize_(static_cast<size_t>(std::max(1, settings->getBatchMaxSize())))
+    {
+        std::cout << "[BatchingAuthClient] Created, window=" << window_.count()
+                  << "ms maxSize=" << maxSize_ << std::endl;
+    }
+
+    ports::output::TokenValidationResult validateAccessToken(const std::string& token) override {
+        if (window_.count() == 0) {
+            return delegate_->validateAccessToken(token);
+        }
+
+        std::shared_ptr<Batch> batch;
+        size_t index = 0;
+        bool leader = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!open_) {
+                open_ = std::make_shared<Batch>();
+                leader = true;
+            }
+            batch = open_;
+            index = batch->tokens.size();
+            batch->tokens.push_back(token);
+            if (batch->tokens.size() >= maxSize_) {
+                open_.reset();
+                full_.notify_all();
+            }
+        }
+
+        if (leader) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                full_.wait_for(lock, window_, [&] { return open_ != batch; });
+                if (open_ == batch) {
+                    open_.reset();
+                }
+            }
+            send(*batch);
+        }
+        return batch->results.get()[index];
+    }
+
+    std::vector<ports::output::TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>& tokens) override {
+        return delegate_->validateAccessTokens(tokens);
+    }
+
+    std::optional<std::string> getAccountIdFromToken(const std::string& token) override {
+        auto result = validateAccessToken(token);
+
+        if (result.valid && !result.accountId.empty()) {
+            return result.accountId;
+        }
+
+        return std::nullopt;
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.batches = batches_.load(std::memory_order_relaxed);
+        s.tokens = tokens_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    using Results = std::vector<ports::output::TokenValidationResult>;
+
+    /// tokens дописываются только под mutex_ и только пока пачка открыта
+    struct Batch {
+        std::vector<std::string> tokens;
+        std::promise<Results> promise;
+        std::shared_future<Results> results = promise.get_future().share();
+    };
+
+    /// Пачка закрыта: tokens больше не меняются
+    void send(Batch& batch) {
+        batches_.fetch_add(1, std::memory_order_relaxed);
+        tokens_.fetch_add(batch.tokens.size(), std::memory_order_relaxed);
+        // Как HttpAuthClient: сбой - невалидные результаты, не исключение
+        Results results;
+        try {
+            results = delegate_->validateAccessTokens(batch.tokens);
+            if (results.size() != batch.tokens.size()) {
+                throw std::runtime_error("expected " + std::to_string(batch.tokens.size()) +
+                                         " results, got " + std::to_string(results.size()));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "[BatchingAuthClient] Batch failed: " << e.what() << std::endl;
+            ports::output::TokenValidationResult failed;
+            failed.message = std::string("Auth service error: ") + e.what();
+            results.assign(batch.tokens.size(), failed);
+        }
+        batch.promise.set_value(std::move(results));
+    }
+
+    std::shared_ptr<ports::output::IAuthClient> delegate_;
+    const std::chrono::milliseconds window_;
+    const size_t maxSize_;
+
+    std::mutex mutex_;
+    std::condition_variable full_;
+    std::shared_ptr<Batch> open_;   ///< пачка, к которой присоединяются новые вызовы
+
+    std::atomic<uint64_t> batches_{0};
+    std::atomic<uint64_t> tokens_{0};
+};
+
+} // namespace trading::adapters::secondary
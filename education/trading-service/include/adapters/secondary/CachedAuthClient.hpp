@@ -0,0 +1,267 @@
+#pragma once
+
+#include "ports/output/IAuthClient.hpp"
+#include "ports/input/IEventConsumer.hpp"
+#include "settings/CacheSettings.hpp"
+#include <nlohmann/json.hpp>
+#include <openssl/sha.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <iostream>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief Декоратор IAuthClient с кэшем успешных валидаций access-токенов
+ *
+ * Ключ - SHA-256 токена (сам токен в памяти не хранится). Запись живёт до
+ * exp токена из ответа auth-service, но не дольше CACHE_TOKEN_MAX_TTL_SECONDS.
+ * Отказы не кэшируются: невалидный токен всегда перепроверяется.
+ *
+ * Отзыв: auth-service при logout публикует auth.session.revoked
+ * {"user_id", "revoked_at"} - все записи пользователя удаляются сразу.
+ * Валидация, начатая до отзыва, результат в кэш не кладёт.
+ *
+ * Кэш разбит на SHARDS сегментов со своим мьютексом; при переполнении
+ * сегмента сначала выбрасываются истёкшие записи, затем произвольная.
+ */
+class CachedAuthClient : public ports::output::IAuthClient {
+public:
+    static constexpr size_t SHARDS = 16;
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t revocations = 0;   ///< событий auth.session.revoked
+        uint64_t revokedEntries = 0;
+        size_t entries = 0;
+    };
+
+    CachedAuthClient(
+        std::shared_ptr<ports::output::IAuthClient> delegate,
+        std::shared_ptr<ports::input::IEventConsumer> eventConsumer,
+        std::shared_ptr<settings::CacheSettings> cacheSettings
+    ) : delegate_(std::move(delegate))
+      , eventConsumer_(std::move(eventConsumer))
+      , shardCapacity_(std::max<size_t>(1, cacheSettings->getTokenCacheSize() / SHARDS))
+      , maxTtlMs_(cacheSettings->getTokenMaxTtlSeconds() * 1000LL)
+    {
+        eventConsumer_->subscribe({"auth.session.revoked"},
+            [this](const std::string&, const std::string& message) {
+                onSessionRevoked(message);
+            });
+        std::cout << "[CachedAuthClient] Created, capacity=" << shardCapacity_ * SHARDS
+                  << " maxTtl=" << cacheSettings->getTokenMaxTtlSeconds() << "s" << std::endl;
+    }
+
+    ports::output::TokenValidationResult validateAccessToken(const std::string& token) override {
+        std::string key = hashOf(token);
+        int64_t now = nowMs();
+        if (auto cached = lookup(key, now)) {
+            return *cached;
+        }
+
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        uint64_t generation = revocationGeneration_.load(std::memory_order_acquire);
+        auto result = delegate_->validateAccessToken(token);
+        store(key, result, generation, now);
+        return result;
+    }
+
+    /// Попадания отвечаются из кэша, промахи уходят в delegate одной пачкой
+    std::vector<ports::output::TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>& tokens) override {
+        std::vector<ports::output::TokenValidationResult> results(tokens.size());
+        std::vector<std::string> keys(tokens.size());
+        std::vector<size_t> missed;
+        std::vector<std::string> missedTokens;
+        int64_t now = nowMs();
+
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            keys[i] = hashOf(tokens[i]);
+            if (auto cached = lookup(keys[i], now)) {
+                results[i] = std::move(*cached);
+            } else {
+                missed.push_back(i);
+                missedTokens.push_back(tokens[i]);
+            }
+        }
+        if (missed.empty()) {
+            return results;
+        }
+
+        misses_.fetch_add(missed.size(), std::memory_order_relaxed);
+        uint64_t generation = revocationGeneration_.load(std::memory_order_acquire);
+        auto fetched = delegate_->validateAccessTokens(missedTokens);
+        for (size_t j = 0; j < missed.size() && j < fetched.size(); ++j) {
+            store(keys[missed[j]], fetched[j], generation, now);
+            results[missed[j]] = std::move(fetched[j]);
+        }
+        return results;
+    }
+
+    std::optional<std::string> getAccountIdFromToken(const std::string& token) override {
+        auto result = validateAccessToken(token);
+
+        if (result.valid && !result.accountId.empty()) {
+            return result.accountId;
+        }
+
+        return std::nullopt;
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.hits = hits_.load(std::memory_order_relaxed);
+        s.misses = misses_.load(std::memory_order_relaxed);
+        s.revocations = revocations_.load(std::memory_order_relaxed);
+        s.revokedEntries = revokedEntries_.load(std::memory_order_relaxed);
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            s.entries += shard.entries.size();
+        }
+        return s;
+    }
+
+private:
+    struct Entry {
+        std::string userId;
+        std::string accountId;
+        int64_t expiresAtMs = 0;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Entry> entries;
+    };
+
+    std::optional<ports::output::TokenValidationResult> lookup(const std::string& key, int64_t now) {
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) {
+            return std::nullopt;
+        }
+        if (it->second.expiresAtMs <= now) {
+            shard.entries.erase(it);
+            return std::nullopt;
+        }
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        ports::output::TokenValidationResult result;
+        result.valid = true;
+        result.message = "Valid";
+        result.userId = it->second.userId;
+        result.accountId = it->second.accountId;
+        result.expiresAtMs = it->second.expiresAtMs;
+        return result;
+    }
+
+    /// generation - revocationGeneration_ до запроса в delegate
+    void store(const std::string& key, const ports::output::TokenValidationResult& result,
+               uint64_t generation, int64_t now) {
+        if (!result.valid || result.userId.empty()) {
+            return;
+        }
+
+        int64_t expiresAt = std::min(
+            result.expiresAtMs > 0 ? result.expiresAtMs : std::numeric_limits<int64_t>::max(),
+            now + maxTtlMs_);
+        if (expiresAt <= now) {
+            return;
+        }
+
+        Shard& shard = shardOf(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        // Отзыв случился, пока шёл запрос - ответ мог устареть
+        if (revocationGeneration_.load(std::memory_order_acquire) != generation) {
+            return;
+        }
+        if (shard.entries.size() >= shardCapacity_ && !shard.entries.count(key)) {
+            evict(shard, now);
+        }
+        shard.entries[key] = Entry{result.userId, result.accountId, expiresAt};
+    }
+
+    void onSessionRevoked(const std::string& message) {
+        std::string userId;
+        try {
+            userId = nlohmann::json::parse(message).value("user_id", "");
+        } catch (const std::exception& e) {
+            std::cerr << "[CachedAuthClient] Bad auth.session.revoked: " << e.what() << std::endl;
+            return;
+        }
+        if (userId.empty()) {
+            return;
+        }
+
+        // Сначала поколение, потом чистка: вставка сверяет его под мьютексом сегмента
+        revocationGeneration_.fetch_add(1, std::memory_order_acq_rel);
+        revocations_.fetch_add(1, std::memory_order_relaxed);
+
+        size_t removed = 0;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+                if (it->second.userId == userId) {
+                    it = shard.entries.erase(it);
+                    ++removed;
+                } else {
+                    ++it;
+                }
+            }
+        }
+        revokedEntries_.fetch_add(removed, std::memory_order_relaxed);
+        std::cout << "[CachedAuthClient] Session revoked for " << userId
+                  << ", dropped " << removed << " cached token(s)" << std::endl;
+    }
+
+    /// Под мьютексом сегмента: сначала истёкшие, живую запись - только если места всё ещё нет
+    void evict(Shard& shard, int64_t now) {
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            it = it->second.expiresAtMs <= now ? shard.entries.erase(it) : std::next(it);
+        }
+        if (shard.entries.size() >= shardCapacity_) {
+            shard.entries.erase(shard.entries.begin());
+        }
+    }
+
+    static std::string hashOf(const std::string& token) {
+        std::string digest(SHA256_DIGEST_LENGTH, '\0');
+        SHA256(reinterpret_cast<const unsigned char*>(token.data()), token.size(),
+               reinterpret_cast<unsigned char*>(digest.data()));
+        return digest;
+    }
+
+    Shard& shardOf(const std::string& key) {
+        return shards_[static_cast<unsigned char>(key[0]) % SHARDS];
+    }
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::shared_ptr<ports::output::IAuthClient> delegate_;
+    std::shared_ptr<ports::input::IEventConsumer> eventConsumer_;
+    const size_t shardCapacity_;
+    const int64_t maxTtlMs_;
+
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<uint64_t> revocationGeneration_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> revocations_{0};
+    std::atomic<uint64_t> revokedEntries_{0};
+};
+
+} // namespace trading::adapters::secondary
@@ -2,13 +2,24 @@
 
 #include "ports/output/IBrokerGateway.hpp"
 #include "adapters/secondary/HttpBrokerGateway.hpp"
+#include "adapters/secondary/SingleFlight.hpp"
 #include "settings/CacheSettings.hpp"
 #include <cache/ICache.hpp>
 #include <cache/Cache.hpp>
 #include <cache/eviction/LRUPolicy.hpp>
 #include <cache/expiration/GlobalTTL.hpp>
 #include <cache/concurrency/ThreadSafeCache.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <iostream>
 
 namespace trading::adapters::secondary {
@@ -23,16 +34,60 @@ namespace trading::adapters::secondary {
  * НЕ кэширует (всегда актуальные данные):
  * - Портфель
  * - Ордера
+ *
+ * Промахи по одному figi склеиваются (SingleFlight): пока запрос к
+ * broker-service в полёте, остальные вызовы ждут его ответа, а не
+ * повторяют его. getQuotes запрашивает одним батчем только те figi,
+ * за которыми ещё никто не пошёл.
+ *
+ * Stale-while-revalidate (CACHE_QUOTE_STALE_SECONDS,
+ * CACHE_INSTRUMENT_STALE_SECONDS): после TTL запись ещё столько секунд
+ * отдаётся как есть, а обновляет её один фоновый поток - по одному
+ * запросу на ключ. Если обновление не удалось, устаревшее значение
+ * отдаётся до конца окна.
  */
 class CachedBrokerGateway : public ports::output::IBrokerGateway {
 public:
+    struct Counters {
+        uint64_t hits = 0;
+        uint64_t staleServed = 0;   ///< отдано устаревшее значение
+        uint64_t misses = 0;
+        uint64_t coalesced = 0;     ///< промахов, дождавшихся чужого запроса
+    };
+
+    struct Stats {
+        Counters quotes;
+        Counters instruments;
+        uint64_t refreshes = 0;     ///< выполненных фоновых обновлений
+        uint64_t refreshErrors = 0;
+        size_t inFlight = 0;
+    };
+
     CachedBrokerGateway(
         std::shared_ptr<HttpBrokerGateway> delegate,
         std::shared_ptr<settings::CacheSettings> cacheSettings
     ) : delegate_(std::move(delegate))
       , cacheSettings_(std::move(cacheSettings))
+      , quoteTtl_(std::chrono::seconds(cacheSettings_->getQuoteTtlSeconds()))
+      , instrumentTtl_(std::chrono::seconds(cacheSettings_->getInstrumentTtlSeconds()))
+      , quoteStale_(cacheSettings_->getQuoteStaleSeconds() > 0)
+      , instrumentStale_(cacheSettings_->getInstrumentStaleSeconds() > 0)
     {
         initCaches();
+        if (quoteStale_ || instrumentStale_) {
+            refreshThread_ = std::thread([this] { refreshLoop(); });
+        }
+    }
+
+    ~CachedBrokerGateway() override {
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            stopped_ = true;
+        }
+        refreshCv_.notify_all();
+        if (refreshThread_.joinable()) {
+            refreshThread_.join();
+        }
     }
 
     // ============================================
@@ -40,17 +95,16 @@ public:
     // ============================================
 
     std::optional<domain::Quote> getQuote(const std::string& figi) override {
-        auto cached = quoteCache_->get(figi);
-        if (cached) {
-            return *cached;
-        }
-
-        auto quote = delegate_->getQuote(figi);
-        if (quote) {
-            quoteCache_->put(figi, *quote);
+        if (auto cached = quoteCache_->get(figi)) {
+            if (!isStale(*cached, quoteStale_, quoteCounters_)) {
+                return cached->value;
+            }
+            scheduleRefresh("quote:" + figi, [this, figi] { quoteFlight_.run(figi, [&] { return fetchQuote(figi); }); });
+            return cached->value;
         }
 
-        return quote;
+        quoteCounters_.misses.fetch_add(1, std::memory_order_relaxed);
+        return quoteFlight_.run(figi, [&] { return fetchQuote(figi); });
     }
 
     std::vector<domain::Quote> getQuotes(const std::vector<std::string>& figis) override {
@@ -60,18 +114,59 @@ public:
         for (const auto& figi : figis) {
             auto cached = quoteCache_->get(figi);
             if (cached) {
-                result.push_back(*cached);
+                if (isStale(*cached, quoteStale_, quoteCounters_)) {
+                    scheduleRefresh("quote:" + figi, [this, figi] { quoteFlight_.run(figi, [&] { return fetchQuote(figi); }); });
+                }
+                result.push_back(cached->value);
             } else {
                 missingFigis.push_back(figi);
             }
         }
 
-        if (!missingFigis.empty()) {
-            auto quotes = delegate_->getQuotes(missingFigis);
+        if (missingFigis.empty()) {
+            return result;
+        }
+        quoteCounters_.misses.fetch_add(missingFigis.size(), std::memory_order_relaxed);
+
+        // За частью figi уже кто-то пошёл - ждём их, остальные берём одним батчем
+        std::vector<std::shared_future<std::optional<domain::Quote>>> pending;
+        std::vector<std::string> claimed;
+        for (const auto& figi : missingFigis) {
+            if (auto future = quoteFlight_.join(figi)) {
+                pending.push_back(*future);
+            } else {
+                claimed.push_back(figi);
+            }
+        }
+
+        if (!claimed.empty()) {
+            std::vector<domain::Quote> quotes;
+            try {
+                quotes = delegate_->getQuotes(claimed);
+            } catch (...) {
+                for (const auto& figi : claimed) {
+                    quoteFlight_.fail(figi, std::current_exception());
+                }
+                throw;
+            }
+
+            std::unordered_map<std::string, const domain::Quote*> byFigi;
             for (const auto& quote : quotes) {
-                quoteCache_->put(quote.figi, quote);
+                quoteCache_->put(quote.figi, fresh(quote, quoteTtl_));
+                byFigi[quote.figi] = &quote;
                 result.push_back(quote);
             }
+            for (const auto& figi : claimed) {
+                auto it = byFigi.find(figi);
+                quoteFlight_.complete(figi, it != byFigi.end()
+                    ? std::optional<domain::Quote>(*it->second) : std::nullopt);
+            }
+        }
+
+        for (auto& future : pending) {
+            if (auto quote = future.get()) {
+                result.push_back(*quote);
+            }
         }
 
         return result;
@@ -82,17 +177,18 @@ public:
     // ============================================
 
     std::optional<domain::Instrument> getInstrumentByFigi(const std::string& figi) override {
-        auto cached = instrumentCache_->get(figi);
-        if (cached) {
-            return *cached;
-        }
-
-        auto instrument = delegate_->getInstrumentByFigi(figi);
-        if (instrument) {
-            instrumentCache_->put(figi, *instrument);
+        if (auto cached = instrumentCache_->get(figi)) {
+            if (!isStale(*cached, instrumentStale_, instrumentCounters_)) {
+                return cached->value;
+            }
+            scheduleRefresh("instrument:" + figi, [this, figi] {
+                instrumentFlight_.run(figi, [&] { return fetchInstrument(figi); });
+            });
+            return cached->value;
         }
 
-        return instrument;
+        instrumentCounters_.misses.fetch_add(1, std::memory_order_relaxed);
+        return instrumentFlight_.run(figi, [&] { return fetchInstrument(figi); });
     }
 
     std::vector<domain::Instrument> getAllInstruments() override {
@@ -101,7 +197,7 @@ public:
 
         // Прогреваем кэш
         for (const auto& instr : instruments) {
-            instrumentCache_->put(instr.figi, instr);
+            instrumentCache_->put(instr.figi, fresh(instr, instrumentTtl_));
         }
 
         return instruments;
@@ -116,7 +212,7 @@ public:
 
         // Прогреваем кэш
         for (const auto& instr : instruments) {
-            instrumentCache_->put(instr.figi, instr);
+            instrumentCache_->put(instr.figi, fresh(instr, instrumentTtl_));
         }
 
         return instruments;
@@ -130,8 +226,11 @@ public:
         return delegate_->getPortfolio(accountId);
     }
 
-    std::vector<domain::Order> getOrders(const std::string& accountId) override {
-        return delegate_->getOrders(accountId);
+    domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query
+    ) override {
+        return delegate_->getOrders(accountId, query);
     }
 
     std::optional<domain::Order> getOrder(
@@ -166,43 +265,171 @@ public:
         return instrumentCache_->size();
     }
 
+    Stats stats() const {
+        Stats s;
+        s.quotes = quoteCounters_.snapshot();
+        s.quotes.coalesced = quoteFlight_.coalesced();
+        s.instruments = instrumentCounters_.snapshot();
+        s.instruments.coalesced = instrumentFlight_.coalesced();
+        s.refreshes = refreshes_.load(std::memory_order_relaxed);
+        s.refreshErrors = refreshErrors_.load(std::memory_order_relaxed);
+        s.inFlight = quoteFlight_.inFlight() + instrumentFlight_.inFlight();
+        return s;
+    }
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Значение в кэше и момент, после которого оно считается устаревшим
+    template<typename T>
+    struct Timed {
+        T value;
+        Clock::time_point freshUntil;
+    };
+
+    struct AtomicCounters {
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> staleServed{0};
+        std::atomic<uint64_t> misses{0};
+
+        Counters snapshot() const {
+            Counters c;
+            c.hits = hits.load(std::memory_order_relaxed);
+            c.staleServed = staleServed.load(std::memory_order_relaxed);
+            c.misses = misses.load(std::memory_order_relaxed);
+            return c;
+        }
+    };
+
+    template<typename T>
+    static Timed<T> fresh(const T& value, Clock::duration ttl) {
+        return Timed<T>{value, Clock::now() + ttl};
+    }
+
+    /// Без окна stale запись живёт ровно TTL кэша и всегда свежая
+    template<typename T>
+    static bool isStale(const Timed<T>& entry, bool staleEnabled, AtomicCounters& counters) {
+        if (!staleEnabled || entry.freshUntil > Clock::now()) {
+            counters.hits.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        counters.staleServed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::optional<domain::Quote> fetchQuote(const std::string& figi) {
+        auto quote = delegate_->getQuote(figi);
+        if (quote) {
+            quoteCache_->put(figi, fresh(*quote, quoteTtl_));
+        }
+        return quote;
+    }
+
+    std::optional<domain::Instrument> fetchInstrument(const std::string& figi) {
+        auto instrument = delegate_->getInstrumentByFigi(figi);
+        if (instrument) {
+            instrumentCache_->put(figi, fresh(*instrument, instrumentTtl_));
+        }
+        return instrument;
+    }
+
+    /// Повторная постановка ключа, пока обновление не выполнено, игнорируется
+    void scheduleRefresh(const std::string& key, std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(refreshMutex_);
+            if (stopped_ || !refreshKeys_.insert(key).second) {
+                return;
+            }
+            refreshQueue_.emplace_back(key, std::move(task));
+        }
+        refreshCv_.notify_one();
+    }
+
+    void refreshLoop() {
+        std::unique_lock<std::mutex> lock(refreshMutex_);
+        while (true) {
+            refreshCv_.wait(lock, [this] { return stopped_ || !refreshQueue_.empty(); });
+            if (stopped_) {
+                return;
+            }
+            auto [key, task] = std::move(refreshQueue_.front());
+            refreshQueue_.pop_front();
+            lock.unlock();
+
+            try {
+                task();
+                refreshes_.fetch_add(1, std::memory_order_relaxed);
+            } catch (const std::exception& e) {
+                refreshErrors_.fetch_add(1, std::memory_order_relaxed);
+                std::cerr << "[CachedBrokerGateway] Refresh failed for " << key << ": " << e.what() << std::endl;
+            }
+
+            lock.lock();
+            refreshKeys_.erase(key);
+        }
+    }
+
     void initCaches() {
         size_t quoteCacheSize = cacheSettings_->getQuoteCacheSize();
         int quoteTtlSeconds = cacheSettings_->getQuoteTtlSeconds();
         size_t instrumentCacheSize = cacheSettings_->getInstrumentCacheSize();
         int instrumentTtlSeconds = cacheSettings_->getInstrumentTtlSeconds();
 
-        // Кэш котировок: figi -> Quote
-        auto quoteBase = std::make_unique<Cache<std::string, domain::Quote>>(
+        int quoteStaleSeconds = std::max(0, cacheSettings_->getQuoteStaleSeconds());
+        int instrumentStaleSeconds = std::max(0, cacheSettings_->getInstrumentStaleSeconds());
+
+        // Кэш котировок: figi -> Quote, хранится TTL + окно stale
+        auto quoteBase = std::make_unique<Cache<std::string, Timed<domain::Quote>>>(
             quoteCacheSize,
             std::make_unique<LRUPolicy<std::string>>(),
-            std::make_unique<GlobalTTL<std::string>>(std::chrono::seconds(quoteTtlSeconds))
+            std::make_unique<GlobalTTL<std::string>>(std::chrono::seconds(quoteTtlSeconds + quoteStaleSeconds))
         );
-        quoteCache_ = std::make_unique<ThreadSafeCache<std::string, domain::Quote>>(
+        quoteCache_ = std::make_unique<ThreadSafeCache<std::string, Timed<domain::Quote>>>(
             std::move(quoteBase)
         );
 
         // Кэш инструментов: figi -> Instrument
-        auto instrumentBase = std::make_unique<Cache<std::string, domain::Instrument>>(
+        auto instrumentBase = std::make_unique<Cache<std::string, Timed<domain::Instrument>>>(
             instrumentCacheSize,
             std::make_unique<LRUPolicy<std::string>>(),
-            std::make_unique<GlobalTTL<std::string>>(std::chrono::seconds(instrumentTtlSeconds))
+            std::make_unique<GlobalTTL<std::string>>(std::chrono::seconds(instrumentTtlSeconds + instrumentStaleSeconds))
         );
-        instrumentCache_ = std::make_unique<ThreadSafeCache<std::string, domain::Instrument>>(
+        instrumentCache_ = std::make_unique<ThreadSafeCache<std::string, Timed<domain::Instrument>>>(
             std::move(instrumentBase)
         );
 
         std::cout << "[CachedBrokerGateway] Created with:"
-                  << " quoteCache=" << quoteCacheSize << "/" << quoteTtlSeconds << "s"
-                  << " instrumentCache=" << instrumentCacheSize << "/" << instrumentTtlSeconds << "s"
+                  << " quoteCache=" << quoteCacheSize << "/" << quoteTtlSeconds << "s+" << quoteStaleSeconds << "s stale"
+                  << " instrumentCache=" << instrumentCacheSize << "/" << instrumentTtlSeconds << "s+"
+                  << instrumentStaleSeconds << "s stale"
                   << std::endl;
     }
 
     std::shared_ptr<HttpBrokerGateway> delegate_;
     std::shared_ptr<settings::CacheSettings> cacheSettings_;
-    std::unique_ptr<ICache<std::string, domain::Quote>> quoteCache_;
-    std::unique_ptr<ICache<std::string, domain::Instrument>> instrumentCache_;
+    const Clock::duration quoteTtl_;
+    const Clock::duration instrumentTtl_;
+    const bool quoteStale_;
+    const bool instrumentStale_;
+
+    std::unique_ptr<ICache<std::string, Timed<domain::Quote>>> quoteCache_;
+    std::unique_ptr<ICache<std::string, Timed<domain::Instrument>>> instrumentCache_;
+
+    SingleFlight<std::string, std::optional<domain::Quote>> quoteFlight_;
+    SingleFlight<std::string, std::optional<domain::Instrument>> instrumentFlight_;
+
+    AtomicCounters quoteCounters_;
+    AtomicCounters instrumentCounters_;
+    std::atomic<uint64_t> refreshes_{0};
+    std::atomic<uint64_t> refreshErrors_{0};
+
+    // Фоновое обновление устаревших записей
+    std::mutex refreshMutex_;
+    std::condition_variable refreshCv_;
+    std::deque<std::pair<std::string, std::function<void()>>> refreshQueue_;
+    std::unordered_set<std::string> refreshKeys_;
+    bool stopped_ = false;
+    std::thread refreshThread_;
 };
 
 } // namespace trading::adapters::secondary
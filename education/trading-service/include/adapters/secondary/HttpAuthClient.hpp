@@ -6,7 +6,11 @@
 #include <SimpleRequest.hpp>
 #include <SimpleResponse.hpp>
 #include <nlohmann/json.hpp>
+#include <algorithm>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 #include <iostream>
 
 namespace trading::adapters::secondary {
@@ -14,10 +18,15 @@ namespace trading::adapters::secondary {
 /**
  * @brief HTTP клиент к Auth Service
  * 
- * Вызывает POST /api/v1/auth/validate для валидации токенов.
+ * Вызывает POST /api/v1/auth/validate для валидации токенов и
+ * POST /api/v1/auth/validate/batch - для пачки (не больше MAX_BATCH
+ * токенов в запросе, длинная пачка режется на несколько).
  */
 class HttpAuthClient : public ports::output::IAuthClient {
 public:
+    /// Предел auth-service для /validate/batch
+    static constexpr size_t MAX_BATCH = 256;
+
     HttpAuthClient(
         std::shared_ptr<IHttpClient> httpClient,
         std::shared_ptr<settings::AuthClientSettings> settings
@@ -56,6 +65,7 @@ public:
                 result.userId = responseBody.value("user_id", "");
                 result.accountId = responseBody.value("account_id", "");
                 result.message = responseBody.value("message", "");
+                result.expiresAtMs = responseBody.value("expires_at", int64_t{0});
             } else {
                 result.valid = false;
                 result.message = "Auth service returned " + std::to_string(response.getStatus());
@@ -70,6 +80,17 @@ public:
         return result;
     }
 
+    std::vector<ports::output::TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>& tokens) override {
+        std::vector<ports::output::TokenValidationResult> results;
+        results.reserve(tokens.size());
+        for (size_t offset = 0; offset < tokens.size(); offset += MAX_BATCH) {
+            size_t count = std::min(MAX_BATCH, tokens.size() - offset);
+            validateChunk(tokens, offset, count, results);
+        }
+        return results;
+    }
+
     std::optional<std::string> getAccountIdFromToken(const std::string& token) override {
         auto result = validateAccessToken(token);
         
@@ -81,6 +102,62 @@ public:
     }
 
 private:
+    void validateChunk(const std::vector<std::string>& tokens, size_t offset, size_t count,
+                       std::vector<ports::output::TokenValidationResult>& results) {
+        std::string error;
+        try {
+            nlohmann::json requestBody;
+            requestBody["tokens"] = std::vector<std::string>(
+                tokens.begin() + offset, tokens.begin() + offset + count);
+            requestBody["type"] = "access";
+
+            SimpleRequest request(
+                "POST",
+                "/api/v1/auth/validate/batch",
+                requestBody.dump(),
+                settings_->getHost(),
+                settings_->getPort(),
+                {{"Content-Type", "application/json"}}
+            );
+
+            SimpleResponse response;
+            httpClient_->send(request, response);
+
+            if (response.getStatus() == 200) {
+                auto items = nlohmann::json::parse(response.getBody()).at("results");
+                if (items.size() != count) {
+                    throw std::runtime_error("expected " + std::to_string(count) +
+                                             " results, got " + std::to_string(items.size()));
+                }
+                // Пачка добавляется целиком: ошибка на середине не должна сдвинуть
+                // результаты относительно токенов следующих пачек
+                std::vector<ports::output::TokenValidationResult> parsed;
+                parsed.reserve(count);
+                for (const auto& item : items) {
+                    ports::output::TokenValidationResult result;
+                    result.valid = item.value("valid", false);
+                    result.userId = item.value("user_id", "");
+                    result.accountId = item.value("account_id", "");
+                    result.message = item.value("message", "");
+                    result.expiresAtMs = item.value("expires_at", int64_t{0});
+                    parsed.push_back(std::move(result));
+                }
+                results.insert(results.end(), std::make_move_iterator(parsed.begin()),
+                               std::make_move_iterator(parsed.end()));
+                return;
+            }
+            error = "Auth service returned " + std::to_string(response.getStatus());
+
+        } catch (const std::exception& e) {
+            std::cerr << "[HttpAuthClient] Batch error: " << e.what() << std::endl;
+            error = std::string("Auth service error: ") + e.what();
+        }
+
+        ports::output::TokenValidationResult failed;
+        failed.message = error;
+        results.insert(results.end(), count, failed);
+    }
+
     std::shared_ptr<IHttpClient> httpClient_;
     std::shared_ptr<settings::AuthClientSettings> settings_;
 };
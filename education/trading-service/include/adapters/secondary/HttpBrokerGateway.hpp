@@ -11,6 +11,8 @@
 #include <iostream>
 #include <sstream>
 #include <algorithm>
+#include <cctype>
+#include <stdexcept>
 
 namespace trading::adapters::secondary {
 
@@ -177,34 +179,51 @@ public:
         return portfolio;
     }
 
-    std::vector<domain::Order> getOrders(const std::string& accountId) override {
-        std::vector<domain::Order> result;
+    /**
+     * @brief Одна страница истории: параметры запроса уходят в broker-service как есть
+     * @throws std::invalid_argument если broker-service отверг параметры (400)
+     * @throws std::runtime_error если страница не получена
+     */
+    domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query
+    ) override {
+        domain::OrderPage page;
         
         try {
-            std::string path = "/api/v1/orders?account_id=" + accountId;
+            std::string path = "/api/v1/orders?account_id=" + urlEncode(accountId) +
+                               "&limit=" + std::to_string(query.limit);
+            if (query.cursor) {
+                path += "&cursor=" + urlEncode(*query.cursor);
+            }
+            if (query.fromMs) {
+                path += "&from=" + std::to_string(*query.fromMs);
+            }
+            if (query.toMs) {
+                path += "&to=" + std::to_string(*query.toMs);
+            }
+            if (query.status) {
+                path += "&status=" + domain::toString(*query.status);
+            }
             auto response = doGet(path);
             
+            if (response.getStatus() == 400) {
+                throw std::invalid_argument("Broker rejected order query: " + response.getBody());
+            }
             if (response.getStatus() != 200) {
-                return result;
+                throw std::runtime_error("Failed to get orders: " + std::to_string(response.getStatus()));
             }
 
-            auto json = nlohmann::json::parse(response.getBody());
-            
-            nlohmann::json ordersJson;
-            if (json.is_array()) {
-                ordersJson = json;
-            } else {
-                ordersJson = json.value("orders", nlohmann::json::array());
-            }
-            
-            for (const auto& o : ordersJson) {
-                result.push_back(parseOrder(o));
+            std::string next = parseOrdersPage(response.getBody(), page.orders);
+            if (!next.empty()) {
+                page.nextCursor = next;
             }
         } catch (const std::exception& e) {
             std::cerr << "[HttpBrokerGateway] getOrders error: " << e.what() << std::endl;
+            throw;
         }
 
-        return result;
+        return page;
     }
 
     std::optional<domain::Order> getOrder(
@@ -232,6 +251,25 @@ private:
     std::shared_ptr<IHttpClient> httpClient_;
     std::shared_ptr<settings::IBrokerClientSettings> settings_;
 
+    /**
+     * @brief Percent-encoding значения query string (RFC 3986, unreserved как есть)
+     */
+    static std::string urlEncode(const std::string& value) {
+        static const char HEX[] = "0123456789ABCDEF";
+        std::string result;
+        result.reserve(value.size());
+        for (unsigned char c : value) {
+            if (std::isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~') {
+                result += static_cast<char>(c);
+            } else {
+                result += '%';
+                result += HEX[c >> 4];
+                result += HEX[c & 0x0F];
+            }
+        }
+        return result;
+    }
+
     static std::string toLower(const std::string& s) {
         std::string result = s;
         std::transform(result.begin(), result.end(), result.begin(), ::tolower);
@@ -286,6 +324,40 @@ private:
         return domain::Money::fromDouble(0.0, defaultCurrency);
     }
 
+    /**
+     * @brief Ордера страницы в out, без разбора всего ответа в один документ
+     *
+     * Понимает {"orders": [...], "next_cursor": ...} и голый массив.
+     * Каждый ордер разбирается сразу по закрытии его объекта и
+     * выбрасывается из дерева.
+     * @return next_cursor или пустая строка, если страница последняя
+     */
+    std::string parseOrdersPage(const std::string& body, std::vector<domain::Order>& out) {
+        using Event = nlohmann::json::parse_event_t;
+        bool bareArray = false;
+        std::string key;
+        std::string nextCursor;
+
+        nlohmann::json::parser_callback_t onEvent =
+            [&](int depth, Event event, nlohmann::json& parsed) {
+                if (depth == 0 && event == Event::array_start) {
+                    bareArray = true;
+                } else if (depth == 1 && event == Event::key) {
+                    key = parsed.get<std::string>();
+                } else if (depth == 1 && event == Event::value && key == "next_cursor" && parsed.is_string()) {
+                    nextCursor = parsed.get<std::string>();
+                } else if (event == Event::object_end &&
+                           (bareArray ? depth == 1 : depth == 2 && key == "orders")) {
+                    out.push_back(parseOrder(parsed));
+                    return false;
+                }
+                return true;
+            };
+
+        nlohmann::json::parse(body, onEvent);
+        return nextCursor;
+    }
+
     domain::Quote parseQuote(const nlohmann::json& j) {
         std::string currency = j.value("currency", "RUB");
         return domain::Quote(
@@ -0,0 +1,439 @@
+// trading-service/include/adapters/secondary/KeepAliveHttpClient.hpp
+#pragma once
+
+#include "settings/HttpPoolSettings.hpp"
+#include <IHttpClient.hpp>
+#include <IRequest.hpp>
+#include <IResponse.hpp>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief HTTP-клиент к одному upstream с пулом keep-alive соединений
+ *
+ * Стандартный HttpClient открывает TCP-соединение на каждый запрос, а
+ * каждый авторизованный запрос к trading-service - это минимум один вызов
+ * auth-service и ещё один к broker-service на чтение. Этот клиент
+ * привязан к одному host:port (адрес из SimpleRequest не используется) и
+ * переиспользует соединения:
+ *
+ * - после ответа с keep-alive соединение возвращается в пул, пока в нём
+ *   меньше getPoolSize() простаивающих; остальные закрываются;
+ * - соединение, простоявшее дольше getIdleTimeoutMs(), закрывается при
+ *   следующей выдаче;
+ * - если upstream успел закрыть простаивающее соединение (eof / reset до
+ *   ответа), запрос один раз повторяется на новом;
+ * - одновременно выполняется не больше getMaxInFlight() запросов,
+ *   остальные ждут слот;
+ * - getRequestTimeoutMs() - общий дедлайн запроса: ожидание слота,
+ *   DNS, connect, запись и чтение ответа.
+ *
+ * HTTP pipelining не используется: ответы на одном соединении приходят
+ * строго по порядку, медленный запрос задерживал бы все следующие.
+ *
+ * Ошибки и таймауты - UpstreamError (std::runtime_error), как у
+ * HttpClient: HttpAuthClient / HttpBrokerGateway их уже перехватывают.
+ *
+ * Каждое соединение владеет своим io_context: операции асинхронные
+ * (так работают таймауты beast::tcp_stream), но запускаются и ждутся в
+ * вызывающем потоке.
+ *
+ * Thread-safe: да
+ */
+class KeepAliveHttpClient : public IHttpClient {
+    using Clock = std::chrono::steady_clock;
+    using tcp = boost::asio::ip::tcp;
+    using Request = boost::beast::http::request<boost::beast::http::string_body>;
+    using Response = boost::beast::http::response<boost::beast::http::string_body>;
+
+public:
+    class UpstreamError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /// Границы бакетов гистограммы задержки, секунды
+    static constexpr std::array<double, 11> LATENCY_BOUNDS_SECONDS = {
+        0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5
+    };
+    static constexpr size_t LATENCY_BOUND_COUNT = LATENCY_BOUNDS_SECONDS.size();
+
+    /**
+     * @brief Снимок метрик пула (для /metrics)
+     */
+    struct Stats {
+        size_t poolSize = 0;            ///< Максимум простаивающих соединений
+        size_t idle = 0;                ///< Простаивающих сейчас
+        size_t inFlight = 0;            ///< Выполняющихся запросов
+        uint64_t requests = 0;          ///< Всего запросов
+        uint64_t poolHits = 0;          ///< Запросов на соединении из пула
+        uint64_t handshakes = 0;        ///< Открыто новых соединений
+        uint64_t retries = 0;           ///< Повторов после закрытого upstream соединения
+        uint64_t evicted = 0;           ///< Закрыто по простою
+        uint64_t timeouts = 0;
+        uint64_t errors = 0;            ///< Прочие ошибки транспорта
+        uint64_t queued = 0;            ///< Запросов, ждавших слот in-flight
+        std::array<uint64_t, LATENCY_BOUND_COUNT> latencyCumulative{};  ///< le-бакеты
+        uint64_t latencyCount = 0;
+        double latencySecondsTotal = 0.0;
+
+        /**
+         * @brief Оценка p99 по гистограмме (верхняя граница бакета)
+         * @return 0 без запросов; хвост за последней границей - последняя граница
+         */
+        double latencyP99Seconds() const {
+            if (latencyCount == 0) {
+                return 0.0;
+            }
+            uint64_t rank = (latencyCount * 99 + 99) / 100;
+            for (size_t b = 0; b < LATENCY_BOUND_COUNT; ++b) {
+                if (latencyCumulative[b] >= rank) {
+                    return LATENCY_BOUNDS_SECONDS[b];
+                }
+            }
+            return LATENCY_BOUNDS_SECONDS[LATENCY_BOUND_COUNT - 1];
+        }
+    };
+
+    /**
+     * @param upstream Имя для логов и метрик ("auth-service", "broker-service")
+     */
+    KeepAliveHttpClient(
+        std::string upstream,
+        std::string host,
+        int port,
+        std::shared_ptr<settings::HttpPoolSettings> settings
+    ) : upstream_(std::move(upstream))
+      , host_(std::move(host))
+      , port_(std::to_string(port))
+      , poolSize_(static_cast<size_t>(settings->getPoolSize()))
+      , idleTimeout_(settings->getIdleTimeoutMs())
+      , requestTimeout_(settings->getRequestTimeoutMs())
+      , maxInFlight_(static_cast<size_t>(settings->getMaxInFlight()))
+    {
+        std::cout << "[KeepAliveHttpClient] Created " << upstream_ << " -> " << host_ << ":" << port_
+                  << ", pool=" << poolSize_ << " in-flight=" << maxInFlight_
+                  << " timeout=" << requestTimeout_.count() << "ms" << std::endl;
+    }
+
+    KeepAliveHttpClient(const KeepAliveHttpClient&) = delete;
+    KeepAliveHttpClient& operator=(const KeepAliveHttpClient&) = delete;
+
+    /**
+     * @brief Выполнить запрос на соединении из пула
+     *
+     * @throws UpstreamError при таймауте или ошибке транспорта
+     */
+    bool send(const IRequest& req, IResponse& res) override {
+        auto started = Clock::now();
+        auto deadline = started + requestTimeout_;
+        requests_.fetch_add(1, std::memory_order_relaxed);
+
+        InFlightSlot slot(*this, deadline);
+        auto request = buildRequest(req);
+
+        for (int attempt = 0;; ++attempt) {
+            std::unique_ptr<Connection> conn = takeIdle();
+            bool reused = static_cast<bool>(conn);
+            try {
+                if (reused) {
+                    poolHits_.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    conn = std::make_unique<Connection>();
+                    conn->connect(host_, port_, deadline);
+                    handshakes_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                auto response = conn->exchange(request, deadline);
+                recordLatency(Clock::now() - started);
+                res.setResult(static_cast<int>(response.result_int()),
+                              std::string(response[boost::beast::http::field::content_type]),
+                              response.body());
+                giveBack(std::move(conn), response.keep_alive());
+                return true;
+            } catch (const boost::beast::system_error& e) {
+                if (e.code() == boost::beast::error::timeout) {
+                    timeouts_.fetch_add(1, std::memory_order_relaxed);
+                    throw UpstreamError("[KeepAliveHttpClient] " + upstream_ + " timeout after " +
+                                        std::to_string(requestTimeout_.count()) + "ms");
+                }
+                if (reused && attempt == 0 && closedByPeer(e.code())) {
+                    retries_.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                errors_.fetch_add(1, std::memory_order_relaxed);
+                throw UpstreamError("[KeepAliveHttpClient] " + upstream_ + ": " + e.code().message());
+            }
+        }
+    }
+
+    /**
+     * @brief Текущие метрики пула
+     */
+    Stats stats() const {
+        Stats s;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            s.idle = idle_.size();
+            s.inFlight = inFlight_;
+        }
+        s.poolSize = poolSize_;
+        s.requests = requests_.load(std::memory_order_relaxed);
+        s.poolHits = poolHits_.load(std::memory_order_relaxed);
+        s.handshakes = handshakes_.load(std::memory_order_relaxed);
+        s.retries = retries_.load(std::memory_order_relaxed);
+        s.evicted = evicted_.load(std::memory_order_relaxed);
+        s.timeouts = timeouts_.load(std::memory_order_relaxed);
+        s.errors = errors_.load(std::memory_order_relaxed);
+        s.queued = queued_.load(std::memory_order_relaxed);
+
+        uint64_t cumulative = 0;
+        for (size_t b = 0; b < LATENCY_BOUND_COUNT; ++b) {
+            cumulative += latencyBuckets_[b].load(std::memory_order_relaxed);
+            s.latencyCumulative[b] = cumulative;
+        }
+        s.latencyCount = latencyCount_.load(std::memory_order_relaxed);
+        s.latencySecondsTotal = latencyMicrosTotal_.load(std::memory_order_relaxed) / 1e6;
+        return s;
+    }
+
+    const std::string& upstream() const { return upstream_; }
+
+private:
+    static constexpr const char* const USER_AGENT = "trading-service";
+
+    /**
+     * @brief Одно TCP-соединение со своим io_context
+     */
+    class Connection {
+    public:
+        Connection() : stream_(ioc_) {}
+
+        ~Connection() {
+            boost::beast::error_code ec;
+            stream_.socket().shutdown(tcp::socket::shutdown_both, ec);
+            stream_.close();
+        }
+
+        void connect(const std::string& host, const std::string& port, Clock::time_point deadline) {
+            boost::beast::error_code ec;
+            bool resolved = false;
+            tcp::resolver::results_type endpoints;
+            tcp::resolver resolver(ioc_);
+            resolver.async_resolve(host, port,
+                [&](boost::beast::error_code e, tcp::resolver::results_type results) {
+                    ec = e;
+                    endpoints = std::move(results);
+                    resolved = true;
+                });
+            ioc_.restart();
+            ioc_.run_until(deadline);
+            if (!resolved) {
+                resolver.cancel();
+                run();
+                throw boost::beast::system_error(boost::beast::error::timeout);
+            }
+            if (ec) {
+                throw boost::beast::system_error(ec);
+            }
+
+            stream_.expires_at(deadline);
+            stream_.async_connect(endpoints,
+                [&](boost::beast::error_code e, const tcp::endpoint&) { ec = e; });
+            run();
+            if (ec) {
+                throw boost::beast::system_error(ec);
+            }
+            stream_.socket().set_option(tcp::no_delay(true), ec);
+        }
+
+        Response exchange(const Request& request, Clock::time_point deadline) {
+            boost::beast::error_code ec;
+            stream_.expires_at(deadline);
+            boost::beast::http::async_write(stream_, request,
+                [&](boost::beast::error_code e, std::size_t) { ec = e; });
+            run();
+            if (ec) {
+                throw boost::beast::system_error(ec);
+            }
+
+            Response response;
+            boost::beast::http::async_read(stream_, buffer_, response,
+                [&](boost::beast::error_code e, std::size_t) { ec = e; });
+            run();
+            if (ec) {
+                throw boost::beast::system_error(ec);
+            }
+
+            stream_.expires_never();
+            lastUsed_ = Clock::now();
+            return response;
+        }
+
+        Clock::time_point lastUsed() const { return lastUsed_; }
+
+    private:
+        void run() {
+            ioc_.restart();
+            ioc_.run();
+        }
+
+        boost::asio::io_context ioc_{1};
+        boost::beast::tcp_stream stream_;
+        boost::beast::flat_buffer buffer_;
+        Clock::time_point lastUsed_ = Clock::now();
+    };
+
+    /**
+     * @brief RAII-слот in-flight: ждёт освобождения не дольше дедлайна запроса
+     */
+    class InFlightSlot {
+    public:
+        InFlightSlot(KeepAliveHttpClient& client, Clock::time_point deadline) : client_(client) {
+            std::unique_lock<std::mutex> lock(client_.mutex_);
+            if (client_.inFlight_ >= client_.maxInFlight_) {
+                client_.queued_.fetch_add(1, std::memory_order_relaxed);
+                bool ready = client_.slotFreed_.wait_until(lock, deadline, [this] {
+                    return client_.inFlight_ < client_.maxInFlight_;
+                });
+                if (!ready) {
+                    client_.timeouts_.fetch_add(1, std::memory_order_relaxed);
+                    throw UpstreamError("[KeepAliveHttpClient] " + client_.upstream_ +
+                                        ": no free slot (in-flight limit " +
+                                        std::to_string(client_.maxInFlight_) + ")");
+                }
+            }
+            ++client_.inFlight_;
+        }
+
+        ~InFlightSlot() {
+            {
+                std::lock_guard<std::mutex> lock(client_.mutex_);
+                --client_.inFlight_;
+            }
+            client_.slotFreed_.notify_one();
+        }
+
+        InFlightSlot(const InFlightSlot&) = delete;
+        InFlightSlot& operator=(const InFlightSlot&) = delete;
+
+    private:
+        KeepAliveHttpClient& client_;
+    };
+
+    Request buildRequest(const IRequest& req) const {
+        Request request(
+            boost::beast::http::string_to_verb(req.getMethod()), req.getPath(), 11);
+        request.set(boost::beast::http::field::host, host_ + ":" + port_);
+        request.set(boost::beast::http::field::user_agent, USER_AGENT);
+        request.keep_alive(true);
+        for (const char* name : {"Content-Type", "Authorization"}) {
+            if (auto value = req.getHeader(name)) {
+                request.set(name, *value);
+            }
+        }
+        request.body() = req.getBody();
+        request.prepare_payload();
+        return request;
+    }
+
+    /**
+     * @brief Самое свежее простаивающее соединение; устаревшие закрываются
+     */
+    std::unique_ptr<Connection> takeIdle() {
+        std::vector<std::unique_ptr<Connection>> expired;
+        std::unique_ptr<Connection> conn;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto now = Clock::now();
+            while (!idle_.empty() && now - idle_.front()->lastUsed() > idleTimeout_) {
+                expired.push_back(std::move(idle_.front()));
+                idle_.pop_front();
+            }
+            if (!idle_.empty()) {
+                conn = std::move(idle_.back());
+                idle_.pop_back();
+            }
+        }
+        evicted_.fetch_add(expired.size(), std::memory_order_relaxed);
+        return conn;   // expired закрываются здесь, вне блокировки
+    }
+
+    void giveBack(std::unique_ptr<Connection> conn, bool keepAlive) {
+        if (!keepAlive) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (idle_.size() < poolSize_) {
+            idle_.push_back(std::move(conn));
+        }
+    }
+
+    static bool closedByPeer(const boost::beast::error_code& ec) {
+        return ec == boost::beast::http::error::end_of_stream
+            || ec == boost::asio::error::eof
+            || ec == boost::asio::error::connection_reset
+            || ec == boost::asio::error::broken_pipe;
+    }
+
+    void recordLatency(Clock::duration elapsed) {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        size_t bucket = 0;
+        while (bucket < LATENCY_BOUND_COUNT && seconds > LATENCY_BOUNDS_SECONDS[bucket]) {
+            ++bucket;
+        }
+        if (bucket < LATENCY_BOUND_COUNT) {
+            latencyBuckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+        latencyCount_.fetch_add(1, std::memory_order_relaxed);
+        latencyMicrosTotal_.fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+            std::memory_order_relaxed);
+    }
+
+    const std::string upstream_;
+    const std::string host_;
+    const std::string port_;
+    const size_t poolSize_;
+    const std::chrono::milliseconds idleTimeout_;
+    const std::chrono::milliseconds requestTimeout_;
+    const size_t maxInFlight_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable slotFreed_;
+    std::deque<std::unique_ptr<Connection>> idle_;   ///< front - самое старое
+    size_t inFlight_ = 0;
+
+    std::atomic<uint64_t> requests_{0};
+    std::atomic<uint64_t> poolHits_{0};
+    std::atomic<uint64_t> handshakes_{0};
+    std::atomic<uint64_t> retries_{0};
+    std::atomic<uint64_t> evicted_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> errors_{0};
+    std::atomic<uint64_t> queued_{0};
+    std::array<std::atomic<uint64_t>, LATENCY_BOUND_COUNT> latencyBuckets_{};
+    std::atomic<uint64_t> latencyCount_{0};
+    std::atomic<uint64_t> latencyMicrosTotal_{0};
+};
+
+} // namespace trading::adapters::secondary
@@ -0,0 +1,293 @@
+// include/adapters/secondary/PgConnectionPool.hpp
+#pragma once
+
+#include "settings/DbSettings.hpp"
+#include <pqxx/pqxx>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief Ограниченный пул соединений PostgreSQL с prepared statements
+ *
+ * Раньше каждый вызов репозитория открывал новое соединение
+ * (TCP + аутентификация + парсинг SQL). Пул держит до getPoolSize()
+ * соединений, создаёт их лениво и переиспользует.
+ *
+ * Prepared statements:
+ * - репозиторий регистрирует запрос через prepare(name, sql) в конструкторе;
+ * - каждое соединение готовит недостающие запросы при выдаче (один раз);
+ * - вызов: txn.exec_prepared(name, args...).
+ *
+ * Если все соединения заняты, acquire() ждёт не дольше getPoolTimeoutMs()
+ * и бросает PoolTimeoutError.
+ *
+ * @example
+ * ```cpp
+ * pool->prepare("idempotency_find", "SELECT ... WHERE key = $1");
+ *
+ * auto conn = pool->acquire();
+ * pqxx::work txn(*conn);
+ * auto result = txn.exec_prepared("idempotency_find", key);
+ * ```
+ *
+ * Thread-safe: да
+ */
+class PgConnectionPool {
+public:
+    /**
+     * @brief Пул исчерпан и соединение не освободилось за таймаут
+     */
+    class PoolTimeoutError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * @brief Снимок метрик пула (для /metrics)
+     */
+    struct Stats {
+        size_t maxSize = 0;             ///< Максимальный размер пула
+        size_t open = 0;                ///< Открытых соединений
+        size_t idle = 0;                ///< Свободных соединений
+        size_t inUse = 0;               ///< Выданных соединений
+        size_t waiting = 0;             ///< Потоков в ожидании соединения
+        uint64_t checkouts = 0;         ///< Всего выдач
+        uint64_t waits = 0;             ///< Выдач, которым пришлось ждать
+        uint64_t timeouts = 0;          ///< Отказов по таймауту
+        uint64_t created = 0;           ///< Создано соединений
+        uint64_t discarded = 0;         ///< Выброшено битых соединений
+        uint64_t waitMicrosTotal = 0;   ///< Суммарное время ожидания (мкс)
+        uint64_t checkoutMicrosTotal = 0; ///< Суммарное время удержания (мкс)
+    };
+
+private:
+    struct PooledConnection {
+        std::unique_ptr<pqxx::connection> conn;
+        size_t preparedCount = 0;   ///< Сколько запросов каталога уже подготовлено
+    };
+
+public:
+    /**
+     * @brief RAII-аренда соединения: возвращает его в пул в деструкторе
+     */
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept
+            : pool_(std::exchange(other.pool_, nullptr))
+            , item_(std::move(other.item_))
+            , acquiredAt_(other.acquiredAt_)
+        {}
+
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        ~Lease() {
+            if (pool_) {
+                pool_->release(std::move(item_), acquiredAt_);
+            }
+        }
+
+        pqxx::connection& operator*() { return *item_.conn; }
+        pqxx::connection* operator->() { return item_.conn.get(); }
+
+    private:
+        friend class PgConnectionPool;
+
+        Lease(PgConnectionPool* pool, PooledConnection item)
+            : pool_(pool)
+            , item_(std::move(item))
+            , acquiredAt_(std::chrono::steady_clock::now())
+        {}
+
+        PgConnectionPool* pool_;
+        PooledConnection item_;
+        std::chrono::steady_clock::time_point acquiredAt_;
+    };
+
+    explicit PgConnectionPool(std::shared_ptr<settings::DbSettings> settings)
+        : settings_(std::move(settings))
+        , maxSize_(std::max(1, settings_->getPoolSize()))
+        , timeout_(std::chrono::milliseconds(settings_->getPoolTimeoutMs()))
+    {
+        std::cout << "[PgConnectionPool] Created, size=" << maxSize_
+                  << " timeout=" << timeout_.count() << "ms" << std::endl;
+    }
+
+    PgConnectionPool(const PgConnectionPool&) = delete;
+    PgConnectionPool& operator=(const PgConnectionPool&) = delete;
+
+    /**
+     * @brief Зарегистрировать prepared statement
+     *
+     * Запрос готовится на каждом соединении пула при его следующей выдаче.
+     * Повторная регистрация того же имени игнорируется.
+     */
+    void prepare(const std::string& name, const std::string& sql) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [existing, _] : statements_) {
+            if (existing == name) {
+                return;
+            }
+        }
+        statements_.emplace_back(name, sql);
+    }
+
+    /**
+     * @brief Взять соединение из пула
+     *
+     * @throws PoolTimeoutError если соединение не освободилось за таймаут
+     * @throws pqxx::broken_connection если не удалось открыть новое соединение
+     */
+    Lease acquire() {
+        auto started = std::chrono::steady_clock::now();
+        PooledConnection item;
+        bool needCreate = false;
+        bool waited = false;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            if (idle_.empty() && open_ >= maxSize_) {
+                waited = true;
+                waits_.fetch_add(1, std::memory_order_relaxed);
+                ++waiting_;
+                bool ready = cv_.wait_for(lock, timeout_, [this] {
+                    return !idle_.empty() || open_ < maxSize_;
+                });
+                --waiting_;
+                if (!ready) {
+                    timeouts_.fetch_add(1, std::memory_order_relaxed);
+                    throw PoolTimeoutError("[PgConnectionPool] acquire timeout after " +
+                                           std::to_string(timeout_.count()) + "ms");
+                }
+            }
+
+            if (!idle_.empty()) {
+                item = std::move(idle_.back());
+                idle_.pop_back();
+            } else {
+                // Резервируем слот до фактического открытия соединения
+                ++open_;
+                needCreate = true;
+            }
+        }
+
+        if (needCreate) {
+            try {
+                item.conn = std::make_unique<pqxx::connection>(settings_->getConnectionString());
+                created_.fetch_add(1, std::memory_order_relaxed);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --open_;
+                cv_.notify_one();
+                throw;
+            }
+        }
+
+        if (waited) {
+            auto waitedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - started).count();
+            waitMicrosTotal_.fetch_add(static_cast<uint64_t>(waitedUs), std::memory_order_relaxed);
+        }
+        checkouts_.fetch_add(1, std::memory_order_relaxed);
+
+        Lease lease(this, std::move(item));
+        prepareMissing(lease.item_);
+        return lease;
+    }
+
+    /**
+     * @brief Текущие метрики пула
+     */
+    Stats stats() const {
+        Stats s;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            s.open = open_;
+            s.idle = idle_.size();
+            s.waiting = waiting_;
+        }
+        s.maxSize = maxSize_;
+        s.inUse = s.open - s.idle;
+        s.checkouts = checkouts_.load(std::memory_order_relaxed);
+        s.waits = waits_.load(std::memory_order_relaxed);
+        s.timeouts = timeouts_.load(std::memory_order_relaxed);
+        s.created = created_.load(std::memory_order_relaxed);
+        s.discarded = discarded_.load(std::memory_order_relaxed);
+        s.waitMicrosTotal = waitMicrosTotal_.load(std::memory_order_relaxed);
+        s.checkoutMicrosTotal = checkoutMicrosTotal_.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    std::shared_ptr<settings::DbSettings> settings_;
+    const size_t maxSize_;
+    const std::chrono::milliseconds timeout_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<PooledConnection> idle_;
+    std::vector<std::pair<std::string, std::string>> statements_;
+    size_t open_ = 0;
+    size_t waiting_ = 0;
+
+    std::atomic<uint64_t> checkouts_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> timeouts_{0};
+    std::atomic<uint64_t> created_{0};
+    std::atomic<uint64_t> discarded_{0};
+    std::atomic<uint64_t> waitMicrosTotal_{0};
+    std::atomic<uint64_t> checkoutMicrosTotal_{0};
+
+    /**
+     * @brief Подготовить на соединении запросы, зарегистрированные после его прошлой выдачи
+     */
+    void prepareMissing(PooledConnection& item) {
+        std::vector<std::pair<std::string, std::string>> pending;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (item.preparedCount >= statements_.size()) {
+                return;
+            }
+            pending.assign(statements_.begin() + item.preparedCount, statements_.end());
+        }
+        for (const auto& [name, sql] : pending) {
+            item.conn->prepare(name, sql);
+            ++item.preparedCount;
+        }
+    }
+
+    void release(PooledConnection item, std::chrono::steady_clock::time_point acquiredAt) {
+        auto heldUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - acquiredAt).count();
+        checkoutMicrosTotal_.fetch_add(static_cast<uint64_t>(heldUs), std::memory_order_relaxed);
+
+        bool healthy = item.conn && item.conn->is_open();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (healthy) {
+                idle_.push_back(std::move(item));
+            } else {
+                // Битое соединение не возвращаем: слот освобождается под новое
+                --open_;
+                discarded_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        cv_.notify_one();
+    }
+};
+
+} // namespace trading::adapters::secondary
@@ -1,30 +1,71 @@
 #pragma once
 
 #include "ports/output/IIdempotencyRepository.hpp"
-#include "settings/DbSettings.hpp"
+#include "adapters/secondary/PgConnectionPool.hpp"
+#include "settings/IdempotencySettings.hpp"
 #include <pqxx/pqxx>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <iostream>
 
 namespace trading::adapters::secondary
 {
 
+    /**
+     * @brief Ключи идемпотентности в PostgreSQL (таблица idempotency_keys)
+     *
+     * Соединения - из PgConnectionPool, запросы - prepared statements.
+     * Ключ действует IDEMPOTENCY_KEY_TTL_SECONDS от created_at: истёкший
+     * не находится и может быть занят заново. Фоновый поток раз в
+     * IDEMPOTENCY_PURGE_INTERVAL_SECONDS удаляет истёкшие строки пачками
+     * по IDEMPOTENCY_PURGE_BATCH, чтобы не держать долгую блокировку.
+     */
     class PostgresIdempotencyRepository : public trading::ports::output::IIdempotencyRepository
     {
     public:
-        explicit PostgresIdempotencyRepository(std::shared_ptr<trading::settings::DbSettings> s) : settings_(std::move(s))
+        PostgresIdempotencyRepository(std::shared_ptr<PgConnectionPool> pool,
+                                      std::shared_ptr<trading::settings::IdempotencySettings> settings)
+            : pool_(std::move(pool)), settings_(std::move(settings))
         {
+            pool_->prepare("idempotency_find",
+                           "SELECT key, response_status, response_body FROM idempotency_keys "
+                           "WHERE key=$1 AND created_at > NOW() - make_interval(secs => $2)");
+            pool_->prepare("idempotency_save",
+                           "INSERT INTO idempotency_keys (key, response_status, response_body) VALUES ($1, $2, $3) "
+                           "ON CONFLICT (key) DO UPDATE SET response_status = EXCLUDED.response_status, "
+                           "response_body = EXCLUDED.response_body, created_at = NOW() "
+                           "WHERE idempotency_keys.created_at <= NOW() - make_interval(secs => $4)");
+            pool_->prepare("idempotency_purge",
+                           "DELETE FROM idempotency_keys WHERE key IN ("
+                           "SELECT key FROM idempotency_keys "
+                           "WHERE created_at <= NOW() - make_interval(secs => $1) LIMIT $2)");
+
             // Проверяем соединение, но не создаём таблицу
-            pqxx::connection c(settings_->getConnectionString());
-            std::cout << "[IdempotencyRepo] Connected to " << settings_->getName() << std::endl;
+            pool_->acquire();
+            std::cout << "[IdempotencyRepo] Connected, key ttl=" << settings_->getKeyTtlSeconds() << "s" << std::endl;
+
+            purgeThread_ = std::thread([this] { purgeLoop(); });
+        }
+
+        ~PostgresIdempotencyRepository() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(purgeMutex_);
+                stopped_ = true;
+            }
+            purgeCv_.notify_all();
+            if (purgeThread_.joinable())
+                purgeThread_.join();
         }
 
         std::optional<trading::domain::IdempotencyRecord> find(const std::string &key) override
         {
-            pqxx::connection c(settings_->getConnectionString());
-            pqxx::work t(c);
-            auto r = t.exec_params(
-                "SELECT key, response_status, response_body FROM idempotency_keys WHERE key=$1", key);
+            auto conn = pool_->acquire();
+            pqxx::work t(*conn);
+            auto r = t.exec_prepared("idempotency_find", key, settings_->getKeyTtlSeconds());
             if (r.empty())
                 return std::nullopt;
             return trading::domain::IdempotencyRecord{
@@ -35,18 +76,61 @@ namespace trading::adapters::secondary
 
         void save(const std::string &key, int status, const std::string &body) override
         {
-            pqxx::connection c(settings_->getConnectionString());
-            pqxx::work t(c);
-            t.exec_params(
-                "INSERT INTO idempotency_keys (key, response_status, response_body) VALUES ($1, $2, $3) "
-                "ON CONFLICT (key) DO NOTHING",
-                key, status, body);
+            auto conn = pool_->acquire();
+            pqxx::work t(*conn);
+            t.exec_prepared("idempotency_save", key, status, body, settings_->getKeyTtlSeconds());
             t.commit();
             std::cout << "[IdempotencyRepo] Saved key: " << key << std::endl;
         }
 
+        /**
+         * @brief Удалить истёкшие ключи
+         * @return сколько строк удалено
+         */
+        size_t purgeExpired()
+        {
+            size_t total = 0;
+            const int batch = settings_->getPurgeBatch();
+            while (true)
+            {
+                auto conn = pool_->acquire();
+                pqxx::work t(*conn);
+                auto r = t.exec_prepared("idempotency_purge", settings_->getKeyTtlSeconds(), batch);
+                t.commit();
+                total += static_cast<size_t>(r.affected_rows());
+                if (r.affected_rows() < batch)
+                    return total;
+            }
+        }
+
     private:
-        std::shared_ptr<trading::settings::DbSettings> settings_;
+        std::shared_ptr<PgConnectionPool> pool_;
+        std::shared_ptr<trading::settings::IdempotencySettings> settings_;
+
+        std::mutex purgeMutex_;
+        std::condition_variable purgeCv_;
+        bool stopped_ = false;
+        std::thread purgeThread_;
+
+        void purgeLoop()
+        {
+            const auto interval = std::chrono::seconds(settings_->getPurgeIntervalSeconds());
+            std::unique_lock<std::mutex> lock(purgeMutex_);
+            while (!purgeCv_.wait_for(lock, interval, [this] { return stopped_; }))
+            {
+                lock.unlock();
+                try
+                {
+                    if (size_t removed = purgeExpired())
+                        std::cout << "[IdempotencyRepo] Purged " << removed << " expired keys" << std::endl;
+                }
+                catch (const std::exception &e)
+                {
+                    std::cerr << "[IdempotencyRepo] Purge error: " << e.what() << std::endl;
+                }
+                lock.lock();
+            }
+        }
     };
 
 } // namespace trading::adapters::secondary
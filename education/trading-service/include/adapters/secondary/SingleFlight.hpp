@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief Склейка одновременных запросов по одному ключу
+ *
+ * Первый вызов по ключу становится ведущим и идёт в upstream, остальные
+ * ждут его результата (или его исключения). После завершения ключ
+ * освобождается: следующий промах снова пойдёт в upstream, поэтому
+ * ведущий должен положить ответ в кэш до complete().
+ *
+ * run() - для одиночного запроса; join()/complete()/fail() - когда один
+ * upstream-запрос отвечает сразу за несколько ключей (батч котировок).
+ */
+template<typename Key, typename Value>
+class SingleFlight {
+public:
+    /**
+     * @brief Присоединиться к запросу в полёте
+     * @return future ведущего; nullopt - ведущим стал вызывающий и обязан
+     *         вызвать complete() или fail() по этому ключу
+     */
+    std::optional<std::shared_future<Value>> join(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+            return it->second.future;
+        }
+        auto promise = std::make_shared<std::promise<Value>>();
+        calls_.emplace(key, Call{promise, promise->get_future().share()});
+        return std::nullopt;
+    }
+
+    void complete(const Key& key, Value value) {
+        if (auto promise = take(key)) {
+            promise->set_value(std::move(value));
+        }
+    }
+
+    void fail(const Key& key, std::exception_ptr error) {
+        if (auto promise = take(key)) {
+            promise->set_exception(std::move(error));
+        }
+    }
+
+    /**
+     * @brief Выполнить fn, если по ключу никто не ходит, иначе дождаться ведущего
+     */
+    template<typename Fn>
+    Value run(const Key& key, Fn&& fn) {
+        if (auto pending = join(key)) {
+            return pending->get();
+        }
+        try {
+            Value value = fn();
+            complete(key, value);
+            return value;
+        } catch (...) {
+            fail(key, std::current_exception());
+            throw;
+        }
+    }
+
+    /// Вызовов, дождавшихся чужого запроса вместо своего
+    uint64_t coalesced() const {
+        return coalesced_.load(std::memory_order_relaxed);
+    }
+
+    size_t inFlight() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
+
+private:
+    struct Call {
+        std::shared_ptr<std::promise<Value>> promise;
+        std::shared_future<Value> future;
+    };
+
+    std::shared_ptr<std::promise<Value>> take(const Key& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it == calls_.end()) {
+            return nullptr;
+        }
+        auto promise = std::move(it->second.promise);
+        calls_.erase(it);
+        return promise;
+    }
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Call> calls_;
+    std::atomic<uint64_t> coalesced_{0};
+};
+
+} // namespace trading::adapters::secondary
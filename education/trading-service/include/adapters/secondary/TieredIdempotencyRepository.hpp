@@ -0,0 +1,247 @@
+#pragma once
+
+#include "ports/output/IIdempotencyRepository.hpp"
+#include "settings/IdempotencySettings.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <iostream>
+
+namespace trading::adapters::secondary {
+
+/**
+ * @brief Двухуровневое хранилище ключей идемпотентности
+ *
+ * Первый уровень - LRU в памяти процесса (SHARDS сегментов со своим
+ * мьютексом, записи живут IDEMPOTENCY_KEY_TTL_SECONDS). Второй - delegate
+ * (PostgresIdempotencyRepository), общий для всех реплик trading-service.
+ *
+ * Параллельные дубли: claim() занимает ключ на IDEMPOTENCY_INFLIGHT_TIMEOUT_MS.
+ * Повтор с тем же ключом ждёт, пока первый запрос сохранит ответ (save)
+ * или отпустит ключ (release), и не публикует order.create второй раз.
+ * Если первый запрос оборвался, не дойдя до IdempotencyCacheWriter,
+ * по истечении срока ключ забирает ожидающий.
+ *
+ * Ожидание действует в пределах процесса; между репликами защищает только БД.
+ */
+class TieredIdempotencyRepository : public ports::output::IIdempotencyRepository {
+public:
+    static constexpr size_t SHARDS = 16;
+
+    struct Stats {
+        uint64_t hits = 0;          ///< ответ из памяти
+        uint64_t backendHits = 0;   ///< ответ из delegate
+        uint64_t misses = 0;        ///< ключ занят под новый запрос
+        uint64_t waits = 0;         ///< повторов, ждавших первый запрос
+        uint64_t takeovers = 0;     ///< ключей, забранных после истечения срока
+        uint64_t evictions = 0;
+        size_t entries = 0;
+        size_t inFlight = 0;
+    };
+
+    TieredIdempotencyRepository(
+        std::shared_ptr<ports::output::IIdempotencyRepository> delegate,
+        std::shared_ptr<settings::IdempotencySettings> settings
+    ) : delegate_(std::move(delegate))
+      , shardCapacity_((static_cast<size_t>(settings->getCacheSize()) + SHARDS - 1) / SHARDS)
+      , keyTtl_(std::chrono::seconds(settings->getKeyTtlSeconds()))
+      , inFlightTimeout_(std::chrono::milliseconds(settings->getInFlightTimeoutMs()))
+    {
+        std::cout << "[TieredIdempotencyRepository] Created, capacity=" << shardCapacity_ * SHARDS
+                  << " inFlightTimeout=" << settings->getInFlightTimeoutMs() << "ms" << std::endl;
+    }
+
+    std::optional<domain::IdempotencyRecord> find(const std::string& key) override {
+        Shard& shard = shardOf(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (auto record = lookup(shard, key, Clock::now())) {
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                return record;
+            }
+        }
+        auto record = delegate_->find(key);
+        if (record) {
+            backendHits_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            remember(shard, *record, Clock::now());
+        }
+        return record;
+    }
+
+    std::optional<domain::IdempotencyRecord> claim(const std::string& key) override {
+        Shard& shard = shardOf(key);
+        {
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            bool waited = false;
+            while (true) {
+                auto now = Clock::now();
+                if (auto record = lookup(shard, key, now)) {
+                    hits_.fetch_add(1, std::memory_order_relaxed);
+                    return record;
+                }
+
+                auto it = shard.inFlight.find(key);
+                if (it == shard.inFlight.end()) {
+                    break;
+                }
+                if (it->second <= now) {
+                    takeovers_.fetch_add(1, std::memory_order_relaxed);
+                    std::cerr << "[TieredIdempotencyRepository] Taking over abandoned key: " << key << std::endl;
+                    break;
+                }
+                if (!waited) {
+                    waited = true;
+                    waits_.fetch_add(1, std::memory_order_relaxed);
+                }
+                auto deadline = it->second;   // запись может исчезнуть, пока ждём
+                shard.cv.wait_until(lock, deadline);
+            }
+            shard.inFlight[key] = Clock::now() + inFlightTimeout_;
+        }
+
+        // Ключ наш: в памяти ответа нет, спрашиваем общий уровень
+        std::optional<domain::IdempotencyRecord> record;
+        try {
+            record = delegate_->find(key);
+        } catch (...) {
+            release(key);
+            throw;
+        }
+
+        if (record) {
+            backendHits_.fetch_add(1, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            remember(shard, *record, Clock::now());
+            shard.inFlight.erase(key);
+            shard.cv.notify_all();
+            return record;
+        }
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    void save(const std::string& key, int status, const std::string& body) override {
+        // Ответ уже отправлен клиенту: даже если БД недоступна, повтор
+        // в этом процессе должен получить его, а не исполниться заново
+        Shard& shard = shardOf(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            remember(shard, domain::IdempotencyRecord{key, status, body}, Clock::now());
+            shard.inFlight.erase(key);
+        }
+        shard.cv.notify_all();
+
+        try {
+            delegate_->save(key, status, body);
+        } catch (const std::exception& e) {
+            std::cerr << "[TieredIdempotencyRepository] Backend save error for " << key
+                      << ": " << e.what() << std::endl;
+        }
+    }
+
+    void release(const std::string& key) override {
+        Shard& shard = shardOf(key);
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.inFlight.erase(key);
+        }
+        shard.cv.notify_all();
+    }
+
+    Stats stats() const {
+        Stats s;
+        s.hits = hits_.load(std::memory_order_relaxed);
+        s.backendHits = backendHits_.load(std::memory_order_relaxed);
+        s.misses = misses_.load(std::memory_order_relaxed);
+        s.waits = waits_.load(std::memory_order_relaxed);
+        s.takeovers = takeovers_.load(std::memory_order_relaxed);
+        s.evictions = evictions_.load(std::memory_order_relaxed);
+        for (const auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            s.entries += shard.index.size();
+            s.inFlight += shard.inFlight.size();
+        }
+        return s;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        domain::IdempotencyRecord record;
+        Clock::time_point expiresAt;
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        std::list<Entry> lru;   ///< голова - самая свежая запись
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::unordered_map<std::string, Clock::time_point> inFlight;   ///< ключ -> срок захвата
+    };
+
+    /// Под мьютексом сегмента
+    std::optional<domain::IdempotencyRecord> lookup(Shard& shard, const std::string& key, Clock::time_point now) {
+        auto it = shard.index.find(key);
+        if (it == shard.index.end()) {
+            return std::nullopt;
+        }
+        if (it->second->expiresAt <= now) {
+            shard.lru.erase(it->second);
+            shard.index.erase(it);
+            return std::nullopt;
+        }
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+        return it->second->record;
+    }
+
+    /// Под мьютексом сегмента
+    void remember(Shard& shard, const domain::IdempotencyRecord& record, Clock::time_point now) {
+        if (shardCapacity_ == 0) {
+            return;
+        }
+        auto it = shard.index.find(record.key);
+        if (it != shard.index.end()) {
+            it->second->record = record;
+            it->second->expiresAt = now + keyTtl_;
+            shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+            return;
+        }
+        if (shard.index.size() >= shardCapacity_) {
+            shard.index.erase(shard.lru.back().record.key);
+            shard.lru.pop_back();
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+        shard.lru.push_front(Entry{record, now + keyTtl_});
+        shard.index[record.key] = shard.lru.begin();
+    }
+
+    Shard& shardOf(const std::string& key) {
+        return shards_[std::hash<std::string>{}(key) % SHARDS];
+    }
+
+    std::shared_ptr<ports::output::IIdempotencyRepository> delegate_;
+    const size_t shardCapacity_;
+    const Clock::duration keyTtl_;
+    const Clock::duration inFlightTimeout_;
+
+    std::array<Shard, SHARDS> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> backendHits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> waits_{0};
+    std::atomic<uint64_t> takeovers_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
+
+} // namespace trading::adapters::secondary
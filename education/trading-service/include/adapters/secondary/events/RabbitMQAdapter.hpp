@@ -72,6 +72,15 @@ public:
     
     void subscribe(const std::vector<std::string>& routingKeys, 
                    ports::input::EventHandler handler) override {
+        subscribeTyped(routingKeys, [handler = std::move(handler)](const std::string& routingKey,
+                                                                   const std::string& message,
+                                                                   const std::string&) {
+            handler(routingKey, message);
+        });
+    }
+
+    void subscribeTyped(const std::vector<std::string>& routingKeys,
+                        ports::input::TypedEventHandler handler) override {
         std::lock_guard<std::mutex> lock(handlersMutex_);
         
         for (const auto& key : routingKeys) {
@@ -202,6 +211,7 @@ private:
             .onReceived([this](const AMQP::Message& msg, uint64_t tag, bool) {
                 std::string routingKey = msg.routingkey();
                 std::string body(msg.body(), msg.bodySize());
+                std::string contentType = msg.hasContentType() ? msg.contentType() : "";
                 
                 std::cout << "[RabbitMQAdapter] Received " << routingKey 
                           << " (" << body.size() << " bytes)" << std::endl;
@@ -212,7 +222,7 @@ private:
                 if (it != handlers_.end()) {
                     for (const auto& handler : it->second) {
                         try {
-                            handler(routingKey, body);
+                            handler(routingKey, body, contentType);
                         } catch (const std::exception& e) {
                             std::cerr << "[RabbitMQAdapter] Handler error: " << e.what() << std::endl;
                         }
@@ -246,7 +256,7 @@ private:
     std::thread workerThread_;
     
     std::mutex handlersMutex_;
-    std::unordered_map<std::string, std::vector<ports::input::EventHandler>> handlers_;
+    std::unordered_map<std::string, std::vector<ports::input::TypedEventHandler>> handlers_;
     std::vector<std::string> pendingBindings_;
 };
 
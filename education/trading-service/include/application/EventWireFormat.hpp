@@ -0,0 +1,347 @@
+// include/application/EventWireFormat.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trading::application::wire {
+
+/**
+ * @brief Бинарный формат событий quote.updated и order.* (версия 1)
+ *
+ * Формат согласуется через AMQP content-type: JSON-сообщения идут
+ * с CONTENT_TYPE_JSON (или без content-type у старых издателей),
+ * бинарные - с CONTENT_TYPE_BINARY. Издатель включает бинарный формат
+ * настройкой RABBITMQ_WIRE_FORMAT=binary, потребители принимают оба.
+ *
+ * Раскладка (все числа little-endian):
+ * ```
+ * header  : u8 magic 'T' | u8 version | u8 kind | u8 reserved
+ * QUOTE   : i64 timestamp_ms | f64 bid | f64 ask | f64 last
+ *           | str8 figi | str8 currency
+ * QUOTE_BATCH : u64 seq | u8 flags (bit0 - snapshot) | u16 count
+ *           | count x (тело QUOTE без заголовка)
+ * ORDER   : i64 timestamp_ms | i64 lots | f64 price | u8 status
+ *           | str16 order_id | str16 account_id | str8 figi
+ *           | str8 currency | str16 reason
+ * str8/16 : длина u8/u16, затем байты без терминатора
+ * ```
+ *
+ * Декодер не копирует строки: QuoteFrame/OrderFrame держат string_view
+ * на исходный буфер, буфер должен жить дольше фрейма.
+ *
+ * Та же схема продублирована в broker-service
+ * (include/application/events/EventWireFormat.hpp) - менять синхронно,
+ * несовместимые изменения - только через новый version.
+ */
+
+constexpr const char* CONTENT_TYPE_JSON = "application/json";
+constexpr const char* CONTENT_TYPE_BINARY = "application/vnd.trading.event.v1";
+
+constexpr uint8_t MAGIC = 'T';
+constexpr uint8_t VERSION = 1;
+
+enum class Kind : uint8_t {
+    QUOTE = 1,
+    ORDER = 2,
+    QUOTE_BATCH = 3
+};
+
+enum class OrderStatus : uint8_t {
+    PENDING = 1,
+    FILLED = 2,
+    PARTIALLY_FILLED = 3,
+    REJECTED = 4,
+    CANCELLED = 5
+};
+
+inline const char* toString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::PENDING:          return "PENDING";
+        case OrderStatus::FILLED:           return "FILLED";
+        case OrderStatus::PARTIALLY_FILLED: return "PARTIALLY_FILLED";
+        case OrderStatus::REJECTED:         return "REJECTED";
+        case OrderStatus::CANCELLED:        return "CANCELLED";
+    }
+    return "UNKNOWN";
+}
+
+inline bool isBinary(std::string_view contentType) {
+    return contentType == CONTENT_TYPE_BINARY;
+}
+
+/**
+ * @brief quote.updated
+ */
+struct QuoteFrame {
+    std::string_view figi;
+    double bid = 0.0;
+    double ask = 0.0;
+    double last = 0.0;
+    std::string_view currency;
+    int64_t timestampMs = 0;
+};
+
+/**
+ * @brief order.created / filled / partially_filled / rejected / cancelled
+ */
+struct OrderFrame {
+    std::string_view orderId;
+    std::string_view accountId;
+    std::string_view figi;
+    OrderStatus status = OrderStatus::PENDING;
+    int64_t lots = 0;
+    double price = 0.0;
+    std::string_view currency;
+    std::string_view reason;
+    int64_t timestampMs = 0;
+};
+
+/**
+ * @brief quote.batch / quote.snapshot - последние котировки пачкой
+ *
+ * seq растёт на 1 с каждым фреймом потока; snapshot=true - полный
+ * срез всех инструментов (после него дельты продолжают нумерацию).
+ */
+struct QuoteBatchFrame {
+    uint64_t seq = 0;
+    bool snapshot = false;
+    std::vector<QuoteFrame> quotes;
+};
+
+constexpr size_t MAX_BATCH_QUOTES = 0xFFFF;
+
+namespace detail {
+
+inline void putU64(std::string& out, uint64_t v) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = static_cast<char>((v >> (8 * i)) & 0xFF);
+    }
+    out.append(bytes, 8);
+}
+
+inline void putI64(std::string& out, int64_t v) {
+    putU64(out, static_cast<uint64_t>(v));
+}
+
+inline void putF64(std::string& out, double v) {
+    uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    putU64(out, bits);
+}
+
+inline void putStr8(std::string& out, std::string_view s) {
+    size_t n = s.size() > 0xFF ? 0xFF : s.size();
+    out.push_back(static_cast<char>(n));
+    out.append(s.data(), n);
+}
+
+inline void putStr16(std::string& out, std::string_view s) {
+    size_t n = s.size() > 0xFFFF ? 0xFFFF : s.size();
+    out.push_back(static_cast<char>(n & 0xFF));
+    out.push_back(static_cast<char>((n >> 8) & 0xFF));
+    out.append(s.data(), n);
+}
+
+inline void putU16(std::string& out, uint16_t v) {
+    out.push_back(static_cast<char>(v & 0xFF));
+    out.push_back(static_cast<char>((v >> 8) & 0xFF));
+}
+
+inline void putHeader(std::string& out, Kind kind) {
+    out.push_back(static_cast<char>(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    out.push_back(static_cast<char>(kind));
+    out.push_back(0);
+}
+
+/**
+ * @brief Последовательное чтение с проверкой границ
+ */
+class Reader {
+public:
+    explicit Reader(std::string_view data) : data_(data) {}
+
+    bool u8(uint8_t& v) {
+        if (pos_ + 1 > data_.size()) return false;
+        v = static_cast<uint8_t>(data_[pos_++]);
+        return true;
+    }
+
+    bool u64(uint64_t& v) {
+        if (pos_ + 8 > data_.size()) return false;
+        v = 0;
+        for (int i = 0; i < 8; ++i) {
+            v |= static_cast<uint64_t>(static_cast<uint8_t>(data_[pos_ + i])) << (8 * i);
+        }
+        pos_ += 8;
+        return true;
+    }
+
+    bool i64(int64_t& v) {
+        uint64_t u;
+        if (!u64(u)) return false;
+        v = static_cast<int64_t>(u);
+        return true;
+    }
+
+    bool f64(double& v) {
+        uint64_t bits;
+        if (!u64(bits)) return false;
+        std::memcpy(&v, &bits, sizeof(v));
+        return true;
+    }
+
+    bool str8(std::string_view& s) {
+        uint8_t n;
+        return u8(n) && take(n, s);
+    }
+
+    bool str16(std::string_view& s) {
+        uint8_t lo, hi;
+        return u8(lo) && u8(hi) && take(static_cast<size_t>(lo) | (static_cast<size_t>(hi) << 8), s);
+    }
+
+    size_t remaining() const {
+        return data_.size() - pos_;
+    }
+
+    bool header(Kind expected) {
+        uint8_t magic, version, kind, reserved;
+        return u8(magic) && u8(version) && u8(kind) && u8(reserved)
+            && magic == MAGIC && version == VERSION && kind == static_cast<uint8_t>(expected);
+    }
+
+private:
+    bool take(size_t n, std::string_view& s) {
+        if (pos_ + n > data_.size()) return false;
+        s = data_.substr(pos_, n);
+        pos_ += n;
+        return true;
+    }
+
+    std::string_view data_;
+    size_t pos_ = 0;
+};
+
+/// i64 + 3 x f64 + два пустых str8
+constexpr size_t QUOTE_BODY_MIN_SIZE = 8 + 3 * 8 + 2;
+
+inline void putQuoteBody(std::string& out, const QuoteFrame& q) {
+    putI64(out, q.timestampMs);
+    putF64(out, q.bid);
+    putF64(out, q.ask);
+    putF64(out, q.last);
+    putStr8(out, q.figi);
+    putStr8(out, q.currency);
+}
+
+inline bool readQuoteBody(Reader& r, QuoteFrame& q) {
+    return r.i64(q.timestampMs) && r.f64(q.bid) && r.f64(q.ask) && r.f64(q.last)
+        && r.str8(q.figi) && r.str8(q.currency);
+}
+
+} // namespace detail
+
+// ============================================================================
+// ENCODE
+// ============================================================================
+
+inline std::string encode(const QuoteFrame& q) {
+    std::string out;
+    out.reserve(4 + 32 + 2 + q.figi.size() + q.currency.size());
+    detail::putHeader(out, Kind::QUOTE);
+    detail::putQuoteBody(out, q);
+    return out;
+}
+
+/**
+ * @brief Пачка котировок; больше MAX_BATCH_QUOTES не кодируется
+ */
+inline std::string encode(const QuoteBatchFrame& b) {
+    size_t count = b.quotes.size() > MAX_BATCH_QUOTES ? MAX_BATCH_QUOTES : b.quotes.size();
+    std::string out;
+    out.reserve(4 + 11 + count * 48);
+    detail::putHeader(out, Kind::QUOTE_BATCH);
+    detail::putU64(out, b.seq);
+    out.push_back(static_cast<char>(b.snapshot ? 1 : 0));
+    detail::putU16(out, static_cast<uint16_t>(count));
+    for (size_t i = 0; i < count; ++i) {
+        detail::putQuoteBody(out, b.quotes[i]);
+    }
+    return out;
+}
+
+inline std::string encode(const OrderFrame& o) {
+    std::string out;
+    out.reserve(4 + 25 + 8 + o.orderId.size() + o.accountId.size() + o.figi.size()
+                + o.currency.size() + o.reason.size());
+    detail::putHeader(out, Kind::ORDER);
+    detail::putI64(out, o.timestampMs);
+    detail::putI64(out, o.lots);
+    detail::putF64(out, o.price);
+    out.push_back(static_cast<char>(o.status));
+    detail::putStr16(out, o.orderId);
+    detail::putStr16(out, o.accountId);
+    detail::putStr8(out, o.figi);
+    detail::putStr8(out, o.currency);
+    detail::putStr16(out, o.reason);
+    return out;
+}
+
+// ============================================================================
+// DECODE (zero-copy)
+// ============================================================================
+
+inline std::optional<QuoteFrame> decodeQuote(std::string_view data) {
+    detail::Reader r(data);
+    QuoteFrame q;
+    if (r.header(Kind::QUOTE) && detail::readQuoteBody(r, q)) {
+        return q;
+    }
+    return std::nullopt;
+}
+
+inline std::optional<QuoteBatchFrame> decodeQuoteBatch(std::string_view data) {
+    detail::Reader r(data);
+    QuoteBatchFrame b;
+    uint8_t flags, lo, hi;
+    if (!(r.header(Kind::QUOTE_BATCH) && r.u64(b.seq) && r.u8(flags) && r.u8(lo) && r.u8(hi))) {
+        return std::nullopt;
+    }
+    b.snapshot = (flags & 1) != 0;
+    size_t count = static_cast<size_t>(lo) | (static_cast<size_t>(hi) << 8);
+    if (count * detail::QUOTE_BODY_MIN_SIZE > r.remaining()) {
+        return std::nullopt;   // count не сходится с длиной - не аллоцируем впустую
+    }
+    b.quotes.resize(count);
+    for (auto& q : b.quotes) {
+        if (!detail::readQuoteBody(r, q)) {
+            return std::nullopt;
+        }
+    }
+    return b;
+}
+
+inline std::optional<OrderFrame> decodeOrder(std::string_view data) {
+    detail::Reader r(data);
+    OrderFrame o;
+    uint8_t status;
+    if (r.header(Kind::ORDER)
+        && r.i64(o.timestampMs) && r.i64(o.lots) && r.f64(o.price) && r.u8(status)
+        && status >= static_cast<uint8_t>(OrderStatus::PENDING)
+        && status <= static_cast<uint8_t>(OrderStatus::CANCELLED)
+        && r.str16(o.orderId) && r.str16(o.accountId) && r.str8(o.figi)
+        && r.str8(o.currency) && r.str16(o.reason)) {
+        o.status = static_cast<OrderStatus>(status);
+        return o;
+    }
+    return std::nullopt;
+}
+
+} // namespace trading::application::wire
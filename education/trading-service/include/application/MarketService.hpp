@@ -2,8 +2,10 @@
 
 #include "ports/input/IMarketService.hpp"
 #include "ports/output/IBrokerGateway.hpp"
+#include "application/QuoteReplica.hpp"
 #include <memory>
 #include <iostream>
+#include <unordered_map>
 
 namespace trading::application {
 
@@ -12,12 +14,19 @@ namespace trading::application {
  * 
  * Получает данные через IBrokerGateway (который может быть
  * обёрнут в CachedBrokerGateway для кэширования).
+ *
+ * Котировки читаются из QuoteReplica, которую наполняют события
+ * broker-service. В broker ходим только при промахе: холодный старт,
+ * инструмент устарел после разрыва потока или ещё не известен его тикер.
+ * Ответ broker записывается обратно в реплику.
  */
 class MarketService : public ports::input::IMarketService {
 public:
-    explicit MarketService(
-        std::shared_ptr<ports::output::IBrokerGateway> broker
+    MarketService(
+        std::shared_ptr<ports::output::IBrokerGateway> broker,
+        std::shared_ptr<QuoteReplica> quoteReplica
     ) : broker_(std::move(broker))
+      , quoteReplica_(std::move(quoteReplica))
     {
         std::cout << "[MarketService] Created" << std::endl;
     }
@@ -26,14 +35,54 @@ public:
      * @brief Получить котировку по FIGI
      */
     std::optional<domain::Quote> getQuote(const std::string& figi) override {
-        return broker_->getQuote(figi);
+        if (auto quote = fromReplica(figi)) {
+            return quote;
+        }
+        auto quote = broker_->getQuote(figi);
+        if (quote) {
+            quoteReplica_->fill(*quote);
+        }
+        return quote;
     }
 
     /**
      * @brief Получить котировки для списка инструментов
      */
     std::vector<domain::Quote> getQuotes(const std::vector<std::string>& figis) override {
-        return broker_->getQuotes(figis);
+        std::vector<std::optional<domain::Quote>> found;
+        found.reserve(figis.size());
+        std::vector<std::string> missing;
+        for (const auto& figi : figis) {
+            found.push_back(fromReplica(figi));
+            if (!found.back()) {
+                missing.push_back(figi);
+            }
+        }
+
+        if (!missing.empty()) {
+            std::unordered_map<std::string, domain::Quote> fetched;
+            for (auto& quote : broker_->getQuotes(missing)) {
+                quoteReplica_->fill(quote);
+                fetched.emplace(quote.figi, std::move(quote));
+            }
+            for (size_t i = 0; i < figis.size(); ++i) {
+                if (!found[i]) {
+                    auto it = fetched.find(figis[i]);
+                    if (it != fetched.end()) {
+                        found[i] = it->second;
+                    }
+                }
+            }
+        }
+
+        std::vector<domain::Quote> result;
+        result.reserve(figis.size());
+        for (auto& quote : found) {
+            if (quote) {
+                result.push_back(std::move(*quote));
+            }
+        }
+        return result;
     }
 
     /**
@@ -58,7 +107,17 @@ public:
     }
 
 private:
+    /// Котировка из реплики; без тикера считается промахом
+    std::optional<domain::Quote> fromReplica(const std::string& figi) const {
+        auto quote = quoteReplica_->get(figi);
+        if (quote && quote->ticker.empty()) {
+            return std::nullopt;
+        }
+        return quote;
+    }
+
     std::shared_ptr<ports::output::IBrokerGateway> broker_;
+    std::shared_ptr<QuoteReplica> quoteReplica_;
 };
 
 } // namespace trading::application
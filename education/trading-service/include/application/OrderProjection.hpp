@@ -0,0 +1,281 @@
+// trading-service/include/application/OrderProjection.hpp
+#pragma once
+
+#include "domain/Order.hpp"
+#include "settings/CacheSettings.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace trading::application {
+
+/**
+ * @brief Ордера, собранные из order.* и собственных POST /api/v1/orders
+ *
+ * Индексы: по id (GET /api/v1/orders/{id} - O(1)) и по аккаунту в порядке
+ * появления, новые первыми (GET /api/v1/orders).
+ *
+ * Источники:
+ * - put(): ордер, отправленный этим процессом (OrderService), или ответ
+ *   broker-service по HTTP - все поля ордера;
+ * - apply(): order.* - только статус и исполнение. Событие по ордеру,
+ *   которого ещё нет (создан другой репликой), заводит неполную запись:
+ *   она не отдаётся, пока её не дополнит HTTP.
+ *
+ * Статус не откатывается: PENDING < PARTIALLY_FILLED < FILLED / CANCELLED /
+ * REJECTED, поэтому опоздавшее событие или устаревший ответ HTTP не
+ * затирают более позднее состояние.
+ *
+ * Список аккаунта отдаётся из памяти, только если однажды был загружен
+ * целиком (putAll) и с тех пор в нём нет неполных или вытесненных записей.
+ * Размер ограничен CACHE_ORDER_SIZE; вытесняются самые старые ордера.
+ */
+class OrderProjection {
+public:
+    struct Stats {
+        uint64_t updates = 0;       ///< order.* применено
+        uint64_t outOfOrder = 0;    ///< отброшено: статус откатился бы назад
+        uint64_t partial = 0;       ///< событий по неизвестному ордеру
+        uint64_t fills = 0;         ///< ордеров из HTTP или от OrderService
+        uint64_t evictions = 0;
+        size_t orders = 0;
+        size_t accounts = 0;
+    };
+
+    explicit OrderProjection(std::shared_ptr<settings::CacheSettings> cacheSettings)
+        : capacity_(cacheSettings->getOrderCacheSize())
+    {
+        std::cout << "[OrderProjection] Created, capacity=" << capacity_ << std::endl;
+    }
+
+    OrderProjection(const OrderProjection&) = delete;
+    OrderProjection& operator=(const OrderProjection&) = delete;
+
+    /**
+     * @brief Ордер аккаунта по id
+     * @return nullopt - нет, чужой или неполный (нужен HTTP)
+     */
+    std::optional<domain::Order> get(const std::string& accountId, const std::string& orderId) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = orders_.find(orderId);
+        if (it == orders_.end() || !it->second.complete || it->second.order.accountId != accountId) {
+            return std::nullopt;
+        }
+        return it->second.order;
+    }
+
+    /**
+     * @brief Все ордера аккаунта, новые первыми
+     * @return nullopt - список в памяти может быть неполным (нужен HTTP)
+     */
+    std::optional<std::vector<domain::Order>> list(const std::string& accountId) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = accounts_.find(accountId);
+        if (it == accounts_.end() || !it->second.loaded || it->second.incomplete > 0) {
+            return std::nullopt;
+        }
+        std::vector<domain::Order> result;
+        result.reserve(it->second.bySeq.size());
+        for (const auto& [seq, orderId] : it->second.bySeq) {
+            result.push_back(orders_.at(orderId).order);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Полный ордер (от OrderService или из HTTP)
+     */
+    void put(const domain::Order& order) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        merge(order);
+        evictOverflow();
+    }
+
+    /**
+     * @brief Полный список аккаунта из HTTP (новые первыми, как отдаёт broker-service)
+     */
+    void putAll(const std::string& accountId, const std::vector<domain::Order>& orders) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        // С конца: старые получают меньший seq
+        for (auto it = orders.rbegin(); it != orders.rend(); ++it) {
+            merge(*it);
+        }
+        Account& account = accounts_[accountId];
+        account.loaded = true;
+        // Вытесненные до загрузки вернулись; неполными остались только ордера новее ответа
+        account.incomplete = 0;
+        for (const auto& [seq, orderId] : account.bySeq) {
+            if (!orders_.at(orderId).complete) {
+                ++account.incomplete;
+            }
+        }
+        evictOverflow();
+    }
+
+    /**
+     * @brief Изменение статуса из order.*
+     */
+    void apply(const std::string& orderId, const std::string& accountId, const std::string& figi,
+               domain::OrderStatus status, int64_t executedLots, double executedPrice) {
+        if (orderId.empty()) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+
+        auto it = orders_.find(orderId);
+        if (it == orders_.end()) {
+            if (accountId.empty()) {
+                return;   // order.cancelled без аккаунта - привязать не к чему
+            }
+            ++stats_.partial;
+            Entry& entry = insert(orderId, accountId, false);
+            entry.order.figi = figi;
+            it = orders_.find(orderId);
+        }
+
+        domain::Order& order = it->second.order;
+        if (!advances(order, status, executedLots)) {
+            ++stats_.outOfOrder;
+            return;
+        }
+        if (executedLots > 0) {
+            order.executedQuantity = executedLots;
+        }
+        if (executedPrice > 0) {
+            order.executedPrice = domain::Money::fromDouble(executedPrice, order.price.currency);
+        }
+        order.updateStatus(status);
+        ++stats_.updates;
+        evictOverflow();
+    }
+
+    Stats stats() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        Stats s = stats_;
+        s.orders = orders_.size();
+        s.accounts = accounts_.size();
+        return s;
+    }
+
+private:
+    struct Entry {
+        domain::Order order;
+        uint64_t seq = 0;
+        bool complete = false;      ///< false - известен только по событию
+    };
+
+    struct Account {
+        std::map<uint64_t, std::string, std::greater<uint64_t>> bySeq;   ///< новые первыми
+        size_t incomplete = 0;      ///< неполных или вытесненных записей
+        bool loaded = false;        ///< список был загружен целиком
+    };
+
+    static int rank(domain::OrderStatus status) {
+        switch (status) {
+            case domain::OrderStatus::PENDING: return 0;
+            case domain::OrderStatus::PARTIALLY_FILLED: return 1;
+            default: return 2;
+        }
+    }
+
+    /// Новое состояние не раньше текущего
+    static bool advances(const domain::Order& current, domain::OrderStatus status, int64_t executedLots) {
+        int from = rank(current.status);
+        int to = rank(status);
+        if (to != from) {
+            return to > from;
+        }
+        if (to == 2) {
+            return status == current.status;   // терминальный статус не меняется
+        }
+        return executedLots >= current.executedQuantity;
+    }
+
+    /// Под mutex_
+    Entry& insert(const std::string& orderId, const std::string& accountId, bool complete) {
+        uint64_t seq = ++seq_;
+        Entry& entry = orders_[orderId];
+        entry.order.id = orderId;
+        entry.order.accountId = accountId;
+        entry.seq = seq;
+        entry.complete = complete;
+        bySeq_.emplace(seq, orderId);
+
+        Account& account = accounts_[accountId];
+        account.bySeq.emplace(seq, orderId);
+        if (!complete) {
+            ++account.incomplete;
+        }
+        return entry;
+    }
+
+    /// Под mutex_
+    void merge(const domain::Order& order) {
+        if (order.id.empty()) {
+            return;
+        }
+        ++stats_.fills;
+
+        auto it = orders_.find(order.id);
+        if (it == orders_.end()) {
+            Entry& entry = insert(order.id, order.accountId, true);
+            entry.order = order;
+            return;
+        }
+
+        Entry& entry = it->second;
+        domain::Order known = entry.order;
+        entry.order = order;
+        entry.order.accountId = known.accountId;
+        if (!advances(known, order.status, order.executedQuantity)) {
+            // Событие уже продвинуло ордер дальше, чем этот ответ
+            entry.order.status = known.status;
+            entry.order.executedQuantity = known.executedQuantity;
+            entry.order.executedPrice = known.executedPrice;
+            entry.order.updatedAt = known.updatedAt;
+        }
+        if (!entry.complete) {
+            entry.complete = true;
+            --accounts_[known.accountId].incomplete;
+        }
+    }
+
+    /// Под mutex_
+    void evictOverflow() {
+        while (orders_.size() > capacity_ && !bySeq_.empty()) {
+            auto oldest = bySeq_.begin();
+            auto it = orders_.find(oldest->second);
+            Account& account = accounts_[it->second.order.accountId];
+            account.bySeq.erase(oldest->first);
+            if (it->second.complete) {
+                ++account.incomplete;   // список аккаунта больше не полный
+            }
+            if (account.bySeq.empty()) {
+                accounts_.erase(it->second.order.accountId);
+            }
+            orders_.erase(it);
+            bySeq_.erase(oldest);
+            ++stats_.evictions;
+        }
+    }
+
+    const size_t capacity_;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Entry> orders_;
+    std::unordered_map<std::string, Account> accounts_;
+    std::map<uint64_t, std::string> bySeq_;   ///< порядок вытеснения: старые первыми
+    uint64_t seq_ = 0;
+    Stats stats_;
+};
+
+} // namespace trading::application
@@ -7,6 +7,7 @@
 #include "domain/OrderRequest.hpp"
 #include "domain/OrderResult.hpp"
 #include "domain/Order.hpp"
+#include "application/OrderProjection.hpp"
 #include <nlohmann/json.hpp>
 #include <memory>
 #include <iostream>
@@ -22,15 +23,18 @@ namespace trading::application {
  * Архитектура:
  * - POST (создание) → валидация FIGI → публикует событие в RabbitMQ → broker слушает
  * - DELETE (отмена) → публикует событие в RabbitMQ → broker слушает
- * - GET (чтение) → HTTP запрос к broker-service
+ * - GET (чтение) → OrderProjection (order.* + отправленные ордера);
+ *   HTTP к broker-service - только если ордера или полного списка в памяти нет
  */
 class OrderService : public ports::input::IOrderService {
 public:
     OrderService(
         std::shared_ptr<ports::output::IBrokerGateway> broker,
-        std::shared_ptr<ports::output::IEventPublisher> eventPublisher
+        std::shared_ptr<ports::output::IEventPublisher> eventPublisher,
+        std::shared_ptr<OrderProjection> projection
     ) : broker_(std::move(broker))
       , eventPublisher_(std::move(eventPublisher))
+      , projection_(std::move(projection))
       , rng_(std::random_device{}())
     {
         std::cout << "[OrderService] Created" << std::endl;
@@ -78,6 +82,10 @@ public:
             
             std::cout << "[OrderService] Published order.create: " << result.orderId << std::endl;
 
+            domain::Order order(result.orderId, request.accountId, request.figi,
+                                request.direction, request.type, request.quantity, request.price);
+            projection_->put(order);
+
         } catch (const std::exception& e) {
             std::cerr << "[OrderService] Failed to publish order: " << e.what() << std::endl;
             result.status = domain::OrderStatus::REJECTED;
@@ -109,36 +117,57 @@ public:
     }
 
     /**
-     * @brief Получить ордер по ID (HTTP к broker-service)
+     * @brief Получить ордер по ID (OrderProjection, при промахе - HTTP к broker-service)
      */
     std::optional<domain::Order> getOrderById(
         const std::string& accountId, 
         const std::string& orderId) override 
     {
-        // Получаем все ордера аккаунта и ищем нужный
-        auto orders = broker_->getOrders(accountId);
-        
-        for (const auto& order : orders) {
-            if (order.id == orderId) {
-                std::cout << "[OrderService] Found order " << orderId << std::endl;
-                return order;
-            }
+        if (auto order = projection_->get(accountId, orderId)) {
+            return order;
         }
-        
-        std::cout << "[OrderService] Order not found: " << orderId << std::endl;
-        return std::nullopt;
+
+        auto order = broker_->getOrder(accountId, orderId);
+        if (!order) {
+            std::cout << "[OrderService] Order not found: " << orderId << std::endl;
+            return std::nullopt;
+        }
+        projection_->put(*order);
+        auto merged = projection_->get(accountId, orderId);   // событие могло быть новее ответа
+        return merged ? merged : order;
     }
 
     /**
-     * @brief Получить все ордера аккаунта (HTTP к broker-service)
+     * @brief Страница истории ордеров аккаунта
+     *
+     * Первая страница без фильтров отдаётся из OrderProjection, если там
+     * полный список аккаунта и он умещается в limit. Иначе страница
+     * запрашивается у broker-service; если это вся история (первая и
+     * последняя страница без фильтров), она становится списком аккаунта
+     * в OrderProjection.
      */
-    std::vector<domain::Order> getAllOrders(const std::string& accountId) override {
-        return broker_->getOrders(accountId);
+    domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query) override
+    {
+        if (query.isFirstUnfiltered()) {
+            auto orders = projection_->list(accountId);
+            if (orders && orders->size() <= query.limit) {
+                return domain::OrderPage{std::move(*orders), std::nullopt};
+            }
+        }
+
+        auto page = broker_->getOrders(accountId, query);
+        if (query.isFirstUnfiltered() && !page.nextCursor) {
+            projection_->putAll(accountId, page.orders);
+        }
+        return page;
     }
 
 private:
     std::shared_ptr<ports::output::IBrokerGateway> broker_;
     std::shared_ptr<ports::output::IEventPublisher> eventPublisher_;
+    std::shared_ptr<OrderProjection> projection_;
     std::mt19937 rng_;
 
     std::string generateOrderId() {
@@ -0,0 +1,173 @@
+// trading-service/include/application/PortfolioProjection.hpp
+#pragma once
+
+#include "domain/Portfolio.hpp"
+#include "application/QuoteReplica.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace trading::application {
+
+/**
+ * @brief Портфели аккаунтов, собранные из portfolio.updated
+ *
+ * portfolio.updated - полный срез (cash + позиции) с epoch (запуск
+ * broker-service) и version (номер события по аккаунту, см.
+ * FakeBrokerAdapter::publishPortfolioUpdate). Пишет TradingEventHandler,
+ * читает PortfolioService - без похода в broker-service.
+ *
+ * - событие с version не больше известного (в той же epoch) - повтор или
+ *   опоздавшее, отбрасывается;
+ * - пропуск номера - часть событий потеряна: срез применяется, но аккаунт
+ *   помечается устаревшим, и следующее чтение перечитывает его по HTTP;
+ * - новая epoch (перезапуск broker-service) принимается как есть.
+ *
+ * Позиции переоцениваются при чтении по QuoteReplica: currentPrice, pnl и
+ * totalValue считаются от последней котировки, а не от цены в событии.
+ */
+class PortfolioProjection {
+public:
+    struct Stats {
+        uint64_t events = 0;        ///< portfolio.updated всего
+        uint64_t outOfOrder = 0;    ///< отброшено как повтор/опоздавшее
+        uint64_t gaps = 0;
+        uint64_t fills = 0;         ///< срезов из HTTP
+        size_t accounts = 0;
+    };
+
+    /// Результат чтения; generation передаётся в fill() после похода в HTTP
+    struct Lookup {
+        std::optional<domain::Portfolio> portfolio;
+        uint64_t generation = 0;
+    };
+
+    explicit PortfolioProjection(std::shared_ptr<QuoteReplica> quoteReplica)
+        : quoteReplica_(std::move(quoteReplica))
+    {
+        std::cout << "[PortfolioProjection] Created" << std::endl;
+    }
+
+    PortfolioProjection(const PortfolioProjection&) = delete;
+    PortfolioProjection& operator=(const PortfolioProjection&) = delete;
+
+    /**
+     * @brief Срез из portfolio.updated
+     * @param version 0 - событие без версии, принимается всегда
+     */
+    void apply(const std::string& accountId, int64_t epoch, uint64_t version, domain::Portfolio portfolio) {
+        if (accountId.empty()) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        ++stats_.events;
+
+        auto it = accounts_.find(accountId);
+        bool gap = false;
+        if (it != accounts_.end() && version != 0 && it->second.version != 0 && it->second.epoch == epoch) {
+            if (version <= it->second.version) {
+                ++stats_.outOfOrder;
+                return;
+            }
+            gap = version != it->second.version + 1;
+        }
+        if (gap) {
+            ++stats_.gaps;
+            std::cerr << "[PortfolioProjection] Version gap for " << accountId << ": expected "
+                      << it->second.version + 1 << ", got " << version << std::endl;
+        }
+
+        Entry& entry = accounts_[accountId];
+        entry.portfolio = std::move(portfolio);
+        entry.epoch = epoch;
+        entry.version = version;
+        entry.generation = ++generation_;
+        entry.stale = gap;
+    }
+
+    /**
+     * @brief Портфель, переоценённый по текущим котировкам
+     * @return portfolio = nullopt, если аккаунта нет или он устарел - нужен HTTP
+     */
+    Lookup get(const std::string& accountId) const {
+        Lookup result;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = accounts_.find(accountId);
+            if (it == accounts_.end()) {
+                return result;
+            }
+            result.generation = it->second.generation;
+            if (it->second.stale) {
+                return result;
+            }
+            result.portfolio = it->second.portfolio;
+        }
+        revalue(*result.portfolio);
+        return result;
+    }
+
+    /**
+     * @brief Срез, полученный по HTTP при промахе
+     *
+     * Не перезаписывает событие, пришедшее пока шёл запрос: generation
+     * должен совпасть с полученным в get().
+     */
+    void fill(const std::string& accountId, const domain::Portfolio& portfolio, uint64_t generation) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = accounts_.find(accountId);
+        uint64_t current = it != accounts_.end() ? it->second.generation : 0;
+        if (current != generation) {
+            return;
+        }
+
+        Entry& entry = accounts_[accountId];
+        entry.portfolio = portfolio;
+        entry.generation = ++generation_;
+        entry.stale = false;   // epoch и version остаются: HTTP не старее последнего события
+        ++stats_.fills;
+    }
+
+    Stats stats() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        Stats s = stats_;
+        s.accounts = accounts_.size();
+        return s;
+    }
+
+private:
+    struct Entry {
+        domain::Portfolio portfolio;
+        int64_t epoch = 0;
+        uint64_t version = 0;       ///< 0 - из HTTP, следующее событие принимается любым
+        uint64_t generation = 0;
+        bool stale = false;
+    };
+
+    void revalue(domain::Portfolio& portfolio) const {
+        double total = portfolio.cash.toDouble();
+        for (auto& position : portfolio.positions) {
+            if (auto quote = quoteReplica_->get(position.figi)) {
+                position.currentPrice = quote->lastPrice;
+                position.updatePnl();
+            }
+            total += position.currentPrice.toDouble() * static_cast<double>(position.quantity);
+        }
+        portfolio.totalValue = domain::Money::fromDouble(total, portfolio.cash.currency);
+    }
+
+    std::shared_ptr<QuoteReplica> quoteReplica_;
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Entry> accounts_;
+    uint64_t generation_ = 0;
+    Stats stats_;
+};
+
+} // namespace trading::application
@@ -2,6 +2,7 @@
 
 #include "ports/input/IPortfolioService.hpp"
 #include "ports/output/IBrokerGateway.hpp"
+#include "application/PortfolioProjection.hpp"
 #include <memory>
 #include <iostream>
 
@@ -10,14 +11,18 @@ namespace trading::application {
 /**
  * @brief Сервис портфеля
  * 
- * Получает данные через HTTP от broker-service.
- * Не кэшируется - нужны актуальные данные.
+ * Читает PortfolioProjection (срезы из portfolio.updated, переоценка по
+ * локальным котировкам). В broker-service по HTTP идёт, только если
+ * аккаунта в проекции ещё нет (холодный старт) или в версиях его событий
+ * обнаружен пропуск.
  */
 class PortfolioService : public ports::input::IPortfolioService {
 public:
-    explicit PortfolioService(
-        std::shared_ptr<ports::output::IBrokerGateway> broker
+    PortfolioService(
+        std::shared_ptr<ports::output::IBrokerGateway> broker,
+        std::shared_ptr<PortfolioProjection> projection
     ) : broker_(std::move(broker))
+      , projection_(std::move(projection))
     {
         std::cout << "[PortfolioService] Created" << std::endl;
     }
@@ -26,27 +31,37 @@ public:
      * @brief Получить портфель аккаунта
      */
     domain::Portfolio getPortfolio(const std::string& accountId) override {
-        return broker_->getPortfolio(accountId);
+        return load(accountId);
     }
 
     /**
      * @brief Получить доступные денежные средства
      */
     domain::Money getAvailableCash(const std::string& accountId) override {
-        auto portfolio = broker_->getPortfolio(accountId);
-        return portfolio.cash;
+        return load(accountId).cash;
     }
 
     /**
      * @brief Получить позиции портфеля
      */
     std::vector<domain::Position> getPositions(const std::string& accountId) override {
-        auto portfolio = broker_->getPortfolio(accountId);
-        return portfolio.positions;
+        return load(accountId).positions;
     }
 
 private:
+    domain::Portfolio load(const std::string& accountId) {
+        auto lookup = projection_->get(accountId);
+        if (lookup.portfolio) {
+            return *lookup.portfolio;
+        }
+
+        auto portfolio = broker_->getPortfolio(accountId);
+        projection_->fill(accountId, portfolio, lookup.generation);
+        return portfolio;
+    }
+
     std::shared_ptr<ports::output::IBrokerGateway> broker_;
+    std::shared_ptr<PortfolioProjection> projection_;
 };
 
 } // namespace trading::application
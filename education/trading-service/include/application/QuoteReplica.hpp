@@ -0,0 +1,339 @@
+// trading-service/include/application/QuoteReplica.hpp
+#pragma once
+
+#include "domain/Quote.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace trading::application {
+
+/**
+ * @brief Локальная реплика котировок, наполняемая событиями broker-service
+ *
+ * Пишут в реплику TradingEventHandler (quote.updated, quote.batch,
+ * quote.snapshot) и MarketService (ответ HTTP при промахе). Читает
+ * MarketService::getQuote/getQuotes - без блокировок и без сети:
+ *
+ * - каждая котировка лежит в своём слоте под seqlock: читатель копирует
+ *   слово за словом и повторяет чтение, если писатель успел вмешаться;
+ * - индекс FIGI -> слот - открытая адресация с атомарными указателями;
+ *   при росте строится новая таблица и публикуется целиком, старые живут
+ *   до разрушения реплики (рост геометрический - не больше 2x памяти);
+ * - писатели сериализуются мьютексом, читатели его не трогают.
+ *
+ * Разрывы потока: пачки несут seq (см. ConflatingQuotePublisher в
+ * broker-service). Если seq пришёл не следующим, часть изменений потеряна -
+ * реплика увеличивает эпоху, и все слоты, не обновлённые после разрыва,
+ * перестают отдаваться (get -> nullopt, MarketService идёт в HTTP).
+ * quote.snapshot возвращает инструменты в актуальное состояние;
+ * observeFrame подсказывает, когда его запросить.
+ */
+class QuoteReplica {
+public:
+    /// Не чаще одного quote.snapshot.request за этот интервал
+    static constexpr std::chrono::milliseconds SNAPSHOT_REQUEST_INTERVAL{5000};
+
+    struct Stats {
+        uint64_t updates = 0;           ///< котировок из событий
+        uint64_t fills = 0;             ///< котировок из HTTP (холодный старт / разрыв)
+        uint64_t frames = 0;            ///< quote.batch + quote.snapshot
+        uint64_t snapshots = 0;
+        uint64_t gaps = 0;
+        uint64_t snapshotRequests = 0;
+        uint64_t lastSeq = 0;
+        size_t instruments = 0;
+    };
+
+    QuoteReplica() {
+        tables_.push_back(std::make_unique<Table>(INITIAL_CAPACITY));
+        table_.store(tables_.back().get(), std::memory_order_release);
+        std::cout << "[QuoteReplica] Created" << std::endl;
+    }
+
+    QuoteReplica(const QuoteReplica&) = delete;
+    QuoteReplica& operator=(const QuoteReplica&) = delete;
+
+    /**
+     * @brief Котировка из реплики (lock-free)
+     * @return nullopt, если инструмента нет или он устарел после разрыва
+     */
+    std::optional<domain::Quote> get(const std::string& figi) const {
+        const Slot* slot = find(figi);
+        if (!slot) {
+            return std::nullopt;
+        }
+
+        Payload p = slot->read();
+        if (p.epoch != epoch_.load(std::memory_order_acquire)) {
+            return std::nullopt;
+        }
+
+        std::string currency(p.currency, strnlen(p.currency, sizeof(p.currency)));
+        const std::string* ticker = slot->ticker.load(std::memory_order_acquire);
+        return domain::Quote(
+            slot->figi,
+            ticker ? *ticker : std::string(),
+            domain::Money(p.lastUnits, p.lastNano, currency),
+            domain::Money(p.bidUnits, p.bidNano, currency),
+            domain::Money(p.askUnits, p.askNano, currency));
+    }
+
+    /**
+     * @brief Котировка из события (quote.updated или элемент пачки)
+     */
+    void update(const std::string& figi, double bid, double ask, double last,
+                const std::string& currency, int64_t timestampMs) {
+        if (figi.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Payload p;
+        setMoney(p.lastUnits, p.lastNano, domain::Money::fromDouble(last));
+        setMoney(p.bidUnits, p.bidNano, domain::Money::fromDouble(bid));
+        setMoney(p.askUnits, p.askNano, domain::Money::fromDouble(ask));
+        setCurrency(p, currency);
+        p.timestampMs = timestampMs;
+        p.epoch = epoch_.load(std::memory_order_relaxed);
+        findOrCreate(figi).write(p);
+        ++stats_.updates;
+    }
+
+    /**
+     * @brief Котировка, полученная по HTTP
+     *
+     * Запоминает тикер (в событиях его нет). Цены перезаписывает, только
+     * если слот новый или устарел: событие, пришедшее пока шёл запрос,
+     * свежее ответа HTTP.
+     */
+    void fill(const domain::Quote& quote) {
+        if (quote.figi.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Slot& slot = findOrCreate(quote.figi);
+        if (!quote.ticker.empty() && !slot.ticker.load(std::memory_order_relaxed)) {
+            slot.tickerStorage = std::make_unique<std::string>(quote.ticker);
+            slot.ticker.store(slot.tickerStorage.get(), std::memory_order_release);
+        }
+
+        uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+        if (slot.read().epoch == epoch) {
+            return;
+        }
+        Payload p;
+        setMoney(p.lastUnits, p.lastNano, quote.lastPrice);
+        setMoney(p.bidUnits, p.bidNano, quote.bidPrice);
+        setMoney(p.askUnits, p.askNano, quote.askPrice);
+        setCurrency(p, quote.lastPrice.currency);
+        p.epoch = epoch;
+        slot.write(p);
+        ++stats_.fills;
+    }
+
+    /**
+     * @brief Учесть seq пачки; вызывается до применения её котировок
+     *
+     * @return true - реплика не синхронизирована с потоком (первая пачка
+     *         без среза или разрыв seq) и пора отправить quote.snapshot.request
+     */
+    bool observeFrame(uint64_t seq, bool snapshot) {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        ++stats_.frames;
+
+        if (snapshot) {
+            ++stats_.snapshots;
+            synced_ = true;
+        } else if (stats_.lastSeq != 0 && seq != stats_.lastSeq + 1) {
+            std::cerr << "[QuoteReplica] Sequence gap: expected " << stats_.lastSeq + 1
+                      << ", got " << seq << std::endl;
+            ++stats_.gaps;
+            epoch_.fetch_add(1, std::memory_order_release);
+            synced_ = false;
+        }
+        stats_.lastSeq = seq;
+
+        if (synced_) {
+            return false;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (stats_.snapshotRequests > 0 && now - lastSnapshotRequest_ < SNAPSHOT_REQUEST_INTERVAL) {
+            return false;
+        }
+        lastSnapshotRequest_ = now;
+        ++stats_.snapshotRequests;
+        return true;
+    }
+
+    Stats stats() const {
+        std::lock_guard<std::mutex> lock(writeMutex_);
+        Stats s = stats_;
+        s.instruments = slots_.size();
+        return s;
+    }
+
+private:
+    /**
+     * @brief Содержимое слота; копируется через seqlock пословно
+     */
+    struct Payload {
+        int64_t lastUnits = 0;
+        int64_t bidUnits = 0;
+        int64_t askUnits = 0;
+        int64_t timestampMs = 0;
+        uint64_t epoch = 0;         ///< 0 - слот ещё не заполнялся
+        int32_t lastNano = 0;
+        int32_t bidNano = 0;
+        int32_t askNano = 0;
+        char currency[12] = {};
+    };
+
+    static constexpr size_t PAYLOAD_WORDS = sizeof(Payload) / sizeof(uint64_t);
+    static_assert(sizeof(Payload) % sizeof(uint64_t) == 0, "Payload must be word-sized");
+
+    struct alignas(64) Slot {
+        explicit Slot(std::string f) : figi(std::move(f)) {
+            for (auto& w : words) {
+                w.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /// Единственный писатель (под writeMutex_)
+        void write(const Payload& p) {
+            uint64_t raw[PAYLOAD_WORDS];
+            std::memcpy(raw, &p, sizeof(raw));
+            uint64_t v = version.load(std::memory_order_relaxed);
+            version.store(v + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < PAYLOAD_WORDS; ++i) {
+                words[i].store(raw[i], std::memory_order_relaxed);
+            }
+            version.store(v + 2, std::memory_order_release);
+        }
+
+        Payload read() const {
+            uint64_t raw[PAYLOAD_WORDS];
+            for (;;) {
+                uint64_t before = version.load(std::memory_order_acquire);
+                if (before & 1) {
+                    continue;   // запись в процессе
+                }
+                for (size_t i = 0; i < PAYLOAD_WORDS; ++i) {
+                    raw[i] = words[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (version.load(std::memory_order_relaxed) == before) {
+                    break;
+                }
+            }
+            Payload p;
+            std::memcpy(&p, raw, sizeof(p));
+            return p;
+        }
+
+        const std::string figi;
+        std::atomic<uint64_t> version{0};
+        std::array<std::atomic<uint64_t>, PAYLOAD_WORDS> words;
+        std::atomic<const std::string*> ticker{nullptr};
+        std::unique_ptr<std::string> tickerStorage;   ///< владелец *ticker, меняется под writeMutex_
+    };
+
+    /**
+     * @brief Таблица открытой адресации; заполнена не больше чем наполовину
+     */
+    struct Table {
+        explicit Table(size_t capacity)
+            : mask(capacity - 1)
+            , buckets(new std::atomic<Slot*>[capacity])
+        {
+            for (size_t i = 0; i < capacity; ++i) {
+                buckets[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        size_t capacity() const { return mask + 1; }
+
+        const size_t mask;
+        std::unique_ptr<std::atomic<Slot*>[]> buckets;
+    };
+
+    static constexpr size_t INITIAL_CAPACITY = 256;
+
+    static size_t hashOf(std::string_view figi) {
+        return std::hash<std::string_view>{}(figi);
+    }
+
+    const Slot* find(const std::string& figi) const {
+        const Table* table = table_.load(std::memory_order_acquire);
+        for (size_t i = hashOf(figi) & table->mask;; i = (i + 1) & table->mask) {
+            const Slot* slot = table->buckets[i].load(std::memory_order_acquire);
+            if (!slot || slot->figi == figi) {
+                return slot;
+            }
+        }
+    }
+
+    static void place(Table& table, Slot* slot) {
+        for (size_t i = hashOf(slot->figi) & table.mask;; i = (i + 1) & table.mask) {
+            if (!table.buckets[i].load(std::memory_order_relaxed)) {
+                table.buckets[i].store(slot, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    /// Под writeMutex_
+    Slot& findOrCreate(const std::string& figi) {
+        if (const Slot* existing = find(figi)) {
+            return const_cast<Slot&>(*existing);
+        }
+
+        Table* table = tables_.back().get();
+        if ((slots_.size() + 1) * 2 > table->capacity()) {
+            tables_.push_back(std::make_unique<Table>(table->capacity() * 2));
+            table = tables_.back().get();
+            for (const auto& slot : slots_) {
+                place(*table, slot.get());
+            }
+            table_.store(table, std::memory_order_release);
+        }
+
+        slots_.push_back(std::make_unique<Slot>(figi));
+        place(*table, slots_.back().get());
+        return *slots_.back();
+    }
+
+    static void setMoney(int64_t& units, int32_t& nano, const domain::Money& money) {
+        units = money.units;
+        nano = money.nano;
+    }
+
+    static void setCurrency(Payload& p, const std::string& currency) {
+        size_t n = std::min(currency.size(), sizeof(p.currency) - 1);
+        std::memcpy(p.currency, currency.data(), n);
+    }
+
+    std::atomic<const Table*> table_{nullptr};
+    std::atomic<uint64_t> epoch_{1};
+
+    mutable std::mutex writeMutex_;
+    std::vector<std::unique_ptr<Table>> tables_;   ///< все поколения; последнее - текущее
+    std::vector<std::unique_ptr<Slot>> slots_;
+    Stats stats_;
+    bool synced_ = false;
+    std::chrono::steady_clock::time_point lastSnapshotRequest_;
+};
+
+} // namespace trading::application
@@ -2,13 +2,15 @@
 #pragma once
 
 #include "ports/input/IEventConsumer.hpp"
+#include "ports/output/IEventPublisher.hpp"
+#include "application/EventWireFormat.hpp"
+#include "application/QuoteReplica.hpp"
+#include "application/PortfolioProjection.hpp"
+#include "application/OrderProjection.hpp"
 #include <nlohmann/json.hpp>
 #include <memory>
 #include <iostream>
 #include <functional>
-#include <map>
-#include <mutex>
-#include <optional>
 
 namespace trading::application {
 
@@ -17,8 +19,20 @@ namespace trading::application {
  * 
  * Слушает события из broker.events exchange:
  * - order.created, order.filled, order.partially_filled, order.rejected, order.cancelled
- * - quote.updated
+ * - quote.updated (по одной котировке) и quote.batch / quote.snapshot
+ *   (пачки последних котировок от ConflatingQuotePublisher broker-service)
  * - portfolio.updated
+ *
+ * Котировки и order.* принимаются и в JSON, и в бинарном формате
+ * (content-type application/vnd.trading.event.v1, см. EventWireFormat.hpp).
+ * Бинарный кадр разбирается без DOM и без копирования строк до заполнения
+ * OrderUpdate/QuoteUpdate. portfolio.updated - всегда JSON.
+ *
+ * Котировки складываются в QuoteReplica, откуда их читает MarketService.
+ * Перед применением пачки проверяется её seq: при разрыве (или если первой
+ * пришла не quote.snapshot) публикуется quote.snapshot.request.
+ * Срезы portfolio.updated складываются в PortfolioProjection, статусы
+ * order.* - в OrderProjection (оттуда их читает OrderService).
  */
 class TradingEventHandler {
 public:
@@ -46,8 +60,17 @@ public:
     using QuoteUpdateCallback = std::function<void(const QuoteUpdate&)>;
     using PortfolioUpdateCallback = std::function<void(const std::string&, const nlohmann::json&)>;
 
-    explicit TradingEventHandler(std::shared_ptr<ports::input::IEventConsumer> eventConsumer)
-        : eventConsumer_(std::move(eventConsumer))
+    TradingEventHandler(
+        std::shared_ptr<ports::input::IEventConsumer> eventConsumer,
+        std::shared_ptr<ports::output::IEventPublisher> eventPublisher,
+        std::shared_ptr<QuoteReplica> quoteReplica,
+        std::shared_ptr<PortfolioProjection> portfolioProjection,
+        std::shared_ptr<OrderProjection> orderProjection
+    ) : eventConsumer_(std::move(eventConsumer))
+      , eventPublisher_(std::move(eventPublisher))
+      , quoteReplica_(std::move(quoteReplica))
+      , portfolioProjection_(std::move(portfolioProjection))
+      , orderProjection_(std::move(orderProjection))
     {
         std::cout << "[TradingEventHandler] Created" << std::endl;
         subscribe();
@@ -57,20 +80,21 @@ public:
     void onQuoteUpdate(QuoteUpdateCallback cb) { quoteCallback_ = std::move(cb); }
     void onPortfolioUpdate(PortfolioUpdateCallback cb) { portfolioCallback_ = std::move(cb); }
 
-    std::optional<OrderUpdate> getOrderStatus(const std::string& orderId) const {
-        std::lock_guard<std::mutex> lock(cacheMutex_);
-        auto it = orderCache_.find(orderId);
-        return (it != orderCache_.end()) ? std::optional(it->second) : std::nullopt;
-    }
-
 private:
     void subscribe() {
-        eventConsumer_->subscribe(
+        eventConsumer_->subscribeTyped(
             {"order.created", "order.filled", "order.partially_filled", 
-             "order.rejected", "order.cancelled", "quote.updated", "portfolio.updated"},
-            [this](const std::string& key, const std::string& msg) { handleEvent(key, msg); }
+             "order.rejected", "order.cancelled", "quote.updated",
+             "quote.batch", "quote.snapshot", "portfolio.updated"},
+            [this](const std::string& key, const std::string& msg, const std::string& contentType) {
+                if (wire::isBinary(contentType)) {
+                    handleBinaryEvent(key, msg);
+                } else {
+                    handleEvent(key, msg);
+                }
+            }
         );
-        std::cout << "[TradingEventHandler] Subscribed to 7 event types" << std::endl;
+        std::cout << "[TradingEventHandler] Subscribed to 9 event types" << std::endl;
     }
 
     void handleEvent(const std::string& routingKey, const std::string& message) {
@@ -81,6 +105,11 @@ private:
                 handleOrderEvent(routingKey, json);
             } else if (routingKey == "quote.updated") {
                 handleQuoteEvent(json);
+            } else if (routingKey == "quote.batch" || routingKey == "quote.snapshot") {
+                trackSequence(json.value("seq", uint64_t{0}), json.value("snapshot", false));
+                for (const auto& quote : json.value("quotes", nlohmann::json::array())) {
+                    handleQuoteEvent(quote);
+                }
             } else if (routingKey == "portfolio.updated") {
                 handlePortfolioEvent(json);
             }
@@ -89,6 +118,63 @@ private:
         }
     }
 
+    void handleBinaryEvent(const std::string& routingKey, const std::string& message) {
+        if (routingKey.rfind("order.", 0) == 0) {
+            auto frame = wire::decodeOrder(message);
+            if (!frame) {
+                std::cerr << "[TradingEventHandler] Malformed binary " << routingKey << std::endl;
+                return;
+            }
+            OrderUpdate update;
+            update.orderId = std::string(frame->orderId);
+            update.accountId = std::string(frame->accountId);
+            update.figi = std::string(frame->figi);
+            update.status = wire::toString(frame->status);
+            update.executedLots = frame->lots;
+            update.executedPrice = frame->price;
+            update.reason = std::string(frame->reason);
+            update.timestamp = frame->timestampMs;
+            applyOrderUpdate(routingKey, std::move(update));
+        } else if (routingKey == "quote.updated") {
+            auto frame = wire::decodeQuote(message);
+            if (!frame) {
+                std::cerr << "[TradingEventHandler] Malformed binary " << routingKey << std::endl;
+                return;
+            }
+            applyQuoteUpdate(toQuoteUpdate(*frame));
+        } else if (routingKey == "quote.batch" || routingKey == "quote.snapshot") {
+            auto frame = wire::decodeQuoteBatch(message);
+            if (!frame) {
+                std::cerr << "[TradingEventHandler] Malformed binary " << routingKey << std::endl;
+                return;
+            }
+            trackSequence(frame->seq, frame->snapshot);
+            for (const auto& q : frame->quotes) {
+                applyQuoteUpdate(toQuoteUpdate(q));
+            }
+        } else {
+            std::cerr << "[TradingEventHandler] Unexpected binary " << routingKey << std::endl;
+        }
+    }
+
+    void trackSequence(uint64_t seq, bool snapshot) {
+        if (quoteReplica_->observeFrame(seq, snapshot)) {
+            std::cout << "[TradingEventHandler] Requesting quote.snapshot (seq " << seq << ")" << std::endl;
+            eventPublisher_->publish("quote.snapshot.request", "{}");
+        }
+    }
+
+    static QuoteUpdate toQuoteUpdate(const wire::QuoteFrame& frame) {
+        QuoteUpdate update;
+        update.figi = std::string(frame.figi);
+        update.bid = frame.bid;
+        update.ask = frame.ask;
+        update.lastPrice = frame.last;
+        update.currency = std::string(frame.currency);
+        update.timestamp = frame.timestampMs;
+        return update;
+    }
+
     // Безопасный парсинг timestamp (может быть числом или строкой)
     static int64_t parseTimestamp(const nlohmann::json& json, const std::string& key) {
         if (!json.contains(key)) return 0;
@@ -117,14 +203,16 @@ private:
         update.executedPrice = json.value("executed_price", 0.0);
         update.reason = json.value("reason", "");
         update.timestamp = parseTimestamp(json, "timestamp");
-        
+        applyOrderUpdate(routingKey, std::move(update));
+    }
+
+    void applyOrderUpdate(const std::string& routingKey, OrderUpdate update) {
         std::cout << "[TradingEventHandler] " << routingKey << ": " << update.orderId << std::endl;
-        
-        {
-            std::lock_guard<std::mutex> lock(cacheMutex_);
-            orderCache_[update.orderId] = update;
-        }
-        
+
+        orderProjection_->apply(update.orderId, update.accountId, update.figi,
+                                domain::parseOrderStatus(update.status),
+                                update.executedLots, update.executedPrice);
+
         if (orderCallback_) orderCallback_(update);
     }
 
@@ -136,29 +224,57 @@ private:
         update.lastPrice = json.value("last_price", 0.0);
         update.currency = json.value("currency", "RUB");
         update.timestamp = parseTimestamp(json, "timestamp");
-        
-        {
-            std::lock_guard<std::mutex> lock(cacheMutex_);
-            quoteCache_[update.figi] = update;
-        }
-        
+        applyQuoteUpdate(std::move(update));
+    }
+
+    void applyQuoteUpdate(QuoteUpdate update) {
+        quoteReplica_->update(update.figi, update.bid, update.ask, update.lastPrice,
+                              update.currency, update.timestamp);
         if (quoteCallback_) quoteCallback_(update);
     }
 
     void handlePortfolioEvent(const nlohmann::json& json) {
         std::string accountId = json.value("account_id", "");
         std::cout << "[TradingEventHandler] portfolio.updated: " << accountId << std::endl;
+        portfolioProjection_->apply(accountId, json.value("epoch", int64_t{0}),
+                                    json.value("version", uint64_t{0}), parsePortfolio(json));
         if (portfolioCallback_) portfolioCallback_(accountId, json);
     }
 
+    /// cash / total_value: {"amount", "currency"}; позиции - как в GET /api/v1/portfolio
+    static domain::Portfolio parsePortfolio(const nlohmann::json& json) {
+        auto money = [](const nlohmann::json& j, const std::string& key) {
+            if (!j.contains(key) || !j[key].is_object()) {
+                return domain::Money::fromDouble(0.0);
+            }
+            return domain::Money::fromDouble(j[key].value("amount", 0.0), j[key].value("currency", "RUB"));
+        };
+
+        domain::Portfolio portfolio;
+        portfolio.cash = money(json, "cash");
+        portfolio.totalValue = money(json, "total_value");
+        for (const auto& p : json.value("positions", nlohmann::json::array())) {
+            domain::Position position;
+            position.figi = p.value("figi", "");
+            position.ticker = p.value("ticker", "");
+            position.quantity = p.value("quantity", int64_t{0});
+            std::string currency = p.value("currency", "RUB");
+            position.averagePrice = domain::Money::fromDouble(p.value("average_price", 0.0), currency);
+            position.currentPrice = domain::Money::fromDouble(p.value("current_price", 0.0), currency);
+            position.updatePnl();
+            portfolio.positions.push_back(std::move(position));
+        }
+        return portfolio;
+    }
+
     std::shared_ptr<ports::input::IEventConsumer> eventConsumer_;
+    std::shared_ptr<ports::output::IEventPublisher> eventPublisher_;
+    std::shared_ptr<QuoteReplica> quoteReplica_;
+    std::shared_ptr<PortfolioProjection> portfolioProjection_;
+    std::shared_ptr<OrderProjection> orderProjection_;
     OrderUpdateCallback orderCallback_;
     QuoteUpdateCallback quoteCallback_;
     PortfolioUpdateCallback portfolioCallback_;
-    
-    mutable std::mutex cacheMutex_;
-    std::map<std::string, OrderUpdate> orderCache_;
-    std::map<std::string, QuoteUpdate> quoteCache_;
 };
 
 } // namespace trading::application
@@ -0,0 +1,45 @@
+// trading-service/include/domain/OrderPage.hpp
+#pragma once
+
+#include "Order.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace trading::domain {
+
+/**
+ * @brief Запрос страницы истории ордеров (GET /api/v1/orders)
+ *
+ * Параметры передаются в broker-service как есть; cursor - непрозрачная
+ * строка из next_cursor предыдущей страницы.
+ */
+struct OrderPageQuery {
+    static constexpr size_t DEFAULT_LIMIT = 100;
+    static constexpr size_t MAX_LIMIT = 1000;
+
+    size_t limit = DEFAULT_LIMIT;
+    std::optional<std::string> cursor;
+    std::optional<int64_t> fromMs;      ///< Время получения ордера >= from, Unix-мс
+    std::optional<int64_t> toMs;        ///< Время получения ордера < to, Unix-мс
+    std::optional<OrderStatus> status;
+
+    /**
+     * @brief Первая страница без фильтров - начало полной истории аккаунта
+     */
+    bool isFirstUnfiltered() const {
+        return !cursor && !fromMs && !toMs && !status;
+    }
+};
+
+/**
+ * @brief Страница истории, новые первыми; nextCursor = nullopt - страница последняя
+ */
+struct OrderPage {
+    std::vector<Order> orders;
+    std::optional<std::string> nextCursor;
+};
+
+} // namespace trading::domain
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <string>
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <optional>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
@@ -32,6 +35,32 @@ public:
         return Timestamp(tp);
     }
 
+    /**
+     * @brief Строгий разбор параметра запроса: Unix-мс или "2026-01-31T10:00:00[Z]" (UTC)
+     * @return nullopt для всего остального, в том числе смещения (+03:00) и мусора после секунд
+     */
+    static std::optional<Timestamp> parseUtc(const std::string& str) {
+        if (!str.empty() && str.size() <= 18 &&
+            std::all_of(str.begin(), str.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            return Timestamp(std::chrono::system_clock::time_point(std::chrono::milliseconds(std::stoll(str))));
+        }
+
+        std::tm tm = {};
+        std::istringstream ss(str);
+        ss >> std::get_time(&tm, "%Y-%m-%dT%H:%M:%S");
+        if (ss.fail()) {
+            return std::nullopt;
+        }
+        if (ss.peek() == 'Z') {
+            ss.get();
+        }
+        ss >> std::ws;
+        if (ss.peek() != std::char_traits<char>::eof()) {
+            return std::nullopt;
+        }
+        return Timestamp(std::chrono::system_clock::from_time_t(timegm(&tm)));
+    }
+
     std::string toString() const {
         auto time_t_val = std::chrono::system_clock::to_time_t(value);
         std::tm tm = *std::gmtime(&time_t_val);
@@ -17,6 +17,16 @@ namespace trading::ports::input {
  */
 using EventHandler = std::function<void(const std::string& routingKey, const std::string& message)>;
 
+/**
+ * @brief Обработчик событий с AMQP content-type
+ *
+ * @param contentType "application/json", "application/vnd.trading.event.v1"
+ *                    или пустая строка, если издатель его не указал
+ */
+using TypedEventHandler = std::function<void(const std::string& routingKey,
+                                             const std::string& message,
+                                             const std::string& contentType)>;
+
 /**
  * @brief Интерфейс потребителя событий
  * 
@@ -45,6 +55,20 @@ public:
      * @param handler Обработчик событий
      */
     virtual void subscribe(const std::vector<std::string>& routingKeys, EventHandler handler) = 0;
+
+    /**
+     * @brief Подписаться на события с учётом content-type
+     *
+     * Нужен потребителям, которые принимают и JSON, и бинарный формат.
+     * Реализация по умолчанию - для транспортов без content-type:
+     * все сообщения считаются JSON.
+     */
+    virtual void subscribeTyped(const std::vector<std::string>& routingKeys, TypedEventHandler handler) {
+        subscribe(routingKeys, [handler = std::move(handler)](const std::string& routingKey,
+                                                              const std::string& message) {
+            handler(routingKey, message, "application/json");
+        });
+    }
     
     /**
      * @brief Запустить прослушивание событий
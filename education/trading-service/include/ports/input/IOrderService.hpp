@@ -4,6 +4,7 @@
 #include "domain/OrderRequest.hpp"
 #include "domain/OrderResult.hpp"
 #include "domain/Order.hpp"
+#include "domain/OrderPage.hpp"
 #include <vector>
 #include <optional>
 #include <string>
@@ -37,9 +38,12 @@ public:
         const std::string& orderId) = 0;
 
     /**
-     * @brief Получить все ордера аккаунта
+     * @brief Получить страницу истории ордеров аккаунта, новые первыми
+     * @throws std::invalid_argument если параметры страницы неверны
      */
-    virtual std::vector<domain::Order> getAllOrders(const std::string& accountId) = 0;
+    virtual domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query) = 0;
 };
 
 } // namespace trading::ports::input
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <optional>
+#include <vector>
+#include <cstdint>
 
 namespace trading::ports::output {
 
@@ -13,6 +15,7 @@ struct TokenValidationResult {
     std::string message;
     std::string userId;
     std::string accountId;
+    int64_t expiresAtMs = 0;    ///< срок действия токена, мс с эпохи Unix; 0 - неизвестен
 };
 
 /**
@@ -31,6 +34,13 @@ public:
      */
     virtual TokenValidationResult validateAccessToken(const std::string& token) = 0;
 
+    /**
+     * @brief Валидировать несколько access token одним запросом
+     * @return results[i] - для tokens[i]; при сбое auth-service все невалидны
+     */
+    virtual std::vector<TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>& tokens) = 0;
+
     /**
      * @brief Извлечь account_id из токена
      * @param token Access token
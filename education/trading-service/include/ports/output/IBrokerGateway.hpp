@@ -4,6 +4,7 @@
 #include "domain/Quote.hpp"
 #include "domain/Portfolio.hpp"
 #include "domain/Order.hpp"
+#include "domain/OrderPage.hpp"
 #include <string>
 #include <vector>
 #include <optional>
@@ -66,9 +67,14 @@ public:
     virtual domain::Portfolio getPortfolio(const std::string& accountId) = 0;
 
     /**
-     * @brief Получить список ордеров аккаунта
+     * @brief Получить одну страницу истории ордеров аккаунта, новые первыми
+     * @throws std::invalid_argument если broker-service отверг параметры (400)
+     * @throws std::runtime_error если страница не получена
      */
-    virtual std::vector<domain::Order> getOrders(const std::string& accountId) = 0;
+    virtual domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query
+    ) = 0;
 
     /**
      * @brief Получить ордер по ID
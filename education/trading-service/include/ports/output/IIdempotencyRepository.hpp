@@ -11,6 +11,23 @@ public:
     virtual ~IIdempotencyRepository() = default;
     virtual std::optional<domain::IdempotencyRecord> find(const std::string& key) = 0;
     virtual void save(const std::string& key, int status, const std::string& body) = 0;
+
+    /**
+     * @brief Найти сохранённый ответ или занять ключ под обработку запроса
+     *
+     * Хранилища, которые видят параллельные запросы, ждут, пока первый
+     * запрос с тем же ключом сохранит ответ (save) или отпустит ключ (release).
+     *
+     * @return сохранённый ответ - повтор; nullopt - ключ занят вызывающим
+     */
+    virtual std::optional<domain::IdempotencyRecord> claim(const std::string& key) {
+        return find(key);
+    }
+
+    /**
+     * @brief Отпустить занятый ключ без сохранения ответа (ошибка обработки)
+     */
+    virtual void release(const std::string& /*key*/) {}
 };
 
 } // namespace trading::ports::output
@@ -11,6 +11,9 @@ namespace trading::settings {
  * Читает из ENV:
  * - AUTH_SERVICE_HOST (default: "auth-service")
  * - AUTH_SERVICE_PORT (default: 8080)
+ * - AUTH_BATCH_WINDOW_MS (default: 2) - сколько BatchingAuthClient копит
+ *   одновременные валидации в один /validate/batch; 0 - без склейки
+ * - AUTH_BATCH_MAX_SIZE (default: 64) - пачка отправляется сразу, набрав столько токенов
  */
 class AuthClientSettings {
 public:
@@ -21,14 +24,24 @@ public:
         if (const char* port = std::getenv("AUTH_SERVICE_PORT")) {
             port_ = std::stoi(port);
         }
+        if (const char* window = std::getenv("AUTH_BATCH_WINDOW_MS")) {
+            batchWindowMs_ = std::stoi(window);
+        }
+        if (const char* size = std::getenv("AUTH_BATCH_MAX_SIZE")) {
+            batchMaxSize_ = std::stoi(size);
+        }
     }
     
     std::string getHost() const { return host_; }
     int getPort() const { return port_; }
+    int getBatchWindowMs() const { return batchWindowMs_; }
+    int getBatchMaxSize() const { return batchMaxSize_; }
 
 private:
     std::string host_ = "auth-service";
     int port_ = 8080;
+    int batchWindowMs_ = 2;
+    int batchMaxSize_ = 64;
 };
 
 } // namespace trading::settings
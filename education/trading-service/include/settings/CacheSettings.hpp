@@ -13,6 +13,13 @@ namespace trading::settings {
  * - CACHE_QUOTE_TTL_SECONDS (default: 10)
  * - CACHE_INSTRUMENT_SIZE (default: 500)
  * - CACHE_INSTRUMENT_TTL_SECONDS (default: 3600)
+ * - CACHE_QUOTE_STALE_SECONDS (default: 0) - сколько после TTL отдавать
+ *   устаревшую котировку, пока её обновляет фоновый запрос (0 - выключено)
+ * - CACHE_INSTRUMENT_STALE_SECONDS (default: 0) - то же для инструментов
+ * - CACHE_ORDER_SIZE (default: 100000) - ордеров в OrderProjection
+ * - CACHE_TOKEN_SIZE (default: 10000) - проверенных access-токенов
+ * - CACHE_TOKEN_MAX_TTL_SECONDS (default: 300) - верхняя граница хранения,
+ *   если событие отзыва потеряется (иначе - до exp токена)
  */
 class CacheSettings {
 public:
@@ -29,18 +36,43 @@ public:
         if (const char* val = std::getenv("CACHE_INSTRUMENT_TTL_SECONDS")) {
             instrumentTtlSeconds_ = std::stoi(val);
         }
+        if (const char* val = std::getenv("CACHE_QUOTE_STALE_SECONDS")) {
+            quoteStaleSeconds_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("CACHE_INSTRUMENT_STALE_SECONDS")) {
+            instrumentStaleSeconds_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("CACHE_ORDER_SIZE")) {
+            orderCacheSize_ = static_cast<size_t>(std::stoi(val));
+        }
+        if (const char* val = std::getenv("CACHE_TOKEN_SIZE")) {
+            tokenCacheSize_ = static_cast<size_t>(std::stoi(val));
+        }
+        if (const char* val = std::getenv("CACHE_TOKEN_MAX_TTL_SECONDS")) {
+            tokenMaxTtlSeconds_ = std::stoi(val);
+        }
     }
     
     size_t getQuoteCacheSize() const { return quoteCacheSize_; }
     int getQuoteTtlSeconds() const { return quoteTtlSeconds_; }
     size_t getInstrumentCacheSize() const { return instrumentCacheSize_; }
     int getInstrumentTtlSeconds() const { return instrumentTtlSeconds_; }
+    int getQuoteStaleSeconds() const { return quoteStaleSeconds_; }
+    int getInstrumentStaleSeconds() const { return instrumentStaleSeconds_; }
+    size_t getOrderCacheSize() const { return orderCacheSize_; }
+    size_t getTokenCacheSize() const { return tokenCacheSize_; }
+    int getTokenMaxTtlSeconds() const { return tokenMaxTtlSeconds_; }
 
 private:
     size_t quoteCacheSize_ = 1000;
     int quoteTtlSeconds_ = 10;
     size_t instrumentCacheSize_ = 500;
     int instrumentTtlSeconds_ = 3600;
+    int quoteStaleSeconds_ = 0;
+    int instrumentStaleSeconds_ = 0;
+    size_t orderCacheSize_ = 100000;
+    size_t tokenCacheSize_ = 10000;
+    int tokenMaxTtlSeconds_ = 300;
 };
 
 } // namespace trading::settings
@@ -12,6 +12,10 @@ namespace trading::settings
      * @brief Настройки подключения к PostgreSQL
      *
      * Читает параметры из переменных окружения (K8s ENV).
+     *
+     * Пул соединений:
+     * - TRADING_DB_POOL_SIZE: максимум соединений (default: 4)
+     * - TRADING_DB_POOL_TIMEOUT_MS: ожидание свободного соединения (default: 2000)
      */
     class DbSettings
     {
@@ -23,6 +27,8 @@ namespace trading::settings
             name_ = getEnvOrDefault("TRADING_DB_NAME", "trading_db");
             user_ = getEnvOrDefault("TRADING_DB_USER", "trading_user");
             password_ = getEnvOrDefault("TRADING_DB_PASSWORD", "trading_secret_password");
+            poolSize_ = std::stoi(getEnvOrDefault("TRADING_DB_POOL_SIZE", "4"));
+            poolTimeoutMs_ = std::stoi(getEnvOrDefault("TRADING_DB_POOL_TIMEOUT_MS", "2000"));
         }
 
         std::string getHost() const { return host_; }
@@ -30,6 +36,8 @@ namespace trading::settings
         std::string getName() const { return name_; }
         std::string getUser() const { return user_; }
         std::string getPassword() const { return password_; }
+        int getPoolSize() const { return poolSize_; }
+        int getPoolTimeoutMs() const { return poolTimeoutMs_; }
 
         std::string getConnectionString() const
         {
@@ -43,6 +51,8 @@ namespace trading::settings
         std::string name_;
         std::string user_;
         std::string password_;
+        int poolSize_;
+        int poolTimeoutMs_;
 
         static std::string getEnvOrDefault(const char *name, const char *defaultValue)
         {
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace trading::settings {
+
+/**
+ * @brief Настройки keep-alive пулов HTTP-соединений к auth-service и broker-service
+ *
+ * Читает из ENV (значения общие, пул у каждого upstream свой):
+ * - HTTP_POOL_SIZE (default: 8) - сколько простаивающих соединений держать
+ * - HTTP_POOL_IDLE_TIMEOUT_MS (default: 30000) - простаивающее дольше закрывается
+ * - HTTP_REQUEST_TIMEOUT_MS (default: 2000) - на весь запрос, включая ожидание
+ *   слота и установку соединения
+ * - HTTP_MAX_IN_FLIGHT (default: 64) - одновременных запросов к upstream
+ */
+class HttpPoolSettings {
+public:
+    HttpPoolSettings() {
+        if (const char* val = std::getenv("HTTP_POOL_SIZE")) {
+            poolSize_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("HTTP_POOL_IDLE_TIMEOUT_MS")) {
+            idleTimeoutMs_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("HTTP_REQUEST_TIMEOUT_MS")) {
+            requestTimeoutMs_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("HTTP_MAX_IN_FLIGHT")) {
+            maxInFlight_ = std::stoi(val);
+        }
+
+        if (poolSize_ < 0 || idleTimeoutMs_ <= 0 || requestTimeoutMs_ <= 0 || maxInFlight_ <= 0) {
+            throw std::invalid_argument(
+                "[HttpPoolSettings] pool size must be >= 0, timeouts and in-flight limit > 0");
+        }
+    }
+
+    int getPoolSize() const { return poolSize_; }
+    int getIdleTimeoutMs() const { return idleTimeoutMs_; }
+    int getRequestTimeoutMs() const { return requestTimeoutMs_; }
+    int getMaxInFlight() const { return maxInFlight_; }
+
+private:
+    int poolSize_ = 8;
+    int idleTimeoutMs_ = 30000;
+    int requestTimeoutMs_ = 2000;
+    int maxInFlight_ = 64;
+};
+
+} // namespace trading::settings
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace trading::settings {
+
+/**
+ * @brief Настройки хранилища ключей идемпотентности
+ *
+ * Читает из ENV:
+ * - IDEMPOTENCY_CACHE_SIZE (default: 10000) - ответов в памяти процесса
+ * - IDEMPOTENCY_KEY_TTL_SECONDS (default: 86400) - сколько ключ защищает от повтора
+ * - IDEMPOTENCY_PURGE_INTERVAL_SECONDS (default: 300) - период чистки истёкших ключей в БД
+ * - IDEMPOTENCY_PURGE_BATCH (default: 1000) - строк за один DELETE
+ * - IDEMPOTENCY_INFLIGHT_TIMEOUT_MS (default: 5000) - сколько повтор ждёт первый
+ *   запрос с тем же ключом; после этого ключ считается брошенным
+ */
+class IdempotencySettings {
+public:
+    IdempotencySettings() {
+        if (const char* val = std::getenv("IDEMPOTENCY_CACHE_SIZE")) {
+            cacheSize_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("IDEMPOTENCY_KEY_TTL_SECONDS")) {
+            keyTtlSeconds_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("IDEMPOTENCY_PURGE_INTERVAL_SECONDS")) {
+            purgeIntervalSeconds_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("IDEMPOTENCY_PURGE_BATCH")) {
+            purgeBatch_ = std::stoi(val);
+        }
+        if (const char* val = std::getenv("IDEMPOTENCY_INFLIGHT_TIMEOUT_MS")) {
+            inFlightTimeoutMs_ = std::stoi(val);
+        }
+
+        if (cacheSize_ < 0 || keyTtlSeconds_ <= 0 || purgeIntervalSeconds_ <= 0 ||
+            purgeBatch_ <= 0 || inFlightTimeoutMs_ <= 0) {
+            throw std::invalid_argument(
+                "[IdempotencySettings] cache size must be >= 0, other values > 0");
+        }
+    }
+
+    int getCacheSize() const { return cacheSize_; }
+    int getKeyTtlSeconds() const { return keyTtlSeconds_; }
+    int getPurgeIntervalSeconds() const { return purgeIntervalSeconds_; }
+    int getPurgeBatch() const { return purgeBatch_; }
+    int getInFlightTimeoutMs() const { return inFlightTimeoutMs_; }
+
+private:
+    int cacheSize_ = 10000;
+    int keyTtlSeconds_ = 86400;
+    int purgeIntervalSeconds_ = 300;
+    int purgeBatch_ = 1000;
+    int inFlightTimeoutMs_ = 5000;
+};
+
+} // namespace trading::settings
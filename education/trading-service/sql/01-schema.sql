@@ -59,3 +59,4 @@ CREATE INDEX IF NOT EXISTS idx_orders_user_id ON orders(user_id);
 CREATE INDEX IF NOT EXISTS idx_orders_status ON orders(status);
 CREATE INDEX IF NOT EXISTS idx_executions_order_id ON executions(order_id);
 CREATE INDEX IF NOT EXISTS idx_portfolio_account_id ON portfolio_positions(account_id);
+CREATE INDEX IF NOT EXISTS idx_idempotency_keys_created_at ON idempotency_keys(created_at);
@@ -0,0 +1,142 @@
+/**
+ * @file BatchingAuthClientTest.cpp
+ * @brief Unit tests for BatchingAuthClient: склейка одновременных валидаций в пачку
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/BatchingAuthClient.hpp"
+#include "../mocks/MockAuthClient.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace trading;
+using namespace trading::adapters::secondary;
+
+namespace {
+
+/**
+ * @brief Делегат, у которого пачка падает
+ */
+class FailingAuthClient : public tests::MockAuthClient {
+public:
+    std::vector<ports::output::TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>&) override {
+        throw std::runtime_error("connection refused");
+    }
+};
+
+} // namespace
+
+class BatchingAuthClientTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        delegate_ = std::make_shared<tests::MockAuthClient>();
+        for (int i = 0; i < 8; ++i) {
+            delegate_->addValidToken("token-" + std::to_string(i), "user-" + std::to_string(i),
+                                     "acc-" + std::to_string(i));
+        }
+    }
+
+    void TearDown() override {
+        unsetenv("AUTH_BATCH_WINDOW_MS");
+        unsetenv("AUTH_BATCH_MAX_SIZE");
+    }
+
+    std::unique_ptr<BatchingAuthClient> create(std::shared_ptr<ports::output::IAuthClient> delegate,
+                                               int windowMs, int maxSize) {
+        setenv("AUTH_BATCH_WINDOW_MS", std::to_string(windowMs).c_str(), 1);
+        setenv("AUTH_BATCH_MAX_SIZE", std::to_string(maxSize).c_str(), 1);
+        return std::make_unique<BatchingAuthClient>(
+            std::move(delegate), std::make_shared<settings::AuthClientSettings>());
+    }
+
+    std::shared_ptr<tests::MockAuthClient> delegate_;
+};
+
+TEST_F(BatchingAuthClientTest, ConcurrentCalls_OneUpstreamBatch) {
+    auto client = create(delegate_, 200, 64);
+
+    std::vector<ports::output::TokenValidationResult> results(8);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&, i] {
+            results[i] = client->validateAccessToken("token-" + std::to_string(i));
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(results[i].valid);
+        EXPECT_EQ(results[i].accountId, "acc-" + std::to_string(i));
+    }
+    EXPECT_EQ(delegate_->validateCallCount(), 0);
+    EXPECT_EQ(delegate_->batchCallCount(), 1);
+    EXPECT_EQ(client->stats().batches, 1u);
+    EXPECT_EQ(client->stats().tokens, 8u);
+}
+
+TEST_F(BatchingAuthClientTest, FullBatch_SentWithoutWaitingWindow) {
+    auto client = create(delegate_, 10000, 4);
+
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&, i] {
+            EXPECT_TRUE(client->validateAccessToken("token-" + std::to_string(i)).valid);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(5));
+    EXPECT_EQ(delegate_->batchCallCount(), 1);
+}
+
+TEST_F(BatchingAuthClientTest, MixedTokens_EachGetsOwnResult) {
+    auto client = create(delegate_, 200, 64);
+
+    // Валидные и неизвестные токены в одной пачке: каждый получает свой ответ
+    const std::vector<std::string> tokens = {"token-3", "unknown-1", "token-5", "unknown-2"};
+    std::vector<std::optional<std::string>> accounts(tokens.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < tokens.size(); ++i) {
+        threads.emplace_back([&, i] {
+            accounts[i] = client->getAccountIdFromToken(tokens[i]);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    EXPECT_EQ(accounts[0], "acc-3");
+    EXPECT_FALSE(accounts[1].has_value());
+    EXPECT_EQ(accounts[2], "acc-5");
+    EXPECT_FALSE(accounts[3].has_value());
+    EXPECT_EQ(delegate_->batchCallCount(), 1);
+    EXPECT_EQ(client->stats().tokens, 4u);
+}
+
+TEST_F(BatchingAuthClientTest, ZeroWindow_PassesThrough) {
+    auto client = create(delegate_, 0, 64);
+
+    EXPECT_TRUE(client->validateAccessToken("token-1").valid);
+    EXPECT_EQ(delegate_->validateCallCount(), 1);
+    EXPECT_EQ(delegate_->batchCallCount(), 0);
+}
+
+TEST_F(BatchingAuthClientTest, UpstreamFailure_AllInvalid) {
+    auto client = create(std::make_shared<FailingAuthClient>(), 1, 64);
+
+    auto result = client->validateAccessToken("token-1");
+
+    EXPECT_FALSE(result.valid);
+    EXPECT_NE(result.message.find("connection refused"), std::string::npos);
+}
@@ -0,0 +1,266 @@
+/**
+ * @file CachedAuthClientTest.cpp
+ * @brief Unit tests for CachedAuthClient: кэш валидаций и отзыв по auth.session.revoked
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/CachedAuthClient.hpp"
+#include "../mocks/MockAuthClient.hpp"
+
+#include <openssl/sha.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+using namespace trading;
+using namespace trading::adapters::secondary;
+
+namespace {
+
+// ============================================================================
+// Fake IEventConsumer
+// ============================================================================
+
+class RevocationFeed : public ports::input::IEventConsumer {
+public:
+    void subscribe(const std::vector<std::string>& routingKeys, ports::input::EventHandler handler) override {
+        keys = routingKeys;
+        handler_ = std::move(handler);
+    }
+
+    void start() override {}
+    void stop() override {}
+
+    void deliver(const std::string& message) {
+        handler_("auth.session.revoked", message);
+    }
+
+    void revoke(const std::string& userId) {
+        deliver(R"({"user_id":")" + userId + R"(","revoked_at":1})");
+    }
+
+    std::vector<std::string> keys;
+
+private:
+    ports::input::EventHandler handler_;
+};
+
+/**
+ * @brief Делегат, во время запроса которого приходит отзыв сессии
+ */
+class RevokingAuthClient : public tests::MockAuthClient {
+public:
+    std::function<void()> duringValidation;
+
+    ports::output::TokenValidationResult validateAccessToken(const std::string& token) override {
+        if (duringValidation) {
+            duringValidation();
+        }
+        return MockAuthClient::validateAccessToken(token);
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class CachedAuthClientTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        delegate_ = std::make_shared<RevokingAuthClient>();
+        delegate_->addValidToken("token-a1", "user-a", "acc-a1");
+        delegate_->addValidToken("token-a2", "user-a", "acc-a2");
+        delegate_->addValidToken("token-b", "user-b", "acc-b");
+        consumer_ = std::make_shared<RevocationFeed>();
+    }
+
+    void TearDown() override {
+        unsetenv("CACHE_TOKEN_SIZE");
+        unsetenv("CACHE_TOKEN_MAX_TTL_SECONDS");
+    }
+
+    std::unique_ptr<CachedAuthClient> create() {
+        return std::make_unique<CachedAuthClient>(
+            delegate_, consumer_, std::make_shared<settings::CacheSettings>());
+    }
+
+    /// Сегмент, в который CachedAuthClient положит токен (первый байт SHA-256)
+    static size_t shardOf(const std::string& token) {
+        unsigned char digest[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<const unsigned char*>(token.data()), token.size(), digest);
+        return digest[0] % CachedAuthClient::SHARDS;
+    }
+
+    static int64_t nowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    std::shared_ptr<RevokingAuthClient> delegate_;
+    std::shared_ptr<RevocationFeed> consumer_;
+};
+
+// ============================================================================
+// CACHE
+// ============================================================================
+
+TEST_F(CachedAuthClientTest, RepeatedToken_ValidatedOnce) {
+    auto client = create();
+
+    EXPECT_EQ(client->getAccountIdFromToken("token-a1"), "acc-a1");
+    EXPECT_EQ(client->getAccountIdFromToken("token-a1"), "acc-a1");
+    auto cached = client->validateAccessToken("token-a1");
+
+    EXPECT_TRUE(cached.valid);
+    EXPECT_EQ(cached.userId, "user-a");
+    EXPECT_EQ(delegate_->validateCallCount(), 1);
+    EXPECT_EQ(client->stats().hits, 2u);
+    EXPECT_EQ(client->stats().misses, 1u);
+}
+
+TEST_F(CachedAuthClientTest, Batch_HitsFromCache_MissesInOneUpstreamBatch) {
+    auto client = create();
+    client->validateAccessToken("token-a1");
+
+    auto results = client->validateAccessTokens({"token-b", "token-a1", "unknown", "token-a2"});
+
+    ASSERT_EQ(results.size(), 4u);
+    EXPECT_EQ(results[0].accountId, "acc-b");
+    EXPECT_EQ(results[1].accountId, "acc-a1");
+    EXPECT_FALSE(results[2].valid);
+    EXPECT_EQ(results[3].accountId, "acc-a2");
+    EXPECT_EQ(delegate_->batchCallCount(), 1);
+    EXPECT_EQ(client->stats().hits, 1u);
+
+    // Пачка положила валидные в кэш
+    client->validateAccessToken("token-b");
+    EXPECT_EQ(delegate_->validateCallCount(), 1);
+    EXPECT_EQ(client->validateAccessTokens({"token-a1", "token-a2"}).size(), 2u);
+    EXPECT_EQ(delegate_->batchCallCount(), 1);
+}
+
+TEST_F(CachedAuthClientTest, InvalidToken_NotCached) {
+    auto client = create();
+
+    EXPECT_FALSE(client->getAccountIdFromToken("unknown").has_value());
+    EXPECT_FALSE(client->getAccountIdFromToken("unknown").has_value());
+
+    EXPECT_EQ(delegate_->validateCallCount(), 2);
+    EXPECT_EQ(client->stats().entries, 0u);
+}
+
+TEST_F(CachedAuthClientTest, TokenExpiry_BoundsEntry) {
+    auto client = create();
+    delegate_->setExpiresAtMs(nowMs() + 50);
+
+    client->validateAccessToken("token-a1");
+    client->validateAccessToken("token-a1");
+    EXPECT_EQ(delegate_->validateCallCount(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    client->validateAccessToken("token-a1");
+    EXPECT_EQ(delegate_->validateCallCount(), 2);
+}
+
+TEST_F(CachedAuthClientTest, ZeroMaxTtl_DisablesCache) {
+    setenv("CACHE_TOKEN_MAX_TTL_SECONDS", "0", 1);
+    auto client = create();
+
+    client->validateAccessToken("token-a1");
+    client->validateAccessToken("token-a1");
+
+    EXPECT_EQ(delegate_->validateCallCount(), 2);
+}
+
+TEST_F(CachedAuthClientTest, Capacity_BoundsEntries) {
+    setenv("CACHE_TOKEN_SIZE", "32", 1);
+    auto client = create();
+    for (int i = 0; i < 200; ++i) {
+        std::string token = "token-" + std::to_string(i);
+        delegate_->addValidToken(token, "user-" + std::to_string(i), "acc");
+        client->validateAccessToken(token);
+    }
+
+    EXPECT_LE(client->stats().entries, 32u);
+}
+
+TEST_F(CachedAuthClientTest, FullShard_ExpiredEntryFreesSpace_LiveEntryKept) {
+    // Две записи на сегмент
+    setenv("CACHE_TOKEN_SIZE", std::to_string(2 * CachedAuthClient::SHARDS).c_str(), 1);
+    auto client = create();
+
+    std::vector<std::string> sameShard;
+    for (int i = 0; sameShard.size() < 3; ++i) {
+        std::string token = "shard-token-" + std::to_string(i);
+        if (shardOf(token) == shardOf("shard-token-0")) {
+            delegate_->addValidToken(token, "user-" + std::to_string(i), "acc");
+            sameShard.push_back(token);
+        }
+    }
+
+    delegate_->setExpiresAtMs(nowMs() + 50);
+    client->validateAccessToken(sameShard[0]);
+    delegate_->setExpiresAtMs(0);
+    client->validateAccessToken(sameShard[1]);
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+
+    client->validateAccessToken(sameShard[2]);
+    EXPECT_EQ(client->stats().entries, 2u);
+    EXPECT_EQ(delegate_->validateCallCount(), 3);
+
+    // Живая запись пережила вставку: хватило места истёкшей
+    client->validateAccessToken(sameShard[1]);
+    client->validateAccessToken(sameShard[2]);
+    EXPECT_EQ(delegate_->validateCallCount(), 3);
+}
+
+// ============================================================================
+// REVOCATION
+// ============================================================================
+
+TEST_F(CachedAuthClientTest, SessionRevoked_DropsOnlyThatUser) {
+    auto client = create();
+    EXPECT_EQ(consumer_->keys, std::vector<std::string>{"auth.session.revoked"});
+    client->validateAccessToken("token-a1");
+    client->validateAccessToken("token-a2");
+    client->validateAccessToken("token-b");
+
+    consumer_->revoke("user-a");
+
+    auto s = client->stats();
+    EXPECT_EQ(s.revocations, 1u);
+    EXPECT_EQ(s.revokedEntries, 2u);
+    EXPECT_EQ(s.entries, 1u);
+
+    // user-a снова идёт в auth-service, user-b - из кэша
+    delegate_->resetCallCount();
+    client->validateAccessToken("token-a1");
+    client->validateAccessToken("token-b");
+    EXPECT_EQ(delegate_->validateCallCount(), 1);
+}
+
+TEST_F(CachedAuthClientTest, RevokedWhileValidating_ResultNotCached) {
+    auto client = create();
+    delegate_->duringValidation = [this] { consumer_->revoke("user-a"); };
+
+    EXPECT_TRUE(client->validateAccessToken("token-a1").valid);
+    delegate_->duringValidation = nullptr;
+    client->validateAccessToken("token-a1");
+
+    EXPECT_EQ(delegate_->validateCallCount(), 2);
+}
+
+TEST_F(CachedAuthClientTest, MalformedRevocation_Ignored) {
+    auto client = create();
+    client->validateAccessToken("token-a1");
+
+    EXPECT_NO_THROW(consumer_->deliver("not json"));
+    EXPECT_NO_THROW(consumer_->deliver("{}"));
+
+    EXPECT_EQ(client->stats().revocations, 0u);
+    EXPECT_EQ(client->stats().entries, 1u);
+}
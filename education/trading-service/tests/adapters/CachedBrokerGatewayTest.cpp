@@ -6,10 +6,15 @@
 #include "settings/IBrokerClientSettings.hpp"
 #include <IHttpClient.hpp>
 
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
 using namespace trading;
 using namespace trading::adapters::secondary;
 using ::testing::Return;
 using ::testing::_;
+using ::testing::Invoke;
 
 // ============================================================================
 // Mocks
@@ -40,7 +45,7 @@ public:
     MOCK_METHOD(std::vector<domain::Instrument>, getAllInstruments, (), (override));
     MOCK_METHOD(std::vector<domain::Instrument>, searchInstruments, (const std::string& query), (override));
     MOCK_METHOD(domain::Portfolio, getPortfolio, (const std::string& accountId), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getOrders, (const std::string& accountId), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string& accountId, const domain::OrderPageQuery& query), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrder, (const std::string& accountId, const std::string& orderId), (override));
 };
 
@@ -270,14 +275,14 @@ TEST_F(CachedBrokerGatewayTest, GetPortfolio_NeverCaches) {
 }
 
 TEST_F(CachedBrokerGatewayTest, GetOrders_NeverCaches) {
-    std::vector<domain::Order> orders;
+    domain::OrderPage page;
     
-    EXPECT_CALL(*mockDelegate_, getOrders("acc-1"))
+    EXPECT_CALL(*mockDelegate_, getOrders("acc-1", _))
         .Times(2)
-        .WillRepeatedly(Return(orders));
+        .WillRepeatedly(Return(page));
 
-    cachedGateway_->getOrders("acc-1");
-    cachedGateway_->getOrders("acc-1");
+    cachedGateway_->getOrders("acc-1", {});
+    cachedGateway_->getOrders("acc-1", {});
 }
 
 // ============================================================================
@@ -308,3 +313,160 @@ TEST_F(CachedBrokerGatewayTest, ClearInstrumentCache_InvalidatesEntries) {
     cachedGateway_->getInstrumentByFigi("BBG004730N88");
 }
 
+
+// ============================================================================
+// ТЕСТЫ: Склейка одновременных промахов
+// ============================================================================
+
+namespace {
+
+/// Ждать условия не дольше секунды
+template<typename Pred>
+bool waitFor(Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!pred()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_F(CachedBrokerGatewayTest, GetQuote_ConcurrentMisses_OneUpstreamCall) {
+    constexpr int CALLERS = 8;
+    auto sberQuote = createQuote("BBG004730N88", "SBER", 280.0);
+
+    // Ведущий отвечает, только когда остальные уже ждут его
+    EXPECT_CALL(*mockDelegate_, getQuote("BBG004730N88"))
+        .Times(1)
+        .WillOnce(Invoke([&](const std::string&) {
+            waitFor([&] { return cachedGateway_->stats().quotes.coalesced == CALLERS - 1; });
+            return std::optional<domain::Quote>(sberQuote);
+        }));
+
+    std::vector<std::thread> callers;
+    std::atomic<int> found{0};
+    for (int i = 0; i < CALLERS; ++i) {
+        callers.emplace_back([&] {
+            if (cachedGateway_->getQuote("BBG004730N88")) {
+                ++found;
+            }
+        });
+    }
+    for (auto& t : callers) {
+        t.join();
+    }
+
+    EXPECT_EQ(found.load(), CALLERS);
+    auto stats = cachedGateway_->stats();
+    EXPECT_EQ(stats.quotes.misses, static_cast<uint64_t>(CALLERS));
+    EXPECT_EQ(stats.quotes.coalesced, static_cast<uint64_t>(CALLERS - 1));
+    EXPECT_EQ(stats.inFlight, 0u);
+}
+
+TEST_F(CachedBrokerGatewayTest, GetInstrumentByFigi_UpstreamError_PropagatesToWaiters) {
+    EXPECT_CALL(*mockDelegate_, getInstrumentByFigi("BBG004730N88"))
+        .Times(2)
+        .WillOnce(Invoke([&](const std::string&) -> std::optional<domain::Instrument> {
+            waitFor([&] { return cachedGateway_->stats().instruments.coalesced == 1; });
+            throw std::runtime_error("broker-service unavailable");
+        }))
+        .WillOnce(Return(createInstrument("BBG004730N88", "SBER", "Сбербанк")));
+
+    std::atomic<int> errors{0};
+    auto call = [&] {
+        try {
+            cachedGateway_->getInstrumentByFigi("BBG004730N88");
+        } catch (const std::runtime_error&) {
+            ++errors;
+        }
+    };
+    std::thread leader(call);
+    std::thread follower(call);
+    leader.join();
+    follower.join();
+
+    EXPECT_EQ(errors.load(), 2);
+    // Ошибка не кэшируется: следующий вызов снова идёт в broker-service
+    EXPECT_TRUE(cachedGateway_->getInstrumentByFigi("BBG004730N88").has_value());
+}
+
+TEST_F(CachedBrokerGatewayTest, GetQuotes_FigiAlreadyInFlight_NotRequestedAgain) {
+    auto sberQuote = createQuote("BBG004730N88", "SBER", 280.0);
+    auto gazpQuote = createQuote("BBG004730RP0", "GAZP", 150.0);
+
+    EXPECT_CALL(*mockDelegate_, getQuote("BBG004730N88"))
+        .WillOnce(Invoke([&](const std::string&) {
+            waitFor([&] { return cachedGateway_->stats().quotes.coalesced == 1; });
+            return std::optional<domain::Quote>(sberQuote);
+        }));
+    EXPECT_CALL(*mockDelegate_, getQuotes(std::vector<std::string>{"BBG004730RP0"}))
+        .WillOnce(Return(std::vector<domain::Quote>{gazpQuote}));
+
+    std::thread single([&] { cachedGateway_->getQuote("BBG004730N88"); });
+    ASSERT_TRUE(waitFor([&] { return cachedGateway_->stats().inFlight == 1; }));
+
+    auto result = cachedGateway_->getQuotes({"BBG004730N88", "BBG004730RP0"});
+    single.join();
+
+    ASSERT_EQ(result.size(), 2u);
+    EXPECT_EQ(result[0].ticker, "GAZP");
+    EXPECT_EQ(result[1].ticker, "SBER");
+}
+
+// ============================================================================
+// ТЕСТЫ: Stale-while-revalidate
+// ============================================================================
+
+class CachedBrokerGatewayStaleTest : public CachedBrokerGatewayTest {
+protected:
+    void SetUp() override {
+        // TTL 0: запись устаревает сразу, но ещё минуту отдаётся
+        setenv("CACHE_QUOTE_TTL_SECONDS", "0", 1);
+        setenv("CACHE_QUOTE_STALE_SECONDS", "60", 1);
+        CachedBrokerGatewayTest::SetUp();
+    }
+
+    void TearDown() override {
+        cachedGateway_.reset();
+        unsetenv("CACHE_QUOTE_TTL_SECONDS");
+        unsetenv("CACHE_QUOTE_STALE_SECONDS");
+    }
+};
+
+TEST_F(CachedBrokerGatewayStaleTest, ExpiredQuote_ServedWhileRefreshedInBackground) {
+    EXPECT_CALL(*mockDelegate_, getQuote("BBG004730N88"))
+        .WillOnce(Return(createQuote("BBG004730N88", "SBER", 280.0)))
+        .WillRepeatedly(Return(createQuote("BBG004730N88", "SBER", 281.0)));
+
+    cachedGateway_->getQuote("BBG004730N88");
+    auto stale = cachedGateway_->getQuote("BBG004730N88");
+
+    ASSERT_TRUE(stale.has_value());
+    EXPECT_DOUBLE_EQ(stale->lastPrice.toDouble(), 280.0);
+    ASSERT_TRUE(waitFor([&] { return cachedGateway_->stats().refreshes >= 1; }));
+
+    auto refreshed = cachedGateway_->getQuote("BBG004730N88");
+    ASSERT_TRUE(refreshed.has_value());
+    EXPECT_DOUBLE_EQ(refreshed->lastPrice.toDouble(), 281.0);
+    EXPECT_EQ(cachedGateway_->stats().quotes.staleServed, 2u);
+}
+
+TEST_F(CachedBrokerGatewayStaleTest, RefreshFailure_KeepsServingStaleValue) {
+    EXPECT_CALL(*mockDelegate_, getQuote("BBG004730N88"))
+        .WillOnce(Return(createQuote("BBG004730N88", "SBER", 280.0)))
+        .WillRepeatedly(Invoke([](const std::string&) -> std::optional<domain::Quote> {
+            throw std::runtime_error("broker-service unavailable");
+        }));
+
+    cachedGateway_->getQuote("BBG004730N88");
+    cachedGateway_->getQuote("BBG004730N88");
+    ASSERT_TRUE(waitFor([&] { return cachedGateway_->stats().refreshErrors >= 1; }));
+
+    auto quote = cachedGateway_->getQuote("BBG004730N88");
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_DOUBLE_EQ(quote->lastPrice.toDouble(), 280.0);
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "adapters/secondary/HttpAuthClient.hpp"
+#include <IHttpClient.hpp>
+#include <SimpleResponse.hpp>
+
+using namespace trading;
+using namespace trading::adapters::secondary;
+using ::testing::_;
+
+// ============================================================================
+// Mocks
+// ============================================================================
+
+class MockHttpClient : public IHttpClient {
+public:
+    MOCK_METHOD(bool, send, (const IRequest& req, IResponse& res), (override));
+};
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class HttpAuthClientTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mockHttpClient_ = std::make_shared<MockHttpClient>();
+        client_ = std::make_shared<HttpAuthClient>(
+            mockHttpClient_, std::make_shared<settings::AuthClientSettings>());
+    }
+
+    /// Отвечает на /validate/batch: токен "ok-*" валиден
+    static bool answerBatch(const IRequest& req, IResponse& res) {
+        EXPECT_EQ(req.getPath(), "/api/v1/auth/validate/batch");
+        auto body = nlohmann::json::parse(req.getBody());
+        EXPECT_EQ(body["type"], "access");
+
+        nlohmann::json results = nlohmann::json::array();
+        for (const auto& token : body["tokens"]) {
+            std::string t = token.get<std::string>();
+            if (t.rfind("ok-", 0) == 0) {
+                results.push_back({{"valid", true}, {"user_id", "user-1"}, {"account_id", t},
+                                   {"expires_at", 1700000000000}});
+            } else {
+                results.push_back({{"valid", false}, {"message", "Invalid or expired token"}});
+            }
+        }
+        auto& simpleRes = dynamic_cast<SimpleResponse&>(res);
+        simpleRes.setStatus(200);
+        simpleRes.setBody(nlohmann::json{{"results", results}}.dump());
+        return true;
+    }
+
+    std::shared_ptr<MockHttpClient> mockHttpClient_;
+    std::shared_ptr<HttpAuthClient> client_;
+};
+
+// ============================================================================
+// ТЕСТЫ: validateAccessTokens
+// ============================================================================
+
+TEST_F(HttpAuthClientTest, ValidateAccessTokens_ResultsInOrder) {
+    EXPECT_CALL(*mockHttpClient_, send(_, _)).WillOnce(&HttpAuthClientTest::answerBatch);
+
+    auto results = client_->validateAccessTokens({"ok-1", "bad", "ok-2"});
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].valid);
+    EXPECT_EQ(results[0].accountId, "ok-1");
+    EXPECT_EQ(results[0].expiresAtMs, 1700000000000);
+    EXPECT_FALSE(results[1].valid);
+    EXPECT_EQ(results[1].message, "Invalid or expired token");
+    EXPECT_EQ(results[2].accountId, "ok-2");
+}
+
+TEST_F(HttpAuthClientTest, ValidateAccessTokens_SplitsOverMaxBatch) {
+    EXPECT_CALL(*mockHttpClient_, send(_, _))
+        .Times(2)
+        .WillRepeatedly(&HttpAuthClientTest::answerBatch);
+
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < HttpAuthClient::MAX_BATCH + 1; ++i) {
+        tokens.push_back("ok-" + std::to_string(i));
+    }
+    auto results = client_->validateAccessTokens(tokens);
+
+    ASSERT_EQ(results.size(), tokens.size());
+    EXPECT_EQ(results.back().accountId, tokens.back());
+}
+
+TEST_F(HttpAuthClientTest, ValidateAccessTokens_ServerError_AllInvalid) {
+    EXPECT_CALL(*mockHttpClient_, send(_, _))
+        .WillOnce([](const IRequest&, IResponse& res) {
+            auto& simpleRes = dynamic_cast<SimpleResponse&>(res);
+            simpleRes.setStatus(503);
+            simpleRes.setBody("");
+            return true;
+        });
+
+    auto results = client_->validateAccessTokens({"ok-1", "ok-2"});
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[0].valid);
+    EXPECT_FALSE(results[1].valid);
+    EXPECT_EQ(results[1].message, "Auth service returned 503");
+}
+
+TEST_F(HttpAuthClientTest, ValidateAccessTokens_MalformedItem_ChunkFailsWithoutShift) {
+    EXPECT_CALL(*mockHttpClient_, send(_, _))
+        .WillOnce([](const IRequest& req, IResponse& res) {
+            // Ответ нужной длины, но второй элемент - не объект
+            answerBatch(req, res);
+            auto& simpleRes = dynamic_cast<SimpleResponse&>(res);
+            auto body = nlohmann::json::parse(simpleRes.getBody());
+            body["results"][1] = "oops";
+            simpleRes.setBody(body.dump());
+            return true;
+        })
+        .WillOnce(&HttpAuthClientTest::answerBatch);
+
+    std::vector<std::string> tokens;
+    for (size_t i = 0; i < HttpAuthClient::MAX_BATCH + 2; ++i) {
+        tokens.push_back("ok-" + std::to_string(i));
+    }
+    auto results = client_->validateAccessTokens(tokens);
+
+    ASSERT_EQ(results.size(), tokens.size());
+    for (size_t i = 0; i < HttpAuthClient::MAX_BATCH; ++i) {
+        EXPECT_FALSE(results[i].valid) << i;
+    }
+    EXPECT_EQ(results[HttpAuthClient::MAX_BATCH].accountId, tokens[HttpAuthClient::MAX_BATCH]);
+    EXPECT_EQ(results.back().accountId, tokens.back());
+}
@@ -289,12 +289,13 @@ TEST_F(HttpBrokerGatewayTest, GetOrders_ArrayResponse_ParsesCorrectly) {
         {"id":"order-1","account_id":"acc-1","figi":"BBG004730N88","direction":"BUY","type":"MARKET","quantity":10,"price":280.0,"status":"PENDING","currency":"RUB"}
     ])";
     
-    expectGetRequest("/api/v1/orders?account_id=acc-1", 200, response);
+    expectGetRequest("/api/v1/orders?account_id=acc-1&limit=100", 200, response);
     
-    auto orders = gateway_->getOrders("acc-1");
+    auto page = gateway_->getOrders("acc-1", {});
     
-    ASSERT_EQ(orders.size(), 1);
-    EXPECT_EQ(orders[0].id, "order-1");
+    ASSERT_EQ(page.orders.size(), 1);
+    EXPECT_EQ(page.orders[0].id, "order-1");
+    EXPECT_FALSE(page.nextCursor.has_value());
 }
 
 TEST_F(HttpBrokerGatewayTest, GetOrders_ObjectResponse_ParsesCorrectly) {
@@ -304,10 +305,62 @@ TEST_F(HttpBrokerGatewayTest, GetOrders_ObjectResponse_ParsesCorrectly) {
         ]
     })";
     
-    expectGetRequest("/api/v1/orders?account_id=acc-1", 200, response);
+    expectGetRequest("/api/v1/orders?account_id=acc-1&limit=100", 200, response);
     
-    auto orders = gateway_->getOrders("acc-1");
+    auto page = gateway_->getOrders("acc-1", {});
     
-    ASSERT_EQ(orders.size(), 1);
-    EXPECT_EQ(orders[0].id, "order-1");
+    ASSERT_EQ(page.orders.size(), 1);
+    EXPECT_EQ(page.orders[0].id, "order-1");
+}
+
+TEST_F(HttpBrokerGatewayTest, GetOrders_SinglePage_ReturnsNextCursor) {
+    expectGetRequest("/api/v1/orders?account_id=acc-1&limit=2", 200, R"({
+        "orders": [
+            {"order_id":"order-3","account_id":"acc-1","figi":"BBG004730N88","direction":"BUY","order_type":"MARKET","quantity":1,"status":"FILLED"},
+            {"order_id":"order-2","account_id":"acc-1","figi":"BBG004730N88","direction":"SELL","order_type":"LIMIT","quantity":2,"status":"PENDING"}
+        ],
+        "next_cursor": "1760000000000000_order-2"
+    })");
+
+    domain::OrderPageQuery query;
+    query.limit = 2;
+    auto page = gateway_->getOrders("acc-1", query);
+
+    ASSERT_EQ(page.orders.size(), 2);
+    EXPECT_EQ(page.orders[0].id, "order-3");
+    EXPECT_EQ(page.orders[1].quantity, 2);
+    EXPECT_EQ(page.nextCursor, "1760000000000000_order-2");
+}
+
+TEST_F(HttpBrokerGatewayTest, GetOrders_QueryParameters_PassedAndCursorEncoded) {
+    expectGetRequest(
+        "/api/v1/orders?account_id=acc-1&limit=50&cursor=1760000000000000_order%202%2Fx%26limit%3D1"
+        "&from=1760000000000&to=1760086400000&status=FILLED",
+        200, R"({"orders": [], "next_cursor": null})");
+
+    domain::OrderPageQuery query;
+    query.limit = 50;
+    query.cursor = "1760000000000000_order 2/x&limit=1";
+    query.fromMs = 1760000000000;
+    query.toMs = 1760086400000;
+    query.status = domain::OrderStatus::FILLED;
+    auto page = gateway_->getOrders("acc-1", query);
+
+    EXPECT_TRUE(page.orders.empty());
+    EXPECT_FALSE(page.nextCursor.has_value());
+}
+
+TEST_F(HttpBrokerGatewayTest, GetOrders_BadRequest_ThrowsInvalidArgument) {
+    expectGetRequest("/api/v1/orders?account_id=acc-1&limit=100&cursor=garbage", 400,
+        R"({"error":"Invalid parameter 'cursor'"})");
+
+    domain::OrderPageQuery query;
+    query.cursor = "garbage";
+    EXPECT_THROW(gateway_->getOrders("acc-1", query), std::invalid_argument);
+}
+
+TEST_F(HttpBrokerGatewayTest, GetOrders_BrokerUnavailable_Throws) {
+    expectGetRequest("/api/v1/orders?account_id=acc-1&limit=100", 503, "");
+
+    EXPECT_THROW(gateway_->getOrders("acc-1", {}), std::runtime_error);
 }
@@ -0,0 +1,252 @@
+/**
+ * @file KeepAliveHttpClientTest.cpp
+ * @brief Unit tests for KeepAliveHttpClient against an in-process HTTP server
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/KeepAliveHttpClient.hpp"
+#include <SimpleRequest.hpp>
+#include <SimpleResponse.hpp>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace trading;
+using namespace trading::adapters::secondary;
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+using tcp = boost::asio::ip::tcp;
+
+// ============================================================================
+// Test server
+// ============================================================================
+
+/**
+ * @brief Синхронный keep-alive сервер на 127.0.0.1:<ephemeral>
+ *
+ * /slow    - отвечает через 200 мс
+ * /close   - отвечает с keep-alive и сразу закрывает соединение
+ * остальное - эхо пути
+ */
+class TestServer {
+public:
+    TestServer() : acceptor_(ioc_, tcp::endpoint(tcp::v4(), 0)) {
+        port_ = acceptor_.local_endpoint().port();
+        acceptThread_ = std::thread([this] { acceptLoop(); });
+    }
+
+    ~TestServer() {
+        stopped_ = true;
+        // Разбудить accept() подключением
+        try {
+            boost::asio::io_context ioc;
+            tcp::socket s(ioc);
+            s.connect(tcp::endpoint(boost::asio::ip::make_address("127.0.0.1"), port_));
+        } catch (...) {}
+        acceptThread_.join();
+        for (auto& t : sessions_) {
+            t.join();
+        }
+    }
+
+    int port() const { return port_; }
+
+    std::atomic<int> connections{0};
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+
+private:
+    void acceptLoop() {
+        while (true) {
+            tcp::socket socket(ioc_);
+            acceptor_.accept(socket);
+            if (stopped_) {
+                return;
+            }
+            ++connections;
+            sessions_.emplace_back([this, s = std::move(socket)]() mutable { serve(std::move(s)); });
+        }
+    }
+
+    void serve(tcp::socket socket) {
+        beast::flat_buffer buffer;
+        beast::error_code ec;
+        while (true) {
+            http::request<http::string_body> req;
+            http::read(socket, buffer, req, ec);
+            if (ec) {
+                return;
+            }
+
+            int now = ++active;
+            int prev = maxActive.load();
+            while (now > prev && !maxActive.compare_exchange_weak(prev, now)) {}
+
+            std::string target(req.target());
+            if (target == "/slow") {
+                std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            }
+
+            http::response<http::string_body> res(http::status::ok, req.version());
+            res.set(http::field::content_type, "text/plain");
+            res.keep_alive(true);
+            res.body() = target + "|" + req.body();
+            res.prepare_payload();
+            --active;
+            http::write(socket, res, ec);
+            if (ec || target == "/close") {
+                socket.shutdown(tcp::socket::shutdown_both, ec);
+                return;
+            }
+        }
+    }
+
+    boost::asio::io_context ioc_;
+    tcp::acceptor acceptor_;
+    int port_ = 0;
+    std::atomic<bool> stopped_{false};
+    std::thread acceptThread_;
+    std::vector<std::thread> sessions_;
+};
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class KeepAliveHttpClientTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        unsetenv("HTTP_POOL_SIZE");
+        unsetenv("HTTP_POOL_IDLE_TIMEOUT_MS");
+        unsetenv("HTTP_REQUEST_TIMEOUT_MS");
+        unsetenv("HTTP_MAX_IN_FLIGHT");
+    }
+
+    std::unique_ptr<KeepAliveHttpClient> create() {
+        return std::make_unique<KeepAliveHttpClient>(
+            "test", "127.0.0.1", server_.port(), std::make_shared<settings::HttpPoolSettings>());
+    }
+
+    SimpleResponse get(KeepAliveHttpClient& client, const std::string& path) {
+        SimpleRequest request("GET", path, "", "ignored", 1, {});
+        SimpleResponse response;
+        client.send(request, response);
+        return response;
+    }
+
+    TestServer server_;
+};
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST_F(KeepAliveHttpClientTest, SequentialRequests_ReuseOneConnection) {
+    auto client = create();
+
+    for (int i = 0; i < 3; ++i) {
+        auto response = get(*client, "/api/v1/quotes?figis=SBER");
+        EXPECT_EQ(response.getStatus(), 200);
+        EXPECT_EQ(response.getBody(), "/api/v1/quotes?figis=SBER|");
+    }
+
+    auto s = client->stats();
+    EXPECT_EQ(s.requests, 3u);
+    EXPECT_EQ(s.handshakes, 1u);
+    EXPECT_EQ(s.poolHits, 2u);
+    EXPECT_EQ(s.idle, 1u);
+    EXPECT_EQ(s.latencyCount, 3u);
+    EXPECT_GT(s.latencyP99Seconds(), 0.0);
+    EXPECT_EQ(server_.connections.load(), 1);
+}
+
+TEST_F(KeepAliveHttpClientTest, Post_ForwardsBodyAndContentType) {
+    auto client = create();
+    SimpleRequest request("POST", "/api/v1/auth/validate", R"({"token":"t"})", "ignored", 1,
+                          {{"Content-Type", "application/json"}});
+    SimpleResponse response;
+
+    client->send(request, response);
+
+    EXPECT_EQ(response.getBody(), R"(/api/v1/auth/validate|{"token":"t"})");
+}
+
+TEST_F(KeepAliveHttpClientTest, IdleTimeout_EvictsConnection) {
+    setenv("HTTP_POOL_IDLE_TIMEOUT_MS", "30", 1);
+    auto client = create();
+
+    get(*client, "/a");
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    get(*client, "/b");
+
+    auto s = client->stats();
+    EXPECT_EQ(s.evicted, 1u);
+    EXPECT_EQ(s.handshakes, 2u);
+    EXPECT_EQ(s.poolHits, 0u);
+}
+
+TEST_F(KeepAliveHttpClientTest, ConnectionClosedByServer_RetriedOnNewConnection) {
+    auto client = create();
+
+    get(*client, "/close");
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    auto response = get(*client, "/after");
+
+    EXPECT_EQ(response.getBody(), "/after|");
+    auto s = client->stats();
+    EXPECT_EQ(s.retries, 1u);
+    EXPECT_EQ(s.handshakes, 2u);
+    EXPECT_EQ(s.errors, 0u);
+}
+
+TEST_F(KeepAliveHttpClientTest, RequestTimeout_Throws) {
+    setenv("HTTP_REQUEST_TIMEOUT_MS", "50", 1);
+    auto client = create();
+
+    EXPECT_THROW(get(*client, "/slow"), KeepAliveHttpClient::UpstreamError);
+
+    auto s = client->stats();
+    EXPECT_EQ(s.timeouts, 1u);
+    EXPECT_EQ(s.idle, 0u);   // соединение после таймаута не возвращается
+}
+
+TEST_F(KeepAliveHttpClientTest, MaxInFlight_LimitsConcurrentRequests) {
+    setenv("HTTP_MAX_IN_FLIGHT", "1", 1);
+    auto client = create();
+
+    std::vector<std::thread> callers;
+    for (int i = 0; i < 3; ++i) {
+        callers.emplace_back([&] { get(*client, "/slow"); });
+    }
+    for (auto& t : callers) {
+        t.join();
+    }
+
+    EXPECT_EQ(server_.maxActive.load(), 1);
+    EXPECT_EQ(client->stats().queued, 2u);
+    EXPECT_EQ(client->stats().handshakes, 1u);
+}
+
+TEST_F(KeepAliveHttpClientTest, ZeroPoolSize_ClosesAfterEachRequest) {
+    setenv("HTTP_POOL_SIZE", "0", 1);
+    auto client = create();
+
+    get(*client, "/a");
+    get(*client, "/b");
+
+    EXPECT_EQ(client->stats().handshakes, 2u);
+    EXPECT_EQ(server_.connections.load(), 2);
+}
+
+TEST(HttpPoolSettingsTest, InvalidValue_Throws) {
+    setenv("HTTP_MAX_IN_FLIGHT", "0", 1);
+    EXPECT_THROW(settings::HttpPoolSettings(), std::invalid_argument);
+    unsetenv("HTTP_MAX_IN_FLIGHT");
+}
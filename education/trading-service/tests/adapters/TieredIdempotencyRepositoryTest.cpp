@@ -0,0 +1,150 @@
+/**
+ * @file TieredIdempotencyRepositoryTest.cpp
+ * @brief Unit tests for TieredIdempotencyRepository: LRU в памяти и ожидание параллельных дублей
+ */
+
+#include <gtest/gtest.h>
+#include "adapters/secondary/TieredIdempotencyRepository.hpp"
+#include "../mocks/MockIdempotencyRepository.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace trading;
+using namespace trading::adapters::secondary;
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class TieredIdempotencyRepositoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        backend_ = std::make_shared<tests::MockIdempotencyRepository>();
+    }
+
+    void TearDown() override {
+        unsetenv("IDEMPOTENCY_CACHE_SIZE");
+        unsetenv("IDEMPOTENCY_INFLIGHT_TIMEOUT_MS");
+    }
+
+    std::unique_ptr<TieredIdempotencyRepository> create() {
+        return std::make_unique<TieredIdempotencyRepository>(
+            backend_, std::make_shared<settings::IdempotencySettings>());
+    }
+
+    std::shared_ptr<tests::MockIdempotencyRepository> backend_;
+};
+
+// ============================================================================
+// TIERS
+// ============================================================================
+
+TEST_F(TieredIdempotencyRepositoryTest, Save_ThenClaim_ServedFromMemory) {
+    auto repo = create();
+    EXPECT_FALSE(repo->claim("key-1").has_value());
+    repo->save("key-1", 201, R"({"order_id":"ord-1"})");
+
+    auto record = repo->claim("key-1");
+
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(record->status, 201);
+    EXPECT_EQ(record->body, R"({"order_id":"ord-1"})");
+    EXPECT_EQ(backend_->findCallCount(), 1);
+    EXPECT_EQ(backend_->saveCallCount(), 1);
+    EXPECT_EQ(repo->stats().inFlight, 0u);
+}
+
+TEST_F(TieredIdempotencyRepositoryTest, BackendRecord_CachedAfterFirstClaim) {
+    backend_->addRecord("key-1", 200, "{}");
+    auto repo = create();
+
+    EXPECT_TRUE(repo->claim("key-1").has_value());
+    EXPECT_TRUE(repo->claim("key-1").has_value());
+    EXPECT_TRUE(repo->find("key-1").has_value());
+
+    EXPECT_EQ(backend_->findCallCount(), 1);
+    auto s = repo->stats();
+    EXPECT_EQ(s.backendHits, 1u);
+    EXPECT_EQ(s.hits, 2u);
+    EXPECT_EQ(s.inFlight, 0u);
+}
+
+TEST_F(TieredIdempotencyRepositoryTest, BackendSaveFails_StillReplayedLocally) {
+    backend_->failSaves(true);
+    auto repo = create();
+    repo->claim("key-1");
+
+    EXPECT_NO_THROW(repo->save("key-1", 201, "{}"));
+
+    EXPECT_TRUE(repo->claim("key-1").has_value());
+}
+
+TEST_F(TieredIdempotencyRepositoryTest, Capacity_EvictsLeastRecentlyUsed) {
+    setenv("IDEMPOTENCY_CACHE_SIZE", "16", 1);
+    auto repo = create();
+
+    for (int i = 0; i < 100; ++i) {
+        repo->save("key-" + std::to_string(i), 201, "{}");
+    }
+
+    auto s = repo->stats();
+    EXPECT_LE(s.entries, 16u);
+    EXPECT_EQ(s.entries + s.evictions, 100u);
+}
+
+// ============================================================================
+// IN-FLIGHT DUPLICATES
+// ============================================================================
+
+TEST_F(TieredIdempotencyRepositoryTest, ConcurrentDuplicate_WaitsForFirstResponse) {
+    auto repo = create();
+    ASSERT_FALSE(repo->claim("key-1").has_value());
+
+    std::optional<domain::IdempotencyRecord> duplicate;
+    std::thread second([&] { duplicate = repo->claim("key-1"); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    repo->save("key-1", 201, R"({"order_id":"ord-1"})");
+    second.join();
+
+    ASSERT_TRUE(duplicate.has_value());
+    EXPECT_EQ(duplicate->body, R"({"order_id":"ord-1"})");
+    EXPECT_EQ(repo->stats().waits, 1u);
+    EXPECT_EQ(backend_->findCallCount(), 1);
+}
+
+TEST_F(TieredIdempotencyRepositoryTest, Release_HandsKeyToWaiter) {
+    auto repo = create();
+    ASSERT_FALSE(repo->claim("key-1").has_value());
+
+    bool secondOwnsKey = false;
+    std::thread second([&] { secondOwnsKey = !repo->claim("key-1").has_value(); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    repo->release("key-1");
+    second.join();
+
+    EXPECT_TRUE(secondOwnsKey);
+    EXPECT_EQ(repo->stats().inFlight, 1u);
+    EXPECT_EQ(repo->stats().takeovers, 0u);
+}
+
+TEST_F(TieredIdempotencyRepositoryTest, AbandonedClaim_TakenOverAfterTimeout) {
+    setenv("IDEMPOTENCY_INFLIGHT_TIMEOUT_MS", "50", 1);
+    auto repo = create();
+    ASSERT_FALSE(repo->claim("key-1").has_value());   // обработчик не дошёл до writer
+
+    auto started = std::chrono::steady_clock::now();
+    EXPECT_FALSE(repo->claim("key-1").has_value());
+
+    EXPECT_GE(std::chrono::steady_clock::now() - started, std::chrono::milliseconds(40));
+    EXPECT_EQ(repo->stats().takeovers, 1u);
+}
+
+TEST(IdempotencySettingsTest, InvalidValue_Throws) {
+    setenv("IDEMPOTENCY_KEY_TTL_SECONDS", "0", 1);
+    EXPECT_THROW(settings::IdempotencySettings(), std::invalid_argument);
+    unsetenv("IDEMPOTENCY_KEY_TTL_SECONDS");
+}
@@ -15,7 +15,8 @@ class MarketServiceTest : public ::testing::Test {
 protected:
     void SetUp() override {
         mockBroker_ = std::make_shared<MockBrokerGateway>();
-        marketService_ = std::make_shared<MarketService>(mockBroker_);
+        replica_ = std::make_shared<QuoteReplica>();
+        marketService_ = std::make_shared<MarketService>(mockBroker_, replica_);
 
         setupTestData();
     }
@@ -41,6 +42,7 @@ protected:
     }
 
     std::shared_ptr<MockBrokerGateway> mockBroker_;
+    std::shared_ptr<QuoteReplica> replica_;
     std::shared_ptr<MarketService> marketService_;
 };
 
@@ -79,6 +81,62 @@ TEST_F(MarketServiceTest, GetQuotes_MultipleIgis_ReturnsQuotes) {
     EXPECT_EQ(quotes.size(), 2u);
 }
 
+// ============================================================================
+// QUOTE REPLICA TESTS
+// ============================================================================
+
+TEST_F(MarketServiceTest, GetQuote_ColdStart_FetchesOnceThenServesFromReplica) {
+    marketService_->getQuote("BBG004730N88");
+    auto quote = marketService_->getQuote("BBG004730N88");
+
+    EXPECT_EQ(mockBroker_->getQuoteCallCount(), 1);
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_EQ(quote->ticker, "SBER");
+    EXPECT_NEAR(quote->lastPrice.toDouble(), 280.0, 0.01);
+}
+
+TEST_F(MarketServiceTest, GetQuote_EventAfterFill_ReplicaHasFreshPrice) {
+    marketService_->getQuote("BBG004730N88");
+    replica_->update("BBG004730N88", 281.5, 282.5, 282.0, "RUB", 0);
+
+    auto quote = marketService_->getQuote("BBG004730N88");
+
+    EXPECT_EQ(mockBroker_->getQuoteCallCount(), 1);
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_NEAR(quote->lastPrice.toDouble(), 282.0, 0.01);
+    EXPECT_EQ(quote->ticker, "SBER");
+}
+
+TEST_F(MarketServiceTest, GetQuote_AfterSequenceGap_FallsBackToBroker) {
+    marketService_->getQuote("BBG004730N88");
+    replica_->observeFrame(1, true);
+    replica_->observeFrame(3, false);
+
+    marketService_->getQuote("BBG004730N88");
+    marketService_->getQuote("BBG004730N88");
+
+    EXPECT_EQ(mockBroker_->getQuoteCallCount(), 2);
+}
+
+TEST_F(MarketServiceTest, GetQuotes_OnlyMissesGoToBroker_OrderPreserved) {
+    domain::Quote gazpQuote(
+        "BBG004730RP0", "GAZP",
+        domain::Money::fromDouble(150.0, "RUB"),
+        domain::Money::fromDouble(149.5, "RUB"),
+        domain::Money::fromDouble(150.5, "RUB"));
+    mockBroker_->setQuote("BBG004730RP0", gazpQuote);
+    marketService_->getQuote("BBG004730N88");
+
+    auto quotes = marketService_->getQuotes({"BBG004730RP0", "BBG004730N88"});
+    auto again = marketService_->getQuotes({"BBG004730RP0", "BBG004730N88"});
+
+    EXPECT_EQ(mockBroker_->getQuotesCallCount(), 1);
+    ASSERT_EQ(quotes.size(), 2u);
+    EXPECT_EQ(quotes[0].ticker, "GAZP");
+    EXPECT_EQ(quotes[1].ticker, "SBER");
+    EXPECT_EQ(again.size(), 2u);
+}
+
 // ============================================================================
 // INSTRUMENT TESTS
 // ============================================================================
@@ -0,0 +1,103 @@
+/**
+ * @file OrderProjectionTest.cpp
+ * @brief Unit tests for OrderProjection: порядок статусов, неполные записи, список аккаунта
+ */
+
+#include <gtest/gtest.h>
+#include "application/OrderProjection.hpp"
+
+#include <cstdlib>
+
+using namespace trading;
+using namespace trading::application;
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class OrderProjectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        projection_ = std::make_shared<OrderProjection>(std::make_shared<settings::CacheSettings>());
+    }
+
+    static domain::Order order(const std::string& id, const std::string& accountId = "acc-001") {
+        return domain::Order(id, accountId, "BBG004730N88", domain::OrderDirection::BUY,
+                             domain::OrderType::LIMIT, 10, domain::Money::fromDouble(280.0, "RUB"));
+    }
+
+    std::shared_ptr<OrderProjection> projection_;
+};
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST_F(OrderProjectionTest, StatusNeverMovesBackwards) {
+    projection_->put(order("ord-1"));
+    projection_->apply("ord-1", "acc-001", "BBG004730N88", domain::OrderStatus::PARTIALLY_FILLED, 4, 280.0);
+    projection_->apply("ord-1", "acc-001", "BBG004730N88", domain::OrderStatus::FILLED, 10, 279.5);
+    projection_->apply("ord-1", "acc-001", "BBG004730N88", domain::OrderStatus::PARTIALLY_FILLED, 6, 280.0);
+    projection_->apply("ord-1", "acc-001", "BBG004730N88", domain::OrderStatus::CANCELLED, 0, 0.0);
+
+    auto o = projection_->get("acc-001", "ord-1");
+    ASSERT_TRUE(o.has_value());
+    EXPECT_EQ(o->status, domain::OrderStatus::FILLED);
+    EXPECT_EQ(o->executedQuantity, 10);
+    EXPECT_NEAR(o->executedPrice.toDouble(), 279.5, 1e-6);
+    EXPECT_EQ(projection_->stats().outOfOrder, 2u);
+}
+
+TEST_F(OrderProjectionTest, StaleHttpAnswer_DoesNotUndoEvent) {
+    projection_->apply("ord-1", "acc-001", "BBG004730N88", domain::OrderStatus::FILLED, 10, 281.0);
+
+    projection_->put(order("ord-1"));   // ответ HTTP ещё со статусом PENDING
+
+    auto o = projection_->get("acc-001", "ord-1");
+    ASSERT_TRUE(o.has_value());
+    EXPECT_EQ(o->status, domain::OrderStatus::FILLED);
+    EXPECT_EQ(o->quantity, 10);
+}
+
+TEST_F(OrderProjectionTest, EventForUnknownOrder_NotServedAndBlocksList) {
+    projection_->putAll("acc-001", {order("ord-1")});
+    ASSERT_TRUE(projection_->list("acc-001").has_value());
+
+    projection_->apply("ord-2", "acc-001", "BBG004730N88", domain::OrderStatus::PENDING, 0, 0.0);
+
+    EXPECT_FALSE(projection_->get("acc-001", "ord-2").has_value());
+    EXPECT_FALSE(projection_->list("acc-001").has_value());
+
+    projection_->put(order("ord-2"));
+    auto orders = projection_->list("acc-001");
+    ASSERT_TRUE(orders.has_value());
+    ASSERT_EQ(orders->size(), 2u);
+    EXPECT_EQ((*orders)[0].id, "ord-2");
+}
+
+TEST_F(OrderProjectionTest, PutAll_KeepsBrokerOrderNewestFirst) {
+    projection_->putAll("acc-001", {order("ord-3"), order("ord-2"), order("ord-1")});
+    projection_->put(order("ord-4"));
+
+    auto orders = projection_->list("acc-001");
+
+    ASSERT_TRUE(orders.has_value());
+    ASSERT_EQ(orders->size(), 4u);
+    EXPECT_EQ((*orders)[0].id, "ord-4");
+    EXPECT_EQ((*orders)[3].id, "ord-1");
+    EXPECT_FALSE(projection_->list("acc-002").has_value());
+}
+
+TEST_F(OrderProjectionTest, Eviction_DropsOldestAndInvalidatesList) {
+    setenv("CACHE_ORDER_SIZE", "2", 1);
+    OrderProjection small(std::make_shared<settings::CacheSettings>());
+    unsetenv("CACHE_ORDER_SIZE");
+
+    small.putAll("acc-001", {order("ord-2"), order("ord-1")});
+    small.put(order("ord-3", "acc-002"));
+
+    EXPECT_FALSE(small.get("acc-001", "ord-1").has_value());
+    EXPECT_TRUE(small.get("acc-001", "ord-2").has_value());
+    EXPECT_FALSE(small.list("acc-001").has_value());
+    EXPECT_EQ(small.stats().evictions, 1u);
+}
@@ -28,11 +28,13 @@ protected:
 
         mockBroker_->setInstrument("BBG004730N88", sber);  // ← Используй существующий метод!
 
-        orderService_ = std::make_shared<OrderService>(mockBroker_, mockPublisher_);
+        projection_ = std::make_shared<OrderProjection>(std::make_shared<settings::CacheSettings>());
+        orderService_ = std::make_shared<OrderService>(mockBroker_, mockPublisher_, projection_);
     }
 
     std::shared_ptr<MockBrokerGateway> mockBroker_;
     std::shared_ptr<MockEventPublisher> mockPublisher_;
+    std::shared_ptr<OrderProjection> projection_;
     std::shared_ptr<OrderService> orderService_;
 };
 
@@ -145,7 +147,7 @@ TEST_F(OrderServiceTest, CancelOrder_PublishesEvent) {
 // GET ORDERS TESTS
 // ============================================================================
 
-TEST_F(OrderServiceTest, GetAllOrders_DelegatesToBroker) {
+TEST_F(OrderServiceTest, GetOrders_DelegatesToBroker) {
     domain::Order order1("ord-001", "acc-001", "BBG004730N88",
                          domain::OrderDirection::BUY, domain::OrderType::MARKET,
                          10, domain::Money::fromDouble(280.0, "RUB"));
@@ -154,17 +156,19 @@ TEST_F(OrderServiceTest, GetAllOrders_DelegatesToBroker) {
                          5, domain::Money::fromDouble(150.0, "RUB"));
     mockBroker_->setOrders("acc-001", {order1, order2});
 
-    auto orders = orderService_->getAllOrders("acc-001");
+    auto page = orderService_->getOrders("acc-001", {});
 
-    EXPECT_EQ(orders.size(), 2u);
-    EXPECT_EQ(orders[0].id, "ord-001");
-    EXPECT_EQ(orders[1].id, "ord-002");
+    ASSERT_EQ(page.orders.size(), 2u);
+    EXPECT_EQ(page.orders[0].id, "ord-001");
+    EXPECT_EQ(page.orders[1].id, "ord-002");
+    EXPECT_FALSE(page.nextCursor.has_value());
 }
 
-TEST_F(OrderServiceTest, GetAllOrders_EmptyAccount_ReturnsEmpty) {
-    auto orders = orderService_->getAllOrders("unknown-account");
+TEST_F(OrderServiceTest, GetOrders_EmptyAccount_ReturnsEmpty) {
+    auto page = orderService_->getOrders("unknown-account", {});
 
-    EXPECT_TRUE(orders.empty());
+    EXPECT_TRUE(page.orders.empty());
+    EXPECT_FALSE(page.nextCursor.has_value());
 }
 
 TEST_F(OrderServiceTest, PlaceOrder_InvalidFigi_ReturnsRejected) {
@@ -181,3 +185,111 @@ TEST_F(OrderServiceTest, PlaceOrder_InvalidFigi_ReturnsRejected) {
     EXPECT_EQ(result.message, "Invalid FIGI: INVALID_FIGI");
     EXPECT_EQ(mockPublisher_->publishCallCount(), 0);  // Событие не публикуется
 }
+
+// ============================================================================
+// PROJECTION TESTS
+// ============================================================================
+
+TEST_F(OrderServiceTest, PlacedOrder_ServedWithoutBroker) {
+    domain::OrderRequest request;
+    request.accountId = "acc-001";
+    request.figi = "BBG004730N88";
+    request.direction = domain::OrderDirection::SELL;
+    request.type = domain::OrderType::LIMIT;
+    request.quantity = 7;
+    request.price = domain::Money::fromDouble(281.5, "RUB");
+
+    auto result = orderService_->placeOrder(request);
+    auto order = orderService_->getOrderById("acc-001", result.orderId);
+
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(order->status, domain::OrderStatus::PENDING);
+    EXPECT_EQ(order->direction, domain::OrderDirection::SELL);
+    EXPECT_EQ(order->quantity, 7);
+    EXPECT_EQ(mockBroker_->getOrderCallCount(), 0);
+    EXPECT_EQ(mockBroker_->getOrdersCallCount(), 0);
+
+    // Чужой аккаунт ордер не видит
+    EXPECT_FALSE(orderService_->getOrderById("acc-002", result.orderId).has_value());
+}
+
+TEST_F(OrderServiceTest, GetOrderById_Unknown_FetchesSingleOrderOnce) {
+    domain::Order order("ord-001", "acc-001", "BBG004730N88",
+                        domain::OrderDirection::BUY, domain::OrderType::MARKET,
+                        10, domain::Money::fromDouble(280.0, "RUB"));
+    mockBroker_->setOrders("acc-001", {order});
+
+    EXPECT_TRUE(orderService_->getOrderById("acc-001", "ord-001").has_value());
+    EXPECT_TRUE(orderService_->getOrderById("acc-001", "ord-001").has_value());
+
+    EXPECT_EQ(mockBroker_->getOrderCallCount(), 1);
+    EXPECT_EQ(mockBroker_->getOrdersCallCount(), 0);
+}
+
+TEST_F(OrderServiceTest, GetOrders_LoadedOnce_ThenIncludesNewOrders) {
+    domain::Order old("ord-001", "acc-001", "BBG004730N88",
+                      domain::OrderDirection::BUY, domain::OrderType::MARKET,
+                      10, domain::Money::fromDouble(280.0, "RUB"));
+    mockBroker_->setOrders("acc-001", {old});
+    orderService_->getOrders("acc-001", {});
+
+    domain::OrderRequest request;
+    request.accountId = "acc-001";
+    request.figi = "BBG004730N88";
+    request.quantity = 1;
+    auto placed = orderService_->placeOrder(request);
+
+    auto page = orderService_->getOrders("acc-001", {});
+
+    ASSERT_EQ(page.orders.size(), 2u);
+    EXPECT_EQ(page.orders[0].id, placed.orderId);
+    EXPECT_EQ(page.orders[1].id, "ord-001");
+    EXPECT_FALSE(page.nextCursor.has_value());
+    EXPECT_EQ(mockBroker_->getOrdersCallCount(), 1);
+}
+
+TEST_F(OrderServiceTest, GetOrders_MultiplePages_EachPageFromBroker) {
+    std::vector<domain::Order> orders;
+    for (int i = 3; i >= 1; --i) {
+        orders.emplace_back("ord-00" + std::to_string(i), "acc-001", "BBG004730N88",
+                            domain::OrderDirection::BUY, domain::OrderType::MARKET,
+                            1, domain::Money::fromDouble(280.0, "RUB"));
+    }
+    mockBroker_->setOrders("acc-001", orders);
+
+    domain::OrderPageQuery query;
+    query.limit = 2;
+    auto first = orderService_->getOrders("acc-001", query);
+
+    ASSERT_EQ(first.orders.size(), 2u);
+    ASSERT_TRUE(first.nextCursor.has_value());
+
+    query.cursor = first.nextCursor;
+    auto second = orderService_->getOrders("acc-001", query);
+
+    ASSERT_EQ(second.orders.size(), 1u);
+    EXPECT_EQ(second.orders[0].id, "ord-001");
+    EXPECT_FALSE(second.nextCursor.has_value());
+    EXPECT_EQ(mockBroker_->lastOrdersQuery().cursor, first.nextCursor);
+
+    // Первая страница с next_cursor - не вся история: список аккаунта не запомнен
+    orderService_->getOrders("acc-001", {});
+    EXPECT_EQ(mockBroker_->getOrdersCallCount(), 3);
+}
+
+TEST_F(OrderServiceTest, GetOrders_Filtered_AlwaysFromBroker) {
+    domain::Order order("ord-001", "acc-001", "BBG004730N88",
+                        domain::OrderDirection::BUY, domain::OrderType::MARKET,
+                        10, domain::Money::fromDouble(280.0, "RUB"));
+    mockBroker_->setOrders("acc-001", {order});
+    orderService_->getOrders("acc-001", {});
+
+    domain::OrderPageQuery query;
+    query.status = domain::OrderStatus::FILLED;
+    query.fromMs = 1760000000000;
+    orderService_->getOrders("acc-001", query);
+
+    EXPECT_EQ(mockBroker_->getOrdersCallCount(), 2);
+    EXPECT_EQ(mockBroker_->lastOrdersQuery().status, domain::OrderStatus::FILLED);
+    EXPECT_EQ(mockBroker_->lastOrdersQuery().fromMs, 1760000000000);
+}
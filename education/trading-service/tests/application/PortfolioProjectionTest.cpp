@@ -0,0 +1,112 @@
+/**
+ * @file PortfolioProjectionTest.cpp
+ * @brief Unit tests for PortfolioProjection: версии portfolio.updated, переоценка, HTTP-заполнение
+ */
+
+#include <gtest/gtest.h>
+#include "application/PortfolioProjection.hpp"
+
+using namespace trading;
+using namespace trading::application;
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class PortfolioProjectionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        replica_ = std::make_shared<QuoteReplica>();
+        projection_ = std::make_shared<PortfolioProjection>(replica_);
+    }
+
+    static domain::Portfolio portfolio(double cash, int64_t sberLots) {
+        domain::Portfolio p;
+        p.cash = domain::Money::fromDouble(cash, "RUB");
+        if (sberLots > 0) {
+            domain::Position pos;
+            pos.figi = "SBER";
+            pos.ticker = "SBER";
+            pos.quantity = sberLots;
+            pos.averagePrice = domain::Money::fromDouble(100.0, "RUB");
+            pos.currentPrice = domain::Money::fromDouble(100.0, "RUB");
+            p.positions.push_back(pos);
+        }
+        return p;
+    }
+
+    double cashOf(const std::string& accountId) {
+        auto p = projection_->get(accountId).portfolio;
+        return p ? p->cash.toDouble() : -1.0;
+    }
+
+    std::shared_ptr<QuoteReplica> replica_;
+    std::shared_ptr<PortfolioProjection> projection_;
+};
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST_F(PortfolioProjectionTest, UnknownAccount_Misses) {
+    auto lookup = projection_->get("acc-001");
+
+    EXPECT_FALSE(lookup.portfolio.has_value());
+    EXPECT_EQ(lookup.generation, 0u);
+}
+
+TEST_F(PortfolioProjectionTest, OlderOrDuplicateVersion_Dropped) {
+    projection_->apply("acc-001", 1, 2, portfolio(2000.0, 0));
+    projection_->apply("acc-001", 1, 1, portfolio(1000.0, 0));
+    projection_->apply("acc-001", 1, 2, portfolio(1500.0, 0));
+
+    EXPECT_DOUBLE_EQ(cashOf("acc-001"), 2000.0);
+    EXPECT_EQ(projection_->stats().outOfOrder, 2u);
+}
+
+TEST_F(PortfolioProjectionTest, VersionGap_RequiresHttpRefresh) {
+    projection_->apply("acc-001", 1, 1, portfolio(1000.0, 0));
+    projection_->apply("acc-001", 1, 3, portfolio(3000.0, 0));
+
+    auto lookup = projection_->get("acc-001");
+    EXPECT_FALSE(lookup.portfolio.has_value());
+    EXPECT_EQ(projection_->stats().gaps, 1u);
+
+    projection_->fill("acc-001", portfolio(3100.0, 0), lookup.generation);
+    EXPECT_DOUBLE_EQ(cashOf("acc-001"), 3100.0);
+
+    // Версии после заполнения продолжают отсчёт
+    projection_->apply("acc-001", 1, 4, portfolio(4000.0, 0));
+    EXPECT_DOUBLE_EQ(cashOf("acc-001"), 4000.0);
+    EXPECT_EQ(projection_->stats().gaps, 1u);
+}
+
+TEST_F(PortfolioProjectionTest, NewEpoch_AcceptedAfterBrokerRestart) {
+    projection_->apply("acc-001", 1, 7, portfolio(1000.0, 0));
+    projection_->apply("acc-001", 2, 1, portfolio(900.0, 0));
+
+    EXPECT_DOUBLE_EQ(cashOf("acc-001"), 900.0);
+    EXPECT_EQ(projection_->stats().gaps, 0u);
+}
+
+TEST_F(PortfolioProjectionTest, Fill_DoesNotOverwriteEventArrivedDuringFetch) {
+    auto lookup = projection_->get("acc-001");
+    projection_->apply("acc-001", 1, 1, portfolio(2000.0, 0));
+
+    projection_->fill("acc-001", portfolio(1000.0, 0), lookup.generation);
+
+    EXPECT_DOUBLE_EQ(cashOf("acc-001"), 2000.0);
+    EXPECT_EQ(projection_->stats().fills, 0u);
+}
+
+TEST_F(PortfolioProjectionTest, Positions_RevaluedFromQuoteReplica) {
+    projection_->apply("acc-001", 1, 1, portfolio(1000.0, 10));
+    replica_->update("SBER", 119.0, 121.0, 120.0, "RUB", 0);
+
+    auto p = projection_->get("acc-001").portfolio;
+
+    ASSERT_TRUE(p.has_value());
+    EXPECT_NEAR(p->positions[0].currentPrice.toDouble(), 120.0, 1e-6);
+    EXPECT_NEAR(p->positions[0].pnl.toDouble(), 200.0, 1e-6);
+    EXPECT_NEAR(p->totalValue.toDouble(), 2200.0, 1e-6);
+}
@@ -15,7 +15,8 @@ class PortfolioServiceTest : public ::testing::Test {
 protected:
     void SetUp() override {
         mockBroker_ = std::make_shared<MockBrokerGateway>();
-        portfolioService_ = std::make_shared<PortfolioService>(mockBroker_);
+        projection_ = std::make_shared<PortfolioProjection>(std::make_shared<QuoteReplica>());
+        portfolioService_ = std::make_shared<PortfolioService>(mockBroker_, projection_);
 
         setupTestData();
     }
@@ -49,6 +50,7 @@ protected:
     }
 
     std::shared_ptr<MockBrokerGateway> mockBroker_;
+    std::shared_ptr<PortfolioProjection> projection_;
     std::shared_ptr<PortfolioService> portfolioService_;
 };
 
@@ -122,3 +124,26 @@ TEST_F(PortfolioServiceTest, Portfolio_TotalPnl_SumsPositions) {
     // Сумма PnL по позициям: 1000 + 1000 = 2000
     EXPECT_NEAR(totalPnl.toDouble(), 2000.0, 0.01);
 }
+
+// ============================================================================
+// PROJECTION TESTS
+// ============================================================================
+
+TEST_F(PortfolioServiceTest, RepeatedReads_FetchOverHttpOnce) {
+    portfolioService_->getPortfolio("acc-001");
+    portfolioService_->getAvailableCash("acc-001");
+    portfolioService_->getPositions("acc-001");
+
+    EXPECT_EQ(mockBroker_->getPortfolioCallCount(), 1);
+}
+
+TEST_F(PortfolioServiceTest, PortfolioUpdated_ServedWithoutHttp) {
+    domain::Portfolio updated;
+    updated.cash = domain::Money::fromDouble(42000.0, "RUB");
+    projection_->apply("acc-002", 1, 1, updated);
+
+    auto cash = portfolioService_->getAvailableCash("acc-002");
+
+    EXPECT_NEAR(cash.toDouble(), 42000.0, 0.01);
+    EXPECT_EQ(mockBroker_->getPortfolioCallCount(), 0);
+}
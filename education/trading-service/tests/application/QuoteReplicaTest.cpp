@@ -0,0 +1,170 @@
+/**
+ * @file QuoteReplicaTest.cpp
+ * @brief Unit tests for QuoteReplica
+ */
+
+#include <gtest/gtest.h>
+#include "application/QuoteReplica.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace trading;
+using namespace trading::application;
+
+namespace {
+
+domain::Quote makeQuote(const std::string& figi, const std::string& ticker, double last) {
+    return domain::Quote(
+        figi, ticker,
+        domain::Money::fromDouble(last, "RUB"),
+        domain::Money::fromDouble(last - 0.5, "RUB"),
+        domain::Money::fromDouble(last + 0.5, "RUB"));
+}
+
+} // namespace
+
+// ============================================================================
+// READ / WRITE
+// ============================================================================
+
+TEST(QuoteReplicaTest, Get_Unknown_ReturnsNullopt) {
+    QuoteReplica replica;
+
+    EXPECT_FALSE(replica.get("SBER").has_value());
+}
+
+TEST(QuoteReplicaTest, Update_ThenGet_ReturnsPrices) {
+    QuoteReplica replica;
+    replica.update("SBER", 99.5, 100.5, 100.0, "USD", 1700000000000);
+
+    auto quote = replica.get("SBER");
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_EQ(quote->figi, "SBER");
+    EXPECT_TRUE(quote->ticker.empty());
+    EXPECT_NEAR(quote->bidPrice.toDouble(), 99.5, 1e-6);
+    EXPECT_NEAR(quote->askPrice.toDouble(), 100.5, 1e-6);
+    EXPECT_NEAR(quote->lastPrice.toDouble(), 100.0, 1e-6);
+    EXPECT_EQ(quote->lastPrice.currency, "USD");
+}
+
+TEST(QuoteReplicaTest, Fill_KeepsExactMoneyAndTicker) {
+    QuoteReplica replica;
+    domain::Quote quote("SBER", "SBER-T",
+                        domain::Money(280, 150000000, "RUB"),
+                        domain::Money(279, 0, "RUB"),
+                        domain::Money(281, 1, "RUB"));
+    replica.fill(quote);
+
+    auto stored = replica.get("SBER");
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ(stored->ticker, "SBER-T");
+    EXPECT_EQ(stored->lastPrice.units, 280);
+    EXPECT_EQ(stored->lastPrice.nano, 150000000);
+    EXPECT_EQ(stored->askPrice.nano, 1);
+}
+
+TEST(QuoteReplicaTest, Fill_DoesNotOverwriteFresherEvent) {
+    QuoteReplica replica;
+    replica.update("SBER", 101.5, 102.5, 102.0, "RUB", 0);
+    replica.fill(makeQuote("SBER", "SBER", 100.0));
+
+    auto quote = replica.get("SBER");
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_NEAR(quote->lastPrice.toDouble(), 102.0, 1e-6);
+    EXPECT_EQ(quote->ticker, "SBER");   // тикер запомнен
+    EXPECT_EQ(replica.stats().fills, 0u);
+}
+
+TEST(QuoteReplicaTest, ManyInstruments_GrowsIndex) {
+    QuoteReplica replica;
+    for (int i = 0; i < 2000; ++i) {
+        replica.update("FIGI" + std::to_string(i), i, i + 1, i + 0.5, "RUB", 0);
+    }
+
+    EXPECT_EQ(replica.stats().instruments, 2000u);
+    for (int i = 0; i < 2000; i += 97) {
+        auto quote = replica.get("FIGI" + std::to_string(i));
+        ASSERT_TRUE(quote.has_value());
+        EXPECT_NEAR(quote->lastPrice.toDouble(), i + 0.5, 1e-6);
+    }
+}
+
+// ============================================================================
+// SEQUENCE
+// ============================================================================
+
+TEST(QuoteReplicaTest, ObserveFrame_ContiguousAfterSnapshot_NoRequest) {
+    QuoteReplica replica;
+
+    EXPECT_FALSE(replica.observeFrame(1, true));
+    EXPECT_FALSE(replica.observeFrame(2, false));
+    EXPECT_FALSE(replica.observeFrame(3, false));
+
+    auto s = replica.stats();
+    EXPECT_EQ(s.frames, 3u);
+    EXPECT_EQ(s.snapshots, 1u);
+    EXPECT_EQ(s.gaps, 0u);
+    EXPECT_EQ(s.lastSeq, 3u);
+}
+
+TEST(QuoteReplicaTest, ObserveFrame_Gap_StalesOldSlotsAndRequestsSnapshot) {
+    QuoteReplica replica;
+    replica.observeFrame(1, true);
+    replica.update("SBER", 1, 2, 1.5, "RUB", 0);
+
+    EXPECT_TRUE(replica.observeFrame(5, false));
+    EXPECT_FALSE(replica.get("SBER").has_value());
+
+    // Повторно не просим, пока не прошёл SNAPSHOT_REQUEST_INTERVAL
+    EXPECT_FALSE(replica.observeFrame(9, false));
+    EXPECT_EQ(replica.stats().gaps, 2u);
+    EXPECT_EQ(replica.stats().snapshotRequests, 1u);
+
+    // HTTP-ответ для устаревшего слота принимается
+    replica.fill(makeQuote("SBER", "SBER", 1.7));
+    ASSERT_TRUE(replica.get("SBER").has_value());
+    EXPECT_NEAR(replica.get("SBER")->lastPrice.toDouble(), 1.7, 1e-6);
+}
+
+// ============================================================================
+// CONCURRENCY
+// ============================================================================
+
+TEST(QuoteReplicaTest, ConcurrentReaders_NeverSeeTornQuote) {
+    QuoteReplica replica;
+    replica.update("SBER", 0, 0, 0, "RUB", 0);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 2; ++r) {
+        readers.emplace_back([&] {
+            while (!done.load()) {
+                auto quote = replica.get("SBER");
+                if (!quote) {
+                    continue;
+                }
+                // Писатель всегда пишет bid = ask = last
+                if (quote->bidPrice.units != quote->lastPrice.units ||
+                    quote->askPrice.units != quote->lastPrice.units) {
+                    ++torn;
+                }
+            }
+        });
+    }
+
+    for (int i = 1; i <= 20000; ++i) {
+        replica.update("SBER", i, i, i, "RUB", i);
+        if (i % 1000 == 0) {
+            replica.update("NEW" + std::to_string(i), i, i, i, "RUB", i);   // рост индекса во время чтения
+        }
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(torn.load(), 0);
+    EXPECT_NEAR(replica.get("SBER")->lastPrice.toDouble(), 20000.0, 1e-6);
+}
@@ -0,0 +1,287 @@
+/**
+ * @file TradingEventHandlerTest.cpp
+ * @brief Unit tests for TradingEventHandler: JSON и бинарный формат событий, реплика котировок
+ */
+
+#include <gtest/gtest.h>
+#include "application/TradingEventHandler.hpp"
+#include "application/EventWireFormat.hpp"
+#include "../mocks/MockEventPublisher.hpp"
+
+#include <nlohmann/json.hpp>
+#include <vector>
+
+using namespace trading;
+using namespace trading::application;
+
+// ============================================================================
+// Fake IEventConsumer
+// ============================================================================
+
+class FakeEventConsumer : public ports::input::IEventConsumer {
+public:
+    void subscribe(const std::vector<std::string>&, ports::input::EventHandler) override {
+        FAIL() << "TradingEventHandler should use subscribeTyped";
+    }
+
+    void subscribeTyped(const std::vector<std::string>& routingKeys,
+                        ports::input::TypedEventHandler handler) override {
+        keys = routingKeys;
+        handler_ = std::move(handler);
+    }
+
+    void start() override {}
+    void stop() override {}
+
+    void deliver(const std::string& routingKey, const std::string& message,
+                 const std::string& contentType) {
+        handler_(routingKey, message, contentType);
+    }
+
+    std::vector<std::string> keys;
+
+private:
+    ports::input::TypedEventHandler handler_;
+};
+
+// ============================================================================
+// Test Fixture
+// ============================================================================
+
+class TradingEventHandlerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        consumer_ = std::make_shared<FakeEventConsumer>();
+        publisher_ = std::make_shared<tests::MockEventPublisher>();
+        replica_ = std::make_shared<QuoteReplica>();
+        portfolios_ = std::make_shared<PortfolioProjection>(replica_);
+        orderProjection_ = std::make_shared<OrderProjection>(std::make_shared<settings::CacheSettings>());
+        handler_ = std::make_unique<TradingEventHandler>(consumer_, publisher_, replica_, portfolios_, orderProjection_);
+        handler_->onOrderUpdate([this](const TradingEventHandler::OrderUpdate& u) { orders_.push_back(u); });
+        handler_->onQuoteUpdate([this](const TradingEventHandler::QuoteUpdate& u) { quotes_.push_back(u); });
+    }
+
+    void deliverBatch(uint64_t seq, bool snapshot, const std::string& figi, double last) {
+        nlohmann::json json;
+        json["seq"] = seq;
+        json["snapshot"] = snapshot;
+        json["quotes"] = nlohmann::json::array({
+            {{"figi", figi}, {"bid", last - 1}, {"ask", last + 1}, {"last_price", last}, {"currency", "RUB"}}
+        });
+        consumer_->deliver(snapshot ? "quote.snapshot" : "quote.batch", json.dump(), wire::CONTENT_TYPE_JSON);
+    }
+
+    std::shared_ptr<FakeEventConsumer> consumer_;
+    std::shared_ptr<tests::MockEventPublisher> publisher_;
+    std::shared_ptr<QuoteReplica> replica_;
+    std::shared_ptr<PortfolioProjection> portfolios_;
+    std::shared_ptr<OrderProjection> orderProjection_;
+    std::unique_ptr<TradingEventHandler> handler_;
+    std::vector<TradingEventHandler::OrderUpdate> orders_;
+    std::vector<TradingEventHandler::QuoteUpdate> quotes_;
+};
+
+// ============================================================================
+// TESTS
+// ============================================================================
+
+TEST_F(TradingEventHandlerTest, SubscribesToBrokerEvents) {
+    EXPECT_EQ(consumer_->keys.size(), 9u);
+}
+
+TEST_F(TradingEventHandlerTest, QuoteUpdated_BinaryAndJsonGiveSameUpdate) {
+    nlohmann::json json;
+    json["figi"] = "BBG004730N88";
+    json["bid"] = 265.1;
+    json["ask"] = 265.3;
+    json["last_price"] = 265.2;
+    json["currency"] = "RUB";
+    json["timestamp"] = 1700000000123;
+    consumer_->deliver("quote.updated", json.dump(), wire::CONTENT_TYPE_JSON);
+
+    wire::QuoteFrame frame;
+    frame.figi = "BBG004730N88";
+    frame.bid = 265.1;
+    frame.ask = 265.3;
+    frame.last = 265.2;
+    frame.currency = "RUB";
+    frame.timestampMs = 1700000000123;
+    consumer_->deliver("quote.updated", wire::encode(frame), wire::CONTENT_TYPE_BINARY);
+
+    ASSERT_EQ(quotes_.size(), 2u);
+    for (const auto& q : quotes_) {
+        EXPECT_EQ(q.figi, "BBG004730N88");
+        EXPECT_DOUBLE_EQ(q.bid, 265.1);
+        EXPECT_DOUBLE_EQ(q.ask, 265.3);
+        EXPECT_DOUBLE_EQ(q.lastPrice, 265.2);
+        EXPECT_EQ(q.currency, "RUB");
+        EXPECT_EQ(q.timestamp, 1700000000123);
+    }
+}
+
+TEST_F(TradingEventHandlerTest, QuoteBatch_BinaryAndJsonAppliedPerQuote) {
+    nlohmann::json json;
+    json["seq"] = 1;
+    json["snapshot"] = false;
+    json["quotes"] = nlohmann::json::array({
+        {{"figi", "SBER"}, {"bid", 1.0}, {"ask", 2.0}, {"last_price", 1.5}, {"currency", "RUB"}},
+        {{"figi", "GAZP"}, {"bid", 3.0}, {"ask", 4.0}, {"last_price", 3.5}, {"currency", "RUB"}}
+    });
+    consumer_->deliver("quote.batch", json.dump(), wire::CONTENT_TYPE_JSON);
+
+    wire::QuoteBatchFrame batch;
+    batch.seq = 2;
+    batch.snapshot = true;
+    wire::QuoteFrame q;
+    q.figi = "SBER";
+    q.bid = 1.0;
+    q.ask = 2.0;
+    q.last = 1.5;
+    q.currency = "RUB";
+    batch.quotes.push_back(q);
+    q.figi = "GAZP";
+    q.bid = 3.0;
+    q.ask = 4.0;
+    q.last = 3.5;
+    batch.quotes.push_back(q);
+    consumer_->deliver("quote.snapshot", wire::encode(batch), wire::CONTENT_TYPE_BINARY);
+
+    ASSERT_EQ(quotes_.size(), 4u);
+    for (size_t i = 0; i < 4; i += 2) {
+        EXPECT_EQ(quotes_[i].figi, "SBER");
+        EXPECT_DOUBLE_EQ(quotes_[i].lastPrice, 1.5);
+        EXPECT_EQ(quotes_[i + 1].figi, "GAZP");
+        EXPECT_DOUBLE_EQ(quotes_[i + 1].ask, 4.0);
+    }
+}
+
+TEST_F(TradingEventHandlerTest, OrderFilled_BinaryAndJsonGiveSameUpdate) {
+    nlohmann::json json;
+    json["order_id"] = "ord-1";
+    json["account_id"] = "acc-1";
+    json["figi"] = "BBG004730N88";
+    json["status"] = "FILLED";
+    json["executed_lots"] = 3;
+    json["executed_price"] = 100.5;
+    json["timestamp"] = 1700000000123;
+    consumer_->deliver("order.filled", json.dump(), "");
+
+    wire::OrderFrame frame;
+    frame.orderId = "ord-1";
+    frame.accountId = "acc-1";
+    frame.figi = "BBG004730N88";
+    frame.status = wire::OrderStatus::FILLED;
+    frame.lots = 3;
+    frame.price = 100.5;
+    frame.currency = "RUB";
+    frame.timestampMs = 1700000000123;
+    consumer_->deliver("order.filled", wire::encode(frame), wire::CONTENT_TYPE_BINARY);
+
+    ASSERT_EQ(orders_.size(), 2u);
+    for (const auto& o : orders_) {
+        EXPECT_EQ(o.orderId, "ord-1");
+        EXPECT_EQ(o.accountId, "acc-1");
+        EXPECT_EQ(o.figi, "BBG004730N88");
+        EXPECT_EQ(o.status, "FILLED");
+        EXPECT_EQ(o.executedLots, 3);
+        EXPECT_DOUBLE_EQ(o.executedPrice, 100.5);
+        EXPECT_EQ(o.timestamp, 1700000000123);
+    }
+
+    // Ордер создан другой репликой: статус записан, но до HTTP не отдаётся
+    EXPECT_EQ(orderProjection_->stats().partial, 1u);
+    EXPECT_FALSE(orderProjection_->get("acc-1", "ord-1").has_value());
+
+    domain::Order order("ord-1", "acc-1", "BBG004730N88", domain::OrderDirection::BUY,
+                        domain::OrderType::MARKET, 3, domain::Money::fromDouble(0.0));
+    orderProjection_->put(order);
+    auto cached = orderProjection_->get("acc-1", "ord-1");
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->status, domain::OrderStatus::FILLED);
+    EXPECT_EQ(cached->executedQuantity, 3);
+}
+
+TEST_F(TradingEventHandlerTest, OrderRejected_BinaryCarriesReason) {
+    wire::OrderFrame frame;
+    frame.orderId = "ord-2";
+    frame.accountId = "acc-1";
+    frame.status = wire::OrderStatus::REJECTED;
+    frame.reason = "Insufficient funds";
+    consumer_->deliver("order.rejected", wire::encode(frame), wire::CONTENT_TYPE_BINARY);
+
+    ASSERT_EQ(orders_.size(), 1u);
+    EXPECT_EQ(orders_[0].status, "REJECTED");
+    EXPECT_EQ(orders_[0].reason, "Insufficient funds");
+}
+
+TEST_F(TradingEventHandlerTest, MalformedBinary_Ignored) {
+    consumer_->deliver("order.filled", "TX", wire::CONTENT_TYPE_BINARY);
+    consumer_->deliver("quote.updated", R"({"figi":"X"})", wire::CONTENT_TYPE_BINARY);
+
+    EXPECT_TRUE(orders_.empty());
+    EXPECT_TRUE(quotes_.empty());
+}
+
+TEST_F(TradingEventHandlerTest, QuoteUpdated_LandsInReplica) {
+    wire::QuoteFrame frame;
+    frame.figi = "SBER";
+    frame.bid = 99.5;
+    frame.ask = 100.5;
+    frame.last = 100.0;
+    frame.currency = "RUB";
+    consumer_->deliver("quote.updated", wire::encode(frame), wire::CONTENT_TYPE_BINARY);
+
+    auto quote = replica_->get("SBER");
+    ASSERT_TRUE(quote.has_value());
+    EXPECT_NEAR(quote->lastPrice.toDouble(), 100.0, 1e-6);
+    EXPECT_NEAR(quote->askPrice.toDouble(), 100.5, 1e-6);
+    EXPECT_EQ(quote->lastPrice.currency, "RUB");
+}
+
+TEST_F(TradingEventHandlerTest, FirstBatchWithoutSnapshot_RequestsSnapshotOnce) {
+    deliverBatch(7, false, "SBER", 100.0);
+    deliverBatch(8, false, "SBER", 101.0);
+
+    ASSERT_EQ(publisher_->publishCallCount(), 1);
+    EXPECT_EQ(publisher_->getPublishedMessages()[0].routingKey, "quote.snapshot.request");
+    EXPECT_TRUE(replica_->get("SBER").has_value());
+}
+
+TEST_F(TradingEventHandlerTest, SequenceGap_InvalidatesUntouchedQuotes) {
+    deliverBatch(1, true, "SBER", 100.0);
+    deliverBatch(2, false, "GAZP", 200.0);
+    EXPECT_EQ(publisher_->publishCallCount(), 0);
+
+    // seq 3 потерян: SBER мог измениться в нём
+    deliverBatch(4, false, "GAZP", 201.0);
+
+    EXPECT_EQ(publisher_->publishCallCount(), 1);
+    EXPECT_FALSE(replica_->get("SBER").has_value());
+    ASSERT_TRUE(replica_->get("GAZP").has_value());
+    EXPECT_NEAR(replica_->get("GAZP")->lastPrice.toDouble(), 201.0, 1e-6);
+
+    // Срез возвращает всё в актуальное состояние
+    deliverBatch(5, true, "SBER", 102.0);
+    ASSERT_TRUE(replica_->get("SBER").has_value());
+    EXPECT_EQ(replica_->stats().gaps, 1u);
+}
+
+TEST_F(TradingEventHandlerTest, PortfolioUpdated_LandsInProjection) {
+    nlohmann::json event = {
+        {"account_id", "acc-001"}, {"epoch", 1}, {"version", 1},
+        {"cash", {{"amount", 5000.0}, {"currency", "RUB"}}},
+        {"positions", nlohmann::json::array({
+            {{"figi", "SBER"}, {"ticker", "SBER"}, {"quantity", 10},
+             {"average_price", 100.0}, {"current_price", 110.0}, {"currency", "RUB"}}
+        })}
+    };
+    consumer_->deliver("portfolio.updated", event.dump(), wire::CONTENT_TYPE_JSON);
+
+    auto portfolio = portfolios_->get("acc-001").portfolio;
+    ASSERT_TRUE(portfolio.has_value());
+    EXPECT_NEAR(portfolio->cash.toDouble(), 5000.0, 1e-6);
+    ASSERT_EQ(portfolio->positions.size(), 1u);
+    EXPECT_EQ(portfolio->positions[0].quantity, 10);
+    EXPECT_NEAR(portfolio->positions[0].pnl.toDouble(), 100.0, 1e-6);
+    EXPECT_NEAR(portfolio->totalValue.toDouble(), 6100.0, 1e-6);
+}
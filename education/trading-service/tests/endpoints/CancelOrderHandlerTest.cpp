@@ -31,7 +31,7 @@ public:
     MOCK_METHOD(domain::OrderResult, placeOrder, (const domain::OrderRequest &), (override));
     MOCK_METHOD(bool, cancelOrder, (const std::string &, const std::string &), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderById, (const std::string &, const std::string &), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getAllOrders, (const std::string &), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string &, const domain::OrderPageQuery &), (override));
 };
 
 // ============================================================================
@@ -106,7 +106,8 @@ TEST_F(CancelOrderHandlerTest, CannotCancel_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_TRUE(json["error"].get<std::string>().find("cancel") != std::string::npos);
@@ -119,7 +120,8 @@ TEST_F(CancelOrderHandlerTest, MissingOrderId_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_TRUE(json["error"].get<std::string>().find("Order ID") != std::string::npos);
@@ -132,7 +134,8 @@ TEST_F(CancelOrderHandlerTest, NoAccountId_Returns500)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 500);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "500");
 }
 
 TEST_F(CancelOrderHandlerTest, GetMethod_Returns405)
@@ -165,5 +168,6 @@ TEST_F(CancelOrderHandlerTest, ServiceThrows_Returns500)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 500);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "500");
 }
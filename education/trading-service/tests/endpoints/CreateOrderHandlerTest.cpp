@@ -31,7 +31,7 @@ public:
     MOCK_METHOD(domain::OrderResult, placeOrder, (const domain::OrderRequest &), (override));
     MOCK_METHOD(bool, cancelOrder, (const std::string &, const std::string &), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderById, (const std::string &, const std::string &), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getAllOrders, (const std::string &), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string &, const domain::OrderPageQuery &), (override));
 };
 
 // ============================================================================
@@ -159,7 +159,8 @@ TEST_F(CreateOrderHandlerTest, NoAccountId_Returns500)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 500);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "500");
 }
 
 TEST_F(CreateOrderHandlerTest, RejectedOrder_Returns400)
@@ -179,7 +180,8 @@ TEST_F(CreateOrderHandlerTest, RejectedOrder_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_EQ(json["status"], "REJECTED");
@@ -198,7 +200,8 @@ TEST_F(CreateOrderHandlerTest, MissingFigi_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_TRUE(json["error"].get<std::string>().find("FIGI") != std::string::npos);
@@ -218,7 +221,8 @@ TEST_F(CreateOrderHandlerTest, ZeroQuantity_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_TRUE(json["error"].get<std::string>().find("Quantity") != std::string::npos);
@@ -231,7 +235,8 @@ TEST_F(CreateOrderHandlerTest, InvalidJson_Returns400)
 
     handler_->handle(req, res);
 
-    EXPECT_EQ(res.getStatus(), 400);
+    EXPECT_EQ(res.getStatus(), 0);
+    EXPECT_EQ(req.getAttribute("httpStatus"), "400");
 
     auto json = parseJson(res.getBody());
     EXPECT_TRUE(json["error"].get<std::string>().find("JSON") != std::string::npos);
@@ -20,7 +20,7 @@ public:
     MOCK_METHOD(domain::OrderResult, placeOrder, (const domain::OrderRequest &), (override));
     MOCK_METHOD(bool, cancelOrder, (const std::string &, const std::string &), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderById, (const std::string &, const std::string &), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getAllOrders, (const std::string &), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string &, const domain::OrderPageQuery &), (override));
 };
 
 class GetOrderHandlerTest : public ::testing::Test
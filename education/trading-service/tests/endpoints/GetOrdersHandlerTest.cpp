@@ -19,7 +19,7 @@ public:
     MOCK_METHOD(domain::OrderResult, placeOrder, (const domain::OrderRequest &), (override));
     MOCK_METHOD(bool, cancelOrder, (const std::string &, const std::string &), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrderById, (const std::string &, const std::string &), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getAllOrders, (const std::string &), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string &, const domain::OrderPageQuery &), (override));
 };
 
 class GetOrdersHandlerTest : public ::testing::Test
@@ -53,15 +53,15 @@ protected:
 
 TEST_F(GetOrdersHandlerTest, ReturnsOrders_Returns200)
 {
-    std::vector<domain::Order> orders;
+    domain::OrderPage page;
     domain::Order order;
     order.id = "ord-001";
     order.accountId = "acc-001";
     order.status = domain::OrderStatus::FILLED;
-    orders.push_back(order);
+    page.orders.push_back(order);
 
-    EXPECT_CALL(*mockOrderService_, getAllOrders("acc-001"))
-        .WillOnce(Return(orders));
+    EXPECT_CALL(*mockOrderService_, getOrders("acc-001", _))
+        .WillOnce(Return(page));
 
     auto req = createRequest("GET", "/api/v1/orders", "acc-001");
     SimpleResponse res;
@@ -71,6 +71,113 @@ TEST_F(GetOrdersHandlerTest, ReturnsOrders_Returns200)
     EXPECT_EQ(res.getStatus(), 200);
     auto json = parseJson(res.getBody());
     EXPECT_EQ(json["orders"].size(), 1);
+    EXPECT_TRUE(json["next_cursor"].is_null());
+}
+
+TEST_F(GetOrdersHandlerTest, PageParameters_PassedToService_NextCursorReturned)
+{
+    domain::OrderPageQuery received;
+    domain::OrderPage page;
+    page.nextCursor = "1760000000000000_ord-050";
+
+    EXPECT_CALL(*mockOrderService_, getOrders("acc-001", _))
+        .WillOnce([&](const std::string &, const domain::OrderPageQuery &query)
+        {
+            received = query;
+            return page;
+        });
+
+    auto req = createRequest("GET",
+        "/api/v1/orders?limit=50&cursor=1760000000000000_ord-100&from=1760000000000"
+        "&to=2025-10-10T00:00:00Z&status=FILLED", "acc-001");
+    SimpleResponse res;
+
+    handler_->handle(req, res);
+
+    EXPECT_EQ(res.getStatus(), 200);
+    EXPECT_EQ(received.limit, 50u);
+    EXPECT_EQ(received.cursor, "1760000000000000_ord-100");
+    EXPECT_EQ(received.fromMs, 1760000000000);
+    EXPECT_EQ(received.toMs, 1760054400000);
+    EXPECT_EQ(received.status, domain::OrderStatus::FILLED);
+    EXPECT_EQ(parseJson(res.getBody())["next_cursor"], "1760000000000000_ord-050");
+}
+
+TEST_F(GetOrdersHandlerTest, InvalidParameter_Returns400)
+{
+    EXPECT_CALL(*mockOrderService_, getOrders(_, _)).Times(0);
+
+    for (const char *path : {"/api/v1/orders?limit=0", "/api/v1/orders?limit=ten",
+                             "/api/v1/orders?status=DONE", "/api/v1/orders?from=yesterday",
+                             "/api/v1/orders?from=2024-01-01T10:00:00+03:00",
+                             "/api/v1/orders?to=2024-01-01T10:00:00garbage"})
+    {
+        auto req = createRequest("GET", path, "acc-001");
+        SimpleResponse res;
+
+        handler_->handle(req, res);
+
+        EXPECT_EQ(res.getStatus(), 400) << path;
+    }
+}
+
+TEST_F(GetOrdersHandlerTest, IsoTime_WithOrWithoutZ_ReadAsUtc)
+{
+    std::vector<domain::OrderPageQuery> received;
+    EXPECT_CALL(*mockOrderService_, getOrders("acc-001", _))
+        .Times(2)
+        .WillRepeatedly([&](const std::string &, const domain::OrderPageQuery &query)
+        {
+            received.push_back(query);
+            return domain::OrderPage{};
+        });
+
+    for (const char *path : {"/api/v1/orders?from=2024-01-01T10:00:00Z",
+                             "/api/v1/orders?from=2024-01-01T10:00:00"})
+    {
+        auto req = createRequest("GET", path, "acc-001");
+        SimpleResponse res;
+
+        handler_->handle(req, res);
+
+        EXPECT_EQ(res.getStatus(), 200) << path;
+    }
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].fromMs, 1704103200000);
+    EXPECT_EQ(received[1].fromMs, 1704103200000);
+}
+
+TEST_F(GetOrdersHandlerTest, LimitAboveMax_Capped)
+{
+    domain::OrderPageQuery received;
+    EXPECT_CALL(*mockOrderService_, getOrders("acc-001", _))
+        .WillOnce([&](const std::string &, const domain::OrderPageQuery &query)
+        {
+            received = query;
+            return domain::OrderPage{};
+        });
+
+    auto req = createRequest("GET", "/api/v1/orders?limit=5000", "acc-001");
+    SimpleResponse res;
+
+    handler_->handle(req, res);
+
+    EXPECT_EQ(res.getStatus(), 200);
+    EXPECT_EQ(received.limit, domain::OrderPageQuery::MAX_LIMIT);
+}
+
+TEST_F(GetOrdersHandlerTest, BrokerRejectsCursor_Returns400)
+{
+    EXPECT_CALL(*mockOrderService_, getOrders("acc-001", _))
+        .WillOnce(::testing::Throw(std::invalid_argument("Broker rejected order query")));
+
+    auto req = createRequest("GET", "/api/v1/orders?cursor=garbage", "acc-001");
+    SimpleResponse res;
+
+    handler_->handle(req, res);
+
+    EXPECT_EQ(res.getStatus(), 400);
 }
 
 TEST_F(GetOrdersHandlerTest, NoAccountId_Returns500)
@@ -26,6 +26,7 @@ class MockAuthClient : public ports::output::IAuthClient
 {
 public:
     MOCK_METHOD(ports::output::TokenValidationResult, validateAccessToken, (const std::string &), (override));
+    MOCK_METHOD(std::vector<ports::output::TokenValidationResult>, validateAccessTokens, (const std::vector<std::string> &), (override));
     MOCK_METHOD(std::optional<std::string>, getAccountIdFromToken, (const std::string &), (override));
 };
 
@@ -0,0 +1,149 @@
+// tests/middleware/IdempotencyChainTest.cpp
+/**
+ * @file IdempotencyChainTest.cpp
+ * @brief Цепочка POST /api/v1/orders с X-Idempotency-Key
+ *
+ * IdempotencyCacheReader -> CreateOrderHandler -> IdempotencyCacheWriter
+ * поверх TieredIdempotencyRepository: ошибка обработчика должна доходить
+ * до writer, иначе повтор ждёт занятый ключ IDEMPOTENCY_INFLIGHT_TIMEOUT_MS.
+ */
+
+#include <gtest/gtest.h>
+
+#include "adapters/primary/IdempotencyCacheReader.hpp"
+#include "adapters/primary/IdempotencyCacheWriter.hpp"
+#include "adapters/primary/CreateOrderHandler.hpp"
+#include "adapters/secondary/TieredIdempotencyRepository.hpp"
+#include "../mocks/MockIdempotencyRepository.hpp"
+
+#include <SimpleRequest.hpp>
+#include <SimpleResponse.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+
+using namespace trading;
+using namespace trading::adapters::primary;
+
+namespace {
+
+/**
+ * @brief Сервис ордеров: первые failCalls вызовов падают (broker-service недоступен), дальше - успех
+ */
+class FlakyOrderService : public ports::input::IOrderService
+{
+public:
+    domain::OrderResult placeOrder(const domain::OrderRequest &) override
+    {
+        if (calls.fetch_add(1) < failCalls)
+        {
+            throw std::runtime_error("broker-service: 502");
+        }
+        domain::OrderResult result;
+        result.orderId = "ord-1";
+        result.status = domain::OrderStatus::PENDING;
+        return result;
+    }
+
+    bool cancelOrder(const std::string &, const std::string &) override { return false; }
+
+    std::optional<domain::Order> getOrderById(const std::string &, const std::string &) override
+    {
+        return std::nullopt;
+    }
+
+    domain::OrderPage getOrders(const std::string &, const domain::OrderPageQuery &) override
+    {
+        return {};
+    }
+
+    int failCalls = 1;
+    std::atomic<int> calls{0};
+};
+
+} // namespace
+
+class IdempotencyChainTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        setenv("IDEMPOTENCY_INFLIGHT_TIMEOUT_MS", "5000", 1);
+        repo_ = std::make_shared<adapters::secondary::TieredIdempotencyRepository>(
+            std::make_shared<tests::MockIdempotencyRepository>(),
+            std::make_shared<settings::IdempotencySettings>());
+        orderService_ = std::make_shared<FlakyOrderService>();
+        chain_ = {std::make_shared<IdempotencyCacheReader>(repo_),
+                  std::make_shared<CreateOrderHandler>(orderService_),
+                  std::make_shared<IdempotencyCacheWriter>(repo_)};
+    }
+
+    void TearDown() override
+    {
+        unsetenv("IDEMPOTENCY_INFLIGHT_TIMEOUT_MS");
+    }
+
+    /// Как serverlib: ненулевой статус останавливает цепочку
+    SimpleResponse post(const std::string &body)
+    {
+        SimpleRequest req;
+        req.setMethod("POST");
+        req.setPath("/api/v1/orders");
+        req.setBody(body);
+        req.setHeader("X-Idempotency-Key", "key-1");
+        req.setAttribute("accountId", "acc-001");
+
+        SimpleResponse res;
+        for (const auto &handler : chain_)
+        {
+            handler->handle(req, res);
+            if (res.getStatus() != 0)
+            {
+                break;
+            }
+        }
+        return res;
+    }
+
+    std::shared_ptr<adapters::secondary::TieredIdempotencyRepository> repo_;
+    std::shared_ptr<FlakyOrderService> orderService_;
+    std::vector<std::shared_ptr<IHttpHandler>> chain_;
+};
+
+TEST_F(IdempotencyChainTest, ValidationError_RetryDoesNotWaitForKey)
+{
+    orderService_->failCalls = 0;
+
+    auto first = post(R"({"quantity": 10})");
+    EXPECT_EQ(first.getStatus(), 400);
+    EXPECT_EQ(repo_->stats().inFlight, 0u);
+
+    auto started = std::chrono::steady_clock::now();
+    auto retry = post(R"({"figi": "BBG004730N88", "quantity": 10})");
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+    EXPECT_EQ(retry.getStatus(), 201);
+    EXPECT_EQ(repo_->stats().waits, 0u);
+}
+
+TEST_F(IdempotencyChainTest, ServiceFailure_RetryExecutesImmediately)
+{
+    const std::string body = R"({"figi": "BBG004730N88", "quantity": 10})";
+
+    auto first = post(body);
+    EXPECT_EQ(first.getStatus(), 500);
+
+    auto started = std::chrono::steady_clock::now();
+    auto retry = post(body);
+
+    EXPECT_LT(std::chrono::steady_clock::now() - started, std::chrono::seconds(1));
+    EXPECT_EQ(retry.getStatus(), 201);
+    EXPECT_EQ(orderService_->calls.load(), 2);
+
+    // Успешный ответ сохранён: третий запрос получает его без исполнения
+    auto replay = post(body);
+    EXPECT_EQ(replay.getStatus(), 201);
+    EXPECT_EQ(orderService_->calls.load(), 2);
+}
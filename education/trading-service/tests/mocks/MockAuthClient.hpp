@@ -1,8 +1,10 @@
 #pragma once
 
 #include "ports/output/IAuthClient.hpp"
+#include <atomic>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace trading::tests {
 
@@ -16,18 +18,46 @@ public:
         validTokens_[token] = {userId, accountId};
     }
 
+    /// expires_at, который вернёт валидация (0 - не сообщать)
+    void setExpiresAtMs(int64_t expiresAtMs) {
+        expiresAtMs_ = expiresAtMs;
+    }
+
     void clearTokens() {
         validTokens_.clear();
     }
 
     // Счётчики вызовов
     int validateCallCount() const { return validateCallCount_; }
-    void resetCallCount() { validateCallCount_ = 0; }
+    int batchCallCount() const { return batchCallCount_; }
+    void resetCallCount() { validateCallCount_ = 0; batchCallCount_ = 0; }
 
     // IAuthClient implementation
     ports::output::TokenValidationResult validateAccessToken(const std::string& token) override {
         ++validateCallCount_;
-        
+        return resolve(token);
+    }
+
+    std::vector<ports::output::TokenValidationResult> validateAccessTokens(
+        const std::vector<std::string>& tokens) override {
+        ++batchCallCount_;
+        std::vector<ports::output::TokenValidationResult> results;
+        for (const auto& token : tokens) {
+            results.push_back(resolve(token));
+        }
+        return results;
+    }
+
+    std::optional<std::string> getAccountIdFromToken(const std::string& token) override {
+        auto result = validateAccessToken(token);
+        if (result.valid) {
+            return result.accountId;
+        }
+        return std::nullopt;
+    }
+
+private:
+    ports::output::TokenValidationResult resolve(const std::string& token) const {
         ports::output::TokenValidationResult result;
         auto it = validTokens_.find(token);
         
@@ -36,6 +66,7 @@ public:
             result.userId = it->second.first;
             result.accountId = it->second.second;
             result.message = "OK";
+            result.expiresAtMs = expiresAtMs_;
         } else {
             result.valid = false;
             result.message = "Invalid token";
@@ -44,17 +75,10 @@ public:
         return result;
     }
 
-    std::optional<std::string> getAccountIdFromToken(const std::string& token) override {
-        auto result = validateAccessToken(token);
-        if (result.valid) {
-            return result.accountId;
-        }
-        return std::nullopt;
-    }
-
-private:
     std::map<std::string, std::pair<std::string, std::string>> validTokens_;  // token -> (userId, accountId)
-    mutable int validateCallCount_ = 0;
+    std::atomic<int> validateCallCount_{0};
+    std::atomic<int> batchCallCount_{0};
+    int64_t expiresAtMs_ = 0;
 };
 
 } // namespace trading::tests
@@ -36,6 +36,7 @@ public:
     int getAllInstrumentsCallCount() const { return getAllInstrumentsCallCount_; }
     int getPortfolioCallCount() const { return getPortfolioCallCount_; }
     int getOrdersCallCount() const { return getOrdersCallCount_; }
+    int getOrderCallCount() const { return getOrderCallCount_; }
 
     void resetCallCounts() {
         getQuoteCallCount_ = 0;
@@ -44,6 +45,7 @@ public:
         getAllInstrumentsCallCount_ = 0;
         getPortfolioCallCount_ = 0;
         getOrdersCallCount_ = 0;
+        getOrderCallCount_ = 0;
     }
 
     // IBrokerGateway implementation
@@ -106,19 +108,44 @@ public:
         return domain::Portfolio();
     }
 
-    std::vector<domain::Order> getOrders(const std::string& accountId) override {
+    /**
+     * @brief Страница по limit; курсор - id последнего ордера страницы
+     */
+    domain::OrderPage getOrders(
+        const std::string& accountId,
+        const domain::OrderPageQuery& query
+    ) override {
         ++getOrdersCallCount_;
+        lastOrdersQuery_ = query;
+        domain::OrderPage page;
         auto it = orders_.find(accountId);
-        if (it != orders_.end()) {
-            return it->second;
+        if (it == orders_.end()) {
+            return page;
+        }
+        const auto& orders = it->second;
+        size_t start = 0;
+        if (query.cursor) {
+            while (start < orders.size() && orders[start].id != *query.cursor) {
+                ++start;
+            }
+            ++start;
+        }
+        for (size_t i = start; i < orders.size() && page.orders.size() < query.limit; ++i) {
+            page.orders.push_back(orders[i]);
         }
-        return {};
+        if (start + page.orders.size() < orders.size()) {
+            page.nextCursor = page.orders.back().id;
+        }
+        return page;
     }
 
+    const domain::OrderPageQuery& lastOrdersQuery() const { return lastOrdersQuery_; }
+
     std::optional<domain::Order> getOrder(
         const std::string& accountId, 
         const std::string& orderId
     ) override {
+        ++getOrderCallCount_;
         auto it = orders_.find(accountId);
         if (it != orders_.end()) {
             for (const auto& order : it->second) {
@@ -135,6 +162,7 @@ private:
     std::map<std::string, domain::Instrument> instruments_;
     std::map<std::string, domain::Portfolio> portfolios_;
     std::map<std::string, std::vector<domain::Order>> orders_;
+    domain::OrderPageQuery lastOrdersQuery_;
 
     mutable int getQuoteCallCount_ = 0;
     mutable int getQuotesCallCount_ = 0;
@@ -142,6 +170,7 @@ private:
     mutable int getAllInstrumentsCallCount_ = 0;
     mutable int getPortfolioCallCount_ = 0;
     mutable int getOrdersCallCount_ = 0;
+    mutable int getOrderCallCount_ = 0;
 };
 
 } // namespace trading::tests
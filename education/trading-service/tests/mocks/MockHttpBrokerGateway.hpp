@@ -38,7 +38,7 @@ public:
     MOCK_METHOD(std::vector<domain::Instrument>, getAllInstruments, (), (override));
     MOCK_METHOD(std::vector<domain::Instrument>, searchInstruments, (const std::string &query), (override));
     MOCK_METHOD(domain::Portfolio, getPortfolio, (const std::string &accountId), (override));
-    MOCK_METHOD(std::vector<domain::Order>, getOrders, (const std::string &accountId), (override));
+    MOCK_METHOD(domain::OrderPage, getOrders, (const std::string &accountId, const domain::OrderPageQuery &query), (override));
     MOCK_METHOD(std::optional<domain::Order>, getOrder, (const std::string &accountId, const std::string &orderId), (override));
 };
 
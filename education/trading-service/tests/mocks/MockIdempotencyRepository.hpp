@@ -0,0 +1,55 @@
+#pragma once
+
+#include "ports/output/IIdempotencyRepository.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+namespace trading::tests {
+
+/**
+ * @brief Mock реализация IIdempotencyRepository (общий уровень) для тестов
+ */
+class MockIdempotencyRepository : public ports::output::IIdempotencyRepository {
+public:
+    // Настройка
+    void addRecord(const std::string& key, int status, const std::string& body) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        records_[key] = domain::IdempotencyRecord{key, status, body};
+    }
+
+    void failSaves(bool fail) { failSaves_ = fail; }
+
+    // Счётчики вызовов
+    int findCallCount() const { return findCallCount_; }
+    int saveCallCount() const { return saveCallCount_; }
+
+    std::optional<domain::IdempotencyRecord> find(const std::string& key) override {
+        ++findCallCount_;
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = records_.find(key);
+        if (it == records_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    void save(const std::string& key, int status, const std::string& body) override {
+        ++saveCallCount_;
+        if (failSaves_) {
+            throw std::runtime_error("database unavailable");
+        }
+        addRecord(key, status, body);
+    }
+
+private:
+    std::mutex mutex_;
+    std::map<std::string, domain::IdempotencyRecord> records_;
+    std::atomic<int> findCallCount_{0};
+    std::atomic<int> saveCallCount_{0};
+    std::atomic<bool> failSaves_{false};
+};
+
+} // namespace trading::tests